@@ -161,6 +161,171 @@ JNIEXPORT void JNICALL Java_CocoJNI_cocoObserverSignalRestart
 
 }
 
+/*
+ * Class:     CocoJNI
+ * Method:    cocoObserverMemoryGetNumberOfRuns
+ * Signature: (J)J
+ */
+JNIEXPORT jlong JNICALL Java_CocoJNI_cocoObserverMemoryGetNumberOfRuns
+(JNIEnv *jenv, jclass interface_cls, jlong jobserver_pointer) {
+
+  coco_observer_t *observer = NULL;
+
+  /* This test is both to prevent warning because interface_cls was not used and to check for exceptions */
+  if (interface_cls == NULL) {
+    jclass Exception = (*jenv)->FindClass(jenv, "java/lang/Exception");
+    (*jenv)->ThrowNew(jenv, Exception, "Exception in cocoObserverMemoryGetNumberOfRuns\n");
+  }
+
+  observer = (coco_observer_t *) jobserver_pointer;
+  return (jlong) coco_observer_memory_get_number_of_runs(observer);
+}
+
+/*
+ * Class:     CocoJNI
+ * Method:    cocoObserverMemoryGetProblemId
+ * Signature: (JJ)Ljava/lang/String;
+ */
+JNIEXPORT jstring JNICALL Java_CocoJNI_cocoObserverMemoryGetProblemId
+(JNIEnv *jenv, jclass interface_cls, jlong jobserver_pointer, jlong jrun_index) {
+
+  coco_observer_t *observer = NULL;
+
+  /* This test is both to prevent warning because interface_cls was not used and to check for exceptions */
+  if (interface_cls == NULL) {
+    jclass Exception = (*jenv)->FindClass(jenv, "java/lang/Exception");
+    (*jenv)->ThrowNew(jenv, Exception, "Exception in cocoObserverMemoryGetProblemId\n");
+  }
+
+  observer = (coco_observer_t *) jobserver_pointer;
+  return (*jenv)->NewStringUTF(jenv, coco_observer_memory_get_problem_id(observer, (size_t) jrun_index));
+}
+
+/*
+ * Class:     CocoJNI
+ * Method:    cocoObserverMemoryGetEvaluations
+ * Signature: (JJ)J
+ */
+JNIEXPORT jlong JNICALL Java_CocoJNI_cocoObserverMemoryGetEvaluations
+(JNIEnv *jenv, jclass interface_cls, jlong jobserver_pointer, jlong jrun_index) {
+
+  coco_observer_t *observer = NULL;
+
+  /* This test is both to prevent warning because interface_cls was not used and to check for exceptions */
+  if (interface_cls == NULL) {
+    jclass Exception = (*jenv)->FindClass(jenv, "java/lang/Exception");
+    (*jenv)->ThrowNew(jenv, Exception, "Exception in cocoObserverMemoryGetEvaluations\n");
+  }
+
+  observer = (coco_observer_t *) jobserver_pointer;
+  return (jlong) coco_observer_memory_get_evaluations(observer, (size_t) jrun_index);
+}
+
+/*
+ * Class:     CocoJNI
+ * Method:    cocoObserverMemoryGetTargets
+ * Signature: (JJ)[D
+ */
+JNIEXPORT jdoubleArray JNICALL Java_CocoJNI_cocoObserverMemoryGetTargets
+(JNIEnv *jenv, jclass interface_cls, jlong jobserver_pointer, jlong jrun_index) {
+
+  coco_observer_t *observer = NULL;
+  double *targets = NULL;
+  size_t number_of_hits;
+  jdoubleArray jtargets;
+
+  /* This test is both to prevent warning because interface_cls was not used and to check for exceptions */
+  if (interface_cls == NULL) {
+    jclass Exception = (*jenv)->FindClass(jenv, "java/lang/Exception");
+    (*jenv)->ThrowNew(jenv, Exception, "Exception in cocoObserverMemoryGetTargets\n");
+  }
+
+  observer = (coco_observer_t *) jobserver_pointer;
+  number_of_hits = coco_observer_memory_get_number_of_hits(observer, (size_t) jrun_index);
+  targets = coco_allocate_vector(number_of_hits + 1);
+  coco_observer_memory_get_hits(observer, (size_t) jrun_index, targets, NULL);
+
+  jtargets = (*jenv)->NewDoubleArray(jenv, (jsize) number_of_hits);
+  (*jenv)->SetDoubleArrayRegion(jenv, jtargets, 0, (jsize) number_of_hits, targets);
+  coco_free_memory(targets);
+  return jtargets;
+}
+
+/*
+ * Class:     CocoJNI
+ * Method:    cocoObserverMemoryGetHitEvaluations
+ * Signature: (JJ)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_CocoJNI_cocoObserverMemoryGetHitEvaluations
+(JNIEnv *jenv, jclass interface_cls, jlong jobserver_pointer, jlong jrun_index) {
+
+  coco_observer_t *observer = NULL;
+  size_t *evaluations = NULL;
+  jlong *jvalues = NULL;
+  size_t number_of_hits, i;
+  jlongArray jevaluations;
+
+  /* This test is both to prevent warning because interface_cls was not used and to check for exceptions */
+  if (interface_cls == NULL) {
+    jclass Exception = (*jenv)->FindClass(jenv, "java/lang/Exception");
+    (*jenv)->ThrowNew(jenv, Exception, "Exception in cocoObserverMemoryGetHitEvaluations\n");
+  }
+
+  observer = (coco_observer_t *) jobserver_pointer;
+  number_of_hits = coco_observer_memory_get_number_of_hits(observer, (size_t) jrun_index);
+  evaluations = coco_allocate_vector_size_t(number_of_hits + 1);
+  jvalues = (jlong *) coco_allocate_memory((number_of_hits + 1) * sizeof(jlong));
+  coco_observer_memory_get_hits(observer, (size_t) jrun_index, NULL, evaluations);
+  for (i = 0; i < number_of_hits; i++)
+    jvalues[i] = (jlong) evaluations[i];
+
+  jevaluations = (*jenv)->NewLongArray(jenv, (jsize) number_of_hits);
+  (*jenv)->SetLongArrayRegion(jenv, jevaluations, 0, (jsize) number_of_hits, jvalues);
+  coco_free_memory(jvalues);
+  coco_free_memory(evaluations);
+  return jevaluations;
+}
+
+/*
+ * Class:     CocoJNI
+ * Method:    cocoObserverMemoryClear
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_CocoJNI_cocoObserverMemoryClear
+(JNIEnv *jenv, jclass interface_cls, jlong jobserver_pointer) {
+
+  coco_observer_t *observer = NULL;
+
+  /* This test is both to prevent warning because interface_cls was not used and to check for exceptions */
+  if (interface_cls == NULL) {
+    jclass Exception = (*jenv)->FindClass(jenv, "java/lang/Exception");
+    (*jenv)->ThrowNew(jenv, Exception, "Exception in cocoObserverMemoryClear\n");
+  }
+
+  observer = (coco_observer_t *) jobserver_pointer;
+  coco_observer_memory_clear(observer);
+}
+
+/*
+ * Class:     CocoJNI
+ * Method:    cocoObserverMemoryExport
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_CocoJNI_cocoObserverMemoryExport
+(JNIEnv *jenv, jclass interface_cls, jlong jobserver_pointer) {
+
+  coco_observer_t *observer = NULL;
+
+  /* This test is both to prevent warning because interface_cls was not used and to check for exceptions */
+  if (interface_cls == NULL) {
+    jclass Exception = (*jenv)->FindClass(jenv, "java/lang/Exception");
+    (*jenv)->ThrowNew(jenv, Exception, "Exception in cocoObserverMemoryExport\n");
+  }
+
+  observer = (coco_observer_t *) jobserver_pointer;
+  coco_observer_memory_export(observer);
+}
+
 /*
  * Class:     CocoJNI
  * Method:    cocoGetSuite
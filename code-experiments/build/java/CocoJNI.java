@@ -17,6 +17,13 @@ public class CocoJNI {
 	public static native long cocoProblemAddObserver(long problemPointer, long observerPointer);
 	public static native long cocoProblemRemoveObserver(long problemPointer, long observerPointer);
 	public static native void cocoObserverSignalRestart(long observerPointer, long problemPointer);
+	public static native long cocoObserverMemoryGetNumberOfRuns(long observerPointer);
+	public static native String cocoObserverMemoryGetProblemId(long observerPointer, long runIndex);
+	public static native long cocoObserverMemoryGetEvaluations(long observerPointer, long runIndex);
+	public static native double[] cocoObserverMemoryGetTargets(long observerPointer, long runIndex);
+	public static native long[] cocoObserverMemoryGetHitEvaluations(long observerPointer, long runIndex);
+	public static native void cocoObserverMemoryClear(long observerPointer);
+	public static native void cocoObserverMemoryExport(long observerPointer);
 
 	// Suite
 	public static native long cocoGetSuite(String suiteName, String suiteInstance, String suiteOptions);
@@ -46,6 +46,57 @@ public class Observer {
 		CocoJNI.cocoObserverSignalRestart(this.getPointer(), problem.getPointer());
 	}
 
+	/* Methods of the "memory" observer */
+
+	/**
+	 * Returns the number of runs (observed problems) stored by the memory observer.
+	 */
+	public long getNumberOfRuns() {
+		return CocoJNI.cocoObserverMemoryGetNumberOfRuns(this.pointer);
+	}
+
+	/**
+	 * Returns the id of the problem of the given run.
+	 */
+	public String getRunProblemId(long runIndex) {
+		return CocoJNI.cocoObserverMemoryGetProblemId(this.pointer, runIndex);
+	}
+
+	/**
+	 * Returns the number of evaluations performed in the given run.
+	 */
+	public long getRunEvaluations(long runIndex) {
+		return CocoJNI.cocoObserverMemoryGetEvaluations(this.pointer, runIndex);
+	}
+
+	/**
+	 * Returns the targets hit in the given run.
+	 */
+	public double[] getRunTargets(long runIndex) {
+		return CocoJNI.cocoObserverMemoryGetTargets(this.pointer, runIndex);
+	}
+
+	/**
+	 * Returns the numbers of evaluations when the targets returned by getRunTargets were first hit.
+	 */
+	public long[] getRunHitEvaluations(long runIndex) {
+		return CocoJNI.cocoObserverMemoryGetHitEvaluations(this.pointer, runIndex);
+	}
+
+	/**
+	 * Frees the data of the finished runs.
+	 */
+	public void clearRuns() {
+		CocoJNI.cocoObserverMemoryClear(this.pointer);
+	}
+
+	/**
+	 * Exports the stored runs to the result folder in the bbob format.
+	 */
+	public void exportRuns() {
+		CocoJNI.cocoObserverMemoryExport(this.pointer);
+	}
+
 	/* toString method */
 	@Override
 	public String toString() {
@@ -37,6 +37,14 @@ cdef extern from "coco.h":
                                               coco_observer_t *observer)
     const char *coco_observer_get_result_folder(const coco_observer_t *observer)
     void coco_observer_signal_restart(coco_observer_t *observer, coco_problem_t *problem)
+    size_t coco_observer_memory_get_number_of_runs(const coco_observer_t *observer)
+    const char *coco_observer_memory_get_problem_id(const coco_observer_t *observer, const size_t run_index)
+    size_t coco_observer_memory_get_evaluations(const coco_observer_t *observer, const size_t run_index)
+    size_t coco_observer_memory_get_number_of_hits(const coco_observer_t *observer, const size_t run_index)
+    void coco_observer_memory_get_hits(const coco_observer_t *observer, const size_t run_index,
+                                       double *targets, size_t *evaluations)
+    void coco_observer_memory_clear(coco_observer_t *observer)
+    void coco_observer_memory_export(coco_observer_t *observer)
 
     coco_suite_t *coco_suite(const char *suite_name, const char *suite_instance,
                              const char *suite_options)
@@ -497,6 +505,40 @@ cdef class Observer:
     def result_folder(self):
         return coco_observer_get_result_folder(self._observer)
 
+    @property
+    def number_of_runs(self):
+        """number of runs (observed problems) stored by the "memory" observer"""
+        return coco_observer_memory_get_number_of_runs(self._observer)
+
+    def run_problem_id(self, run_index):
+        """id of the problem of run `run_index` of the "memory" observer"""
+        return coco_observer_memory_get_problem_id(self._observer, run_index)
+
+    def run_evaluations(self, run_index):
+        """number of evaluations of run `run_index` of the "memory" observer"""
+        return coco_observer_memory_get_evaluations(self._observer, run_index)
+
+    def run_hits(self, run_index):
+        """return the targets hit in run `run_index` of the "memory" observer
+        and the evaluations when they were first hit as two `np.ndarray`.
+        """
+        cdef size_t number_of_hits = coco_observer_memory_get_number_of_hits(self._observer, run_index)
+        cdef np.ndarray[double, ndim=1, mode="c"] targets = np.zeros(number_of_hits + 1)
+        cdef np.ndarray evaluations = np.zeros(number_of_hits + 1, dtype=np.uintp)
+        coco_observer_memory_get_hits(self._observer, run_index,
+                                      <double *>np.PyArray_DATA(targets),
+                                      <size_t *>np.PyArray_DATA(evaluations))
+        return targets[:number_of_hits], np.asarray(evaluations[:number_of_hits], dtype=np.int64)
+
+    def clear_runs(self):
+        """free the data of the finished runs of the "memory" observer"""
+        coco_observer_memory_clear(self._observer)
+
+    def export_runs(self):
+        """write the runs of the "memory" observer that have not been
+        exported yet to `result_folder` in the bbob format"""
+        coco_observer_memory_export(self._observer)
+
     def free(self):
         self.__dealloc__()
         self._observer = NULL
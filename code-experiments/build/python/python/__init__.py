@@ -390,6 +390,11 @@ class Observer(_Observer):
           underlying C observer is passed by global assignment with
           `_update_current_observer_global()`
 
+        - The "memory" observer writes no files. The targets hit in each run
+          (observed problem) and their first hitting evaluations are returned
+          by `run_hits`, see also `number_of_runs`, `run_problem_id`,
+          `run_evaluations`, `clear_runs` and `export_runs`.
+
     """
 
     def __init__(self, name, options):
@@ -0,0 +1,285 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * An evaluator that answers the requests with the evaluations recorded by COCO (see the suite option
+ * "record" in socket_communication.c), so that the evaluations of an expensive external evaluator can
+ * be replayed without calling it. It is used by the replay server (socket_server.c compiled with
+ * REPLAY_SERVER set to 1).
+ *
+ * The log has the format of the cache files of COCO (see socket_cache.c): the 8 characters "COCOCAC1"
+ * and the 32-bit unsigned integer 0x01020304 (in the byte order of the platform that recorded the log),
+ * followed by records. Each record consists of the length of the key and the number of values (32-bit
+ * unsigned integers), followed by the key and the values (doubles). The key consists of the evaluation
+ * type (1 for objectives, 2 for constraints), function, instance, dimension, number of values and length
+ * of the suite name (32-bit unsigned integers), followed by the suite name and the x-values (doubles).
+ *
+ * The log is mapped into memory (on Windows, it is read into memory) and indexed with a hash table of
+ * the offsets of its records, so that the lookups need neither copies nor parsing. If the same
+ * evaluation was recorded several times, the last record is used.
+ *
+ * The text protocol sends the x-values rounded to precision_x digits, while the binary protocol sends
+ * them exactly, so the requests match the records exactly only if the log was recorded with the same
+ * protocol. The records are therefore also indexed by their x-values rounded in the same way as by the
+ * text protocol (with the precision given to the replay server, 8 by default). Requests that are not
+ * found exactly are looked up with their rounded x-values, so that a log recorded with one protocol can
+ * be replayed with the other one (the evaluations of the recorded solutions, which differ from the
+ * requested ones by the rounding, are then returned). Requests that are not found in this way either
+ * are answered with NaN values (and reported to stderr).
+ */
+
+#define REPLAY_MAGIC "COCOCAC1"     /* The first 8 bytes of the log */
+#define REPLAY_BYTE_ORDER 0x01020304 /* The number that follows the magic (used to check the byte order) */
+#define REPLAY_HEADER_SIZE 12       /* The size of the magic and byte order in bytes */
+
+/**
+ * The indexed log.
+ */
+typedef struct {
+  const char *log;          /* The contents of the log */
+  size_t log_size;          /* The size of the log in bytes */
+  size_t *index;            /* The hash table of the offsets of the records (0 denotes an empty slot) */
+  size_t index_size;        /* The number of slots of the hash tables (a power of two) */
+  size_t number_of_records; /* The number of different evaluations in the log */
+  int precision_x;          /* The precision of the rounded x-values */
+  size_t *rounded_index;    /* The hash table of the offsets of the records with rounded x-values */
+  unsigned long *rounded_hashes; /* The hashes of the rounded keys of the records in rounded_index */
+} replay_t;
+
+replay_t replay = { NULL, 0, NULL, 0, 0, 8, NULL, NULL };
+
+/**
+ * Returns the 32-bit FNV-1a hash of the given bytes.
+ */
+unsigned long replay_hash(const char *bytes, size_t length) {
+  unsigned long hash = 2166136261UL;
+  size_t i;
+
+  for (i = 0; i < length; i++) {
+    hash ^= (unsigned long) (unsigned char) bytes[i];
+    hash = (hash * 16777619UL) & 0xFFFFFFFFUL;
+  }
+  return hash;
+}
+
+/**
+ * Returns the 32-bit unsigned integer (in the byte order of the platform) at the given position.
+ */
+size_t replay_read_number(const char *position) {
+  unsigned int number;
+  memcpy(&number, position, sizeof(number));
+  return number;
+}
+
+/**
+ * Returns the slot of the hash table that contains the record with the given key or the empty slot
+ * where it would be inserted.
+ */
+size_t replay_find_slot(const char *key, size_t key_length) {
+  size_t slot, offset;
+
+  for (slot = replay_hash(key, key_length) & (replay.index_size - 1); (offset = replay.index[slot]) != 0;
+      slot = (slot + 1) & (replay.index_size - 1)) {
+    if ((replay_read_number(replay.log + offset) == key_length)
+        && (memcmp(replay.log + offset + 8, key, key_length) == 0))
+      break;
+  }
+  return slot;
+}
+
+/**
+ * Copies the key of the given length into rounded_key with its x-values rounded to precision_x digits
+ * (in the same way as they are written and parsed by the text protocol).
+ */
+void replay_round_key(const char *key, size_t key_length, char *rounded_key) {
+  size_t dimension, i;
+  double value;
+  char number[64];
+
+  memcpy(rounded_key, key, key_length);
+  dimension = replay_read_number(key + 12);
+  for (i = key_length - dimension * sizeof(double); i < key_length; i += sizeof(double)) {
+    memcpy(&value, rounded_key + i, sizeof(double));
+    sprintf(number, "%.*e", replay.precision_x, value);
+    value = strtod(number, NULL);
+    memcpy(rounded_key + i, &value, sizeof(double));
+  }
+}
+
+/**
+ * Returns the slot of the rounded hash table that contains the record with the given rounded key (with
+ * the given hash) or the empty slot where it would be inserted. The buffer must hold key_length bytes.
+ */
+size_t replay_find_rounded_slot(const char *rounded_key, size_t key_length, unsigned long hash, char *buffer) {
+  size_t slot, offset;
+
+  for (slot = hash & (replay.index_size - 1); (offset = replay.rounded_index[slot]) != 0;
+      slot = (slot + 1) & (replay.index_size - 1)) {
+    if ((replay.rounded_hashes[slot] == hash) && (replay_read_number(replay.log + offset) == key_length)) {
+      replay_round_key(replay.log + offset + 8, key_length, buffer);
+      if (memcmp(buffer, rounded_key, key_length) == 0)
+        break;
+    }
+  }
+  return slot;
+}
+
+/**
+ * Maps the log with the given name into memory and indexes its records. An incomplete last record
+ * (the recording was interrupted) is ignored.
+ */
+void replay_open(const char *file_name) {
+  size_t offset, record_length, key_length, max_key_length = 0, number_of_records = 0, slot, i;
+  unsigned long hash;
+  char *log, *rounded_key, *buffer;
+  unsigned int byte_order;
+#if WINSOCK == 0
+  int descriptor;
+  struct stat file_stat;
+#else
+  FILE *file;
+#endif
+
+#if WINSOCK == 0
+  if (((descriptor = open(file_name, O_RDONLY)) < 0) || (fstat(descriptor, &file_stat) != 0)) {
+    fprintf(stderr, "replay_open(): Failed to open the log %s\n", file_name);
+    exit(EXIT_FAILURE);
+  }
+  replay.log_size = (size_t) file_stat.st_size;
+  log = (char *) mmap(NULL, replay.log_size + 1, PROT_READ, MAP_SHARED, descriptor, 0);
+  close(descriptor);
+  if (log == MAP_FAILED) {
+    fprintf(stderr, "replay_open(): Failed to map the log %s into memory\n", file_name);
+    exit(EXIT_FAILURE);
+  }
+#else
+  if ((file = fopen(file_name, "rb")) == NULL) {
+    fprintf(stderr, "replay_open(): Failed to open the log %s\n", file_name);
+    exit(EXIT_FAILURE);
+  }
+  fseek(file, 0, SEEK_END);
+  replay.log_size = (size_t) ftell(file);
+  rewind(file);
+  log = (char *) malloc(replay.log_size + 1);
+  if (fread(log, 1, replay.log_size, file) != replay.log_size) {
+    fprintf(stderr, "replay_open(): Failed to read the log %s\n", file_name);
+    exit(EXIT_FAILURE);
+  }
+  fclose(file);
+#endif
+  byte_order = REPLAY_BYTE_ORDER;
+  if ((replay.log_size < REPLAY_HEADER_SIZE) || (memcmp(log, REPLAY_MAGIC, 8) != 0)
+      || (memcmp(log + 8, &byte_order, sizeof(byte_order)) != 0)) {
+    fprintf(stderr, "replay_open(): %s is not a log recorded on this platform\n", file_name);
+    exit(EXIT_FAILURE);
+  }
+  replay.log = log;
+
+  /* Count the records to size the hash table (at most half of its slots are used) */
+  for (offset = REPLAY_HEADER_SIZE; offset + 8 <= replay.log_size; offset += record_length) {
+    record_length = 8 + replay_read_number(log + offset) + replay_read_number(log + offset + 4) * sizeof(double);
+    if (offset + record_length > replay.log_size)
+      break;
+    if (replay_read_number(log + offset) > max_key_length)
+      max_key_length = replay_read_number(log + offset);
+    number_of_records++;
+  }
+  for (replay.index_size = 2; replay.index_size < 2 * number_of_records; replay.index_size *= 2)
+    ;
+  replay.index = (size_t *) malloc(replay.index_size * sizeof(size_t));
+  replay.rounded_index = (size_t *) malloc(replay.index_size * sizeof(size_t));
+  replay.rounded_hashes = (unsigned long *) malloc(replay.index_size * sizeof(unsigned long));
+  for (i = 0; i < replay.index_size; i++)
+    replay.index[i] = replay.rounded_index[i] = 0;
+  rounded_key = (char *) malloc(max_key_length + 1);
+  buffer = (char *) malloc(max_key_length + 1);
+
+  /* Index the records (the later records of the same evaluation replace the earlier ones) */
+  for (offset = REPLAY_HEADER_SIZE, i = 0; i < number_of_records; i++, offset += record_length) {
+    key_length = replay_read_number(log + offset);
+    record_length = 8 + key_length + replay_read_number(log + offset + 4) * sizeof(double);
+    slot = replay_find_slot(log + offset + 8, key_length);
+    if (replay.index[slot] == 0)
+      replay.number_of_records++;
+    replay.index[slot] = offset;
+
+    replay_round_key(log + offset + 8, key_length, rounded_key);
+    hash = replay_hash(rounded_key, key_length);
+    slot = replay_find_rounded_slot(rounded_key, key_length, hash, buffer);
+    replay.rounded_index[slot] = offset;
+    replay.rounded_hashes[slot] = hash;
+  }
+  free(rounded_key);
+  free(buffer);
+  if (offset < replay.log_size)
+    fprintf(stderr, "replay_open(): Ignoring the incomplete record at the end of the log %s\n", file_name);
+}
+
+/**
+ * Looks up the evaluation of the given type in the log and saves its values into values (or NaN values
+ * if the evaluation is not in the log).
+ */
+void replay_lookup(unsigned int evaluation_type, char *suite_name, size_t number_of_values, size_t function,
+    size_t instance, size_t dimension, const double *x, double *values) {
+  unsigned int numbers[6];
+  size_t suite_name_length = strlen(suite_name), key_length, offset, i;
+  unsigned long hash;
+  char *key, *rounded_key, *buffer;
+  double zero = 0;
+
+  /* Create the key in the same way as socket_cache_set_key() */
+  key_length = sizeof(numbers) + suite_name_length + dimension * sizeof(double);
+  key = (char *) malloc(key_length);
+  numbers[0] = evaluation_type;
+  numbers[1] = (unsigned int) function;
+  numbers[2] = (unsigned int) instance;
+  numbers[3] = (unsigned int) dimension;
+  numbers[4] = (unsigned int) number_of_values;
+  numbers[5] = (unsigned int) suite_name_length;
+  memcpy(key, numbers, sizeof(numbers));
+  memcpy(key + sizeof(numbers), suite_name, suite_name_length);
+  memcpy(key + sizeof(numbers) + suite_name_length, x, dimension * sizeof(double));
+
+  offset = replay.index[replay_find_slot(key, key_length)];
+  if (offset == 0) {
+    /* Look up the evaluation with rounded x-values (recorded or requested with the other protocol) */
+    rounded_key = (char *) malloc(2 * key_length);
+    buffer = rounded_key + key_length;
+    replay_round_key(key, key_length, rounded_key);
+    hash = replay_hash(rounded_key, key_length);
+    offset = replay.rounded_index[replay_find_rounded_slot(rounded_key, key_length, hash, buffer)];
+    free(rounded_key);
+  }
+  free(key);
+  if ((offset != 0) && (replay_read_number(replay.log + offset + 4) == number_of_values)) {
+    memcpy(values, replay.log + offset + 8 + key_length, number_of_values * sizeof(double));
+    return;
+  }
+  fprintf(stderr, "replay_lookup(): The evaluation of type %u of %s f%lu i%lu d%lu is not in the log\n",
+      evaluation_type, suite_name, (unsigned long) function, (unsigned long) instance, (unsigned long) dimension);
+  for (i = 0; i < number_of_values; i++)
+    values[i] = zero / zero;
+}
+
+/**
+ * Evaluates x by looking up its evaluation in the log (an evaluation of the type "both" is looked up as
+ * the evaluation of objectives followed by the evaluation of the number_of_constraints constraints).
+ */
+void evaluate_replay(char *suite_name, char *evaluation_type, size_t number_of_values,
+    size_t number_of_constraints, size_t function, size_t instance, size_t dimension, const double *x,
+    double *values) {
+  if (strcmp(evaluation_type, "objectives") == 0)
+    replay_lookup(1, suite_name, number_of_values, function, instance, dimension, x, values);
+  else if (strcmp(evaluation_type, "constraints") == 0)
+    replay_lookup(2, suite_name, number_of_values, function, instance, dimension, x, values);
+  else if ((strcmp(evaluation_type, "both") == 0) && (number_of_constraints <= number_of_values)) {
+    replay_lookup(1, suite_name, number_of_values - number_of_constraints, function, instance, dimension, x,
+        values);
+    replay_lookup(2, suite_name, number_of_constraints, function, instance, dimension, x,
+        values + number_of_values - number_of_constraints);
+  } else {
+    fprintf(stderr, "evaluate_replay(): Evaluation type %s not supported", evaluation_type);
+    exit(EXIT_FAILURE);
+  }
+}
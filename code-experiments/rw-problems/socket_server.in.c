@@ -6,11 +6,27 @@
  * preprocessor directives (see the #define and #if directives below that start with EVALUATE_).
  * These definitions can be modified directly or through do.py.
  *
- * If the server receives the message 'RESET', it closes the current socket and opens a new one.
+ * If the server receives the message 'RESET', it closes the connection with the client that sent it.
  * If the server receives the message 'SHUTDOWN', it shuts down.
  *
+ * On Linux, the server serves many clients at once: it waits for their messages with epoll and a pool
+ * of worker threads evaluates them (see serve_clients()). On other platforms, the clients are served one
+ * after another.
+ *
+ * On POSIX platforms, the server listens also on a Unix-domain socket (see UNIX_PATH). Clients connected
+ * through it can ask to exchange the messages through rings in shared memory (see attach_shm()).
+ *
+ * Besides text messages, the server understands binary frames that start with the magic "COCB" (see
+ * evaluate_binary_message()). The protocol is recognized for each message separately. Binary frames
+ * can contain a batch of solutions, which are evaluated in parallel by a pool of worker threads (on
+ * platforms with POSIX threads, see evaluate_batch()).
+ *
  * Change code below to connect it to other evaluators (for other suites) -- see occurrences
  * of 'ADD HERE'.
+ *
+ * When compiled with REPLAY_SERVER set to 1 (see the target replay_server in the Makefile), the server
+ * answers all requests with the evaluations from a log recorded by COCO instead of calling the
+ * evaluators (see replay/replay_evaluator.c).
  */
 
 /* The winsock2.h header *needs* to be included before windows.h! */
@@ -20,27 +36,76 @@
 #pragma comment(lib, "ws2_32.lib") /* Winsock library */
 #endif
 #define WINSOCK 1
+typedef SOCKET socket_t;
 #else
 #include <sys/socket.h>
 #include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/un.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/select.h>
+#include <fcntl.h>
+#include <sched.h>
 #include <unistd.h>
+#include <pthread.h>
 #define WINSOCK 0
+typedef int socket_t;
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <errno.h>
+#define EPOLL 1
+#else
+#define EPOLL 0
+#endif
 #endif
 
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 
-#define MESSAGE_SIZE 8192   /* Large enough for the entire message */
+#define MESSAGE_SIZE 8192   /* The number of bytes received at once (the messages can be longer) */
 #define RESULT_PRECISION 16 /* Precision used to write objective values and constraint violations */
-#define RESPONSE_SIZE 1024  /* Large enough for the entire response (objective values or constraint violations) */
+#define RESULT_SIZE (RESULT_PRECISION + 16) /* Large enough for a single value in the response */
 #define STRING_SIZE 64      /* Large enough for a single string (the name of the suite etc.) */
 /* Types of the evaluation function */
 #define EVAL_TYPE_OBJ "objectives"
 #define EVAL_TYPE_CON "constraints"
+#define EVAL_TYPE_BOTH "both"     /* Objectives followed by constraints */
+/* Definitions for the binary protocol (must match those in socket_communication.c) */
+#define BINARY_MAGIC "COCB"       /* The first four bytes of each binary frame */
+#define BINARY_VERSION 2          /* The version of the binary protocol */
+#define BINARY_HEADER_SIZE 40     /* The magic followed by nine 32-bit unsigned integers */
+#define BINARY_TYPE_HELLO 0       /* Frame type used to negotiate the protocol */
+#define BINARY_TYPE_OBJ 1         /* Frame type for evaluation of objectives */
+#define BINARY_TYPE_CON 2         /* Frame type for evaluation of constraints */
+#define BINARY_TYPE_BOTH 3        /* Frame type for evaluation of objectives followed by constraints */
+#define BINARY_FEATURES 1         /* The features announced in the response to HELLO (1 for BINARY_TYPE_BOTH) */
+#define NUMBER_OF_WORKERS 4       /* Minimal number of threads used to evaluate messages and batches */
+#define LISTEN_BACKLOG 64         /* Maximal number of connections waiting to be accepted */
+#define MAX_EVENTS 64             /* Maximal number of events handled after a single epoll_wait() */
+/* Definitions for the local transports (must match those in socket_communication.c) */
+#define UNIX_PATH "/tmp/coco_socket_%u" /* The path of the Unix-domain socket of the server on a port */
+#define SHM_HEADER_SIZE 128       /* The space reserved for the header of each ring */
+#define SHM_SPIN 10000            /* The number of checks of an empty ring before sleeping (with several
+                                     processors) */
+#if WINSOCK == 0 && defined(__GNUC__)
+#define SHM 1                     /* Shared memory needs the memory barriers of GCC (and compatible) */
+#define SHM_BARRIER() __sync_synchronize()
+#else
+#define SHM 0
+#endif
 
 #include "toy_socket/toy_socket_evaluator.c"  /* Include the toy_evaluator for evaluation */
 
+#ifndef REPLAY_SERVER
+#define REPLAY_SERVER 0                       /* Set to 1 to build the replay server */
+#endif
+#if REPLAY_SERVER > 0
+#include "replay/replay_evaluator.c"          /* Include the evaluator that replays a recorded log */
+#endif
+
 #define EVALUATE_RW_TOP_TRUMPS 0              /* Value can be modified through do.py */
 #if EVALUATE_RW_TOP_TRUMPS > 0
 #include "top_trumps/rw_top_trumps.h"         /* Include rw_top_trumps for evaluation */
@@ -60,42 +125,45 @@ typedef void (*evaluate_t)(char *suite_name, size_t number_of_values, size_t fun
     size_t instance, size_t dimension, const double *x, double *values);
 
 /**
- * Parses the message and calls an evaluator to compute the evaluation (can be used to evaluate
- * objectives as well as constraints). Constructs and returns the response.
+ * Returns 1 if the evaluator of the given suite can be called from several threads at once and 0
+ * otherwise (in which case batches of solutions are evaluated sequentially and the evaluations for
+ * different clients are serialized).
  */
-char *evaluate_message(char *message) {
+int is_thread_safe(char *suite_name) {
+#if REPLAY_SERVER > 0
+  return 1; /* The replay server only reads the log */
+#endif
+  if ((strcmp(suite_name, "toy-socket") == 0) || (strcmp(suite_name, "toy-socket-biobj") == 0))
+    return 1;
+  /* ADD HERE evaluators that can be called from several threads at once, for example
+  if (strcmp(suite_name, "my-suite") == 0)
+    return 1; */
+  return 0;
+}
+
+#if WINSOCK == 0
+/* Serializes the calls of evaluators that are not thread safe (the clients can be served at once) */
+static pthread_mutex_t evaluator_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+/**
+ * Calls an evaluator to compute the evaluation of the given type (can be used to evaluate objectives as
+ * well as constraints) and saves it into values. The evaluation of the type "both" saves the
+ * number_of_values - number_of_constraints objective values followed by the number_of_constraints
+ * constraint values (number_of_constraints is ignored for the other types).
+ */
+void evaluate(char *suite_name, char *evaluation_type, size_t number_of_values, size_t number_of_constraints,
+    size_t function, size_t instance, size_t dimension, const double *x, double *values) {
 
-  char suite_name[STRING_SIZE];
-  char evaluation_type[STRING_SIZE];
-  size_t number_of_values, i;
-  size_t function, instance, dimension;
-  double *x, *values;
-  char *response = "", *pointer;
-  int read_count;
-  int char_count, offset = 0;
   evaluate_t evaluate_objectives = NULL;
   evaluate_t evaluate_constraints = NULL;
 
-  /* Parse the message
-   *
-   * char_count is used to count how many characters are read and offset moves the pointer
-   * along the message accordingly
-   */
-  if ((read_count = sscanf(message, "s %s t %s r %lu f %lu i %lu d %lu x%*c%n", suite_name,
-      evaluation_type, &number_of_values, &function, &instance, &dimension, &char_count)) != 6) {
-    fprintf(stderr, "evaluate_message(): Failed to read beginning of the message %s", message);
-    fprintf(stderr, "(read %d instead of %d items)", read_count, 6);
-    exit(EXIT_FAILURE);
-  }
-  x = malloc(dimension * sizeof(double));
-  offset = char_count;
-  for (i = 0; i < dimension; i++) {
-    if (sscanf(message + offset, "%lf%*c%n", &x[i], &char_count) != 1) {
-      fprintf(stderr, "evaluate_message(): Failed to read message %s", message);
-      exit(EXIT_FAILURE);
-    }
-    offset += char_count;
-  }
+#if REPLAY_SERVER > 0
+  /* The replay server answers all requests from the log (which can be read by several threads at once) */
+  evaluate_replay(suite_name, evaluation_type, number_of_values, number_of_constraints, function, instance,
+      dimension, x, values);
+  return;
+#endif
 
   /* Choose the right function */
   if ((strcmp(suite_name, "toy-socket") == 0) || (strcmp(suite_name, "toy-socket-biobj") == 0)) {
@@ -113,25 +181,290 @@ char *evaluate_message(char *message) {
     evaluate_constraints = evaluate_my_suite_constraints;
   } */
   else {
-    fprintf(stderr, "evaluate_message(): Suite %s not supported", suite_name);
+    fprintf(stderr, "evaluate(): Suite %s not supported", suite_name);
     exit(EXIT_FAILURE);
   }
 
   /* Evaluate x and save the result to values */
-  values = malloc(number_of_values * sizeof(double));
+#if WINSOCK == 0
+  if (!is_thread_safe(suite_name))
+    pthread_mutex_lock(&evaluator_mutex);
+#endif
   if ((strcmp(evaluation_type, EVAL_TYPE_OBJ) == 0))
     evaluate_objectives(suite_name, number_of_values, function, instance, dimension, x, values);
   else if ((strcmp(evaluation_type, EVAL_TYPE_CON) == 0))
     evaluate_constraints(suite_name, number_of_values, function, instance, dimension, x, values);
-  else {
-    fprintf(stderr, "evaluate_message(): Evaluation type %s not supported", evaluation_type);
+  else if ((strcmp(evaluation_type, EVAL_TYPE_BOTH) == 0) && (number_of_constraints <= number_of_values)) {
+    evaluate_objectives(suite_name, number_of_values - number_of_constraints, function, instance, dimension, x,
+        values);
+    evaluate_constraints(suite_name, number_of_constraints, function, instance, dimension, x,
+        values + number_of_values - number_of_constraints);
+  } else {
+    fprintf(stderr, "evaluate(): Evaluation type %s not supported", evaluation_type);
+    exit(EXIT_FAILURE);
+  }
+#if WINSOCK == 0
+  if (!is_thread_safe(suite_name))
+    pthread_mutex_unlock(&evaluator_mutex);
+#endif
+}
+
+/**
+ * A batch of solutions to be evaluated (possibly by several threads at once).
+ */
+typedef struct batch_s {
+  char *suite_name;
+  char *evaluation_type;
+  size_t number_of_values;
+  size_t number_of_constraints; /* Used only by the evaluations of the type "both" */
+  size_t function;
+  size_t instance;
+  size_t dimension;
+  size_t count;             /* Number of solutions */
+  const double *x;          /* The solutions stored one after another */
+  double *values;           /* The values of the solutions stored one after another */
+  size_t next;              /* Index of the next solution to be evaluated */
+  size_t finished;          /* Number of evaluated solutions */
+  struct batch_s *next_batch; /* The next batch being evaluated by the worker threads */
+} batch_t;
+
+/**
+ * Evaluates the solution with the given index from the batch.
+ */
+void evaluate_batch_solution(batch_t *batch, size_t index) {
+  evaluate(batch->suite_name, batch->evaluation_type, batch->number_of_values, batch->number_of_constraints,
+      batch->function,
+      batch->instance, batch->dimension, batch->x + index * batch->dimension,
+      batch->values + index * batch->number_of_values);
+}
+
+/**
+ * A connection with a client. The received bytes are collected in a buffer that grows as needed until
+ * they contain a complete message. Text messages end with a null character, while the length of binary
+ * frames is given in their header (see evaluate_binary_message()). Because the client can send several
+ * messages without waiting for the responses, the buffer can also contain (a part of) the next messages.
+ */
+typedef struct connection_s {
+  socket_t sock;
+  char *buffer;             /* The received bytes that have not been processed yet */
+  size_t size;              /* The allocated size of the buffer */
+  size_t length;            /* The number of received bytes in the buffer */
+  int local;                /* Whether the connection was accepted on the Unix-domain socket */
+  char *shm;                /* The shared memory with the rings (NULL if the socket is used) */
+  unsigned int ring_size;   /* The size of each ring in the shared memory */
+  size_t spin;              /* The number of checks of an empty ring before sleeping */
+  struct connection_s *next; /* The next connection waiting for the worker threads */
+} connection_t;
+
+/**
+ * The header of a ring in shared memory (see attach_shm()). The producer writes the bytes at position
+ * head and then advances head, while the consumer reads the bytes at position tail and then advances
+ * tail (the positions are taken modulo the size of the ring, which is a power of two). A consumer that
+ * finds the ring empty sets sleeping and waits for a byte on the socket, which the producer sends only in
+ * this case.
+ */
+typedef struct {
+  volatile unsigned int head;
+  char padding[64];         /* Keeps head and tail in different cache lines */
+  volatile unsigned int tail;
+  volatile unsigned int sleeping;
+} ring_t;
+
+#if WINSOCK == 0
+/**
+ * The pool of worker threads. The threads evaluate the solutions of batches (together with the thread
+ * that called evaluate_batch()) and, when the server serves several clients at once, the messages of
+ * the connections that have received data. The solutions of batches are evaluated first, since their
+ * connections are waiting for them.
+ */
+static struct {
+  pthread_mutex_t mutex;
+  pthread_cond_t work_ready;      /* Signaled when a new batch or connection is available */
+  pthread_cond_t batch_finished;  /* Signaled when all solutions of a batch have been evaluated */
+  batch_t *first_batch;           /* The batches being evaluated (NULL if there are none) */
+  connection_t *first_connection; /* The connections waiting to be served (NULL if there are none) */
+  connection_t *last_connection;
+  int started;
+} worker_pool = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER, NULL, NULL,
+    NULL, 0 };
+
+#if EPOLL
+void serve_ready_connection(connection_t *connection);
+#endif
+
+/**
+ * Takes solutions from the batch and evaluates them until all of them are taken. Must be called with the
+ * mutex of the worker pool locked (the mutex is unlocked during the evaluations).
+ */
+void work_on_batch(batch_t *batch) {
+  size_t index;
+
+  while (batch->next < batch->count) {
+    index = batch->next++;
+    pthread_mutex_unlock(&worker_pool.mutex);
+    evaluate_batch_solution(batch, index);
+    pthread_mutex_lock(&worker_pool.mutex);
+    if (++batch->finished == batch->count)
+      pthread_cond_broadcast(&worker_pool.batch_finished);
+  }
+}
+
+/**
+ * Returns the first batch with solutions that have not been taken yet (or NULL if there is none). Must
+ * be called with the mutex of the worker pool locked.
+ */
+batch_t *find_open_batch(void) {
+  batch_t *batch;
+
+  for (batch = worker_pool.first_batch; batch != NULL; batch = batch->next_batch) {
+    if (batch->next < batch->count)
+      return batch;
+  }
+  return NULL;
+}
+
+/**
+ * The main function of the worker threads.
+ */
+void *worker(void *argument) {
+  batch_t *batch;
+#if EPOLL
+  connection_t *connection;
+#endif
+
+  (void) argument; /* To silence the compiler */
+  pthread_mutex_lock(&worker_pool.mutex);
+  while (1) {
+    if ((batch = find_open_batch()) != NULL)
+      work_on_batch(batch);
+#if EPOLL
+    else if ((connection = worker_pool.first_connection) != NULL) {
+      worker_pool.first_connection = connection->next;
+      if (worker_pool.first_connection == NULL)
+        worker_pool.last_connection = NULL;
+      pthread_mutex_unlock(&worker_pool.mutex);
+      serve_ready_connection(connection);
+      pthread_mutex_lock(&worker_pool.mutex);
+    }
+#endif
+    else
+      pthread_cond_wait(&worker_pool.work_ready, &worker_pool.mutex);
+  }
+  return NULL; /* Never reached */
+}
+
+/**
+ * Starts the worker threads (if they have not been started yet). Their number equals the number of
+ * processors, but is at least NUMBER_OF_WORKERS. Must be called with the mutex of the worker pool locked.
+ */
+void start_workers(void) {
+  pthread_t thread;
+  long i, number_of_workers = NUMBER_OF_WORKERS;
+
+  if (worker_pool.started)
+    return;
+#ifdef _SC_NPROCESSORS_ONLN
+  if (sysconf(_SC_NPROCESSORS_ONLN) > number_of_workers)
+    number_of_workers = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+  for (i = 0; i < number_of_workers; i++) {
+    if (pthread_create(&thread, NULL, worker, NULL) != 0) {
+      fprintf(stderr, "start_workers(): Failed to create a worker thread");
+      exit(EXIT_FAILURE);
+    }
+    pthread_detach(thread);
+  }
+  worker_pool.started = 1;
+}
+#endif
+
+/**
+ * Evaluates all solutions of the batch. If the evaluator is thread safe, the solutions are evaluated in
+ * parallel by the worker threads and the calling thread (several batches can be evaluated at once).
+ */
+void evaluate_batch(batch_t *batch) {
+  size_t i;
+#if WINSOCK == 0
+  batch_t **pointer;
+
+  if ((batch->count > 1) && is_thread_safe(batch->suite_name)) {
+    pthread_mutex_lock(&worker_pool.mutex);
+    start_workers();
+    batch->next_batch = worker_pool.first_batch;
+    worker_pool.first_batch = batch;
+    pthread_cond_broadcast(&worker_pool.work_ready);
+    work_on_batch(batch);
+    while (batch->finished < batch->count)
+      pthread_cond_wait(&worker_pool.batch_finished, &worker_pool.mutex);
+    for (pointer = &worker_pool.first_batch; *pointer != batch; pointer = &(*pointer)->next_batch)
+      ;
+    *pointer = batch->next_batch;
+    pthread_mutex_unlock(&worker_pool.mutex);
+    return;
+  }
+#endif
+  for (i = 0; i < batch->count; i++)
+    evaluate_batch_solution(batch, i);
+}
+
+/**
+ * Parses the message and calls an evaluator to compute the evaluation (can be used to evaluate
+ * objectives as well as constraints). Constructs and returns the response (a string).
+ *
+ * Messages of the type "both" contain the number of constraints (c <c>) after the number of values.
+ */
+char *evaluate_message(char *message) {
+
+  char suite_name[STRING_SIZE];
+  char evaluation_type[STRING_SIZE];
+  size_t number_of_values, number_of_constraints = 0, i;
+  size_t function, instance, dimension;
+  double *x, *values;
+  char *response = "", *pointer;
+  int read_count;
+  int char_count, offset = 0;
+
+  /* Parse the message
+   *
+   * char_count is used to count how many characters are read and offset moves the pointer
+   * along the message accordingly
+   */
+  if ((read_count = sscanf(message, "s %63s t %63s r %lu%n", suite_name, evaluation_type, &number_of_values,
+      &char_count)) != 3) {
+    fprintf(stderr, "evaluate_message(): Failed to read beginning of the message %s", message);
+    fprintf(stderr, "(read %d instead of %d items)", read_count, 3);
     exit(EXIT_FAILURE);
   }
+  offset = char_count;
+  if ((strcmp(evaluation_type, EVAL_TYPE_BOTH) == 0)
+      && (sscanf(message + offset, " c %lu%n", &number_of_constraints, &char_count) == 1))
+    offset += char_count;
+  if ((read_count = sscanf(message + offset, " f %lu i %lu d %lu x%*c%n", &function, &instance, &dimension,
+      &char_count)) != 3) {
+    fprintf(stderr, "evaluate_message(): Failed to read beginning of the message %s", message);
+    fprintf(stderr, "(read %d instead of %d items)", read_count + 3, 6);
+    exit(EXIT_FAILURE);
+  }
+  x = malloc(dimension * sizeof(double));
+  offset += char_count;
+  for (i = 0; i < dimension; i++) {
+    if (sscanf(message + offset, "%lf%*c%n", &x[i], &char_count) != 1) {
+      fprintf(stderr, "evaluate_message(): Failed to read message %s", message);
+      exit(EXIT_FAILURE);
+    }
+    offset += char_count;
+  }
+
+  /* Evaluate x and save the result to values */
+  values = malloc(number_of_values * sizeof(double));
+  evaluate(suite_name, evaluation_type, number_of_values, number_of_constraints, function, instance, dimension,
+      x, values);
   free(x);
 
   /* Construct the response (pointer keeps track of the current place in the response) */
-  response = (char *) malloc(RESPONSE_SIZE);
+  response = (char *) malloc(number_of_values * RESULT_SIZE + 1);
   pointer = response;
+  *pointer = '\0';
   for (i = 0; i < number_of_values; i++) {
     char_count = sprintf(pointer, "%.*e ", RESULT_PRECISION, values[i]);
     pointer += char_count;
@@ -141,6 +474,791 @@ char *evaluate_message(char *message) {
   return response;
 }
 
+/**
+ * Sends all length bytes of the buffer to the socket.
+ */
+void send_all(socket_t sock, const char *buffer, size_t length) {
+  long sent_len;
+
+  while (length > 0) {
+#if WINSOCK == 1
+    sent_len = (long) send(sock, buffer, (int) length, 0);
+#else
+    sent_len = (long) send(sock, buffer, length, 0);
+#endif
+    if (sent_len <= 0) {
+      fprintf(stderr, "send_all(): Send failed");
+      exit(EXIT_FAILURE);
+    }
+    buffer += sent_len;
+    length -= (size_t) sent_len;
+  }
+}
+
+#if SHM
+/**
+ * Returns the size of the shared memory with two rings of the given size.
+ */
+size_t shm_size(unsigned int ring_size) {
+  return 2 * (SHM_HEADER_SIZE + (size_t) ring_size);
+}
+
+/**
+ * Returns the header of the ring of the connection with the given index (0 for the messages and 1 for
+ * the responses).
+ */
+ring_t *ring_header(const connection_t *connection, size_t index) {
+  return (ring_t *) (void *) (connection->shm + index * SHM_HEADER_SIZE);
+}
+
+/**
+ * Returns the bytes of the ring of the connection with the given index.
+ */
+char *ring_bytes(const connection_t *connection, size_t index) {
+  return connection->shm + 2 * SHM_HEADER_SIZE + index * connection->ring_size;
+}
+
+/**
+ * Writes all length bytes of the buffer into the ring for the responses (waiting for free space if
+ * needed) and wakes up the client if it waits for them. Returns 0 on success and -1 if the client closed
+ * the connection.
+ */
+int ring_write(connection_t *connection, const char *buffer, size_t length) {
+  ring_t *ring = ring_header(connection, 1);
+  char *bytes = ring_bytes(connection, 1);
+  size_t count, position;
+  char byte;
+
+  while (length > 0) {
+    while ((count = connection->ring_size - (ring->head - ring->tail)) == 0) {
+      /* The ring is full, wait until the client reads from it (or closes the connection) */
+      if (recv(connection->sock, &byte, 1, MSG_PEEK | MSG_DONTWAIT) == 0)
+        return -1;
+      sched_yield();
+    }
+    position = ring->head & (connection->ring_size - 1);
+    if (count > connection->ring_size - position)
+      count = connection->ring_size - position;
+    if (count > length)
+      count = length;
+    memcpy(bytes + position, buffer, count);
+    SHM_BARRIER(); /* The bytes must be visible before the new head */
+    ring->head += (unsigned int) count;
+    buffer += count;
+    length -= count;
+    SHM_BARRIER(); /* The new head must be visible before sleeping is checked */
+    if (ring->sleeping) {
+      ring->sleeping = 0;
+      send(connection->sock, "", 1, 0);
+    }
+  }
+  return 0;
+}
+
+/**
+ * Reads at most length bytes from the ring for the messages into the buffer and returns their number.
+ * Works like recv() called with the given flags: if the ring stays empty for connection->spin checks, the
+ * function either sleeps until the client sends a byte through the socket or, with MSG_DONTWAIT, returns
+ * -1 (with errno set to EAGAIN). Returns 0 if the client closed the connection.
+ */
+long ring_read(connection_t *connection, char *buffer, size_t length, int flags) {
+  ring_t *ring = ring_header(connection, 0);
+  const char *bytes = ring_bytes(connection, 0);
+  size_t count, position, spin = 0;
+  char wake_up[64];
+  long received_len;
+
+  while ((count = (size_t) (ring->head - ring->tail)) == 0) {
+    if (spin++ < connection->spin)
+      continue;
+    if (flags & MSG_DONTWAIT) {
+      /* Receive the wake-up bytes to find out whether the client closed the connection */
+      while ((received_len = (long) recv(connection->sock, wake_up, sizeof(wake_up), MSG_DONTWAIT)) > 0)
+        ;
+      if ((received_len == 0) || (ring->head == ring->tail))
+        return received_len;
+      continue;
+    }
+    ring->sleeping = 1;
+    SHM_BARRIER(); /* The client must see sleeping before head is checked again */
+    if ((ring->head == ring->tail)
+        && ((received_len = (long) recv(connection->sock, wake_up, sizeof(wake_up), 0)) <= 0))
+      return received_len;
+    ring->sleeping = 0;
+  }
+  SHM_BARRIER(); /* The bytes must be read after the head */
+  position = ring->tail & (connection->ring_size - 1);
+  if (count > connection->ring_size - position)
+    count = connection->ring_size - position;
+  if (count > length)
+    count = length;
+  memcpy(buffer, bytes + position, count);
+  SHM_BARRIER(); /* The bytes must be read before the new tail is visible */
+  ring->tail += (unsigned int) count;
+  return (long) count;
+}
+#endif
+
+/**
+ * Sends all length bytes of the buffer to the client of the connection (through the socket or the ring
+ * for the responses).
+ */
+void send_response(connection_t *connection, const char *buffer, size_t length) {
+#if SHM
+  if (connection->shm != NULL) {
+    if (ring_write(connection, buffer, length) != 0) {
+      fprintf(stderr, "send_response(): Send failed");
+      exit(EXIT_FAILURE);
+    }
+    return;
+  }
+#endif
+  send_all(connection->sock, buffer, length);
+}
+
+/**
+ * Attaches the connection to the shared memory announced by the client with the message
+ * "SHM <path> <size>" and answers "OK" (or "NO" if the shared memory cannot be used). The shared memory
+ * contains two rings of the given size, one for the messages and one for the responses, through which
+ * all further messages of the client are exchanged. The socket is then used only to wake up a peer that
+ * waits for data (see ring_t). Only clients connected through the Unix-domain socket can use shared
+ * memory (they run on the same machine).
+ */
+void attach_shm(connection_t *connection) {
+#if SHM
+  char path[1024];
+  unsigned int ring_size;
+  struct stat file_stat;
+  char *shm;
+  int fd;
+
+  if (connection->local && (sscanf(connection->buffer, "SHM %1023s %u", path, &ring_size) == 2)
+      && (ring_size >= 4096) && ((ring_size & (ring_size - 1)) == 0)
+      && ((fd = open(path, O_RDWR)) >= 0)) {
+    shm = MAP_FAILED;
+    if ((fstat(fd, &file_stat) == 0) && ((size_t) file_stat.st_size == shm_size(ring_size)))
+      shm = (char *) mmap(NULL, shm_size(ring_size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (shm != MAP_FAILED) {
+      send_all(connection->sock, "OK", 3);
+      connection->shm = shm;
+      connection->ring_size = ring_size;
+      /* Waiting actively makes sense only if the client can run at the same time */
+      connection->spin = (sysconf(_SC_NPROCESSORS_ONLN) > 1) ? SHM_SPIN : 0;
+      return;
+    }
+  }
+#endif
+  send_all(connection->sock, "NO", 3);
+}
+
+/**
+ * Closes the socket of the connection and detaches it from the shared memory.
+ */
+void close_connection(connection_t *connection) {
+#if WINSOCK == 1
+  closesocket(connection->sock);
+#else
+  close(connection->sock);
+#endif
+#if SHM
+  if (connection->shm != NULL) {
+    munmap(connection->shm, shm_size(connection->ring_size));
+    connection->shm = NULL;
+  }
+#endif
+}
+
+/**
+ * Reads a 32-bit unsigned integer stored in little-endian order.
+ */
+unsigned long read_uint32(const char *buffer) {
+  const unsigned char *bytes = (const unsigned char *) buffer;
+  return (unsigned long) bytes[0] | ((unsigned long) bytes[1] << 8) | ((unsigned long) bytes[2] << 16)
+      | ((unsigned long) bytes[3] << 24);
+}
+
+/**
+ * Writes a 32-bit unsigned integer in little-endian order.
+ */
+void write_uint32(char *buffer, unsigned long value) {
+  unsigned char *bytes = (unsigned char *) buffer;
+  bytes[0] = (unsigned char) (value & 0xFF);
+  bytes[1] = (unsigned char) ((value >> 8) & 0xFF);
+  bytes[2] = (unsigned char) ((value >> 16) & 0xFF);
+  bytes[3] = (unsigned char) ((value >> 24) & 0xFF);
+}
+
+/**
+ * Converts between the little-endian representation of a double (used in binary frames) and the
+ * representation of the platform (the conversion is its own inverse).
+ */
+void convert_double(const char *from, char *to) {
+  const double one = 1.0;
+  size_t i;
+
+  if (((const unsigned char *) &one)[sizeof(double) - 1] == 0x3F)
+    memcpy(to, from, sizeof(double));
+  else {
+    for (i = 0; i < sizeof(double); i++)
+      to[i] = from[sizeof(double) - 1 - i];
+  }
+}
+
+/**
+ * Returns 1 if the message is a binary frame and 0 if it is a text message.
+ */
+int is_binary_message(const char *message, size_t message_len) {
+  return (message_len >= 4) && (memcmp(message, BINARY_MAGIC, 4) == 0);
+}
+
+/**
+ * Calls an evaluator for the given binary frame and constructs the response (its length is saved into
+ * response_len). The frames have the following format (all numbers are in little-endian order):
+ * <magic> <version> <t> <l> <r> <f> <i> <d> <n> <q> <s> <x1> ... <xd>
+ * Where
+ * <magic> are the four bytes "COCB"
+ * <version> is the version of the binary protocol
+ * <t> is the type of the frame (0 for HELLO, 1 for objectives, 2 for constraints, 3 for both)
+ * <l> is the length of the suite name
+ * <r> is the number of values to be returned
+ * <f> is the function number
+ * <i> is the instance number
+ * <d> is the problem dimension
+ * <n> is the number of solutions
+ * <q> is the sequence id of the frame
+ * <s> is the suite name (without the terminating null character)
+ * <xi> is the i-th value of x as an IEEE-754 double (there are d values for each of the n solutions)
+ * The numbers from <version> to <q> are 32-bit unsigned integers. Frames of type 3 contain the number of
+ * constraints <c> (a 32-bit unsigned integer) between <s> and <x1>, the r values of each solution are then
+ * the r - c objective values followed by the c constraint values.
+ *
+ * The response has the same header (with l = 0), followed by n * r doubles (the values of the first
+ * solution, then those of the second one and so on). The response to a HELLO frame is a HELLO frame
+ * with the version supported by the server and the supported features in <n> (BINARY_FEATURES). The
+ * frames are answered in the order in which they arrive.
+ */
+char *evaluate_binary_message(const char *message, size_t *response_len) {
+
+  char suite_name[STRING_SIZE];
+  const char *payload;
+  char *response;
+  size_t type, suite_name_length, number_of_values, number_of_constraints = 0, function, instance, dimension;
+  size_t count, i;
+  double *x, *values;
+  batch_t batch;
+
+  type = read_uint32(message + 8);
+  suite_name_length = read_uint32(message + 12);
+  number_of_values = read_uint32(message + 16);
+  function = read_uint32(message + 20);
+  instance = read_uint32(message + 24);
+  dimension = read_uint32(message + 28);
+  count = read_uint32(message + 32);
+
+  /* Answer the request for negotiation with the supported version */
+  if (type == BINARY_TYPE_HELLO) {
+    response = (char *) malloc(BINARY_HEADER_SIZE);
+    memcpy(response, message, BINARY_HEADER_SIZE);
+    write_uint32(response + 4, BINARY_VERSION);
+    write_uint32(response + 32, BINARY_FEATURES);
+    *response_len = BINARY_HEADER_SIZE;
+    return response;
+  }
+  if ((read_uint32(message + 4) != BINARY_VERSION) || (suite_name_length >= STRING_SIZE) || (count == 0)
+      || ((type != BINARY_TYPE_OBJ) && (type != BINARY_TYPE_CON) && (type != BINARY_TYPE_BOTH))) {
+    fprintf(stderr, "evaluate_binary_message(): Unsupported frame (version %lu, type %lu, count %lu)",
+        read_uint32(message + 4), (unsigned long) type, (unsigned long) count);
+    exit(EXIT_FAILURE);
+  }
+
+  payload = message + BINARY_HEADER_SIZE;
+  memcpy(suite_name, payload, suite_name_length);
+  suite_name[suite_name_length] = '\0';
+  payload += suite_name_length;
+  if (type == BINARY_TYPE_BOTH) {
+    number_of_constraints = read_uint32(payload);
+    payload += 4;
+  }
+  x = malloc(count * dimension * sizeof(double));
+  for (i = 0; i < count * dimension; i++)
+    convert_double(payload + i * sizeof(double), (char *) &x[i]);
+
+  /* Evaluate the solutions and save the results to values */
+  values = malloc(count * number_of_values * sizeof(double));
+  batch.suite_name = suite_name;
+  batch.evaluation_type = (type == BINARY_TYPE_OBJ) ? EVAL_TYPE_OBJ
+      : ((type == BINARY_TYPE_CON) ? EVAL_TYPE_CON : EVAL_TYPE_BOTH);
+  batch.number_of_values = number_of_values;
+  batch.number_of_constraints = number_of_constraints;
+  batch.function = function;
+  batch.instance = instance;
+  batch.dimension = dimension;
+  batch.count = count;
+  batch.x = x;
+  batch.values = values;
+  batch.next = 0;
+  batch.finished = 0;
+  batch.next_batch = NULL;
+  evaluate_batch(&batch);
+  free(x);
+
+  /* Construct the response */
+  *response_len = BINARY_HEADER_SIZE + count * number_of_values * sizeof(double);
+  response = (char *) malloc(*response_len);
+  memcpy(response, message, BINARY_HEADER_SIZE);
+  write_uint32(response + 12, 0);
+  for (i = 0; i < count * number_of_values; i++)
+    convert_double((char *) &values[i], response + BINARY_HEADER_SIZE + i * sizeof(double));
+  free(values);
+  return response;
+}
+
+/**
+ * Returns the length of the first message in the buffer of the connection if the message is complete
+ * and 0 otherwise.
+ */
+size_t complete_message_length(const connection_t *connection) {
+  const char *end;
+  size_t frame_len;
+
+  if (is_binary_message(connection->buffer, connection->length)) {
+    if (connection->length < BINARY_HEADER_SIZE)
+      return 0;
+    frame_len = BINARY_HEADER_SIZE;
+    if (read_uint32(connection->buffer + 8) != BINARY_TYPE_HELLO)
+      frame_len += read_uint32(connection->buffer + 12)
+          + read_uint32(connection->buffer + 28) * read_uint32(connection->buffer + 32) * sizeof(double);
+    if (read_uint32(connection->buffer + 8) == BINARY_TYPE_BOTH)
+      frame_len += 4;
+    return (connection->length >= frame_len) ? frame_len : 0;
+  }
+  end = (const char *) memchr(connection->buffer, '\0', connection->length);
+  return (end != NULL) ? (size_t) (end - connection->buffer) + 1 : 0;
+}
+
+/**
+ * Receives the bytes that are available (at most MESSAGE_SIZE of them) into the buffer of the connection,
+ * which is enlarged if needed (there is always space for an additional character after the received
+ * bytes). Returns the result of recv() called with the given flags (see also ring_read()).
+ */
+long receive_more(connection_t *connection, int flags) {
+  long received_len;
+
+  if (connection->size < connection->length + MESSAGE_SIZE + 1) {
+    connection->size = 2 * connection->size + MESSAGE_SIZE + 1;
+    connection->buffer = (char *) realloc(connection->buffer, connection->size);
+    if (connection->buffer == NULL) {
+      fprintf(stderr, "receive_more(): Failed to allocate %lu bytes", (unsigned long) connection->size);
+      exit(EXIT_FAILURE);
+    }
+  }
+#if SHM
+  if (connection->shm != NULL)
+    received_len = ring_read(connection, connection->buffer + connection->length, MESSAGE_SIZE, flags);
+  else
+#endif
+  received_len = (long) recv(connection->sock, connection->buffer + connection->length, MESSAGE_SIZE, flags);
+  if (received_len > 0)
+    connection->length += (size_t) received_len;
+  return received_len;
+}
+
+/**
+ * Completes the last message of a connection that was closed by the client. If the buffer contains a
+ * text message without the terminating null character (for example, 'SHUTDOWN' sent by do.py), the
+ * character is added and the length of the message is returned. Otherwise, 0 is returned.
+ */
+size_t complete_last_message(connection_t *connection) {
+  if ((connection->length == 0) || is_binary_message(connection->buffer, connection->length))
+    return 0;
+  connection->buffer[connection->length++] = '\0';
+  return connection->length;
+}
+
+/**
+ * Receives bytes from the client until the buffer of the connection contains a complete message and
+ * returns the length of the message. Returns 0 if the connection was closed before a complete message
+ * was received (except for the last text message, see complete_last_message()).
+ */
+size_t receive_message(connection_t *connection) {
+  size_t message_len;
+
+  while ((message_len = complete_message_length(connection)) == 0) {
+    if (receive_more(connection, 0) <= 0)
+      return complete_last_message(connection);
+  }
+  return message_len;
+}
+
+/**
+ * Removes the first message of the given length from the buffer of the connection.
+ */
+void consume_message(connection_t *connection, size_t message_len) {
+  memmove(connection->buffer, connection->buffer + message_len, connection->length - message_len);
+  connection->length -= message_len;
+}
+
+/**
+ * Evaluates the first message (text or binary) in the buffer of the connection and sends the response.
+ */
+void respond(connection_t *connection, int silent) {
+
+  char *response;
+  size_t response_len;
+
+  if (is_binary_message(connection->buffer, connection->length)) {
+    response = evaluate_binary_message(connection->buffer, &response_len);
+    send_response(connection, response, response_len);
+    if (silent == 0)
+      printf("Sent binary response (length %lu)\n", (unsigned long) response_len);
+  } else {
+    /* Parse the message and evaluate its contents using an evaluator */
+    response = evaluate_message(connection->buffer);
+    send_response(connection, response, strlen(response) + 1);
+    if (silent == 0)
+      printf("Sent response %s (length %lu)\n", response, (unsigned long) strlen(response));
+  }
+  free(response);
+}
+
+/* The results of handling a message */
+#define CONNECTION_OPEN 0   /* The connection remains open */
+#define CONNECTION_RESET 1  /* The client asked for a reset (the connection should be closed) */
+#define SERVER_SHUT_DOWN 2  /* The client asked for a shut down of the server */
+
+/**
+ * Handles the first message of the given length in the buffer of the connection: evaluates it and sends
+ * the response or recognizes a request for reset or shut down. Returns one of CONNECTION_OPEN,
+ * CONNECTION_RESET and SERVER_SHUT_DOWN.
+ */
+int handle_message(connection_t *connection, size_t message_len, int silent) {
+
+  if ((silent == 0) && !is_binary_message(connection->buffer, message_len))
+    printf("Received message: %s (length %lu)\n", connection->buffer, (unsigned long) message_len);
+
+  /* Check if the message is a request for reset */
+  if (strncmp(connection->buffer, "RESET", strlen("RESET")) == 0) {
+    printf("Socket server (C) reset\n");
+    return CONNECTION_RESET;
+  }
+
+  /* Check if the message is a request for shut down */
+  if (strncmp(connection->buffer, "SHUTDOWN", strlen("SHUTDOWN")) == 0) {
+    printf("Socket server (C) shut down\n");
+    return SERVER_SHUT_DOWN;
+  }
+
+  /* Evaluate the message and send the response (or set up the shared memory) */
+  if (strncmp(connection->buffer, "SHM ", strlen("SHM ")) == 0)
+    attach_shm(connection);
+  else
+    respond(connection, silent);
+  consume_message(connection, message_len);
+  return CONNECTION_OPEN;
+}
+
+/**
+ * Serves the client of the connection until it asks for a reset or closes the connection (returns 0)
+ * or asks for a shut down (returns 1).
+ */
+int serve_connection(connection_t *connection, int silent) {
+
+  size_t message_len;
+  int status;
+
+  while ((message_len = receive_message(connection)) > 0) {
+    if ((status = handle_message(connection, message_len, silent)) != CONNECTION_OPEN)
+      return (status == SERVER_SHUT_DOWN);
+  }
+  if (silent == 0)
+    printf("Socket server (C) connection closed by the client\n");
+  return 0;
+}
+
+/**
+ * Initializes a new connection with the client on the given socket (local is 1 if the socket was
+ * accepted on the Unix-domain socket).
+ */
+void initialize_connection(connection_t *connection, socket_t sock, int local) {
+  int no_delay = 1;
+
+  /* Send the responses right away (the client can send several messages without waiting) */
+  if (!local)
+    setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, (const char *) &no_delay, sizeof(no_delay));
+  connection->sock = sock;
+  connection->length = 0;
+  connection->local = local;
+  connection->shm = NULL;
+  connection->ring_size = 0;
+  connection->spin = 0;
+  connection->next = NULL;
+}
+
+/**
+ * Returns 1 if the connection can wait for more data and 0 if data arrived in the meantime. The client
+ * using shared memory is told to wake up the server with a byte on the socket before the ring for the
+ * messages is checked for the last time.
+ */
+int prepare_to_wait(connection_t *connection) {
+#if SHM
+  ring_t *ring;
+
+  if (connection->shm != NULL) {
+    ring = ring_header(connection, 0);
+    ring->sleeping = 1;
+    SHM_BARRIER(); /* The client must see sleeping before head is checked again */
+    if (ring->head != ring->tail) {
+      ring->sleeping = 0;
+      return 0;
+    }
+  }
+#else
+  (void) connection; /* To silence the compiler */
+#endif
+  return 1;
+}
+
+#if EPOLL
+/**
+ * The state of the server that serves several clients at once.
+ */
+static struct {
+  int epoll_fd;             /* The epoll instance that waits for the messages of all clients */
+  int shutdown_pipe[2];     /* Written to by the worker thread that receives a request for shut down */
+  int unix_sock;            /* The listening Unix-domain socket (-1 if there is none) */
+  int silent;
+} server;
+
+/**
+ * Serves the connection that has received data (called by a worker thread). Receives the available
+ * bytes and handles all complete messages. Afterwards, the connection either waits for more data (the
+ * worker threads never serve the same connection at once, since the connection is registered with
+ * EPOLLONESHOT) or is closed and freed.
+ */
+void serve_ready_connection(connection_t *connection) {
+
+  struct epoll_event event;
+  size_t message_len;
+  long received_len;
+  int closed, status = CONNECTION_OPEN;
+
+  do {
+    /* Receive all available bytes */
+    while ((received_len = receive_more(connection, MSG_DONTWAIT)) > 0)
+      ;
+    closed = (received_len == 0) || ((errno != EAGAIN) && (errno != EWOULDBLOCK));
+
+    /* Handle the complete messages */
+    while ((status == CONNECTION_OPEN) && ((message_len = complete_message_length(connection)) > 0))
+      status = handle_message(connection, message_len, server.silent);
+    if ((status == CONNECTION_OPEN) && closed && ((message_len = complete_last_message(connection)) > 0))
+      status = handle_message(connection, message_len, server.silent);
+  } while ((status == CONNECTION_OPEN) && !closed && !prepare_to_wait(connection));
+
+  if ((status == CONNECTION_OPEN) && !closed) {
+    /* Wait for more data (the mutex makes sure that the next worker thread serving the connection sees
+     * all changes made by this one) */
+    event.events = EPOLLIN | EPOLLONESHOT;
+    event.data.ptr = connection;
+    pthread_mutex_lock(&worker_pool.mutex);
+    if (epoll_ctl(server.epoll_fd, EPOLL_CTL_MOD, connection->sock, &event) != 0) {
+      perror("serve_ready_connection(): Failed to wait for the connection");
+      exit(EXIT_FAILURE);
+    }
+    pthread_mutex_unlock(&worker_pool.mutex);
+    return;
+  }
+
+  if ((status == CONNECTION_OPEN) && (server.silent == 0))
+    printf("Socket server (C) connection closed by the client\n");
+  if ((status == SERVER_SHUT_DOWN) && (write(server.shutdown_pipe[1], "", 1) != 1)) {
+    perror("serve_ready_connection(): Failed to request the shut down");
+    exit(EXIT_FAILURE);
+  }
+  close_connection(connection);
+  free(connection->buffer);
+  free(connection);
+}
+
+/**
+ * Accepts an incoming connection on the listening socket and starts waiting for its data.
+ */
+void accept_connection(int listening_sock, int silent) {
+
+  struct epoll_event event;
+  connection_t *connection;
+  int new_sock;
+
+  if ((new_sock = accept(listening_sock, NULL, NULL)) < 0) {
+    perror("accept_connection(): Accept failed");
+    return;
+  }
+  connection = (connection_t *) malloc(sizeof(connection_t));
+  connection->buffer = NULL;
+  connection->size = 0;
+  initialize_connection(connection, new_sock, listening_sock == server.unix_sock);
+  event.events = EPOLLIN | EPOLLONESHOT;
+  event.data.ptr = connection;
+  if (epoll_ctl(server.epoll_fd, EPOLL_CTL_ADD, new_sock, &event) != 0) {
+    perror("accept_connection(): Failed to wait for the connection");
+    exit(EXIT_FAILURE);
+  }
+  if (silent == 0)
+    printf("Socket server (C) accepted a connection\n");
+}
+
+/**
+ * Serves the clients connecting to the listening sockets (unix_sock is -1 if there is no Unix-domain
+ * socket) until one of them asks for a shut down. The calling thread waits with epoll for new connections
+ * and for data on the existing ones. The connections that have received data are served by the worker
+ * threads, so that the messages of different clients are evaluated at once (the messages of each client
+ * are still answered in the order of arrival).
+ */
+void serve_clients(int sock, int unix_sock, int silent) {
+
+  struct epoll_event event, events[MAX_EVENTS];
+  connection_t *connection;
+  int i, number_of_events, shut_down = 0;
+
+  server.silent = silent;
+  server.unix_sock = unix_sock;
+  if ((server.epoll_fd = epoll_create(MAX_EVENTS)) < 0) {
+    perror("serve_clients(): Failed to create the epoll instance");
+    exit(EXIT_FAILURE);
+  }
+  if (pipe(server.shutdown_pipe) != 0) {
+    perror("serve_clients(): Failed to create the pipe");
+    exit(EXIT_FAILURE);
+  }
+
+  /* Wait for new connections (denoted by NULL and &server.unix_sock) and for the request for shut down
+   * (denoted by &server) */
+  event.events = EPOLLIN;
+  event.data.ptr = NULL;
+  epoll_ctl(server.epoll_fd, EPOLL_CTL_ADD, sock, &event);
+  if (unix_sock >= 0) {
+    event.data.ptr = &server.unix_sock;
+    epoll_ctl(server.epoll_fd, EPOLL_CTL_ADD, unix_sock, &event);
+  }
+  event.data.ptr = &server;
+  epoll_ctl(server.epoll_fd, EPOLL_CTL_ADD, server.shutdown_pipe[0], &event);
+
+  pthread_mutex_lock(&worker_pool.mutex);
+  start_workers();
+  pthread_mutex_unlock(&worker_pool.mutex);
+
+  while (!shut_down) {
+    if ((number_of_events = epoll_wait(server.epoll_fd, events, MAX_EVENTS, -1)) < 0) {
+      if (errno == EINTR)
+        continue;
+      perror("serve_clients(): Waiting for events failed");
+      exit(EXIT_FAILURE);
+    }
+    for (i = 0; i < number_of_events; i++) {
+      if (events[i].data.ptr == NULL) {
+        accept_connection(sock, silent);
+      } else if (events[i].data.ptr == &server.unix_sock) {
+        accept_connection(unix_sock, silent);
+      } else if (events[i].data.ptr == &server) {
+        shut_down = 1;
+      } else {
+        /* Pass the connection to the worker threads */
+        connection = (connection_t *) events[i].data.ptr;
+        pthread_mutex_lock(&worker_pool.mutex);
+        if (worker_pool.last_connection != NULL)
+          worker_pool.last_connection->next = connection;
+        else
+          worker_pool.first_connection = connection;
+        worker_pool.last_connection = connection;
+        connection->next = NULL;
+        pthread_cond_signal(&worker_pool.work_ready);
+        pthread_mutex_unlock(&worker_pool.mutex);
+      }
+    }
+  }
+  /* The epoll instance and the pipe are not closed, since the worker threads serving other clients can
+   * still use them (they are closed when the process ends) */
+}
+#else
+/**
+ * Serves the clients connecting to the listening sockets (unix_sock is -1 if there is no Unix-domain
+ * socket) one after another until one of them asks for a shut down.
+ */
+void serve_clients(socket_t sock, socket_t unix_sock, int silent) {
+
+  connection_t connection;
+  socket_t new_sock, listening_sock = sock;
+  int shut_down;
+#if WINSOCK == 0
+  fd_set listening_socks;
+#endif
+
+  connection.buffer = NULL;
+  connection.size = 0;
+  do {
+#if WINSOCK == 0
+    /* Wait for a connection on any of the listening sockets */
+    if (unix_sock >= 0) {
+      FD_ZERO(&listening_socks);
+      FD_SET(sock, &listening_socks);
+      FD_SET(unix_sock, &listening_socks);
+      if (select((sock > unix_sock ? sock : unix_sock) + 1, &listening_socks, NULL, NULL, NULL) < 0) {
+        perror("serve_clients(): Select failed");
+        exit(EXIT_FAILURE);
+      }
+      listening_sock = FD_ISSET(sock, &listening_socks) ? sock : unix_sock;
+    }
+#else
+    (void) unix_sock; /* Only TCP is available */
+#endif
+    /* Accept an incoming connection */
+#if WINSOCK == 1
+    if ((new_sock = accept(listening_sock, NULL, NULL)) == INVALID_SOCKET) {
+      fprintf(stderr, "serve_clients(): Accept failed: %d", WSAGetLastError());
+      return;
+    }
+#else
+    if ((new_sock = accept(listening_sock, NULL, NULL)) < 0) {
+      perror("serve_clients(): Accept failed");
+      exit(EXIT_FAILURE);
+    }
+#endif
+    initialize_connection(&connection, new_sock, listening_sock != sock);
+    shut_down = serve_connection(&connection, silent);
+    close_connection(&connection);
+  } while (!shut_down);
+  free(connection.buffer);
+}
+#endif
+
+#if WINSOCK == 0
+/**
+ * Creates the Unix-domain socket of the server on the given port (see UNIX_PATH) and returns it (or -1
+ * if it cannot be created, in which case the clients can connect only through TCP).
+ */
+int listen_unix(unsigned short port) {
+  struct sockaddr_un address;
+  int sock;
+
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  sprintf(address.sun_path, UNIX_PATH, (unsigned int) port);
+  /* Remove the socket left behind by a previous server on the same port */
+  unlink(address.sun_path);
+  if (((sock = socket(AF_UNIX, SOCK_STREAM, 0)) < 0)
+      || (bind(sock, (struct sockaddr*) &address, sizeof(address)) < 0)
+      || (listen(sock, LISTEN_BACKLOG) < 0)) {
+    perror("listen_unix(): Unix-domain socket not available");
+    if (sock >= 0)
+      close(sock);
+    return -1;
+  }
+  printf("Socket server (C) ready, listening on %s\n", address.sun_path);
+  return sock;
+}
+#endif
+
 /**
  * Starts the server on the given port.
  *
@@ -148,15 +1266,10 @@ char *evaluate_message(char *message) {
  */
 void socket_server_start(unsigned short port, int silent) {
 
-  int address_size;
-  char message[MESSAGE_SIZE];
-  char *response;
-
 #if WINSOCK == 1
   WSADATA wsa;
-  SOCKET sock, new_sock;
+  SOCKET sock;
   SOCKADDR_IN address;
-  int message_len;
   char yes = 0;
 
   /* Initialize Winsock */
@@ -188,61 +1301,14 @@ void socket_server_start(unsigned short port, int silent) {
   }
 
   /* Listen */
-  if (listen(sock, 3) < 0) {
+  if (listen(sock, LISTEN_BACKLOG) < 0) {
     fprintf(stderr, "socket_server_start(): Listen failed: %d", WSAGetLastError());
     return;
   }
-
-  printf("Socket server (C) ready, listening on port %d\n", port);
-  address_size = sizeof(address);
-
-  while (1) {
-    /* Accept an incoming connection */
-    if ((new_sock = accept(sock, (SOCKADDR *) &address, &address_size)) == INVALID_SOCKET) {
-      fprintf(stderr, "socket_server_start(): Accept failed: %d", WSAGetLastError());
-      return;
-    }
-
-    while (1) {
-      /* Read the message */
-      if ((message_len = recv(new_sock, message, MESSAGE_SIZE, 0)) == SOCKET_ERROR) {
-        fprintf(stderr, "socket_server_start(): Receive failed: %d", WSAGetLastError());
-        closesocket(new_sock);
-        return;
-      }
-      if (silent == 0)
-        printf("Received message: %s (length %d)\n", message, message_len);
-
-      /* Check if the message is a request for reset */
-      if (strncmp(message, "RESET", strlen("RESET")) == 0) {
-        printf("Socket server (C) reset\n");
-        closesocket(new_sock);
-        break;
-      }
-
-      /* Check if the message is a request for shut down */
-      if (strncmp(message, "SHUTDOWN", strlen("SHUTDOWN")) == 0) {
-        printf("Socket server (C) shut down \n");
-        closesocket(new_sock);
-        return;
-      }
-
-      /* Parse the message and evaluate its contents using an evaluator */
-      response = evaluate_message(message);
-
-      /* Send the response */
-      send(new_sock, response, (int)strlen(response) + 1, 0);
-      if (silent == 0)
-        printf("Sent response %s (length %ld)\n", response, strlen(response));
-
-      free(response);
-    }
-  }
-  closesocket(new_sock);
 #else
-  int sock, new_sock;
+  int sock, unix_sock;
+  char unix_path[sizeof(((struct sockaddr_un *) NULL)->sun_path)];
   struct sockaddr_in address;
-  long message_len;
   int yes = 0;
 
   /* Create a socket file descriptor */
@@ -267,57 +1333,28 @@ void socket_server_start(unsigned short port, int silent) {
   }
 
   /* Listen */
-  if (listen(sock, 3) < 0) {
+  if (listen(sock, LISTEN_BACKLOG) < 0) {
     perror("socket_server_start(): Listen failed");
     exit(EXIT_FAILURE);
   }
+#endif
 
   printf("Socket server (C) ready, listening on port %d\n", port);
-  address_size = sizeof(address);
-
-  while (1) {
-    /* Accept an incoming connection */
-    if ((new_sock = accept(sock, (struct sockaddr*) &address, (socklen_t*) &address_size)) < 0) {
-      perror("socket_server_start(): Accept failed");
-      exit(EXIT_FAILURE);
-    }
-
-    while (1) {
-      /* Read the message */
-      if ((message_len = read(new_sock, message, MESSAGE_SIZE)) < 0) {
-        perror("socket_server_start(): Receive failed");
-        close(new_sock);
-        exit(EXIT_FAILURE);
-      }
-      if (silent == 0)
-        printf("Received message: %s (length %ld)\n", message, message_len);
-
-      /* Check if the message is a request for reset */
-      if (strncmp(message, "RESET", strlen("RESET")) == 0) {
-        printf("Socket server (C) reset\n");
-        close(new_sock);
-        break;
-      }
-
-      /* Check if the message is a request for shut down */
-      if (strncmp(message, "SHUTDOWN", strlen("SHUTDOWN")) == 0) {
-        printf("Socket server (C) shut down\n");
-        close(new_sock);
-        return;
-      }
-
-      /* Parse the message and evaluate its contents using an evaluator */
-      response = evaluate_message(message);
+#if WINSOCK == 1
+  serve_clients(sock, INVALID_SOCKET, silent);
 
-      /* Send the response */
-      send(new_sock, response, strlen(response) + 1, 0);
-      if (silent == 0)
-        printf("Sent response %s (length %ld)\n", response, strlen(response));
+  closesocket(sock);
+  WSACleanup();
+#else
+  unix_sock = listen_unix(port);
+  serve_clients(sock, unix_sock, silent);
 
-      free(response);
-    }
+  close(sock);
+  if (unix_sock >= 0) {
+    close(unix_sock);
+    sprintf(unix_path, UNIX_PATH, (unsigned int) port);
+    unlink(unix_path);
   }
-  close(new_sock);
 #endif
 }
 
@@ -326,7 +1363,35 @@ int main(int argc, char* argv[])
   int silent = 0;
   long port;
   unsigned short port_short;
+#if REPLAY_SERVER > 0
+  int i;
+#endif
 
+#if REPLAY_SERVER > 0
+  /* The log is given after the port and can be followed by the precision of the rounded x-values (the
+   * options are then shifted accordingly) */
+  if ((argc >= 4) && (strncmp(argv[3], "precision_x=", 12) == 0)) {
+    replay.precision_x = (int) strtol(argv[3] + 12, NULL, 10);
+    if ((replay.precision_x < 1) || (replay.precision_x > 32)) {
+      printf("Incorrect precision_x %s\n", argv[3] + 12);
+      return -1;
+    }
+    for (i = 3; i < argc - 1; i++)
+      argv[i] = argv[i + 1];
+    argc--;
+  }
+  if ((argc >= 3) && (argc <= 4)) {
+    replay_open(argv[2]);
+    printf("Replay server (C) with %lu evaluations from %s\n", (unsigned long) replay.number_of_records,
+        argv[2]);
+    argv[2] = argv[1];
+    argc--;
+    argv++;
+  } else {
+    printf("Incorrect options\nUsage:\nreplay_server PORT LOG <precision_x=N> <\"silent\">");
+    return -1;
+  }
+#endif
   if ((argc >= 2) && (argc <= 3)) {
     port = strtol(argv[1], NULL, 10);
     port_short = (unsigned short)port;
@@ -0,0 +1,362 @@
+"""
+The socket server in Python.
+Uses the toy_socket_evaluator to evaluate problems from the toy-socket suite. Additional evaluators
+can be used -- whether they are included or not depends on the values of the respective variables
+(see the variables that start with EVALUATE_). These definitions can be modified directly or through
+do.py.
+If the server receives the message 'RESET', it closes the current socket and opens a new one.
+If the server receives the message 'SHUTDOWN', it shuts down.
+Where available, the server listens also on a Unix-domain socket (see UNIX_PATH). The shared-memory
+transport is not supported (the request for it is answered with 'NO').
+Besides text messages, the server understands binary frames that start with the magic 'COCB' (see
+evaluate_binary_message). The protocol is recognized for each message separately. Binary frames
+can contain a batch of solutions, which are evaluated in parallel by a pool of processes.
+Change code below to connect it to other evaluators (for other suites) -- see occurrences of
+'ADD HERE'.
+Note that separate functions are used for evaluating objectives and constraints.
+"""
+import os
+import sys
+import select
+import socket
+import struct
+from concurrent.futures import ProcessPoolExecutor
+from toy_socket.toy_socket_evaluator import evaluate_toy_socket_objectives
+from toy_socket.toy_socket_evaluator import evaluate_toy_socket_constraints
+
+HOST = '127.0.0.1'        # Local host
+MESSAGE_SIZE = 8192       # The number of bytes received at once (the messages can be longer)
+RESULT_PRECISION = 16     # Precision used to write objective and constraint values
+# Types of the evaluation function
+EVAL_TYPE_OBJ = 'objectives'
+EVAL_TYPE_CON = 'constraints'
+EVAL_TYPE_BOTH = 'both'   # Objectives followed by constraints
+# Definitions for the binary protocol (must match those in socket_communication.c)
+BINARY_MAGIC = b'COCB'    # The first four bytes of each binary frame
+BINARY_VERSION = 2        # The version of the binary protocol
+BINARY_HEADER = struct.Struct('<4s9I')  # The magic followed by nine 32-bit unsigned integers
+BINARY_TYPE_HELLO = 0     # Frame type used to negotiate the protocol
+BINARY_TYPE_OBJ = 1       # Frame type for evaluation of objectives
+BINARY_TYPE_CON = 2       # Frame type for evaluation of constraints
+BINARY_TYPE_BOTH = 3      # Frame type for evaluation of objectives followed by constraints
+BINARY_FEATURES = 1       # The features announced in the response to HELLO (1 for BINARY_TYPE_BOTH)
+NUMBER_OF_WORKERS = 4     # Number of processes used to evaluate a batch of solutions
+UNIX_PATH = '/tmp/coco_socket_{}'  # Path of the Unix-domain socket on a port (see socket_communication.c)
+
+EVALUATE_RW_MARIO_GAN = 0
+if EVALUATE_RW_MARIO_GAN:
+    from mario_gan.mario_gan_evaluator import evaluate_mario_gan
+# ADD HERE imports from other evaluators, for example
+# EVALUATE_MY_EVALUATOR = 0
+# if EVALUATE_MY_EVALUATOR:
+# from .my_suite.my_evaluator import evaluate_my_suite_objectives, evaluate_my_suite_constraints
+#
+# The evaluators should support the following usage:
+# result = evaluate_my_suite(suite_name, function, instance, x)
+# where the result is a list of values (even if it contains a single value)
+
+
+def evaluate(suite_name, evaluation_type, num_values, func, instance, x, num_constraints=0):
+    """Calls an evaluator to compute the evaluation of the given type and returns the list of values.
+    The evaluation of the type 'both' returns the objective values followed by the num_constraints
+    constraint values.
+    """
+    # Find the right evaluator
+    evaluate_objectives = None
+    evaluate_constraints = None
+    if 'toy-socket' in suite_name:
+        evaluate_objectives = evaluate_toy_socket_objectives
+        evaluate_constraints = evaluate_toy_socket_constraints
+    elif EVALUATE_RW_MARIO_GAN > 0:
+        if 'mario-gan' in suite_name or 'mario-gan-biobj' in suite_name:
+            evaluate_objectives = evaluate_mario_gan
+    # ADD HERE the functions for another evaluator, for example
+    # elif EVALUATE_MY_EVALUATOR > 0:
+    #     if 'my-suite' in suite_name:
+    #         evaluate_objectives = evaluate_my_suite_objectives
+    #         evaluate_constraints = evaluate_my_suite_constraints
+    else:
+        raise ValueError('Suite {} not supported'.format(suite_name))
+
+    if evaluation_type == EVAL_TYPE_OBJ:
+        # Evaluate the objective values of x and save the result to values
+        values = evaluate_objectives(suite_name, func, instance, x)
+    elif evaluation_type == EVAL_TYPE_CON:
+        # Evaluate the constraint violations of x and save the result to values
+        values = evaluate_constraints(suite_name, func, instance, x)
+    elif evaluation_type == EVAL_TYPE_BOTH:
+        values = list(evaluate_objectives(suite_name, func, instance, x))
+        constraints = list(evaluate_constraints(suite_name, func, instance, x))
+        if len(constraints) != num_constraints:
+            raise ValueError('Number of constraint values {} does not match {}'.format(
+                len(constraints), num_constraints))
+        values += constraints
+    else:
+        raise ValueError('Evaluation type {} not supported'.format(evaluation_type))
+
+    if len(values) != num_values:
+        raise ValueError('Number of result values {} does not match {}'.format(len(values),
+                                                                               num_values))
+    return values
+
+
+_process_pool = None
+
+
+def evaluate_batch(suite_name, evaluation_type, num_values, func, instance, xs, num_constraints=0):
+    """Evaluates all solutions in the list xs and returns the list of their values (one list for
+    each solution). Batches of more than one solution are evaluated in parallel by a pool of
+    processes (created when the first batch arrives).
+    """
+    global _process_pool
+    if len(xs) == 1:
+        return [evaluate(suite_name, evaluation_type, num_values, func, instance, xs[0],
+                         num_constraints)]
+    if _process_pool is None:
+        _process_pool = ProcessPoolExecutor(max_workers=NUMBER_OF_WORKERS)
+    n = len(xs)
+    return list(_process_pool.map(evaluate, [suite_name] * n, [evaluation_type] * n,
+                                  [num_values] * n, [func] * n, [instance] * n, xs,
+                                  [num_constraints] * n, chunksize=max(1, n // (4 * NUMBER_OF_WORKERS))))
+
+
+def evaluate_message(message):
+    """Parses the message and calls an evaluator to compute the evaluation. Then constructs a
+    response. Returns the response.
+    Messages of the type 'both' contain the number of constraints ('c') and are answered with the
+    objective values followed by the constraint values.
+    """
+    try:
+        # Parse the message
+        msg = message.split(' ')
+        suite_name = msg[msg.index('s') + 1]
+        evaluation_type = msg[msg.index('t') + 1]
+        num_values = int(msg[msg.index('r') + 1])
+        func = int(msg[msg.index('f') + 1])
+        dimension = int(msg[msg.index('d') + 1])
+        instance = int(msg[msg.index('i') + 1])
+        num_constraints = int(msg[msg.index('c') + 1]) if evaluation_type == EVAL_TYPE_BOTH else 0
+        x = [float(m) for m in msg[msg.index('x') + 1:] if m != '']
+        if len(x) != dimension:
+            raise ValueError('Number of x values {} does not match dimension {}'.format(len(x),
+                                                                                        dimension))
+
+        values = evaluate(suite_name, evaluation_type, num_values, func, instance, x,
+                          num_constraints)
+
+        # Construct the response
+        response = ''
+        for value in values:
+            response += '{:.{p}e} '.format(value, p=RESULT_PRECISION)
+        return str.encode(response)
+    except Exception as e:
+        print('Error within message evaluation: {} \nMessage = {}'.format(e, message))
+        raise e
+
+
+def _message_length(data):
+    """Returns the length of the first message in data if the message is complete and 0 otherwise.
+    Text messages end with a null character, while the length of binary frames is given in their
+    header (see evaluate_binary_message).
+    """
+    if data[:len(BINARY_MAGIC)] == BINARY_MAGIC:
+        if len(data) < BINARY_HEADER.size:
+            return 0
+        _, _, frame_type, name_length, _, _, _, dimension, count, _ = \
+            BINARY_HEADER.unpack_from(data)
+        length = BINARY_HEADER.size
+        if frame_type != BINARY_TYPE_HELLO:
+            length += name_length + 8 * count * dimension
+        if frame_type == BINARY_TYPE_BOTH:
+            length += 4
+        return length if len(data) >= length else 0
+    end = data.find(b'\x00')
+    return end + 1 if end >= 0 else 0
+
+
+def _receive_message(conn, data):
+    """Receives bytes from the connection until data (the bytes that have already been received)
+    contains a complete message. Returns the message and the bytes that belong to the next messages
+    (the client can send several messages without waiting for the responses). Returns None instead
+    of the message if the connection was closed before a complete message was received. If the
+    connection was closed after a text message without the terminating null character (for example,
+    'SHUTDOWN' sent by do.py), the message is returned as well.
+    """
+    data = bytearray(data)
+    length = _message_length(data)
+    while length == 0:
+        chunk = conn.recv(MESSAGE_SIZE)
+        if not chunk:
+            if len(data) == 0 or data[:len(BINARY_MAGIC)] == BINARY_MAGIC:
+                return None, b''
+            data.append(0)
+            length = len(data)
+            break
+        data.extend(chunk)
+        length = _message_length(data)
+    return bytes(data[:length]), bytes(data[length:])
+
+
+def evaluate_binary_message(message):
+    """Calls an evaluator for the binary frame and constructs the response. Returns the response.
+    The frame consists of a header with the magic 'COCB' and nine 32-bit unsigned integers
+    (version, type, length of the suite name, number of values, function, instance, dimension,
+    number of solutions and sequence id), followed by the suite name and the x-values as IEEE-754
+    doubles. All
+    numbers are in little-endian order. The response has the same header (with the length of the
+    suite name set to 0), followed by the values. A frame can contain several solutions (their
+    number is given in the header), in which case the response contains the values of all of them.
+    Frames of the type 'both' contain the number of constraints (a 32-bit unsigned integer) between
+    the suite name and the x-values and are answered with the objective values followed by the
+    constraint values of each solution.
+    The response to a HELLO frame is a HELLO frame with the version supported by the server and the
+    supported features (BINARY_FEATURES) in place of the number of solutions. The frames are
+    answered in the order in which they arrive.
+    """
+    magic, version, frame_type, name_length, num_values, func, instance, dimension, count, \
+        sequence = BINARY_HEADER.unpack_from(message)
+    if frame_type == BINARY_TYPE_HELLO:
+        return BINARY_HEADER.pack(magic, BINARY_VERSION, frame_type, 0, 0, 0, 0, 0, BINARY_FEATURES,
+                                  sequence)
+    if version != BINARY_VERSION or count == 0 or frame_type not in (BINARY_TYPE_OBJ,
+                                                                     BINARY_TYPE_CON,
+                                                                     BINARY_TYPE_BOTH):
+        raise ValueError('Unsupported frame (version {}, type {}, count {})'.format(version,
+                                                                                   frame_type,
+                                                                                   count))
+    payload = message[BINARY_HEADER.size:]
+    suite_name = payload[:name_length].decode('utf-8')
+    num_constraints = 0
+    if frame_type == BINARY_TYPE_BOTH:
+        num_constraints, = struct.unpack_from('<I', payload, name_length)
+        name_length += 4
+    x = struct.unpack_from('<{}d'.format(count * dimension), payload, name_length)
+    xs = [list(x[i * dimension:(i + 1) * dimension]) for i in range(count)]
+    evaluation_type = {BINARY_TYPE_OBJ: EVAL_TYPE_OBJ, BINARY_TYPE_CON: EVAL_TYPE_CON,
+                       BINARY_TYPE_BOTH: EVAL_TYPE_BOTH}[frame_type]
+    values = evaluate_batch(suite_name, evaluation_type, num_values, func, instance, xs,
+                            num_constraints)
+    return BINARY_HEADER.pack(magic, version, frame_type, 0, num_values, func, instance, dimension,
+                              count, sequence) + \
+        struct.pack('<{}d'.format(count * num_values), *[v for vs in values for v in vs])
+
+
+def _listen_unix(port):
+    """Creates the Unix-domain socket of the server on the given port and returns it (or None if
+    Unix-domain sockets are not available, in which case the clients can connect only through TCP).
+    """
+    if not hasattr(socket, 'AF_UNIX'):
+        return None
+    path = UNIX_PATH.format(port)
+    # Remove the socket left behind by a previous server on the same port
+    if os.path.exists(path):
+        os.unlink(path)
+    try:
+        us = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        us.bind(path)
+        us.listen(1)
+    except socket.error as e:
+        print('Unix-domain socket not available: {}'.format(e))
+        return None
+    print('Socket server (Python) ready, listening on {}'.format(path))
+    return us
+
+
+def socket_server_start(port, silent=False):
+    s = None
+    us = None
+    try:
+        # Create socket
+        s = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+
+        # Bind socket to local host and port
+        try:
+            s.bind((HOST, port))
+        except socket.error as e:
+            print('Bind failed: {}'.format(e))
+            raise e
+
+        # Start listening on socket
+        s.listen(1)
+        print('Socket server (Python) ready, listening on port {}'.format(port))
+        us = _listen_unix(port)
+        listening = [s] if us is None else [s, us]
+
+        # Talk with the client
+        while True:
+            try:
+                # Wait to accept a connection on any of the sockets - blocking call
+                ready, _, _ = select.select(listening, [], [])
+                conn, addr = ready[0].accept()
+            except socket.error as e:
+                print('Accept failed: {}'.format(e))
+                raise e
+            # Send the responses right away (the client can send several messages without waiting)
+            if ready[0] is s:
+                conn.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+            with conn:
+                pending = b''
+                while True:
+                    # Receive the message (the previous reads can already contain a part of it)
+                    data, pending = _receive_message(conn, pending)
+                    if data is None:
+                        if not silent:
+                            print('Socket server (Python) connection closed by the client')
+                        break
+                    if data[:len(BINARY_MAGIC)] == BINARY_MAGIC:
+                        # Evaluate the binary frame and send the response
+                        conn.sendall(evaluate_binary_message(data))
+                        if not silent:
+                            print('Sent binary response')
+                        continue
+                    # Remove the terminating null character
+                    message = data[:-1].decode("utf-8")
+                    if not silent:
+                        print('Received message: {}'.format(message))
+                    # Check if the message is a request for reset
+                    if message == 'RESET':
+                        print('Socket server (Python) reset')
+                        break
+                    # Check if the message is a request for shut down
+                    if message == 'SHUTDOWN':
+                        print('Socket server (Python) shut down')
+                        return
+                    # Decline the request for shared memory (the client keeps using the socket)
+                    if message.startswith('SHM '):
+                        conn.sendall(b'NO\x00')
+                        continue
+                    # Parse the message and evaluate its contents using an evaluator
+                    response = evaluate_message(message)
+                    # Send the response (terminated by a null character)
+                    conn.sendall(response + b'\x00')
+                    if not silent:
+                        print('Sent response: {}'.format(response.decode("utf-8")))
+    except KeyboardInterrupt or SystemExit as e:
+        print('Socket server (Python) terminated: {}'.format(e))
+        raise e
+    except Exception as e:
+        print('Socket server (Python) error: {}'.format(e))
+        raise e
+    finally:
+        if s is not None:
+            s.close()
+        if us is not None:
+            us.close()
+            os.unlink(UNIX_PATH.format(port))
+
+
+if __name__ == '__main__':
+    silent = False
+    port = None
+    if 2 <= len(sys.argv) <= 3:
+        port = int(sys.argv[1])
+        print('Socket server (Python) called on port {}'.format(port))
+        if len(sys.argv) == 3:
+            if sys.argv[2] == 'silent':
+                silent = True
+            else:
+                print('Ignoring input option {}'.format(sys.argv[2]))
+    else:
+        print('Incorrect options\nUsage:\nsocket_server PORT <\"silent\">')
+        exit(-1)
+    socket_server_start(port=port, silent=silent)
\ No newline at end of file
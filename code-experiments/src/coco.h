@@ -10,6 +10,7 @@
 #define __COCO_H__
 
 #include <stddef.h>
+#include <stdio.h>
 
 /* Definitions of some 32 and 64-bit types (used by the random number generator) */
 #ifdef _MSC_VER
@@ -296,6 +297,45 @@ const char *coco_observer_get_result_folder(const coco_observer_t *observer);
  */
 void coco_observer_signal_restart(coco_observer_t *observer, coco_problem_t *problem);
 
+/**
+ * @brief Returns the number of runs (observed problems) stored by the memory observer.
+ */
+size_t coco_observer_memory_get_number_of_runs(const coco_observer_t *observer);
+
+/**
+ * @brief Returns the id of the problem of the given run stored by the memory observer.
+ */
+const char *coco_observer_memory_get_problem_id(const coco_observer_t *observer, const size_t run_index);
+
+/**
+ * @brief Returns the number of evaluations of the given run stored by the memory observer.
+ */
+size_t coco_observer_memory_get_evaluations(const coco_observer_t *observer, const size_t run_index);
+
+/**
+ * @brief Returns the number of targets hit in the given run stored by the memory observer.
+ */
+size_t coco_observer_memory_get_number_of_hits(const coco_observer_t *observer, const size_t run_index);
+
+/**
+ * @brief Copies the targets hit in the given run and the evaluations of their first hits into the arrays.
+ */
+void coco_observer_memory_get_hits(const coco_observer_t *observer,
+                                   const size_t run_index,
+                                   double *targets,
+                                   size_t *evaluations);
+
+/**
+ * @brief Frees the data of the finished runs stored by the memory observer.
+ */
+void coco_observer_memory_clear(coco_observer_t *observer);
+
+/**
+ * @brief Exports the runs stored by the memory observer that have not been exported yet to the result folder
+ * in the bbob format.
+ */
+void coco_observer_memory_export(coco_observer_t *observer);
+
 /**@}*/
 
 /***********************************************************************************************************/
@@ -309,6 +349,25 @@ void coco_observer_signal_restart(coco_observer_t *observer, coco_problem_t *pro
  */
 void coco_evaluate_function(coco_problem_t *problem, const double *x, double *y);
 
+/**
+ * @brief Evaluates the problem function in a batch of points x and saves the results in y.
+ */
+void coco_evaluate_function_batch(coco_problem_t *problem,
+                                  const double *x,
+                                  const size_t number_of_solutions,
+                                  double *y);
+
+/**
+ * @brief Submits the point x for evaluation without waiting for the result.
+ */
+void coco_evaluate_function_submit(coco_problem_t *problem, const double *x);
+
+/**
+ * @brief Evaluates the earliest submitted point that has not been collected yet, saves it in x and its
+ * evaluation in y. Returns 1 if such a point exists and 0 otherwise.
+ */
+int coco_evaluate_function_collect(coco_problem_t *problem, double *x, double *y);
+
 /**
  * @brief Evaluates the problem constraints in point x and save the result in y.
  */
@@ -412,6 +471,12 @@ size_t coco_problem_get_suite_dep_index(const coco_problem_t *problem);
  * @brief Returns an initial solution, i.e. a feasible variable setting, to the problem.
  */
 void coco_problem_get_initial_solution(const coco_problem_t *problem, double *initial_solution);
+
+/**
+ * @brief Outputs the number of evaluations and the time spent in each layer of the problem to the given file
+ * (has an effect only when COCO is compiled with COCO_PROFILING defined).
+ */
+void coco_problem_profile_report(const coco_problem_t *problem, FILE *file);
 /**@}*/
 
 /***********************************************************************************************************/
@@ -505,6 +570,12 @@ void coco_debug(const char *message, ...);
  * @brief Sets the COCO log level to the given value and returns the previous value of the log level.
  */
 const char *coco_set_log_level(const char *level);
+
+/**
+ * @brief Turns the profiling of problem evaluations on (1) or off (0) and returns the previous value
+ * (has an effect only when COCO is compiled with COCO_PROFILING defined).
+ */
+int coco_set_profiling(const int enabled);
 /**@}*/
 
 /***********************************************************************************************************/
@@ -528,6 +599,19 @@ coco_archive_t *coco_archive(const char *suite_name,
  */
 int coco_archive_add_solution(coco_archive_t *archive, const double y1, const double y2, const char *text);
 
+/**
+ * @brief Adds a batch of solutions to the archive and returns the number of solutions from the batch that
+ * are contained in the updated archive.
+ *
+ * The objectives of the i-th solution are stored in y[2 * i] and y[2 * i + 1] and its text in texts[i]. The
+ * result is the same as when adding the solutions one by one with coco_archive_add_solution, but the batch
+ * is processed in O(n log n) time without searching the archive for every solution.
+ */
+size_t coco_archive_add_solutions(coco_archive_t *archive,
+                                  const size_t number_of_solutions,
+                                  const double *y,
+                                  const char **texts);
+
 /**
  * @brief Returns the number of (non-dominated) solutions in the archive (computed first, if needed).
  */
@@ -553,6 +637,14 @@ void coco_archive_free(coco_archive_t *archive);
  * @brief Feeds the solution to the bi-objective logger for logger output reconstruction purposes.
  */
 int coco_logger_biobj_feed_solution(coco_problem_t *problem, const size_t evaluation, const double *y);
+
+/**
+ * @brief Feeds a batch of solutions to the bi-objective logger and returns the number of archive updates.
+ */
+size_t coco_logger_biobj_feed_solutions(coco_problem_t *problem,
+                                        const size_t number_of_solutions,
+                                        const size_t *evaluations,
+                                        const double *y);
 /**@}*/
 
 /***********************************************************************************************************/
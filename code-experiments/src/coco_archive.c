@@ -6,10 +6,13 @@
  * wrapper written in Python, these functions are used to merge archives and compute their hypervolumes.
  */
 
+#include <stdlib.h>
+
 #include "coco.h"
 #include "coco_utilities.c"
 #include "mo_utilities.c"
 #include "mo_avl_tree.c"
+#include "mo_slab.c"
 
 /**
  * @brief The COCO archive structure.
@@ -19,14 +22,19 @@
 struct coco_archive_s {
 
   avl_tree_t *tree;              /**< @brief The AVL tree with non-dominated solutions. */
+  mo_slab_t *item_slab;          /**< @brief The slab holding the nodes' items (with their data). */
+  mo_slab_t *node_slab;          /**< @brief The slab holding the nodes of the tree. */
+  mo_slab_t *text_slab;          /**< @brief The slab holding the texts of the solutions. */
   double *ideal;                 /**< @brief The ideal point. */
   double *nadir;                 /**< @brief The nadir point. */
+  double *scales;                /**< @brief The reciprocal normalization scales (see mo_normalize_into()). */
 
   size_t number_of_objectives;   /**< @brief Number of objectives (clearly equal to 2). */
 
-  int is_up_to_date;             /**< @brief Whether archive fields have been updated since last addition. */
-  size_t number_of_solutions;    /**< @brief Number of solutions in the archive. */
-  double hypervolume;            /**< @brief Hypervolume of the solutions in the archive. */
+  int is_up_to_date;             /**< @brief Whether the iteration over solutions was reset since last addition. */
+  size_t number_of_solutions;    /**< @brief Number of solutions in the archive (maintained incrementally). */
+  double hypervolume;            /**< @brief Hypervolume of the solutions in the archive (maintained
+                                      incrementally as the sum of the solutions' contributions). */
 
   avl_node_t *current_solution;  /**< @brief Current solution (to return). */
   avl_node_t *extreme1;          /**< @brief Pointer to the first extreme solution. */
@@ -38,41 +46,45 @@ struct coco_archive_s {
  * @brief The type for the node's item in the AVL tree used by the archive.
  *
  * Contains information on the rounded normalized objective values (normalized_y), which are used for
- * computing the indicators and the text, which is used for output.
+ * computing the indicators and the text, which is used for output. The item and its normalized_y values
+ * are stored in a single block of the archive's item slab, while the text is stored in the text slab.
  */
 typedef struct {
   double *normalized_y;      /**< @brief The values of normalized objectives of this solution. */
   char *text;                /**< @brief The text describing the solution (the whole line of the archive). */
+  int within_ROI;            /**< @brief Whether the solution is within the region of interest (ROI). */
+  double hypervolume_contribution; /**< @brief The contribution of this solution to the hypervolume. */
 } coco_archive_avl_item_t;
 
 /**
  * @brief Creates and returns the information on the solution in the form of a node's item in the AVL tree.
  */
-static coco_archive_avl_item_t* coco_archive_node_item_create(const double *y,
-                                                              const double *ideal,
-                                                              const double *nadir,
-                                                              const size_t num_obj,
-                                                              const char *text,
-                                                              const int is_opt_known) {
+static coco_archive_avl_item_t* coco_archive_node_item_create(coco_archive_t *archive,
+                                                              const double *normalized_y,
+                                                              const char *text) {
 
-  /* Allocate memory to hold the data structure coco_archive_avl_item_t */
-  coco_archive_avl_item_t *item = (coco_archive_avl_item_t*) coco_allocate_memory(sizeof(*item));
+  size_t i;
 
-  /* Compute the normalized y */
-  item->normalized_y = mo_normalize(y, ideal, nadir, num_obj, is_opt_known);
+  /* Get memory to hold the data structure coco_archive_avl_item_t and the normalized y */
+  coco_archive_avl_item_t *item = (coco_archive_avl_item_t*) mo_slab_get_block(archive->item_slab);
+  item->normalized_y = (double *) (item + 1);
+  for (i = 0; i < archive->number_of_objectives; i++)
+    item->normalized_y[i] = normalized_y[i];
 
-  item->text = coco_strdup(text);
+  item->text = mo_slab_strdup(archive->text_slab, text);
+  item->within_ROI = mo_is_within_ROI(item->normalized_y, archive->number_of_objectives);
+  item->hypervolume_contribution = 0;
   return item;
 }
 
 /**
- * @brief Frees the data of the given coco_archive_avl_item_t.
+ * @brief Frees the data of the given coco_archive_avl_item_t (gives it and its text back to the slabs of
+ * the archive, which is passed as userdata).
  */
 static void coco_archive_node_item_free(coco_archive_avl_item_t *item, void *userdata) {
-  coco_free_memory(item->normalized_y);
-  coco_free_memory(item->text);
-  coco_free_memory(item);
-  (void) userdata; /* To silence the compiler */
+  coco_archive_t *archive = (coco_archive_t *) userdata;
+  mo_slab_put_string(archive->text_slab, item->text);
+  mo_slab_put_block(archive->item_slab, item);
 }
 
 /**
@@ -91,6 +103,48 @@ static int coco_archive_compare_by_last_objective(const coco_archive_avl_item_t
   (void) userdata; /* To silence the compiler */
 }
 
+/**
+ * @brief Recomputes the hypervolume contribution of the solution in the given node and updates the
+ * hypervolume of the archive accordingly.
+ *
+ * The contribution of a solution within the ROI equals the area between it and the previous solution (or
+ * the ROI boundary, if the previous solution is not within the ROI). Since the contribution depends only on
+ * the previous solution, it needs to be recomputed only for the solutions next to the inserted or removed
+ * ones. The first solution (an extreme one) does not contribute to the hypervolume.
+ */
+static void coco_archive_update_contribution(coco_archive_t *archive, avl_node_t *node) {
+
+  coco_archive_avl_item_t *item = (coco_archive_avl_item_t *) node->item;
+  coco_archive_avl_item_t *previous_item;
+  double hyp = 0;
+
+  if ((node->prev != NULL) && item->within_ROI) {
+    previous_item = (coco_archive_avl_item_t *) node->prev->item;
+    if (previous_item->within_ROI)
+      hyp = (previous_item->normalized_y[0] - item->normalized_y[0]) * (1 - item->normalized_y[1]);
+    else
+      hyp = (1 - item->normalized_y[0]) * (1 - item->normalized_y[1]);
+    assert(hyp >= 0);
+  }
+  archive->hypervolume += hyp - item->hypervolume_contribution;
+  item->hypervolume_contribution = hyp;
+}
+
+/**
+ * @brief Removes the given (dominated) node from the archive and updates the archive fields.
+ */
+static void coco_archive_delete_node(coco_archive_t *archive, avl_node_t *node) {
+
+  avl_node_t *next_node = node->next;
+
+  assert((node != archive->extreme1) && (node != archive->extreme2));
+  archive->hypervolume -= ((coco_archive_avl_item_t *) node->item)->hypervolume_contribution;
+  archive->number_of_solutions--;
+  avl_node_delete(archive->tree, node);
+  if (next_node != NULL)
+    coco_archive_update_contribution(archive, next_node);
+}
+
 /**
  * @brief Allocates memory for the archive and initializes its fields.
  */
@@ -102,9 +156,15 @@ static coco_archive_t *coco_archive_allocate(void) {
   /* Initialize the AVL tree */
   archive->tree = avl_tree_construct((avl_compare_t) coco_archive_compare_by_last_objective,
       (avl_free_t) coco_archive_node_item_free);
+  archive->tree->userdata = archive;
+  archive->item_slab = mo_slab_allocate(sizeof(coco_archive_avl_item_t) + 2 * sizeof(double), 1024);
+  archive->node_slab = mo_slab_allocate(sizeof(avl_node_t), 1024);
+  archive->text_slab = mo_slab_allocate(256, 1024);
+  mo_slab_attach_to_tree(archive->node_slab, archive->tree);
 
   archive->ideal = NULL;                /* To be allocated in coco_archive() */
   archive->nadir = NULL;                /* To be allocated in coco_archive() */
+  archive->scales = NULL;               /* To be allocated in coco_archive() */
   archive->number_of_objectives = 2;
   archive->is_up_to_date = 0;
   archive->number_of_solutions = 0;
@@ -151,6 +211,8 @@ coco_archive_t *coco_archive(const char *suite_name,
   /* Store the ideal and nadir points */
   archive->ideal = coco_duplicate_vector(problem->best_value, 2);
   archive->nadir = coco_duplicate_vector(problem->nadir_value, 2);
+  archive->scales = coco_allocate_vector(2);
+  mo_get_normalization_scales(archive->ideal, archive->nadir, 2, archive->scales);
 
   /* Add the extreme points to the archive */
   text = coco_strdupf("0\t%.*e\t%.*e\n", output_precision, archive->nadir[0], output_precision, archive->ideal[1]);
@@ -176,37 +238,38 @@ coco_archive_t *coco_archive(const char *suite_name,
   return archive;
 }
 
-int coco_archive_add_solution(coco_archive_t *archive, const double y1, const double y2, const char *text) {
+/**
+ * @brief Adds the solution with the given normalized objectives to the archive if it is not dominated by or
+ * equal to any of the existing solutions and returns 1 in this case (0 otherwise).
+ *
+ * The finger must point to the last node that is not worse than the solution in the last objective (or to
+ * NULL, if such a node does not exist), as returned by avl_item_search_right(). On return, the finger
+ * points to the node of the inserted solution or is left unchanged if the solution was not inserted.
+ */
+static int coco_archive_insert(coco_archive_t *archive,
+                               avl_node_t **finger,
+                               const double *normalized_y,
+                               const char *text) {
 
   coco_archive_avl_item_t* insert_item;
-  avl_node_t *node, *next_node;
+  coco_archive_avl_item_t probe_item;
+  avl_node_t *node = *finger, *next_node;
   int update = 0;
   int dominance;
 
-  double *y = coco_allocate_vector(2);
-  y[0] = y1;
-  y[1] = y2;
-  insert_item = coco_archive_node_item_create(y, archive->ideal, archive->nadir,
-      archive->number_of_objectives, text, 1);
-  coco_free_memory(y);
-
-  /* Find the first point that is not worse than the new point (NULL if such point does not exist) */
-  node = avl_item_search_right(archive->tree, insert_item, NULL);
-
   if (node == NULL) {
     /* The new point is an extreme point */
     update = 1;
     next_node = archive->tree->head;
   } else {
-    dominance = mo_get_dominance(insert_item->normalized_y, ((coco_archive_avl_item_t*) node->item)->normalized_y,
+    dominance = mo_get_dominance(normalized_y, ((coco_archive_avl_item_t*) node->item)->normalized_y,
         archive->number_of_objectives);
     if (dominance > -1) {
       update = 1;
       next_node = node->next;
       if (dominance == 1) {
         /* The new point dominates the next point, remove the next point */
-      	assert((node != archive->extreme1) && (node != archive->extreme2));
-      	avl_node_delete(archive->tree, node);
+        coco_archive_delete_node(archive, node);
       }
     } else {
       /* The new point is dominated or equal to an existing one, ignore */
@@ -214,9 +277,10 @@ int coco_archive_add_solution(coco_archive_t *archive, const double y1, const do
     }
   }
 
-  if (!update) {
-    coco_archive_node_item_free(insert_item, NULL);
-  } else {
+  if (update) {
+    /* The item is created only for solutions that update the archive */
+    insert_item = coco_archive_node_item_create(archive, normalized_y, text);
+
     /* Perform tree update */
     while (next_node != NULL) {
       /* Check the dominance relation between the new node and the next node. There are only two possibilities:
@@ -228,16 +292,27 @@ int coco_archive_add_solution(coco_archive_t *archive, const double y1, const do
       if (dominance == 1) {
         next_node = node->next;
         /* The new point dominates the next point, remove the next point */
-        assert((node != archive->extreme1) && (node != archive->extreme2));
-      	avl_node_delete(archive->tree, node);
+        coco_archive_delete_node(archive, node);
       } else {
         break;
       }
     }
 
-    if(avl_item_insert(archive->tree, insert_item) == NULL) {
+    node = avl_item_insert(archive->tree, insert_item);
+    if (node == NULL) {
       coco_warning("Solution %s did not update the archive", text);
+      coco_archive_node_item_free(insert_item, archive);
       update = 0;
+      /* The finger might have been removed, find it again */
+      probe_item.normalized_y = (double *) normalized_y;
+      *finger = avl_item_search_right(archive->tree, &probe_item, NULL);
+    } else {
+      /* Update the hypervolume with the contributions of the new solution and the one following it */
+      archive->number_of_solutions++;
+      coco_archive_update_contribution(archive, node);
+      if (node->next != NULL)
+        coco_archive_update_contribution(archive, node->next);
+      *finger = node;
     }
 
     archive->is_up_to_date = 0;
@@ -246,43 +321,112 @@ int coco_archive_add_solution(coco_archive_t *archive, const double y1, const do
   return update;
 }
 
+int coco_archive_add_solution(coco_archive_t *archive, const double y1, const double y2, const char *text) {
+
+  coco_archive_avl_item_t probe_item;
+  avl_node_t *node;
+  double y[2], normalized_y[2];
+
+  y[0] = y1;
+  y[1] = y2;
+  mo_normalize_into(y, archive->ideal, archive->nadir, archive->scales, archive->number_of_objectives, 1,
+      normalized_y);
+
+  /* Find the first point that is not worse than the new point (NULL if such point does not exist) */
+  probe_item.normalized_y = normalized_y;
+  node = avl_item_search_right(archive->tree, &probe_item, NULL);
+
+  return coco_archive_insert(archive, &node, normalized_y, text);
+}
+
 /**
- * @brief Updates the archive fields returned by the getters.
+ * @brief A candidate solution of a batch added to the archive.
  */
-static void coco_archive_update(coco_archive_t *archive) {
+typedef struct {
+  double normalized_y[2];    /**< @brief The values of normalized objectives of this solution. */
+  size_t index;              /**< @brief The index of the solution in the batch. */
+} coco_archive_candidate_t;
+
+/**
+ * @brief Orders the candidates by the first objective, then by the second objective and then by their index
+ * in the batch (so that the first of equal solutions is kept, as when the solutions are added one by one).
+ */
+static int coco_archive_compare_candidates(const void *a, const void *b) {
+
+  const coco_archive_candidate_t *candidate1 = (const coco_archive_candidate_t *) a;
+  const coco_archive_candidate_t *candidate2 = (const coco_archive_candidate_t *) b;
+
+  if (candidate1->normalized_y[0] != candidate2->normalized_y[0])
+    return (candidate1->normalized_y[0] < candidate2->normalized_y[0]) ? -1 : 1;
+  if (candidate1->normalized_y[1] != candidate2->normalized_y[1])
+    return (candidate1->normalized_y[1] < candidate2->normalized_y[1]) ? -1 : 1;
+  if (candidate1->index != candidate2->index)
+    return (candidate1->index < candidate2->index) ? -1 : 1;
+  return 0;
+}
 
-  double hyp;
+/**
+ * The solutions are first sorted by the first objective and filtered in linear time, so that only those
+ * that are not dominated by other solutions in the batch remain. These are then merged with the archive in
+ * a single pass along the tree, which avoids searching the tree for every solution.
+ */
+size_t coco_archive_add_solutions(coco_archive_t *archive,
+                                  const size_t number_of_solutions,
+                                  const double *y,
+                                  const char **texts) {
 
-  if (!archive->is_up_to_date) {
+  coco_archive_candidate_t *candidates;
+  coco_archive_avl_item_t probe_item;
+  avl_node_t *node, *next_node;
+  size_t i, number_of_candidates = 0, number_of_updates = 0;
 
-    avl_node_t *node, *left_node;
-    coco_archive_avl_item_t *node_item, *left_node_item;
-
-    /* Updates number_of_solutions */
-
-    archive->number_of_solutions = avl_count(archive->tree);
-
-    /* Updates hypervolume */
-
-    node = archive->tree->head;
-    archive->hypervolume = 0; /* Hypervolume of the extreme point equals 0 */
-    while (node->next) {
-      /* Add hypervolume contributions of the other points that are within ROI */
-      left_node = node->next;
-      node_item = (coco_archive_avl_item_t *) node->item;
-      left_node_item = (coco_archive_avl_item_t *) left_node->item;
-      if (mo_is_within_ROI(left_node_item->normalized_y, archive->number_of_objectives)) {
-        hyp = 0;
-        if (mo_is_within_ROI(node_item->normalized_y, archive->number_of_objectives))
-          hyp = (node_item->normalized_y[0] - left_node_item->normalized_y[0]) * (1 - left_node_item->normalized_y[1]);
-        else
-          hyp = (1 - left_node_item->normalized_y[0]) * (1 - left_node_item->normalized_y[1]);
-        assert(hyp >= 0);
-         archive->hypervolume += hyp;
-      }
-      node = left_node;
+  if (number_of_solutions == 0)
+    return 0;
+
+  candidates = (coco_archive_candidate_t *) coco_allocate_memory(number_of_solutions * sizeof(*candidates));
+  for (i = 0; i < number_of_solutions; i++) {
+    mo_normalize_into(&y[2 * i], archive->ideal, archive->nadir, archive->scales, archive->number_of_objectives, 1,
+        candidates[i].normalized_y);
+    candidates[i].index = i;
+  }
+  qsort(candidates, number_of_solutions, sizeof(*candidates), coco_archive_compare_candidates);
+
+  /* Keep only the candidates not dominated by (or equal to) the previously kept one, which is the one with
+   * the best second objective among the kept candidates */
+  for (i = 0; i < number_of_solutions; i++) {
+    if ((number_of_candidates == 0) || (mo_get_dominance(candidates[i].normalized_y,
+        candidates[number_of_candidates - 1].normalized_y, archive->number_of_objectives) > -1))
+      candidates[number_of_candidates++] = candidates[i];
+  }
+
+  /* Merge the candidates with the archive in the order of the tree (by increasing last objective) */
+  node = NULL;
+  for (i = number_of_candidates; i > 0; i--) {
+    /* Move the finger to the last node that is not worse in the last objective than the candidate */
+    probe_item.normalized_y = candidates[i - 1].normalized_y;
+    next_node = (node == NULL) ? archive->tree->head : node->next;
+    while ((next_node != NULL) && (coco_archive_compare_by_last_objective(
+        (coco_archive_avl_item_t *) next_node->item, &probe_item, NULL) <= 0)) {
+      node = next_node;
+      next_node = node->next;
     }
+    number_of_updates += (size_t) coco_archive_insert(archive, &node, candidates[i - 1].normalized_y,
+        texts[candidates[i - 1].index]);
+  }
 
+  coco_free_memory(candidates);
+  return number_of_updates;
+}
+
+/**
+ * @brief Resets the iteration over the solutions if the archive has changed since the last call.
+ *
+ * The number of solutions and the hypervolume are maintained incrementally by coco_archive_add_solution()
+ * and need no updating.
+ */
+static void coco_archive_update(coco_archive_t *archive) {
+
+  if (!archive->is_up_to_date) {
     archive->is_up_to_date = 1;
     archive->current_solution = NULL;
     archive->extremes_already_returned = 0;
@@ -347,9 +491,14 @@ void coco_archive_free(coco_archive_t *archive) {
 
   assert(archive != NULL);
 
-  avl_tree_destruct(archive->tree);
+  /* The nodes, items and texts are owned by the slabs, which free them at once */
+  avl_tree_release(archive->tree);
+  mo_slab_free(archive->item_slab);
+  mo_slab_free(archive->node_slab);
+  mo_slab_free(archive->text_slab);
   coco_free_memory(archive->ideal);
   coco_free_memory(archive->nadir);
+  coco_free_memory(archive->scales);
   coco_free_memory(archive);
 
 }
@@ -57,6 +57,35 @@ typedef void (*coco_recommend_function_t)(coco_problem_t *problem, const double
  */
 typedef void (*coco_restart_function_t)(coco_problem_t *problem);
 
+/**
+ * @brief The prefetch function type.
+ *
+ * This is a template for functions that prepare the evaluation of a batch of solutions (for example, by
+ * evaluating all of them at once), so that the subsequent evaluations of these solutions are cheaper.
+ */
+typedef void (*coco_prefetch_function_t)(coco_problem_t *problem,
+                                         const double *x,
+                                         const size_t number_of_solutions);
+
+/**
+ * @brief The submit function type.
+ *
+ * This is a template for functions that start the evaluation of a solution without waiting for its
+ * result (the result is obtained by a subsequent evaluation of the same solution).
+ */
+typedef void (*coco_submit_function_t)(coco_problem_t *problem, const double *x);
+
+/**
+ * @brief A queue of solutions (see coco_evaluate_function_submit).
+ */
+typedef struct {
+  double *solutions;           /**< @brief The solutions (a circular buffer of capacity * dimension values). */
+  size_t dimension;            /**< @brief The dimension of the solutions. */
+  size_t capacity;             /**< @brief The maximal number of solutions before the buffer is enlarged. */
+  size_t first;                /**< @brief The index of the first solution in the buffer. */
+  size_t count;                /**< @brief The number of solutions in the queue. */
+} coco_solution_queue_t;
+
 /**
  * @brief The allocate logger function type.
  *
@@ -123,6 +152,23 @@ typedef struct {
 } coco_option_keys_t;
 
 
+#if defined(COCO_PROFILING)
+/**
+ * @brief The profile data type.
+ *
+ * This is a type of a structure used to aggregate the profiling information of problem layers with the
+ * same name (used by suites, see coco_problem_profile_report).
+ */
+typedef struct {
+  size_t count;        /**< @brief Number of profiled layers */
+  size_t capacity;     /**< @brief Number of layers that fit into the allocated memory */
+  char **names;        /**< @brief Names of the layers */
+  size_t *calls;       /**< @brief Numbers of evaluations of the layers */
+  double *total_times; /**< @brief Times (in ns) spent in the layers including their inner problems */
+  double *self_times;  /**< @brief Times (in ns) spent in the layers excluding their inner problems */
+} coco_profile_t;
+#endif
+
 /***********************************************************************************************************/
 
 /**
@@ -183,6 +229,20 @@ struct coco_problem_s {
   void *data;                          /**< @brief Pointer to a data instance @see coco_problem_transformed_data_t */
   
   void *versatile_data;                /* Wassim: *< @brief pointer to eventual additional data that need to be accessed all along the transformations*/
+
+  coco_solution_queue_t *submitted_solutions; /**< @brief Solutions submitted for evaluation that have not been
+                                              collected yet (NULL if none were submitted). */
+
+#if defined(COCO_PROFILING)
+  /* Fields used for profiling (see coco_set_profiling) */
+
+  size_t profile_calls;                /**< @brief Number of profiled evaluations of this problem (layer). */
+  double profile_time;                 /**< @brief Time (in ns) spent in the profiled evaluations. */
+  double profile_inner_time;           /**< @brief Time (in ns) spent in the profiled evaluations of the inner
+                                       problems. */
+  coco_problem_t *profile_inner;       /**< @brief The first inner problem evaluated by this problem. */
+  char *profile_name;                  /**< @brief Name of the layer (the name prefix of transformed problems). */
+#endif
 };
 
 /**
@@ -211,6 +271,7 @@ struct coco_observer_s {
   int precision_f;              /**< @brief Output precision for function values. */
   int precision_g;              /**< @brief Output precision for constraint values. */
   int log_discrete_as_int;      /**< @brief Whether to output discrete variables in int or double format. */
+  int is_tracing;               /**< @brief Whether the observer has started tracing the experiment timeline. */
   void *data;                   /**< @brief Void pointer that can be used to point to data specific to an observer. */
 
   coco_data_free_function_t data_free_function;             /**< @brief  The function for freeing this observer. */
@@ -252,6 +313,15 @@ struct coco_suite_s {
 
   coco_data_free_function_t data_free_function; /**< @brief The function for freeing this suite. */
 
+  coco_prefetch_function_t prefetch_function;   /**< @brief The function for prefetching evaluations
+                                                     of a batch of solutions (can be NULL). */
+
+  coco_submit_function_t submit_function;       /**< @brief The function for starting the evaluation of a
+                                                     solution without waiting for the result (can be NULL). */
+
+#if defined(COCO_PROFILING)
+  coco_profile_t *profile;         /**< @brief Profiling information aggregated over the suite's problems. */
+#endif
 };
 
 static void bbob_evaluate_gradient(coco_problem_t *problem, const double *x, double *y);
@@ -5,6 +5,7 @@
 
 #include "coco.h"
 #include "coco_internal.h"
+#include "coco_trace.c"
 #include <limits.h>
 #include <float.h>
 #include <math.h>
@@ -24,6 +25,11 @@ typedef struct {
   size_t number_of_triggers;  /**< @brief Number of target triggers between 10**i and 10**(i+1) for any i. */
   double precision;           /**< @brief Minimal precision of interest. */
 
+  int zero_exponent;          /**< @brief Exponent of the target corresponding to the value 0. */
+  double upper_threshold;     /**< @brief Nonnegative values larger than this cannot trigger logging. */
+  double lower_threshold;     /**< @brief Negative values with absolute values smaller than this cannot
+                                   trigger logging. */
+
 } coco_observer_log_targets_t;
 
 /**
@@ -61,22 +67,21 @@ typedef struct {
  * The numbers of evaluations that trigger logging are any of the two:
  * - every 10**(exponent1/number_of_triggers) for exponent1 >= 0
  * - every base_evaluation * dimension * (10**exponent2) for exponent2 >= 0
+ *
+ * Both sequences are precomputed when the structure is created, so that checking whether an evaluation
+ * number triggers logging amounts to a comparison with the next value in each sequence.
  */
 typedef struct {
 
   /* First trigger */
-  size_t value1;              /**< @brief The next value for the first trigger. */
-  size_t exponent1;           /**< @brief Exponent used to compute the first trigger. */
-  size_t number_of_triggers;  /**< @brief Number of target triggers between 10**i and 10**(i+1) for any i. */
+  size_t *values1;            /**< @brief The precomputed values of the first trigger. */
+  size_t count1;              /**< @brief The number of precomputed values of the first trigger. */
+  size_t index1;              /**< @brief The index of the next value of the first trigger. */
 
   /* Second trigger */
-  size_t value2;              /**< @brief The next value for the second trigger. */
-  size_t exponent2;           /**< @brief Exponent used to compute the second trigger. */
-  size_t *base_evaluations;   /**< @brief The base evaluation numbers used to compute the actual evaluation
-                                   numbers that trigger logging. */
-  size_t base_count;          /**< @brief The number of base evaluations. */
-  size_t base_index;          /**< @brief The next index of the base evaluations. */
-  size_t dimension;           /**< @brief Dimension used in the calculation of the first trigger. */
+  size_t *values2;            /**< @brief The precomputed values of the second trigger. */
+  size_t count2;              /**< @brief The number of precomputed values of the second trigger. */
+  size_t index2;              /**< @brief The index of the next value of the second trigger. */
 
 } coco_observer_evaluations_t;
 
@@ -88,6 +93,14 @@ typedef struct {
  */
 #define COCO_MAX_EVALS_TO_LOG 1000
 
+/**
+ * @brief The relative tolerance used by logarithmic target triggers to decide (without computing any
+ * logarithms) that a value cannot hit the next target.
+ *
+ * Values closer to the next target than this are checked exactly.
+ */
+#define COCO_LOG_TARGETS_TOLERANCE 1e-9
+
 /***********************************************************************************************************/
 
 /**
@@ -95,15 +108,66 @@ typedef struct {
  */
 /**@{*/
 
+/**
+ * @brief Returns the target value 10**(exponent/number_of_triggers).
+ */
+static double coco_observer_log_targets_get_power(const coco_observer_log_targets_t *log_targets,
+                                                  const int exponent) {
+
+  const double number_of_targets_double = (double) (long) log_targets->number_of_triggers;
+
+  return pow(10, (double) exponent / number_of_targets_double);
+}
+
+/**
+ * @brief Updates the thresholds used to quickly decide whether a value can trigger logging (called only
+ * when a target is hit).
+ *
+ * A nonnegative value triggers logging only if it is at most 10**((exponent - 1)/number_of_triggers),
+ * while a negative value triggers logging only if its absolute value is at least
+ * 10**((2 * zero_exponent - exponent)/number_of_triggers) (see coco_observer_log_targets_trigger). The
+ * thresholds are moved away from these values by COCO_LOG_TARGETS_TOLERANCE, so that values close to the
+ * next target are still checked exactly.
+ */
+static void coco_observer_log_targets_update_thresholds(coco_observer_log_targets_t *log_targets) {
+
+  double threshold;
+
+  if (log_targets->exponent == INT_MAX) {
+    /* No target has been hit yet */
+    log_targets->upper_threshold = INFINITY;
+    log_targets->lower_threshold = 0;
+    return;
+  }
+
+  if (log_targets->exponent - 1 < log_targets->zero_exponent) {
+    /* No nonnegative value can trigger logging */
+    log_targets->upper_threshold = -1;
+  } else {
+    log_targets->upper_threshold = coco_observer_log_targets_get_power(log_targets,
+        log_targets->exponent - 1) * (1 + COCO_LOG_TARGETS_TOLERANCE);
+  }
+
+  threshold = coco_observer_log_targets_get_power(log_targets,
+      2 * log_targets->zero_exponent - log_targets->exponent) * (1 - COCO_LOG_TARGETS_TOLERANCE);
+  /* Negative values are never checked with a higher precision than log_targets->precision */
+  log_targets->lower_threshold = (threshold > log_targets->precision) ? threshold : 0;
+}
+
 /**
  * @brief Creates and returns a structure containing information on logarithmic targets.
  *
+ * @note The coco_observer_log_targets_t object instances need to be freed using the
+ * coco_observer_log_targets_free function!
+ *
  * @param number_of_targets The number of targets between 10**i and 10**(i+1) for each i.
  * @param precision Minimal precision of interest.
  */
 static coco_observer_log_targets_t *coco_observer_log_targets(const size_t number_of_targets,
                                                               const double precision) {
 
+  const double number_of_targets_double = (double) (long) number_of_targets;
+
   coco_observer_log_targets_t *log_targets =
       (coco_observer_log_targets_t *) coco_allocate_memory(sizeof(*log_targets));
   log_targets->exponent = INT_MAX;
@@ -111,11 +175,17 @@ static coco_observer_log_targets_t *coco_observer_log_targets(const size_t numbe
   log_targets->number_of_triggers = number_of_targets;
   log_targets->precision = precision;
 
+  log_targets->zero_exponent = (int) (ceil(log10(precision / 10.0) * number_of_targets_double));
+  coco_observer_log_targets_update_thresholds(log_targets);
+
   return log_targets;
 }
 
 /**
  * @brief Computes and returns whether the given value should trigger logging.
+ *
+ * Most values are discarded by a single comparison with the thresholds of the next target, only the
+ * remaining ones are checked by computing their exponents.
  */
 static int coco_observer_log_targets_trigger(coco_observer_log_targets_t *log_targets,
                                              const double given_value) {
@@ -130,6 +200,14 @@ static int coco_observer_log_targets_trigger(coco_observer_log_targets_t *log_ta
 
   assert(log_targets != NULL);
 
+  /* Quick checks that cover the majority of values */
+  if (given_value >= 0) {
+    if (given_value > log_targets->upper_threshold)
+      return 0;
+  } else if (-given_value < log_targets->lower_threshold) {
+    return 0;
+  }
+
   /* The given_value is positive or zero */
   if (given_value >= 0) {
 
@@ -151,7 +229,7 @@ static int coco_observer_log_targets_trigger(coco_observer_log_targets_t *log_ta
       if (given_value == 0)
       	log_targets->value = 0;
       else
-      	log_targets->value = pow(10, (double) current_exponent / number_of_targets_double);
+      	log_targets->value = coco_observer_log_targets_get_power(log_targets, current_exponent);
       activate_trigger = 1;
     }
   }
@@ -171,20 +249,31 @@ static int coco_observer_log_targets_trigger(coco_observer_log_targets_t *log_ta
     /* Compute the adjusted_exponent in such a way, that it is always diminishing in value. The adjusted
      * exponent can only be used to verify if a new target has been hit. To compute the actual target
      * value, the current_exponent needs to be used. */
-    adjusted_exponent = 2 * (int) (ceil(log10(log_targets->precision / 10.0) * number_of_targets_double))
-        - current_exponent - 1;
+    adjusted_exponent = 2 * log_targets->zero_exponent - current_exponent - 1;
 
     if (adjusted_exponent < log_targets->exponent) {
       /* Update the target information */
       log_targets->exponent = adjusted_exponent;
-      log_targets->value = - pow(10, (double) current_exponent / number_of_targets_double);
+      log_targets->value = - coco_observer_log_targets_get_power(log_targets, current_exponent);
       activate_trigger = 1;
     }
   }
 
+  if (activate_trigger)
+    coco_observer_log_targets_update_thresholds(log_targets);
+
   return activate_trigger;
 }
 
+/**
+ * @brief Frees the given log_targets object.
+ */
+static void coco_observer_log_targets_free(coco_observer_log_targets_t *log_targets) {
+
+  assert(log_targets != NULL);
+  coco_free_memory(log_targets);
+}
+
 /**
  * @brief Creates and returns a structure containing information on linear targets.
  *
@@ -292,7 +381,7 @@ static void coco_observer_targets_free(coco_observer_targets_t *targets) {
   assert(targets != NULL);
   if (targets->use_linear)
     coco_free_memory(targets->lin_targets);
-  coco_free_memory(targets->log_targets);
+  coco_observer_log_targets_free(targets->log_targets);
   coco_free_memory(targets);
 }
 
@@ -312,6 +401,9 @@ static void coco_observer_targets_free(coco_observer_targets_t *targets) {
  * - every 10**(exponent1/number_of_triggers) for exponent1 >= 0
  * - every base_evaluation * dimension * (10**exponent2) for exponent2 >= 0
  *
+ * Both sequences of evaluation numbers are precomputed up to the largest evaluation number that can be
+ * safely represented.
+ *
  * @note The coco_observer_evaluations_t object instances need to be freed using the
  * coco_observer_evaluations_free function!
  *
@@ -322,23 +414,60 @@ static void coco_observer_targets_free(coco_observer_targets_t *targets) {
 static coco_observer_evaluations_t *coco_observer_evaluations(const char *base_evaluations,
                                                               const size_t dimension) {
 
+  const size_t number_of_triggers = 20;
+  const double max_value = (double) ((size_t) -1) / 10.0;
+  /* The number of powers of 10 smaller than max_value (bounds the number of precomputed values) */
+  const size_t number_of_decades = (size_t) ceil(log10(max_value)) + 1;
+  size_t *base_evaluations_parsed, base_count, base_index;
+  size_t exponent;
+  double next_value;
+
   coco_observer_evaluations_t *evaluations = (coco_observer_evaluations_t *) coco_allocate_memory(
       sizeof(*evaluations));
 
   /* First trigger */
-  evaluations->value1 = 1;
-  evaluations->exponent1 = 0;
-  evaluations->number_of_triggers = 20;
+  evaluations->values1 = coco_allocate_memory(number_of_decades * number_of_triggers * sizeof(size_t));
+  evaluations->values1[0] = 1;
+  evaluations->count1 = 1;
+  evaluations->index1 = 0;
+  exponent = 0;
+  for (;;) {
+    /* Compute the next value for the first trigger */
+    while (floor(pow(10, (double) exponent / (double) number_of_triggers)) <=
+        (double) evaluations->values1[evaluations->count1 - 1]) {
+      exponent++;
+    }
+    next_value = floor(pow(10, (double) exponent / (double) number_of_triggers));
+    if (next_value > max_value)
+      break;
+    evaluations->values1[evaluations->count1++] = coco_double_to_size_t(next_value);
+  }
 
   /* Second trigger */
-  evaluations->base_evaluations = coco_string_parse_ranges(base_evaluations, 1, 0, "base_evaluations",
+  base_evaluations_parsed = coco_string_parse_ranges(base_evaluations, 1, 0, "base_evaluations",
       COCO_MAX_EVALS_TO_LOG);
-  evaluations->dimension = dimension;
-  evaluations->base_count = coco_count_numbers(evaluations->base_evaluations, COCO_MAX_EVALS_TO_LOG,
-      "base_evaluations");
-  evaluations->base_index = 0;
-  evaluations->value2 = dimension * evaluations->base_evaluations[0];
-  evaluations->exponent2 = 0;
+  base_count = coco_count_numbers(base_evaluations_parsed, COCO_MAX_EVALS_TO_LOG, "base_evaluations");
+  evaluations->values2 = coco_allocate_memory(number_of_decades * base_count * sizeof(size_t));
+  evaluations->values2[0] = dimension * base_evaluations_parsed[0];
+  evaluations->count2 = 1;
+  evaluations->index2 = 0;
+  base_index = 0;
+  exponent = 0;
+  for (;;) {
+    /* Compute the next value for the second trigger */
+    if (base_index < base_count - 1) {
+      base_index++;
+    } else {
+      base_index = 0;
+      exponent++;
+    }
+    next_value = pow(10, (double) exponent) * (double) (long) dimension
+        * (double) (long) base_evaluations_parsed[base_index];
+    if ((next_value > max_value) || (evaluations->count2 == number_of_decades * base_count))
+      break;
+    evaluations->values2[evaluations->count2++] = coco_double_to_size_t(next_value);
+  }
+  coco_free_memory(base_evaluations_parsed);
 
   return evaluations;
 }
@@ -347,7 +476,7 @@ static coco_observer_evaluations_t *coco_observer_evaluations(const char *base_e
  * @brief Computes and returns whether the given evaluation number triggers the first condition of the
  * logging based on the number of evaluations.
  *
- * The second condition is:
+ * The first condition is:
  * evaluation_number == 10**(exponent1/number_of_triggers)
  */
 static int coco_observer_evaluations_trigger_first(coco_observer_evaluations_t *evaluations,
@@ -355,12 +484,9 @@ static int coco_observer_evaluations_trigger_first(coco_observer_evaluations_t *
 
   assert(evaluations != NULL);
 
-  if (evaluation_number >= evaluations->value1) {
-    /* Compute the next value for the first trigger */
-    while (coco_double_to_size_t(floor(pow(10, (double) evaluations->exponent1 / (double) evaluations->number_of_triggers)) <= evaluations->value1)) {
-      evaluations->exponent1++;
-    }
-    evaluations->value1 = coco_double_to_size_t(floor(pow(10, (double) evaluations->exponent1 / (double) evaluations->number_of_triggers)));
+  if ((evaluations->index1 < evaluations->count1) &&
+      (evaluation_number >= evaluations->values1[evaluations->index1])) {
+    evaluations->index1++;
     return 1;
   }
   return 0;
@@ -378,17 +504,9 @@ static int coco_observer_evaluations_trigger_second(coco_observer_evaluations_t
 
   assert(evaluations != NULL);
 
-  if (evaluation_number >= evaluations->value2) {
-    /* Compute the next value for the second trigger */
-    if (evaluations->base_index < evaluations->base_count - 1) {
-      evaluations->base_index++;
-    } else {
-      evaluations->base_index = 0;
-      evaluations->exponent2++;
-    }
-    evaluations->value2 = coco_double_to_size_t(pow(10, (double) evaluations->exponent2)
-        * (double) (long) evaluations->dimension
-        * (double) (long) evaluations->base_evaluations[evaluations->base_index]);
+  if ((evaluations->index2 < evaluations->count2) &&
+      (evaluation_number >= evaluations->values2[evaluations->index2])) {
+    evaluations->index2++;
     return 1;
   }
   return 0;
@@ -411,13 +529,54 @@ static int coco_observer_evaluations_trigger(coco_observer_evaluations_t *evalua
   return (first + second > 0) ? 1: 0;
 }
 
+/**
+ * @brief Returns the smallest evaluation number in [first_evaluation, last_evaluation] that triggers logging
+ * and 0 if there is no such evaluation number.
+ *
+ * The triggers are updated as if coco_observer_evaluations_trigger() was called for all evaluation numbers
+ * from first_evaluation to the returned one (or to last_evaluation, if 0 is returned). Since the next
+ * trigger values are known, this takes constant time regardless of the length of the range, so that the
+ * evaluation numbers triggering logging in a range can be enumerated by repeatedly calling this function
+ * with the first_evaluation set to one more than the previously returned value.
+ */
+static size_t coco_observer_evaluations_next_trigger(coco_observer_evaluations_t *evaluations,
+                                                     const size_t first_evaluation,
+                                                     const size_t last_evaluation) {
+
+  size_t next = 0, next2;
+
+  assert(evaluations != NULL);
+  if (first_evaluation > last_evaluation)
+    return 0;
+
+  /* Each trigger fires at the first evaluation number that is not smaller than its next value */
+  if (evaluations->index1 < evaluations->count1) {
+    next = evaluations->values1[evaluations->index1];
+    if (next < first_evaluation)
+      next = first_evaluation;
+  }
+  if (evaluations->index2 < evaluations->count2) {
+    next2 = evaluations->values2[evaluations->index2];
+    if (next2 < first_evaluation)
+      next2 = first_evaluation;
+    if ((next == 0) || (next2 < next))
+      next = next2;
+  }
+  if ((next == 0) || (next > last_evaluation))
+    return 0;
+
+  coco_observer_evaluations_trigger(evaluations, next);
+  return next;
+}
+
 /**
  * @brief Frees the given evaluations object.
  */
 static void coco_observer_evaluations_free(coco_observer_evaluations_t *evaluations) {
 
   assert(evaluations != NULL);
-  coco_free_memory(evaluations->base_evaluations);
+  coco_free_memory(evaluations->values1);
+  coco_free_memory(evaluations->values2);
   coco_free_memory(evaluations);
 }
 
@@ -458,6 +617,7 @@ static coco_observer_t *coco_observer_allocate(const char *result_folder,
   observer->precision_f = precision_f;
   observer->precision_g = precision_g;
   observer->log_discrete_as_int = log_discrete_as_int;
+  observer->is_tracing = 0;
   observer->data = NULL;
   observer->data_free_function = NULL;
   observer->logger_allocate_function = NULL;
@@ -471,6 +631,8 @@ void coco_observer_free(coco_observer_t *observer) {
 
   if (observer != NULL) {
     observer->is_active = 0;
+    if (observer->is_tracing)
+      coco_trace_stop();
     if (observer->observer_name != NULL)
       coco_free_memory(observer->observer_name);
     if (observer->result_folder != NULL)
@@ -505,6 +667,7 @@ void coco_observer_free(coco_observer_t *observer) {
 #include "logger_biobj.c"
 #include "logger_toy.c"
 #include "logger_rw.c"
+#include "logger_memory.c"
 
 /**
  * Currently, four observers are supported:
@@ -515,9 +678,12 @@ void coco_observer_free(coco_observer_t *observer) {
  * - "rw" is an observer for single- and bi-objective real-world problems that logs all information (can be
  * configured to long only some information) and produces *.txt files (not readable by post-processing).
  * - "toy" is a simple observer that logs when a target has been hit.
+ * - "memory" is an observer for single-objective problems that keeps the numbers of evaluations needed to
+ * hit the targets in memory (see coco_observer_memory_get_hits) and writes no files unless the data is
+ * exported with coco_observer_memory_export.
  *
  * @param observer_name A string containing the name of the observer. Currently supported observer names are
- * "bbob", "bbob-biobj", "toy". Strings "no_observer", "" or NULL return NULL.
+ * "bbob", "bbob-biobj", "toy", "memory". Strings "no_observer", "" or NULL return NULL.
  * @param observer_options A string of pairs "key: value" used to pass the options to the observer. Some
  * observer options are general, while others are specific to some observers. Here we list only the general
  * options, see observer_bbob, observer_biobj and observer_toy for options of the specific observers.
@@ -549,6 +715,10 @@ void coco_observer_free(coco_observer_t *observer) {
  * of digits to be printed after the decimal point. The default value is 3.
  * - "log_discrete_as_int: VALUE" determines whether the values of integer variables (in mixed-integer problems)
  * are logged as integers (1) or not (0 - in this case they are logged as doubles). The default value is 0.
+ * - "trace: VALUE" determines whether the timeline of the experiment (problem construction and freeing,
+ * evaluations, logger output and socket round trips) is traced to the binary file coco_trace.bin in the
+ * result folder (1) or not (0). The file can be converted to the Chrome trace format with
+ * code-experiments/tools/coco_trace_to_json.py. The default value is 0.
  *
  * @return The constructed observer object or NULL if observer_name equals NULL, "" or "no_observer".
  */
@@ -556,7 +726,7 @@ coco_observer_t *coco_observer(const char *observer_name, const char *observer_o
 
   coco_observer_t *observer;
   char *path, *outer_folder, *result_folder, *algorithm_name, *algorithm_info;
-  int precision_x, precision_f, precision_g, log_discrete_as_int;
+  int precision_x, precision_f, precision_g, log_discrete_as_int, trace;
 
   size_t number_target_triggers;
   size_t number_evaluation_triggers;
@@ -569,7 +739,7 @@ coco_observer_t *coco_observer(const char *observer_name, const char *observer_o
    * IMPORTANT: This list should be up-to-date with the code and the documentation */
   const char *known_keys[] = { "outer_folder", "result_folder", "algorithm_name", "algorithm_info",
       "number_target_triggers", "log_target_precision", "lin_target_precision", "number_evaluation_triggers",
-      "base_evaluation_triggers", "precision_x", "precision_f", "precision_g", "log_discrete_as_int" };
+      "base_evaluation_triggers", "precision_x", "precision_f", "precision_g", "log_discrete_as_int", "trace" };
   additional_option_keys = NULL; /* To be set by the chosen observer */
 
   if (0 == strcmp(observer_name, "no_observer")) {
@@ -595,8 +765,11 @@ coco_observer_t *coco_observer(const char *observer_name, const char *observer_o
   path = coco_allocate_string(COCO_PATH_MAX + 1);
   memcpy(path, outer_folder, strlen(outer_folder) + 1);
   coco_join_path(path, COCO_PATH_MAX, result_folder, NULL);
-  coco_create_unique_directory(&path);
-  coco_info("Results will be output to folder %s", path);
+  if (0 != strcmp(observer_name, "memory")) {
+    /* The memory observer creates the folder only if its data is exported */
+    coco_create_unique_directory(&path);
+    coco_info("Results will be output to folder %s", path);
+  }
   coco_free_memory(outer_folder);
   coco_free_memory(result_folder);
 
@@ -682,6 +855,14 @@ coco_observer_t *coco_observer(const char *observer_name, const char *observer_o
     }
   }
 
+  trace = 0;
+  if (coco_options_read_int(observer_options, "trace", &trace) != 0) {
+    if ((trace < 0) || (trace > 1)) {
+      coco_warning("coco_observer(): Unsuitable observer option value (trace: %d) ignored", trace);
+      trace = 0;
+    }
+  }
+
   observer = coco_observer_allocate(path, observer_name, algorithm_name, algorithm_info,
       number_target_triggers, log_target_precision, lin_target_precision,
       number_evaluation_triggers, base_evaluation_triggers, precision_x, precision_f,
@@ -729,11 +910,22 @@ coco_observer_t *coco_observer(const char *observer_name, const char *observer_o
     observer_biobj(observer, observer_options, &additional_option_keys);
   } else if (0 == strcmp(observer_name, "rw")) {
     observer_rw(observer, observer_options, &additional_option_keys);
+  } else if (0 == strcmp(observer_name, "memory")) {
+    observer_memory(observer, observer_options, &additional_option_keys);
   } else {
     coco_warning("coco_observer(): Unknown observer %s!", observer_name);
     return NULL;
   }
 
+  if (trace) {
+    path = coco_allocate_string(COCO_PATH_MAX + 1);
+    memcpy(path, observer->result_folder, strlen(observer->result_folder) + 1);
+    coco_join_path(path, COCO_PATH_MAX, "coco_trace.bin", NULL);
+    coco_trace_start(path);
+    coco_free_memory(path);
+    observer->is_tracing = 1;
+  }
+
   /* Check for redundant option keys */
   known_option_keys = coco_option_keys_allocate(sizeof(known_keys) / sizeof(char *), known_keys);
   coco_option_keys_add(&known_option_keys, additional_option_keys);
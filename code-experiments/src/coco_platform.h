@@ -13,6 +13,13 @@
 #ifndef __COCO_PLATFORM__ 
 #define __COCO_PLATFORM__
 
+/* When compiling in strict ANSI mode (for example, with -std=c89), POSIX functions such as
+ * clock_gettime() need to be requested explicitly */
+#if defined(__STRICT_ANSI__) && !defined(_POSIX_C_SOURCE) && \
+    !(defined(_WIN32) || defined(_WIN64) || defined(__MINGW64__) || defined(__CYGWIN__))
+#define _POSIX_C_SOURCE 199309L
+#endif
+
 #include <stddef.h>
 
 /* The winsock2.h header *needs* to be included before windows.h! */
@@ -25,6 +32,12 @@
 #else
 #include <sys/socket.h>
 #include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/un.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <sched.h>
 #include <unistd.h>
 #define WINSOCK 0
 #endif
@@ -80,6 +93,7 @@ static const char *coco_path_separator = "/";
 #include <dirent.h>
 #else
 #include <dirent.h>
+#include <stdio.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -90,6 +104,8 @@ extern "C" {
 int rmdir(const char *pathname);
 int unlink(const char *file_name);
 int mkdir(const char *pathname, mode_t mode);
+int ftruncate(int fd, off_t length);
+int fileno(FILE *stream);
 /** @endcond */
 #endif
 
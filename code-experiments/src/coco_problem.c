@@ -8,6 +8,12 @@
 #include "coco_internal.h"
 
 #include "coco_utilities.c"
+#include "coco_trace.c"
+
+#if defined(COCO_PROFILING)
+static int coco_profiling_enabled = 0; /**< @brief Whether evaluations are being profiled. */
+static void coco_problem_profile_evaluate_function(coco_problem_t *problem, const double *x, double *y);
+#endif
 
 /***********************************************************************************************************/
 
@@ -31,6 +37,7 @@ void coco_evaluate_function(coco_problem_t *problem, const double *x, double *y)
   size_t i, j;
   int is_feasible;
   double *z;
+  double trace_start;
   
   assert(problem != NULL);
   assert(problem->evaluate_function != NULL);
@@ -51,8 +58,15 @@ void coco_evaluate_function(coco_problem_t *problem, const double *x, double *y)
     return;
   }
 
+  trace_start = coco_trace_begin_evaluation();
+#if defined(COCO_PROFILING)
+  if (coco_profiling_enabled)
+    coco_problem_profile_evaluate_function(problem, x, y);
+  else
+#endif
   problem->evaluate_function(problem, x, y);
   problem->evaluations++; /* each derived class has its own counter, only the most outer will be visible */
+  coco_trace_end_evaluation(COCO_TRACE_FUNCTION_EVALUATION, trace_start, (double) problem->evaluations);
 
   /* A little bit of bookkeeping */
   if (y[0] < problem->best_observed_fvalue[0]) {
@@ -69,6 +83,135 @@ void coco_evaluate_function(coco_problem_t *problem, const double *x, double *y)
   }
 }
 
+/**
+ * Evaluates the problem function in a batch of points. The points are evaluated one after another with
+ * coco_evaluate_function (so that each evaluation is counted and logged), but if the suite of the problem
+ * supports prefetching (as do the suites with external evaluation through sockets), all points are first
+ * evaluated at once (for example, in a single round trip to the external evaluator).
+ *
+ * @note Both x and y must point to correctly sized allocated memory regions.
+ *
+ * @param problem The given COCO problem.
+ * @param x The decision vectors stored one after another (number_of_solutions * dimension values).
+ * @param number_of_solutions The number of decision vectors.
+ * @param y The objective vectors that are the result of the evaluation stored one after another
+ * (number_of_solutions * number_of_objectives values).
+ */
+void coco_evaluate_function_batch(coco_problem_t *problem,
+                                  const double *x,
+                                  const size_t number_of_solutions,
+                                  double *y) {
+  size_t i, dimension, number_of_objectives;
+
+  assert(problem != NULL);
+  dimension = coco_problem_get_dimension(problem);
+  number_of_objectives = coco_problem_get_number_of_objectives(problem);
+
+  if ((number_of_solutions > 1) && (problem->suite != NULL) && (problem->suite->prefetch_function != NULL))
+    problem->suite->prefetch_function(problem, x, number_of_solutions);
+
+  for (i = 0; i < number_of_solutions; i++)
+    coco_evaluate_function(problem, x + i * dimension, y + i * number_of_objectives);
+}
+
+/**
+ * @brief Allocates an empty queue of solutions of the given dimension.
+ */
+static coco_solution_queue_t *coco_solution_queue_allocate(const size_t dimension) {
+  coco_solution_queue_t *queue = (coco_solution_queue_t *) coco_allocate_memory(sizeof(*queue));
+  queue->dimension = dimension;
+  queue->capacity = 16;
+  queue->solutions = coco_allocate_vector(queue->capacity * dimension);
+  queue->first = 0;
+  queue->count = 0;
+  return queue;
+}
+
+/**
+ * @brief Frees the queue of solutions.
+ */
+static void coco_solution_queue_free(coco_solution_queue_t *queue) {
+  coco_free_memory(queue->solutions);
+  coco_free_memory(queue);
+}
+
+/**
+ * @brief Appends a copy of x to the end of the queue (the queue is enlarged if needed).
+ */
+static void coco_solution_queue_push(coco_solution_queue_t *queue, const double *x) {
+  size_t i;
+  double *solutions;
+
+  if (queue->count == queue->capacity) {
+    solutions = coco_allocate_vector(2 * queue->capacity * queue->dimension);
+    for (i = 0; i < queue->count; i++)
+      memcpy(solutions + i * queue->dimension,
+          queue->solutions + ((queue->first + i) % queue->capacity) * queue->dimension,
+          queue->dimension * sizeof(double));
+    coco_free_memory(queue->solutions);
+    queue->solutions = solutions;
+    queue->capacity *= 2;
+    queue->first = 0;
+  }
+  memcpy(queue->solutions + ((queue->first + queue->count) % queue->capacity) * queue->dimension, x,
+      queue->dimension * sizeof(double));
+  queue->count++;
+}
+
+/**
+ * @brief Removes the first solution from the queue and saves it into x. Returns 0 if the queue is empty
+ * and 1 otherwise.
+ */
+static int coco_solution_queue_pop(coco_solution_queue_t *queue, double *x) {
+  if (queue->count == 0)
+    return 0;
+  memcpy(x, queue->solutions + queue->first * queue->dimension, queue->dimension * sizeof(double));
+  queue->first = (queue->first + 1) % queue->capacity;
+  queue->count--;
+  return 1;
+}
+
+/**
+ * Submits the point x for evaluation without waiting for the result, which is obtained by a later call
+ * to coco_evaluate_function_collect (the submitted points are collected in the same order as they were
+ * submitted). If the suite of the problem supports it (as do the suites with external evaluation through
+ * sockets using the binary protocol), the evaluation of x starts immediately, so that several evaluations
+ * can be in progress at the same time. Otherwise, x is evaluated only when it is collected.
+ *
+ * @note The evaluation is counted and logged only when the point is collected.
+ *
+ * @param problem The given COCO problem.
+ * @param x The decision vector.
+ */
+void coco_evaluate_function_submit(coco_problem_t *problem, const double *x) {
+  assert(problem != NULL);
+  if (problem->submitted_solutions == NULL)
+    problem->submitted_solutions = coco_solution_queue_allocate(coco_problem_get_dimension(problem));
+  coco_solution_queue_push(problem->submitted_solutions, x);
+
+  if ((problem->suite != NULL) && (problem->suite->submit_function != NULL))
+    problem->suite->submit_function(problem, x);
+}
+
+/**
+ * Evaluates (as coco_evaluate_function) the earliest point submitted with coco_evaluate_function_submit
+ * that has not been collected yet.
+ *
+ * @note Both x and y must point to correctly sized allocated memory regions.
+ *
+ * @param problem The given COCO problem.
+ * @param x The decision vector of the collected point.
+ * @param y The objective vector that is the result of the evaluation.
+ * @return 1 if a point was collected and 0 if there are no submitted points to collect.
+ */
+int coco_evaluate_function_collect(coco_problem_t *problem, double *x, double *y) {
+  assert(problem != NULL);
+  if ((problem->submitted_solutions == NULL) || !coco_solution_queue_pop(problem->submitted_solutions, x))
+    return 0;
+  coco_evaluate_function(problem, x, y);
+  return 1;
+}
+
 /**
  * Evaluates the problem constraint.
  * 
@@ -84,6 +227,7 @@ void coco_evaluate_constraint_optional_update(coco_problem_t *problem,
                                               int update_counter) {
   /* implements a safer version of problem->evaluate(problem, x, y) */
   size_t i, j;
+  double trace_start;
   assert(problem != NULL);
   if (problem->evaluate_constraint == NULL) {
     coco_error("coco_evaluate_constraint_optional_update(): No constraint function implemented for problem %s",
@@ -106,9 +250,12 @@ void coco_evaluate_constraint_optional_update(coco_problem_t *problem,
     return;
   }
   
+  trace_start = coco_trace_begin_evaluation();
   problem->evaluate_constraint(problem, x, y, update_counter);
   if (update_counter)
     problem->evaluations_constraints++;
+  coco_trace_end_evaluation(COCO_TRACE_CONSTRAINT_EVALUATION, trace_start,
+      (double) problem->evaluations_constraints);
 
 }
 
@@ -203,6 +350,14 @@ static coco_problem_t *coco_problem_allocate(const size_t number_of_variables,
   problem->suite_dep_instance = 0;
   problem->data = NULL;
   problem->versatile_data = NULL; /* Wassim: added to be able to pass data from one transformation to another*/
+  problem->submitted_solutions = NULL;
+#if defined(COCO_PROFILING)
+  problem->profile_calls = 0;
+  problem->profile_time = 0;
+  problem->profile_inner_time = 0;
+  problem->profile_inner = NULL;
+  problem->profile_name = NULL;
+#endif
   return problem;
 }
 
@@ -320,6 +475,13 @@ void coco_problem_free(coco_problem_t *problem) {
       coco_free_memory(problem->data);
     if (problem->initial_solution != NULL)
       coco_free_memory(problem->initial_solution);
+    if (problem->submitted_solutions != NULL)
+      coco_solution_queue_free(problem->submitted_solutions);
+#if defined(COCO_PROFILING)
+    if (problem->profile_name != NULL)
+      coco_free_memory(problem->profile_name);
+    problem->profile_name = NULL;
+#endif
     problem->smallest_values_of_interest = NULL;
     problem->largest_values_of_interest = NULL;
     problem->best_parameter = NULL;
@@ -328,6 +490,7 @@ void coco_problem_free(coco_problem_t *problem) {
     problem->suite = NULL;
     problem->data = NULL;
     problem->initial_solution = NULL;
+    problem->submitted_solutions = NULL;
     coco_free_memory(problem);
   }
 }
@@ -799,6 +962,9 @@ static coco_problem_t *coco_problem_transformed_allocate(coco_problem_t *inner_p
 
   coco_problem_set_name(inner_copy, "%s(%s)", name_prefix, old_name);
   coco_free_memory(old_name);
+#if defined(COCO_PROFILING)
+  inner_copy->profile_name = coco_strdup(name_prefix);
+#endif
 
   return inner_copy;
 }
@@ -886,22 +1052,58 @@ static void coco_problem_stacked_free(coco_problem_t *problem) {
   coco_problem_free(problem);
 }
 
+/**
+ * @brief Updates the nadir values of the given problem with its objective values in the optima of the
+ * single-objective components of the source problem.
+ *
+ * The components of a multi-objective source problem can only be found if it is a stacked problem, other
+ * multi-objective source problems cause an error (the nadir values would otherwise remain undefined).
+ */
+static void coco_problem_stacked_update_nadir(coco_problem_t *problem,
+                                              const coco_problem_t *source,
+                                              double *nadir_value) {
+  coco_problem_stacked_data_t *data;
+  double *y;
+  size_t i;
+
+  if (source->number_of_objectives == 1) {
+    assert(source->best_parameter != NULL);
+    y = coco_allocate_vector(problem->number_of_objectives);
+    coco_evaluate_function(problem, source->best_parameter, y);
+    for (i = 0; i < problem->number_of_objectives; i++) {
+      if (y[i] > nadir_value[i])
+        nadir_value[i] = y[i];
+    }
+    coco_free_memory(y);
+  } else if (source->problem_free_function == coco_problem_stacked_free) {
+    data = (coco_problem_stacked_data_t *) source->data;
+    coco_problem_stacked_update_nadir(problem, data->problem1, nadir_value);
+    coco_problem_stacked_update_nadir(problem, data->problem2, nadir_value);
+  } else {
+    coco_error("coco_problem_stacked_update_nadir(): cannot compute the nadir values of problem '%s' from "
+        "problem '%s' with %lu objectives that is not a stacked problem", problem->problem_id,
+        source->problem_id, (unsigned long) source->number_of_objectives);
+  }
+}
+
 /**
  * @brief Allocates a problem constructed by stacking two COCO problems.
  * 
  * This is particularly useful for generating multi-objective problems, e.g. a bi-objective problem from two
  * single-objective problems. The stacked problem must behave like a normal COCO problem accepting the same
- * input.
+ * input. Stacking stacked problems yields problems with more than two objectives.
  *
  * @note Regions of interest in the decision space must either agree or at least one of them must be NULL.
- * @note Best parameter becomes somewhat meaningless, but the nadir value make sense now.
+ * @note Best parameter becomes somewhat meaningless, but the nadir value make sense now. The nadir value of
+ * each objective is its largest value in the optima of the single-objective problems from the other stacked
+ * problem (and the nadir value of the stacked problem it comes from, if any).
  */
 static coco_problem_t *coco_problem_stacked_allocate(coco_problem_t *problem1, 
                                                      coco_problem_t *problem2,
                                                      const double *smallest_values_of_interest,
                                                      const double *largest_values_of_interest) {
 
-  size_t number_of_variables, number_of_objectives, number_of_constraints;
+  size_t number_of_variables, number_of_objectives, number_of_objectives1, number_of_constraints;
   size_t i;
   char *s;
   coco_problem_stacked_data_t *data;
@@ -957,10 +1159,19 @@ static coco_problem_t *coco_problem_stacked_allocate(coco_problem_t *problem1,
     /* Compute the ideal and nadir values */
     assert(problem->nadir_value);
     
-    problem->best_value[0] = problem1->best_value[0];
-    problem->best_value[1] = problem2->best_value[0];
-    coco_evaluate_function(problem1, problem2->best_parameter, &problem->nadir_value[0]);
-    coco_evaluate_function(problem2, problem1->best_parameter, &problem->nadir_value[1]);
+    number_of_objectives1 = coco_problem_get_number_of_objectives(problem1);
+    for (i = 0; i < number_of_objectives; i++) {
+      if (i < number_of_objectives1) {
+        problem->best_value[i] = problem1->best_value[i];
+        problem->nadir_value[i] = (number_of_objectives1 > 1) ? problem1->nadir_value[i] : -DBL_MAX;
+      } else {
+        problem->best_value[i] = problem2->best_value[i - number_of_objectives1];
+        problem->nadir_value[i] = (number_of_objectives > number_of_objectives1 + 1) ?
+            problem2->nadir_value[i - number_of_objectives1] : -DBL_MAX;
+      }
+    }
+    coco_problem_stacked_update_nadir(problem1, problem2, &problem->nadir_value[0]);
+    coco_problem_stacked_update_nadir(problem2, problem1, &problem->nadir_value[number_of_objectives1]);
     
   }
 
@@ -977,3 +1188,220 @@ static coco_problem_t *coco_problem_stacked_allocate(coco_problem_t *problem1,
 /**@}*/
 
 /***********************************************************************************************************/
+
+/**
+ * @name Methods regarding profiling
+ *
+ * When COCO is compiled with COCO_PROFILING defined and profiling is turned on using coco_set_profiling, the
+ * number of evaluations and the time spent in each layer of the problem "onion" (transformations, raw
+ * functions and loggers) are recorded. The layers are discovered while evaluating, so that even problems
+ * without the coco_problem_transformed_data_t structure (raw functions, stacked problems) are included.
+ * Without COCO_PROFILING, no profiling code is compiled in.
+ */
+/**@{*/
+
+int coco_set_profiling(const int enabled) {
+#if defined(COCO_PROFILING)
+  int previous = coco_profiling_enabled;
+  coco_profiling_enabled = enabled;
+  return previous;
+#else
+  if (enabled)
+    coco_warning("coco_set_profiling(): COCO needs to be compiled with COCO_PROFILING defined to enable profiling");
+  return 0;
+#endif
+}
+
+#if defined(COCO_PROFILING)
+
+/**
+ * @brief The problem whose evaluation is currently being profiled (NULL when none).
+ */
+static coco_problem_t *coco_profiling_current_problem = NULL;
+
+/**
+ * @brief Evaluates the problem function and records the number of evaluations and the time spent in this
+ * problem and its inner problems.
+ */
+static void coco_problem_profile_evaluate_function(coco_problem_t *problem, const double *x, double *y) {
+
+  coco_problem_t *outer_problem = coco_profiling_current_problem;
+  double start, elapsed;
+
+  coco_profiling_current_problem = problem;
+  start = coco_get_time_ns();
+  problem->evaluate_function(problem, x, y);
+  elapsed = coco_get_time_ns() - start;
+  coco_profiling_current_problem = outer_problem;
+
+  problem->profile_calls++;
+  problem->profile_time += elapsed;
+  if (outer_problem != NULL) {
+    outer_problem->profile_inner_time += elapsed;
+    if (outer_problem->profile_inner == NULL)
+      outer_problem->profile_inner = problem;
+  }
+}
+
+/**
+ * @brief Returns the name of the given problem layer.
+ */
+static const char *coco_problem_profile_get_name(const coco_problem_t *problem) {
+  if (problem->profile_name != NULL)
+    return problem->profile_name;
+  if (problem->problem_name != NULL)
+    return problem->problem_name;
+  return "unknown";
+}
+
+/**
+ * @brief Outputs the header of the profiling report to the given file.
+ */
+static void coco_profile_output_header(FILE *file, const char *title) {
+  fprintf(file, "%s\n", title);
+  fprintf(file, "%-40s %12s %14s %14s %8s\n", "layer", "calls", "total time (s)", "self time (s)",
+      "self (%)");
+}
+
+/**
+ * @brief Outputs one line of the profiling report to the given file.
+ */
+static void coco_profile_output_line(FILE *file,
+                                     const char *name,
+                                     const size_t calls,
+                                     const double total_time,
+                                     const double self_time,
+                                     const double all_time) {
+  fprintf(file, "%-40s %12lu %14.6e %14.6e %8.2f\n", name, (unsigned long) calls, total_time / 1e9,
+      self_time / 1e9, (all_time > 0) ? 100 * self_time / all_time : 0);
+}
+
+/**
+ * @brief Adds the profiling information of all layers of the given problem to the profile.
+ *
+ * Layers with the same name are aggregated.
+ */
+static void coco_profile_add_problem(coco_profile_t *profile, const coco_problem_t *problem) {
+
+  size_t i;
+  const char *name;
+
+  for (; problem != NULL; problem = problem->profile_inner) {
+    if (problem->profile_calls == 0)
+      continue;
+    name = coco_problem_profile_get_name(problem);
+    for (i = 0; i < profile->count; i++) {
+      if (strcmp(profile->names[i], name) == 0)
+        break;
+    }
+    if (i == profile->count) {
+      if (profile->count == profile->capacity) {
+        /* Double the allocated memory */
+        size_t new_capacity = (profile->capacity == 0) ? 16 : 2 * profile->capacity;
+        char **names = (char **) coco_allocate_memory(new_capacity * sizeof(char *));
+        size_t *calls = coco_allocate_vector_size_t(new_capacity);
+        double *total_times = coco_allocate_vector(new_capacity);
+        double *self_times = coco_allocate_vector(new_capacity);
+        if (profile->count > 0) {
+          memcpy(names, profile->names, profile->count * sizeof(char *));
+          memcpy(calls, profile->calls, profile->count * sizeof(size_t));
+          memcpy(total_times, profile->total_times, profile->count * sizeof(double));
+          memcpy(self_times, profile->self_times, profile->count * sizeof(double));
+          coco_free_memory(profile->names);
+          coco_free_memory(profile->calls);
+          coco_free_memory(profile->total_times);
+          coco_free_memory(profile->self_times);
+        }
+        profile->names = names;
+        profile->calls = calls;
+        profile->total_times = total_times;
+        profile->self_times = self_times;
+        profile->capacity = new_capacity;
+      }
+      profile->names[i] = coco_strdup(name);
+      profile->calls[i] = 0;
+      profile->total_times[i] = 0;
+      profile->self_times[i] = 0;
+      profile->count++;
+    }
+    profile->calls[i] += problem->profile_calls;
+    profile->total_times[i] += problem->profile_time;
+    profile->self_times[i] += problem->profile_time - problem->profile_inner_time;
+  }
+}
+
+/**
+ * @brief Allocates an empty profile.
+ */
+static coco_profile_t *coco_profile_allocate(void) {
+  coco_profile_t *profile = (coco_profile_t *) coco_allocate_memory(sizeof(*profile));
+  profile->count = 0;
+  profile->capacity = 0;
+  profile->names = NULL;
+  profile->calls = NULL;
+  profile->total_times = NULL;
+  profile->self_times = NULL;
+  return profile;
+}
+
+/**
+ * @brief Outputs the aggregated profile to the given file.
+ */
+static void coco_profile_output(const coco_profile_t *profile, FILE *file, const char *title) {
+
+  size_t i;
+  double all_time = 0;
+
+  for (i = 0; i < profile->count; i++)
+    all_time += profile->self_times[i];
+  coco_profile_output_header(file, title);
+  for (i = 0; i < profile->count; i++)
+    coco_profile_output_line(file, profile->names[i], profile->calls[i], profile->total_times[i],
+        profile->self_times[i], all_time);
+}
+
+/**
+ * @brief Frees the given profile.
+ */
+static void coco_profile_free(coco_profile_t *profile) {
+
+  size_t i;
+
+  for (i = 0; i < profile->count; i++)
+    coco_free_memory(profile->names[i]);
+  if (profile->capacity > 0) {
+    coco_free_memory(profile->names);
+    coco_free_memory(profile->calls);
+    coco_free_memory(profile->total_times);
+    coco_free_memory(profile->self_times);
+  }
+  coco_free_memory(profile);
+}
+
+#endif
+
+/**
+ * The report contains a line for each layer of the problem (from the outermost to the innermost one) with
+ * the number of evaluations, the total time spent in the layer (including the time spent in its inner
+ * layers) and the self time (excluding the time spent in its inner layers). For layers that evaluate
+ * more than one inner problem (such as stacked problems), only the first inner problem is followed.
+ *
+ * @param problem The given COCO problem.
+ * @param file The file to which the report is output.
+ */
+void coco_problem_profile_report(const coco_problem_t *problem, FILE *file) {
+#if defined(COCO_PROFILING)
+  const coco_problem_t *layer;
+
+  coco_profile_output_header(file, coco_problem_get_id(problem));
+  for (layer = problem; layer != NULL; layer = layer->profile_inner) {
+    coco_profile_output_line(file, coco_problem_profile_get_name(layer), layer->profile_calls,
+        layer->profile_time, layer->profile_time - layer->profile_inner_time, problem->profile_time);
+  }
+#else
+  (void) problem; /* To silence the compiler */
+  (void) file; /* To silence the compiler */
+  coco_warning("coco_problem_profile_report(): COCO needs to be compiled with COCO_PROFILING defined to enable profiling");
+#endif
+}
+/**@}*/
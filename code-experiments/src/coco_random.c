@@ -6,6 +6,8 @@
  * eventually be fixed.
  */
 
+#include "coco_platform.h"
+
 #include <math.h>
 
 #include "coco.h"
@@ -14,6 +14,7 @@
 #include "coco.h"
 #include "coco_internal.h"
 #include "coco_utilities.c"
+#include "coco_trace.c"
 #include "suite_bbob.c"
 #include "suite_bbob_mixint.c"
 #include "suite_biobj.c"
@@ -47,7 +48,7 @@ static coco_suite_t *coco_suite_intialize(const char *suite_name, const char *su
     suite = suite_bbob_initialize();
   } else if ((strcmp(suite_name, "bbob-biobj") == 0) ||
       (strcmp(suite_name, "bbob-biobj-ext") == 0)) {
-    suite = suite_biobj_initialize(suite_name);
+    suite = suite_biobj_initialize(suite_name, suite_options);
   } else if (strcmp(suite_name, "bbob-largescale") == 0) {
     suite = suite_largescale_initialize();
   } else if (strcmp(suite_name, "bbob-constrained") == 0) {
@@ -55,7 +56,7 @@ static coco_suite_t *coco_suite_intialize(const char *suite_name, const char *su
   } else if (strcmp(suite_name, "bbob-mixint") == 0) {
     suite = suite_bbob_mixint_initialize(suite_name);
   } else if (strcmp(suite_name, "bbob-biobj-mixint") == 0) {
-    suite = suite_biobj_mixint_initialize();
+    suite = suite_biobj_mixint_initialize(suite_options);
   } else if (strcmp(suite_name, "toy-socket") == 0) {
     suite = suite_toy_socket_initialize(suite_options);
   } else if (strcmp(suite_name, "toy-socket-biobj") == 0) {
@@ -294,6 +295,12 @@ static coco_suite_t *coco_suite_allocate(const char *suite_name,
   /* To be set in particular suites if needed */
   suite->data = NULL;
   suite->data_free_function = NULL;
+  suite->prefetch_function = NULL;
+  suite->submit_function = NULL;
+
+#if defined(COCO_PROFILING)
+  suite->profile = coco_profile_allocate();
+#endif
 
   return suite;
 }
@@ -423,6 +430,16 @@ void coco_suite_free(coco_suite_t *suite) {
 
   if (suite != NULL) {
 
+#if defined(COCO_PROFILING)
+    /* Output the profiling information aggregated over all problems of the suite */
+    if (suite->current_problem)
+      coco_profile_add_problem(suite->profile, suite->current_problem);
+    if (suite->profile->count > 0)
+      coco_profile_output(suite->profile, stdout, suite->suite_name);
+    coco_profile_free(suite->profile);
+    suite->profile = NULL;
+#endif
+
     if (suite->suite_name) {
       coco_free_memory(suite->suite_name);
       suite->suite_name = NULL;
@@ -670,6 +687,9 @@ static int coco_suite_is_next_dimension_found(coco_suite_t *suite) {
  * in the suite, and
  * - "instance_indices: VALUES", where VALUES is a list or a range of instance indices (starting from 1) to keep
  * in the suite.
+ * The bi-objective suites ("bbob-biobj", "bbob-biobj-ext" and "bbob-biobj-mixint") also support the option
+ * "instance_cache: PATH", where PATH is a file that stores the instances created for instance numbers that
+ * are not precomputed, so that they need to be searched for only once (see suite_biobj_get_new_instance()).
  *
  * @return The constructed suite object.
  */
@@ -688,7 +708,9 @@ coco_suite_t *coco_suite(const char *suite_name, const char *suite_instance, con
 
   /* Sets the valid keys for suite options and suite instance */
   const char *known_keys_o[] = { "dimensions", "dimension_indices", "function_indices", "instance_indices",
-                                 "host_name", "port", "precision_x" };
+                                 "host_name", "port", "ports", "endpoints", "precision_x", "protocol", "window",
+                                 "transport", "shm_size", "cache_size", "cache_file", "combined",
+                                 "record", "instance_cache" };
   const char *known_keys_i[] = { "year", "instances" };
 
   /* Initialize the suite */
@@ -863,6 +885,8 @@ coco_problem_t *coco_suite_get_next_problem(coco_suite_t *suite, coco_observer_t
   long previous_dimension_idx;
   long previous_instance_idx;
 
+  double trace_start, trace_value;
+
   assert(suite != NULL);
 
   previous_function_idx = suite->current_function_idx;
@@ -880,7 +904,13 @@ coco_problem_t *coco_suite_get_next_problem(coco_suite_t *suite, coco_observer_t
   }
 
   if (suite->current_problem) {
+#if defined(COCO_PROFILING)
+    coco_profile_add_problem(suite->profile, suite->current_problem);
+#endif
+    trace_value = (double) coco_problem_get_suite_dep_index(suite->current_problem);
+    trace_start = coco_trace_begin();
     coco_problem_free(suite->current_problem);
+    coco_trace_end(COCO_TRACE_PROBLEM_FREE, trace_start, trace_value);
   }
 
   assert(suite->current_function_idx >= 0);
@@ -891,10 +921,12 @@ coco_problem_t *coco_suite_get_next_problem(coco_suite_t *suite, coco_observer_t
   dimension_idx = (size_t) suite->current_dimension_idx;
   instance_idx = (size_t) suite->current_instance_idx;
 
+  trace_start = coco_trace_begin();
   problem = coco_suite_get_problem_from_indices(suite, function_idx, dimension_idx, instance_idx);
   if (observer != NULL)
     problem = coco_problem_add_observer(problem, observer);
   suite->current_problem = problem;
+  coco_trace_end(COCO_TRACE_PROBLEM_CONSTRUCTION, trace_start, (double) coco_problem_get_suite_dep_index(problem));
 
   /* Output information regarding the current place in the iteration */
   if (coco_log_level >= COCO_INFO) {
@@ -0,0 +1,183 @@
+/**
+ * @file coco_trace.c
+ * @brief Definitions of functions regarding the binary event trace of the experiment timeline.
+ *
+ * When tracing is enabled (through the observer option "trace"), the most relevant events of the
+ * experiment (problem construction and freeing, function and constraint evaluations, logger output and
+ * socket round trips) are timestamped and collected into an in-memory buffer of fixed size. Whenever the
+ * buffer is full, its content is appended to the trace file, so that the overhead per event amounts to
+ * reading the clock twice and storing one record.
+ *
+ * The trace file consists of a header, followed by a sequence of records:
+ * - header: the 8 characters "COCOTRC1", followed by two 32-bit unsigned integers, the first one equal to
+ * 0x01020304 (used to determine the byte order) and the second one containing the size of a record in bytes;
+ * - record: the start time (in nanoseconds of a monotonic clock), the duration (in nanoseconds) and an
+ * event-specific value, all stored as doubles, followed by the 32-bit unsigned event type and 32 bits of
+ * padding.
+ *
+ * The script code-experiments/tools/coco_trace_to_json.py converts one or more such files to the Chrome
+ * trace JSON format that can be viewed with Perfetto (https://ui.perfetto.dev) or chrome://tracing.
+ *
+ * @note The C core is single-threaded (parallel experiments run separate processes, each with its own
+ * result folder), therefore there is one buffer per process and every trace file corresponds to one
+ * timeline.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "coco.h"
+#include "coco_internal.h"
+#include "coco_utilities.c"
+
+/** @brief The number of records kept in memory before they are written to the trace file. */
+#define COCO_TRACE_BUFFER_SIZE 4096
+
+/**
+ * @brief The types of traced events (must be consistent with the names in coco_trace_to_json.py).
+ */
+typedef enum {
+  COCO_TRACE_PROBLEM_CONSTRUCTION = 0, /**< @brief Construction of the next problem of the suite. */
+  COCO_TRACE_PROBLEM_FREE,             /**< @brief Freeing of a problem of the suite. */
+  COCO_TRACE_FUNCTION_EVALUATION,      /**< @brief Evaluation of the objective function(s). */
+  COCO_TRACE_CONSTRAINT_EVALUATION,    /**< @brief Evaluation of the constraints. */
+  COCO_TRACE_LOGGER_OUTPUT,            /**< @brief Output of a logger to its files. */
+  COCO_TRACE_SOCKET_ROUND_TRIP         /**< @brief Request sent to an external evaluator and its response. */
+} coco_trace_event_t;
+
+/**
+ * @brief A single record of the trace.
+ */
+typedef struct {
+  double start;          /**< @brief The start time of the event in nanoseconds. */
+  double duration;       /**< @brief The duration of the event in nanoseconds. */
+  double value;          /**< @brief An event-specific value (problem index, number of evaluations...). */
+  unsigned int event;    /**< @brief The type of the event (see coco_trace_event_t). */
+  unsigned int padding;  /**< @brief Unused (makes the size of the record independent of alignment). */
+} coco_trace_record_t;
+
+/**
+ * @brief The state of the trace.
+ */
+typedef struct {
+  FILE *file;                   /**< @brief The trace file (NULL when tracing is disabled). */
+  coco_trace_record_t *records; /**< @brief The buffer of records not yet written to the file. */
+  size_t count;                 /**< @brief The number of records in the buffer. */
+  size_t depth;                 /**< @brief The nesting depth of evaluations (only the outermost is traced). */
+} coco_trace_t;
+
+static coco_trace_t coco_trace = { NULL, NULL, 0, 0 };
+
+/**
+ * @brief Writes the buffered records to the trace file and empties the buffer.
+ */
+static void coco_trace_flush(void) {
+  if ((coco_trace.file == NULL) || (coco_trace.count == 0))
+    return;
+  if (fwrite(coco_trace.records, sizeof(coco_trace_record_t), coco_trace.count, coco_trace.file)
+      != coco_trace.count) {
+    coco_warning("coco_trace_flush(): Failed to write to the trace file, tracing stopped");
+    fclose(coco_trace.file);
+    coco_trace.file = NULL;
+  }
+  coco_trace.count = 0;
+}
+
+/**
+ * @brief Stops tracing, writes the remaining records to the trace file and closes it.
+ */
+static void coco_trace_stop(void) {
+  /* The records are kept even if the trace file was closed after a failed write */
+  if (coco_trace.records == NULL)
+    return;
+  coco_trace_flush();
+  if (coco_trace.file != NULL)
+    fclose(coco_trace.file);
+  coco_trace.file = NULL;
+  coco_free_memory(coco_trace.records);
+  coco_trace.records = NULL;
+  coco_trace.count = 0;
+  coco_trace.depth = 0;
+}
+
+/**
+ * @brief Starts tracing to the file with the given path (an already running trace is stopped first).
+ */
+static void coco_trace_start(const char *path) {
+
+  const char magic[] = "COCOTRC1";
+  unsigned int header[2];
+
+  coco_trace_stop();
+  coco_trace.file = fopen(path, "wb");
+  if (coco_trace.file == NULL) {
+    coco_warning("coco_trace_start(): Failed to open trace file %s, tracing disabled", path);
+    return;
+  }
+  header[0] = 0x01020304;
+  header[1] = (unsigned int) sizeof(coco_trace_record_t);
+  if ((fwrite(magic, sizeof(char), strlen(magic), coco_trace.file) != strlen(magic))
+      || (fwrite(header, sizeof(unsigned int), 2, coco_trace.file) != 2)) {
+    coco_warning("coco_trace_start(): Failed to write to trace file %s, tracing disabled", path);
+    fclose(coco_trace.file);
+    coco_trace.file = NULL;
+    return;
+  }
+
+  coco_trace.records = (coco_trace_record_t *) coco_allocate_memory(COCO_TRACE_BUFFER_SIZE
+      * sizeof(coco_trace_record_t));
+  coco_trace.count = 0;
+  coco_trace.depth = 0;
+}
+
+/**
+ * @brief Returns the start time of an event or a negative value if tracing is disabled.
+ */
+static double coco_trace_begin(void) {
+  if (coco_trace.file == NULL)
+    return -1;
+  return coco_get_time_ns();
+}
+
+/**
+ * @brief Records the event that started at the given time (does nothing if the start time is negative).
+ */
+static void coco_trace_end(const coco_trace_event_t event, const double start, const double value) {
+
+  coco_trace_record_t *record;
+
+  if ((start < 0) || (coco_trace.file == NULL))
+    return;
+  record = &coco_trace.records[coco_trace.count];
+  record->start = start;
+  record->duration = coco_get_time_ns() - start;
+  record->value = value;
+  record->event = (unsigned int) event;
+  record->padding = 0;
+  if (++coco_trace.count == COCO_TRACE_BUFFER_SIZE)
+    coco_trace_flush();
+}
+
+/**
+ * @brief Same as coco_trace_begin, but starts the event only if it is not nested within another evaluation.
+ *
+ * Every call must be matched by a call to coco_trace_end_evaluation.
+ */
+static double coco_trace_begin_evaluation(void) {
+  if (coco_trace.file == NULL)
+    return -1;
+  if (coco_trace.depth++ > 0)
+    return -1;
+  return coco_get_time_ns();
+}
+
+/**
+ * @brief Records the evaluation that started at the given time (see coco_trace_begin_evaluation).
+ */
+static void coco_trace_end_evaluation(const coco_trace_event_t event, const double start, const double value) {
+  if (coco_trace.file == NULL)
+    return;
+  if (coco_trace.depth > 0)
+    coco_trace.depth--;
+  coco_trace_end(event, start, value);
+}
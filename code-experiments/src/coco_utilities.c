@@ -1121,6 +1121,28 @@ static char *coco_current_time_get_string(void) {
   return time_string;
 }
 
+/**
+ * @brief Returns the current value of a monotonic clock in nanoseconds.
+ *
+ * Only differences between two such values are meaningful. On platforms without a monotonic clock, the
+ * calendar time (with the resolution of one second) is used instead.
+ */
+static double coco_get_time_ns(void) {
+#if WINSOCK
+  LARGE_INTEGER counter, frequency;
+  if (QueryPerformanceCounter(&counter) && QueryPerformanceFrequency(&frequency))
+    return (double) counter.QuadPart * (1e9 / (double) frequency.QuadPart);
+  return (double) time(NULL) * 1e9;
+#elif defined(CLOCK_MONOTONIC)
+  struct timespec now;
+  if (clock_gettime(CLOCK_MONOTONIC, &now) == 0)
+    return (double) now.tv_sec * 1e9 + (double) now.tv_nsec;
+  return (double) time(NULL) * 1e9;
+#else
+  return (double) time(NULL) * 1e9;
+#endif
+}
+
 /**
  * @brief Returns the number of positive numbers pointed to by numbers (the count stops when the first
  * 0 is encountered of max_count numbers have been read).
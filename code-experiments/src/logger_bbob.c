@@ -181,6 +181,7 @@ static void logger_bbob_output(FILE *data_file,
   /* This function contains many hard-coded values (10.9, 22, 5.4) that could be read through
    * observer options */
   size_t i;
+  const double trace_start = coco_trace_begin();
 
   fprintf(data_file, "%lu %lu %+10.9e %+10.9e ", (unsigned long) logger->num_func_evaluations,
     (unsigned long) logger->num_cons_evaluations, logger->best_found_value - logger->optimal_value, current_value);
@@ -209,6 +210,7 @@ static void logger_bbob_output(FILE *data_file,
    * Otherwise it can take a long time until the output appears.
    */
   fflush(data_file);
+  coco_trace_end(COCO_TRACE_LOGGER_OUTPUT, trace_start, (double) logger->num_func_evaluations);
 }
 
 /**
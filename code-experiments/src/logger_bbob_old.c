@@ -600,7 +600,7 @@ static void logger_bbob_old_free(void *stuff) {
   }
 
   if (logger->targets != NULL){
-    coco_free_memory(logger->targets);
+    coco_observer_log_targets_free(logger->targets);
     logger->targets = NULL;
   }
 
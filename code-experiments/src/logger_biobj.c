@@ -6,6 +6,12 @@
  * without knowing their true Pareto front (and set). Uses the hypervolume indicator, but supports
  * inclusion of other indicators. Archives nondominated solutions.
  *
+ * Problems with more than two objectives (for example, stacks of more than two single-objective problems)
+ * are logged in the same format. Their nondominated solutions are archived in an ND-tree (see mo_nd_tree.c)
+ * instead of an AVL tree and their hypervolume is computed by mo_hypervolume.c (exactly for three
+ * objectives and approximately for more, in which case the precision of the estimate is given as
+ * indicator_precision in the header of the info file).
+ *
  * In constrained problems only the feasible solutions are logged (except for the first one).
  *
  * Produces these files:
@@ -49,6 +55,9 @@
 #include "coco_problem.c"
 #include "coco_string.c"
 #include "mo_avl_tree.c"
+#include "mo_slab.c"
+#include "mo_nd_tree.c"
+#include "mo_hypervolume.c"
 #include "observer_biobj.c"
 
 #include "mo_utilities.c"
@@ -56,6 +65,16 @@
 /** @brief Number of implemented indicators */
 #define LOGGER_BIOBJ_NUMBER_OF_INDICATORS 1
 
+/**
+ * @brief Types of implemented indicators (used as indices into logger_biobj_indicators).
+ *
+ * The indicator computations dispatch on the type, so that the names need not be compared at every
+ * evaluation.
+ */
+typedef enum {
+  LOGGER_BIOBJ_INDICATOR_HYP = 0 /**< @brief The hypervolume indicator. */
+} logger_biobj_indicator_type_e;
+
 /** @brief Names of implemented indicators
  *
  * "hyp" stands for the hypervolume indicator.
@@ -87,6 +106,8 @@ const char *logger_biobj_indicators[LOGGER_BIOBJ_NUMBER_OF_INDICATORS] = { "hyp"
 typedef struct {
 
   char *name;                /**< @brief Name of the indicator used for identification and the output. */
+  logger_biobj_indicator_type_e type;
+                             /**< @brief Type of the indicator used to dispatch the computations. */
 
   FILE *info_file;           /**< @brief File for logging summary information on algorithm performance. */
   FILE *dat_file;            /**< @brief File for logging indicator values at predefined values */
@@ -133,15 +154,26 @@ typedef struct {
   size_t num_cons_evaluations;        /**< @brief The number of evaluations of constraints performed so far. */
   size_t number_of_variables;         /**< @brief Dimension of the problem. */
   size_t number_of_integer_variables; /**< @brief Number of integer variables. */
-  size_t number_of_objectives;        /**< @brief Number of objectives (clearly equal to 2). */
+  size_t number_of_objectives;        /**< @brief Number of objectives (at least 2). */
   size_t suite_dep_instance;          /**< @brief Suite-dependent instance number of the observed problem. */
 
   size_t previous_evaluations;        /**< @brief The number of evaluations from the previous call to the logger. */
 
-  avl_tree_t *archive_tree;           /**< @brief The tree keeping currently non-dominated solutions. */
+  avl_tree_t *archive_tree;           /**< @brief The tree keeping currently non-dominated solutions (for
+                                           two objectives). */
+  mo_nd_tree_t *nd_tree;              /**< @brief The ND-tree keeping currently non-dominated solutions (for
+                                           more than two objectives). */
+  mo_hypervolume_t *hypervolume;      /**< @brief The hypervolume of the solutions in the ND-tree. */
   avl_tree_t *buffer_tree;            /**< @brief The tree with pointers to nondominated solutions that haven't
                                            been logged yet. */
 
+  double *normalized_y;               /**< @brief Scratch buffer for the normalized objectives of the current
+                                           solution (used to check dominance before creating a node). */
+  double *normalization_scales;       /**< @brief The reciprocal normalization scales (computed once from the
+                                           ideal and nadir points, see mo_normalize_into()). */
+  mo_slab_t *item_slab;               /**< @brief The slab holding the nodes' items (with their data). */
+  mo_slab_t *node_slab;               /**< @brief The slab holding the nodes of both trees. */
+
   /* TODO: Implement other indicators */
   int compute_indicators;             /**< @brief Whether to compute the indicators. */
   logger_biobj_indicator_t *indicators[LOGGER_BIOBJ_NUMBER_OF_INDICATORS];
@@ -168,66 +200,94 @@ typedef struct {
 
 } logger_biobj_avl_item_t;
 
+/**
+ * @brief Returns whether the solution with the given constraint values is feasible.
+ */
+static int logger_biobj_is_feasible(const double *constraints, const size_t num_const) {
+
+  size_t i;
+  double sum_constraints = 0;
+
+  if (num_const > 0) {
+    assert(constraints != NULL);
+    for (i = 0; i < num_const; i++) {
+      if (constraints[i] > 0)
+        sum_constraints += constraints[i];
+    }
+  }
+  return !(sum_constraints > 0);
+}
+
 /**
  * @brief Creates and returns the information on the solution in the form of a node's item in the AVL tree.
+ *
+ * The item and its x, y and normalized_y values are stored in a single block of the logger's item slab.
  */
-static logger_biobj_avl_item_t* logger_biobj_node_create(const coco_problem_t *problem,
+static logger_biobj_avl_item_t* logger_biobj_node_create(logger_biobj_data_t *logger,
                                                          const double *x,
                                                          const double *y,
-                                                         const double *constraints,
-                                                         const size_t evaluation_number,
-                                                         const size_t dim,
-                                                         const size_t num_obj,
-                                                         const size_t num_const) {
+                                                         const double *normalized_y,
+                                                         const int is_feasible,
+                                                         const size_t evaluation_number) {
 
   size_t i;
-  double sum_constraints = 0;
+  const size_t dim = logger->number_of_variables;
+  const size_t num_obj = logger->number_of_objectives;
+  logger_biobj_avl_item_t *item;
 
-  /* Allocate memory to hold the data structure logger_biobj_node_t */
-  logger_biobj_avl_item_t *item = (logger_biobj_avl_item_t*) coco_allocate_memory(sizeof(*item));
+  /* Get memory to hold the data structure logger_biobj_node_t and the (copied) data of the new node */
+  item = (logger_biobj_avl_item_t*) mo_slab_get_block(logger->item_slab);
+  item->x = (double *) (item + 1);
+  item->y = item->x + dim;
+  item->normalized_y = item->y + num_obj;
 
-  /* Allocate memory to store the (copied) data of the new node */
-  item->x = coco_allocate_vector(dim);
-  item->y = coco_allocate_vector(num_obj);
-
-  /* Copy the data */
+  /* Copy the data (the decision vector is set to zero if it is not given) */
   for (i = 0; i < dim; i++)
-    item->x[i] = x[i];
-  for (i = 0; i < num_obj; i++)
+    item->x[i] = (x != NULL) ? x[i] : 0;
+  for (i = 0; i < num_obj; i++) {
     item->y[i] = y[i];
-
-  /* Compute the normalized y */
-  item->normalized_y = mo_normalize(item->y, problem->best_value, problem->nadir_value, num_obj, problem->is_opt_known);
+    item->normalized_y[i] = normalized_y[i];
+  }
   item->within_ROI = mo_is_within_ROI(item->normalized_y, num_obj);
 
   item->evaluation_number = evaluation_number;
   for (i = 0; i < LOGGER_BIOBJ_NUMBER_OF_INDICATORS; i++)
     item->indicator_contribution[i] = 0;
-
-  /* Determine whether the solution is feasible */
-  item->is_feasible = 1;
-  if (num_const > 0) {
-    assert(constraints != NULL);
-    for (i = 0; i < num_const; i++) {
-      if (constraints[i] > 0)
-        sum_constraints += constraints[i];
-    }
-    item->is_feasible = !(sum_constraints > 0);
-  }
+  item->is_feasible = is_feasible;
 
   return item;
 }
 
 /**
- * @brief Frees the data of the given logger_biobj_avl_item_t.
+ * @brief Frees the data of the given logger_biobj_avl_item_t (gives it back to the item slab of the logger,
+ * which is passed as userdata).
  */
 static void logger_biobj_node_free(logger_biobj_avl_item_t *item, void *userdata) {
+  logger_biobj_data_t *logger = (logger_biobj_data_t *) userdata;
+  mo_slab_put_block(logger->item_slab, item);
+}
 
-  coco_free_memory(item->x);
-  coco_free_memory(item->y);
-  coco_free_memory(item->normalized_y);
-  coco_free_memory(item);
-  (void) userdata; /* To silence the compiler */
+/**
+ * @brief Returns whether the solution with the given normalized objectives is weakly dominated by a
+ * solution in the archive.
+ *
+ * Performs the same check as logger_biobj_tree_update, but without creating a node, so that dominated
+ * solutions (the vast majority in later stages of a run) cost no memory allocation.
+ */
+static int logger_biobj_is_dominated(const logger_biobj_data_t *logger, double *normalized_y) {
+
+  logger_biobj_avl_item_t probe;
+  avl_node_t *node;
+
+  if (logger->nd_tree != NULL)
+    return mo_nd_tree_is_dominated(logger->nd_tree, normalized_y);
+
+  probe.normalized_y = normalized_y;
+  node = avl_item_search_right(logger->archive_tree, &probe, NULL);
+  if (node == NULL)
+    return 0;
+  return mo_get_dominance(normalized_y, ((logger_biobj_avl_item_t*) node->item)->normalized_y,
+      logger->number_of_objectives) < 0;
 }
 
 /**
@@ -308,6 +368,53 @@ static size_t logger_biobj_tree_output(FILE *file,
   return number_of_nodes;
 }
 
+/**
+ * @brief Removes the item of a dominated solution from the buffer tree and frees it (the remove function of
+ * the ND-tree).
+ */
+static void logger_biobj_nd_tree_remove(void *item, void *userdata) {
+  logger_biobj_data_t *logger = (logger_biobj_data_t *) userdata;
+  avl_item_delete(logger->buffer_tree, item);
+  logger_biobj_node_free((logger_biobj_avl_item_t *) item, logger);
+}
+
+/**
+ * @brief Updates the ND-tree and the buffer tree with the given node (the counterpart of
+ * logger_biobj_tree_update for more than two objectives).
+ *
+ * The hypervolume grows by the contribution of the new solution, which does not change when the solutions
+ * it dominates are removed. Therefore, the items of the ND-tree do not keep their contributions.
+ *
+ * @return 1 if the update was performed and 0 otherwise.
+ */
+static int logger_biobj_nd_tree_update(logger_biobj_data_t *logger,
+                                       logger_biobj_avl_item_t *node_item) {
+  size_t i;
+  double contribution;
+
+  if (mo_nd_tree_is_dominated(logger->nd_tree, node_item->normalized_y)) {
+    logger_biobj_node_free(node_item, logger);
+    return 0;
+  }
+
+  if (logger->compute_indicators) {
+    contribution = mo_hypervolume_add(logger->hypervolume, node_item->normalized_y, logger->nd_tree);
+    for (i = 0; i < LOGGER_BIOBJ_NUMBER_OF_INDICATORS; i++) {
+      if (logger->indicators[i]->type == LOGGER_BIOBJ_INDICATOR_HYP) {
+        node_item->indicator_contribution[i] = contribution;
+        logger->indicators[i]->current_value += contribution;
+      } else {
+        coco_error("logger_biobj_nd_tree_update(): Indicator computation not implemented yet for indicator %s",
+            logger->indicators[i]->name);
+      }
+    }
+  }
+
+  mo_nd_tree_insert(logger->nd_tree, node_item->normalized_y, node_item);
+  avl_item_insert(logger->buffer_tree, node_item);
+  return 1;
+}
+
 /**
  * @brief Updates the archive and buffer trees with the given node.
  *
@@ -327,8 +434,13 @@ static int logger_biobj_tree_update(logger_biobj_data_t *logger,
   int previous_unavailable = 0;
 
   /* If the node contains an infeasible solution, exit immediately (do not update the tree) */
-  if (node_item->is_feasible == 0)
+  if (node_item->is_feasible == 0) {
+    logger_biobj_node_free(node_item, logger);
     return 0;
+  }
+
+  if (logger->nd_tree != NULL)
+    return logger_biobj_nd_tree_update(logger, node_item);
 
   /* Find the first point that is not worse than the new point (NULL if such point does not exist) */
   node = avl_item_search_right(logger->archive_tree, node_item, NULL);
@@ -360,7 +472,7 @@ static int logger_biobj_tree_update(logger_biobj_data_t *logger,
   }
 
   if (!trigger_update) {
-    logger_biobj_node_free(node_item, NULL);
+    logger_biobj_node_free(node_item, logger);
   } else {
     /* Perform tree update */
     while (next_node != NULL) {
@@ -399,7 +511,7 @@ static int logger_biobj_tree_update(logger_biobj_data_t *logger,
           if (next_item->within_ROI) {
             for (i = 0; i < LOGGER_BIOBJ_NUMBER_OF_INDICATORS; i++) {
               logger->indicators[i]->current_value -= next_item->indicator_contribution[i];
-              if (strcmp(logger->indicators[i]->name, "hyp") == 0) {
+              if (logger->indicators[i]->type == LOGGER_BIOBJ_INDICATOR_HYP) {
                 next_item->indicator_contribution[i] = (node_item->normalized_y[0] - next_item->normalized_y[0])
                     * (1 - next_item->normalized_y[1]);
                 assert(next_item->indicator_contribution[i] >= 0);
@@ -418,7 +530,7 @@ static int logger_biobj_tree_update(logger_biobj_data_t *logger,
           previous_item = (logger_biobj_avl_item_t*) new_node->prev->item;
           if (previous_item->within_ROI) {
             for (i = 0; i < LOGGER_BIOBJ_NUMBER_OF_INDICATORS; i++) {
-              if (strcmp(logger->indicators[i]->name, "hyp") == 0) {
+              if (logger->indicators[i]->type == LOGGER_BIOBJ_INDICATOR_HYP) {
                 node_item->indicator_contribution[i] = (previous_item->normalized_y[0] - node_item->normalized_y[0])
                     * (1 - node_item->normalized_y[1]);
                 assert(node_item->indicator_contribution[i] >= 0);
@@ -438,7 +550,7 @@ static int logger_biobj_tree_update(logger_biobj_data_t *logger,
         if (previous_unavailable) {
           /* Previous item does not exist or is out of ROI, use reference point instead */
           for (i = 0; i < LOGGER_BIOBJ_NUMBER_OF_INDICATORS; i++) {
-            if (strcmp(logger->indicators[i]->name, "hyp") == 0) {
+            if (logger->indicators[i]->type == LOGGER_BIOBJ_INDICATOR_HYP) {
               node_item->indicator_contribution[i] = (1 - node_item->normalized_y[0])
                   * (1 - node_item->normalized_y[1]);
               assert(node_item->indicator_contribution[i] >= 0);
@@ -451,7 +563,7 @@ static int logger_biobj_tree_update(logger_biobj_data_t *logger,
         }
 
         for (i = 0; i < LOGGER_BIOBJ_NUMBER_OF_INDICATORS; i++) {
-          if (strcmp(logger->indicators[i]->name, "hyp") == 0) {
+          if (logger->indicators[i]->type == LOGGER_BIOBJ_INDICATOR_HYP) {
             assert(node_item->indicator_contribution[i] >= 0);
             logger->indicators[i]->current_value += node_item->indicator_contribution[i];
           }
@@ -510,18 +622,19 @@ static void logger_biobj_indicator_initialize_file(const logger_biobj_data_t *lo
 }
 
 /**
- * @brief Initializes the indicator with name indicator_name.
+ * @brief Initializes the indicator of the given type (named according to logger_biobj_indicators).
  *
  * Opens files for writing and resets counters.
  */
 static logger_biobj_indicator_t *logger_biobj_indicator(const logger_biobj_data_t *logger,
                                                         const coco_observer_t *observer,
                                                         const coco_problem_t *problem,
-                                                        const char *indicator_name) {
+                                                        const logger_biobj_indicator_type_e indicator_type) {
 
   observer_biobj_data_t *observer_data;
   logger_biobj_indicator_t *indicator;
   coco_suite_t *suite;
+  const char *indicator_name = logger_biobj_indicators[indicator_type];
   char *prefix, *file_name, *path_name;
   int info_file_exists = 0;
 
@@ -535,6 +648,7 @@ static logger_biobj_indicator_t *logger_biobj_indicator(const logger_biobj_data_
   observer_data = (observer_biobj_data_t *) observer->data;
 
   indicator->name = coco_strdup(indicator_name);
+  indicator->type = indicator_type;
 
   assert(problem->suite);
   suite = (coco_suite_t *)problem->suite;
@@ -572,9 +686,14 @@ static logger_biobj_indicator_t *logger_biobj_indicator(const logger_biobj_data_
     /* Output algorithm name */
     assert(problem->suite);
     fprintf(indicator->info_file,
-        "suite = '%s', algorithm = '%s', indicator = '%s', folder = '%s', coco_version = '%s'\n%% %s",
+        "suite = '%s', algorithm = '%s', indicator = '%s', folder = '%s', coco_version = '%s'",
         problem->suite->suite_name, observer->algorithm_name, indicator_name, problem->problem_type,
-        coco_version, observer->algorithm_info);
+        coco_version);
+    /* The hypervolume of more than three objectives is estimated, output the precision of the estimate */
+    if ((logger->hypervolume != NULL) && (mo_hypervolume_get_precision(logger->hypervolume) > 0))
+      fprintf(indicator->info_file, ", indicator_precision = %.1e",
+          mo_hypervolume_get_precision(logger->hypervolume));
+    fprintf(indicator->info_file, "\n%% %s", observer->algorithm_info);
     if (logger->log_nondom_mode == LOG_NONDOM_READ)
       fprintf(indicator->info_file, " (reconstructed)");
   }
@@ -690,10 +809,12 @@ static void logger_biobj_indicator_free(void *stuff) {
  */
 static void logger_biobj_output(logger_biobj_data_t *logger,
                                 const int update_performed,
-                                const logger_biobj_avl_item_t *node_item) {
+                                const int is_feasible,
+                                const double *normalized_y) {
 
   size_t i, j;
   logger_biobj_indicator_t *indicator;
+  const double trace_start = coco_trace_begin();
 
   coco_debug("Started logger_biobj_output()");
 
@@ -707,11 +828,11 @@ static void logger_biobj_output(logger_biobj_data_t *logger,
       /* If the update was performed, update the overall indicator value */
       if (update_performed) {
         /* Compute the overall_value of an indicator */
-        if (strcmp(indicator->name, "hyp") == 0) {
+        if (indicator->type == LOGGER_BIOBJ_INDICATOR_HYP) {
           if (coco_double_almost_equal(indicator->current_value, 0, mo_precision)) {
             /* Update the additional penalty for hypervolume (the minimal distance from the nondominated set
              * to the ROI) */
-            double new_distance = mo_get_distance_to_ROI(node_item->normalized_y, logger->number_of_objectives);
+            double new_distance = mo_get_distance_to_ROI(normalized_y, logger->number_of_objectives);
             indicator->additional_penalty = coco_double_min(indicator->additional_penalty, new_distance);
             assert(indicator->additional_penalty >= 0);
           } else {
@@ -727,7 +848,7 @@ static void logger_biobj_output(logger_biobj_data_t *logger,
         /* Check whether a target was hit */
         indicator->target_hit = coco_observer_targets_trigger(indicator->targets, indicator->overall_value);
       }
-      else if ((logger->num_func_evaluations == 1) && (node_item->is_feasible == 0)) {
+      else if ((logger->num_func_evaluations == 1) && (is_feasible == 0)) {
         /* Special case if the solution is infeasible and this is the first evaluation */
         indicator->overall_value = INFINITY_FOR_LOGGING;
         indicator->target_hit = coco_observer_targets_trigger(indicator->targets, indicator->overall_value);
@@ -742,13 +863,15 @@ static void logger_biobj_output(logger_biobj_data_t *logger,
 
       if (logger->log_nondom_mode == LOG_NONDOM_READ) {
         /* Log to the tdat file the previous indicator value if any evaluation number between the previous and
-         * this one matches one of the predefined evaluation numbers. */
-        for (j = logger->previous_evaluations + 1; j < logger->num_func_evaluations; j++) {
-          indicator->evaluation_logged = coco_observer_evaluations_trigger(indicator->evaluations, j);
-          if (indicator->evaluation_logged) {
-            fprintf(indicator->tdat_file, "%lu\t%.*e\n", (unsigned long) j, logger->precision_f,
-                indicator->previous_value);
-          }
+         * this one matches one of the predefined evaluation numbers (the matching evaluation numbers are
+         * found directly, without checking each evaluation number in between). */
+        j = coco_observer_evaluations_next_trigger(indicator->evaluations, logger->previous_evaluations + 1,
+            logger->num_func_evaluations - 1);
+        while (j > 0) {
+          fprintf(indicator->tdat_file, "%lu\t%.*e\n", (unsigned long) j, logger->precision_f,
+              indicator->previous_value);
+          j = coco_observer_evaluations_next_trigger(indicator->evaluations, j + 1,
+              logger->num_func_evaluations - 1);
         }
       }
 
@@ -772,6 +895,7 @@ static void logger_biobj_output(logger_biobj_data_t *logger,
   if (logger->algorithm_restarted)
     logger->algorithm_restarted = 0;
 
+  coco_trace_end(COCO_TRACE_LOGGER_OUTPUT, trace_start, (double) logger->num_func_evaluations);
   coco_debug("Ended   logger_biobj_output()");
 }
 
@@ -783,7 +907,7 @@ static void logger_biobj_evaluate(coco_problem_t *problem, const double *x, doub
 
   logger_biobj_data_t *logger;
   logger_biobj_avl_item_t *node_item;
-  int update_performed;
+  int update_performed = 0, is_feasible;
   coco_problem_t *inner_problem;
   double *constraints = NULL;
 
@@ -801,12 +925,17 @@ static void logger_biobj_evaluate(coco_problem_t *problem, const double *x, doub
   }
   logger->num_cons_evaluations = problem->evaluations_constraints;
 
-  node_item = logger_biobj_node_create(inner_problem, x, y, constraints, logger->num_func_evaluations,
-      logger->number_of_variables, logger->number_of_objectives, problem->number_of_constraints);
+  is_feasible = logger_biobj_is_feasible(constraints, problem->number_of_constraints);
+  mo_normalize_into(y, inner_problem->best_value, inner_problem->nadir_value, logger->normalization_scales,
+      logger->number_of_objectives, inner_problem->is_opt_known, logger->normalized_y);
 
-  /* Update the archive with the new solution, if it is not dominated by or equal to existing solutions in
-   * the archive */
-  update_performed = logger_biobj_tree_update(logger, node_item);
+  /* Update the archive with the new solution, if it is feasible and not dominated by or equal to existing
+   * solutions in the archive (the node is created only in this case) */
+  if (is_feasible && !logger_biobj_is_dominated(logger, logger->normalized_y)) {
+    node_item = logger_biobj_node_create(logger, x, y, logger->normalized_y, is_feasible,
+        logger->num_func_evaluations);
+    update_performed = logger_biobj_tree_update(logger, node_item);
+  }
 
   /* If the archive was updated and you need to log all nondominated solutions, output the new solution to
    * nondom_file */
@@ -821,7 +950,7 @@ static void logger_biobj_evaluate(coco_problem_t *problem, const double *x, doub
   }
 
   /* Output according to observer options */
-  logger_biobj_output(logger, update_performed, node_item);
+  logger_biobj_output(logger, update_performed, is_feasible, logger->normalized_y);
 
   /* Free allocated memory */
   if (problem->number_of_constraints > 0)
@@ -892,10 +1021,8 @@ int coco_logger_biobj_feed_solution(coco_problem_t *problem, const size_t evalua
 
   logger_biobj_data_t *logger;
   logger_biobj_avl_item_t *node_item;
-  int update_performed;
+  int update_performed = 0;
   coco_problem_t *inner_problem;
-  double *x;
-  size_t i;
 
   assert(problem != NULL);
   logger = (logger_biobj_data_t *) coco_problem_transformed_get_data(problem);
@@ -909,23 +1036,54 @@ int coco_logger_biobj_feed_solution(coco_problem_t *problem, const size_t evalua
         "the evaluations need to be always increasing.", logger->previous_evaluations, evaluation);
   logger->num_func_evaluations = evaluation;
 
-  /* Update the archive with the new solution */
-  x = coco_allocate_vector(problem->number_of_variables);
-  for (i = 0; i < problem->number_of_variables; i++)
-    x[i] = 0;
-  node_item = logger_biobj_node_create(inner_problem, x, y, NULL, logger->num_func_evaluations,
-      logger->number_of_variables, logger->number_of_objectives, 0);
-  coco_free_memory(x);
-
-  /* Update the archive */
-  update_performed = logger_biobj_tree_update(logger, node_item);
+  /* Update the archive with the new solution (the decision vector is unknown and is set to zero), if it is
+   * not dominated by or equal to existing solutions in the archive */
+  mo_normalize_into(y, inner_problem->best_value, inner_problem->nadir_value, logger->normalization_scales,
+      logger->number_of_objectives, inner_problem->is_opt_known, logger->normalized_y);
+  if (!logger_biobj_is_dominated(logger, logger->normalized_y)) {
+    node_item = logger_biobj_node_create(logger, NULL, y, logger->normalized_y, 1, logger->num_func_evaluations);
+    update_performed = logger_biobj_tree_update(logger, node_item);
+  }
 
   /* Output according to observer options */
-  logger_biobj_output(logger, update_performed, node_item);
+  logger_biobj_output(logger, update_performed, 1, logger->normalized_y);
 
   return update_performed;
 }
 
+/**
+ * Feeds the given solutions to the logger in the given order (see coco_logger_biobj_feed_solution()). This
+ * is equivalent to, but faster than, feeding the solutions one by one from a language binding.
+ *
+ * @param problem The given COCO problem.
+ * @param number_of_solutions The number of solutions.
+ * @param evaluations The (increasing) numbers of evaluations of the solutions.
+ * @param y The objective vectors of the solutions stored one after another (the objectives of the i-th
+ * solution start at y[i * number_of_objectives]).
+ * @return The number of solutions that updated the archive.
+ */
+size_t coco_logger_biobj_feed_solutions(coco_problem_t *problem,
+                                        const size_t number_of_solutions,
+                                        const size_t *evaluations,
+                                        const double *y) {
+  size_t i, number_of_updates = 0;
+
+  assert(problem != NULL);
+  for (i = 0; i < number_of_solutions; i++) {
+    if (coco_logger_biobj_feed_solution(problem, evaluations[i], y + i * problem->number_of_objectives))
+      number_of_updates++;
+  }
+  return number_of_updates;
+}
+
+/**
+ * @brief Inserts the item into the tree given as userdata (used to visit the ND-tree).
+ */
+static void logger_biobj_nd_tree_collect(const double *point, void *item, void *userdata) {
+  avl_item_insert((avl_tree_t *) userdata, item);
+  (void) point; /* To silence the compiler */
+}
+
 /**
  * @brief Outputs the final nondominated solutions to the archive file.
  */
@@ -939,7 +1097,9 @@ static void logger_biobj_finalize(logger_biobj_data_t *logger) {
   /* Re-sort archive_tree according to time stamp and then output it */
   resorted_tree = avl_tree_construct((avl_compare_t) avl_tree_compare_by_eval_number, NULL);
 
-  if (logger->archive_tree->tail) {
+  if (logger->nd_tree != NULL) {
+    mo_nd_tree_visit(logger->nd_tree, NULL, logger_biobj_nd_tree_collect, resorted_tree);
+  } else if (logger->archive_tree->tail) {
     /* There is at least a solution in the tree to output */
     solution = logger->archive_tree->head;
     while (solution != NULL) {
@@ -994,8 +1154,19 @@ static void logger_biobj_free(void *stuff) {
     logger->mdat_file = NULL;
   }
 
-  avl_tree_destruct(logger->archive_tree);
-  avl_tree_destruct(logger->buffer_tree);
+  /* The nodes and items are owned by the slabs, which free them at once */
+  if (logger->nd_tree != NULL) {
+    mo_nd_tree_free(logger->nd_tree);
+    if (logger->hypervolume != NULL)
+      mo_hypervolume_free(logger->hypervolume);
+  } else {
+    avl_tree_release(logger->archive_tree);
+  }
+  avl_tree_release(logger->buffer_tree);
+  mo_slab_free(logger->item_slab);
+  mo_slab_free(logger->node_slab);
+  coco_free_memory(logger->normalized_y);
+  coco_free_memory(logger->normalization_scales);
 
   observer = logger->observer;
   if ((observer != NULL) && (observer->is_active == 1)) {
@@ -1049,8 +1220,8 @@ static coco_problem_t *logger_biobj(coco_observer_t *observer, coco_problem_t *i
 
   coco_debug("Started logger_biobj()");
 
-  if (inner_problem->number_of_objectives != 2) {
-    coco_error("logger_biobj(): The bi-objective logger cannot log a problem with %d objective(s)",
+  if (inner_problem->number_of_objectives < 2) {
+    coco_error("logger_biobj(): The bi-objective logger cannot log a problem with %d objective",
         inner_problem->number_of_objectives);
     return NULL; /* Never reached. */
   }
@@ -1127,15 +1298,37 @@ static coco_problem_t *logger_biobj(coco_observer_t *observer, coco_problem_t *i
     }
   }
 
-  /* Initialize the AVL trees */
-  logger_data->archive_tree = avl_tree_construct((avl_compare_t) avl_tree_compare_by_last_objective,
-      (avl_free_t) logger_biobj_node_free);
+  /* Initialize the AVL trees (or the ND-tree for more than two objectives) */
+  logger_data->archive_tree = NULL;
+  logger_data->nd_tree = NULL;
+  logger_data->hypervolume = NULL;
+  if (logger_data->number_of_objectives == 2) {
+    logger_data->archive_tree = avl_tree_construct((avl_compare_t) avl_tree_compare_by_last_objective,
+        (avl_free_t) logger_biobj_node_free);
+    logger_data->archive_tree->userdata = logger_data;
+  } else {
+    logger_data->nd_tree = mo_nd_tree_allocate(logger_data->number_of_objectives, logger_biobj_nd_tree_remove,
+        logger_data);
+    if (logger_data->compute_indicators)
+      logger_data->hypervolume = mo_hypervolume_allocate(logger_data->number_of_objectives);
+  }
+  logger_data->normalized_y = coco_allocate_vector(logger_data->number_of_objectives);
+  logger_data->normalization_scales = coco_allocate_vector(logger_data->number_of_objectives);
+  mo_get_normalization_scales(inner_problem->best_value, inner_problem->nadir_value,
+      logger_data->number_of_objectives, logger_data->normalization_scales);
   logger_data->buffer_tree = avl_tree_construct((avl_compare_t) avl_tree_compare_by_eval_number, NULL);
+  logger_data->item_slab = mo_slab_allocate(sizeof(logger_biobj_avl_item_t) + (logger_data->number_of_variables
+      + 2 * logger_data->number_of_objectives) * sizeof(double), 256);
+  logger_data->node_slab = mo_slab_allocate(sizeof(avl_node_t), 512);
+  if (logger_data->archive_tree != NULL)
+    mo_slab_attach_to_tree(logger_data->node_slab, logger_data->archive_tree);
+  mo_slab_attach_to_tree(logger_data->node_slab, logger_data->buffer_tree);
 
   /* Initialize the indicators */
   if (logger_data->compute_indicators) {
     for (i = 0; i < LOGGER_BIOBJ_NUMBER_OF_INDICATORS; i++)
-      logger_data->indicators[i] = logger_biobj_indicator(logger_data, observer, inner_problem, logger_biobj_indicators[i]);
+      logger_data->indicators[i] = logger_biobj_indicator(logger_data, observer, inner_problem,
+          (logger_biobj_indicator_type_e) i);
 
     observer_data->previous_function = (long) inner_problem->suite_dep_function;
     observer_data->previous_dimension = (long) inner_problem->number_of_variables;
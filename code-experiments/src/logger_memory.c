@@ -0,0 +1,138 @@
+/**
+ * @file logger_memory.c
+ * @brief Implementation of the memory logger.
+ *
+ * Records the targets hit by the optimizer on single-objective problems and the numbers of evaluations when
+ * they were first hit into the run data of the memory observer. No file is read or written.
+ */
+
+#include <assert.h>
+#include <float.h>
+
+#include "coco.h"
+
+#include "coco_utilities.c"
+#include "coco_problem.c"
+#include "coco_observer.c"
+#include "logger_bbob.c"
+#include "observer_memory.c"
+
+/**
+ * @brief The memory logger data type.
+ */
+typedef struct {
+  coco_observer_t *observer;         /**< @brief Pointer to the observer (NULL if it was already freed). */
+  observer_memory_run_t *run;        /**< @brief The run data of the observed problem (owned by the observer). */
+  coco_observer_targets_t *targets;  /**< @brief Triggers based on target values. */
+} logger_memory_data_t;
+
+/**
+ * @brief Evaluates the function and records the target hits.
+ *
+ * The logged value is the distance to the optimal value of the best value found so far (as in the bbob
+ * logger, the sum of positive constraint violations is added for constrained problems).
+ */
+static void logger_memory_evaluate(coco_problem_t *problem, const double *x, double *y) {
+
+  logger_memory_data_t *logger = (logger_memory_data_t *) coco_problem_transformed_get_data(problem);
+  coco_problem_t *inner_problem = coco_problem_transformed_get_inner_problem(problem);
+  observer_memory_run_t *run = logger->run;
+  double *constraints;
+  double value, sum_constraints = 0;
+  size_t i;
+
+  coco_evaluate_function(inner_problem, x, y);
+  if (run == NULL)
+    return;
+  run->number_of_evaluations++;
+
+  if (problem->number_of_constraints > 0) {
+    constraints = coco_allocate_vector(problem->number_of_constraints);
+    inner_problem->evaluate_constraint(inner_problem, x, constraints, 0);
+    for (i = 0; i < problem->number_of_constraints; ++i) {
+      if (constraints[i] > 0)
+        sum_constraints += constraints[i];
+    }
+    coco_free_memory(constraints);
+  }
+
+  if (coco_is_nan(y[0]) || coco_is_nan(sum_constraints))
+    return;
+  if (problem->is_opt_known)
+    value = coco_double_max(y[0], run->optimal_value) + sum_constraints;
+  else
+    value = ((sum_constraints > 0) ? LOGGER_BBOB_INFEASIBLE_PENALTY : y[0]) + sum_constraints;
+  value -= run->optimal_value;
+
+  if (value < run->best_value) {
+    run->best_value = value;
+    if (coco_observer_targets_trigger(logger->targets, value))
+      observer_memory_run_add_hit(run, coco_observer_targets_get_last_target(logger->targets), value,
+          run->number_of_evaluations);
+  }
+}
+
+/**
+ * @brief Frees the memory of the given memory logger.
+ */
+static void logger_memory_free(void *stuff) {
+
+  logger_memory_data_t *logger = (logger_memory_data_t *) stuff;
+
+  if (logger->targets != NULL) {
+    coco_observer_targets_free(logger->targets);
+    logger->targets = NULL;
+  }
+
+  if ((logger->observer != NULL) && (logger->observer->is_active == 1) && (logger->observer->data != NULL))
+    ((observer_memory_data_t *) logger->observer->data)->observed_problem = NULL;
+}
+
+/**
+ * @brief Disconnects the logger from the observer (called when the observer is freed before the problem).
+ */
+static void logger_memory_data_nullify_observer(void *stuff) {
+  logger_memory_data_t *logger = (logger_memory_data_t *) stuff;
+  logger->observer = NULL;
+  logger->run = NULL;
+}
+
+/**
+ * @brief Initializes the memory logger.
+ */
+static coco_problem_t *logger_memory(coco_observer_t *observer, coco_problem_t *inner_problem) {
+
+  coco_problem_t *problem;
+  logger_memory_data_t *logger_data;
+  observer_memory_data_t *observer_data;
+  coco_suite_t *suite;
+
+  assert(inner_problem);
+  assert(inner_problem->suite);
+  suite = (coco_suite_t *) inner_problem->suite;
+  if (inner_problem->number_of_objectives != 1) {
+    coco_warning("logger_memory(): The memory logger shouldn't be used to log a problem with %d objectives",
+        inner_problem->number_of_objectives);
+  }
+
+  observer_data = (observer_memory_data_t *) observer->data;
+  assert(observer_data != NULL);
+  if (observer_data->observed_problem != NULL) {
+    coco_error("logger_memory(): The observed problem must be closed before a new problem can be observed");
+  }
+  if (observer_data->suite_name == NULL)
+    observer_data->suite_name = coco_strdup(suite->suite_name);
+
+  logger_data = (logger_memory_data_t *) coco_allocate_memory(sizeof(*logger_data));
+  logger_data->observer = observer;
+  logger_data->run = observer_memory_add_run(observer_data, inner_problem);
+  logger_data->targets = coco_observer_targets(suite->known_optima, observer->lin_target_precision,
+      observer->number_target_triggers, observer->log_target_precision);
+
+  problem = coco_problem_transformed_allocate(inner_problem, logger_data, logger_memory_free,
+      observer->observer_name);
+  problem->evaluate_function = logger_memory_evaluate;
+
+  observer_data->observed_problem = problem;
+  return problem;
+}
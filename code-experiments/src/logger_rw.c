@@ -22,6 +22,32 @@
 #include "coco_problem.c"
 #include "coco_string.c"
 #include "observer_rw.c"
+#include "socket_communication.c"
+
+/**
+ * @brief The number of histogram buckets for each power of two (determines the relative precision of the
+ * reported percentiles).
+ */
+#define LOGGER_RW_HISTOGRAM_SUB_BUCKETS 32
+
+/**
+ * @brief The number of powers of two covered by the histogram (evaluation times of up to 2**40 ns, that is
+ * around 18 minutes, are distinguished).
+ */
+#define LOGGER_RW_HISTOGRAM_EXPONENTS 40
+
+/**
+ * @brief A histogram of evaluation times.
+ *
+ * The bucket widths grow with the times (each power of two is split into LOGGER_RW_HISTOGRAM_SUB_BUCKETS
+ * buckets of equal width), so that the percentiles are recorded with the same relative precision for
+ * short and long evaluation times.
+ */
+typedef struct {
+  size_t *counts;                /**< @brief The number of times in each bucket. */
+  size_t number_of_times;        /**< @brief The number of all recorded times. */
+  double max_time;               /**< @brief The largest recorded time (in ns). */
+} logger_rw_histogram_t;
 
 /**
  * @brief The rw logger data type.
@@ -43,15 +69,117 @@ typedef struct {
   int log_only_better;           /**< @brief Whether to log only solutions that are better than previous ones. */
   int log_time;                  /**< @brief Whether to log evaluation time. */
 
+  logger_rw_histogram_t func_times; /**< @brief Histogram of the times of function evaluations. */
+  logger_rw_histogram_t cons_times; /**< @brief Histogram of the times of constraint evaluations. */
+
+  int log_cache;                 /**< @brief Whether the problem uses a cache of evaluations. */
+  size_t cache_hits;             /**< @brief The number of cache hits of this problem. */
+  size_t cache_misses;           /**< @brief The number of cache misses of this problem. */
+  size_t cache_hits_before;      /**< @brief The number of cache hits of the suite before this problem. */
+  size_t cache_misses_before;    /**< @brief The number of cache misses of the suite before this problem. */
+
   int precision_x;               /**< @brief Precision for outputting decision values. */
   int precision_f;               /**< @brief Precision for outputting objective values. */
   int precision_g;               /**< @brief Precision for outputting constraint values. */
   int log_discrete_as_int;       /**< @brief Whether to output discrete variables in int or double format. */
 } logger_rw_data_t;
 
+/**
+ * @brief Initializes the given histogram.
+ */
+static void logger_rw_histogram_initialize(logger_rw_histogram_t *histogram) {
+
+  size_t i;
+  const size_t number_of_buckets = LOGGER_RW_HISTOGRAM_EXPONENTS * LOGGER_RW_HISTOGRAM_SUB_BUCKETS;
+
+  histogram->counts = (size_t *) coco_allocate_memory(number_of_buckets * sizeof(size_t));
+  for (i = 0; i < number_of_buckets; i++)
+    histogram->counts[i] = 0;
+  histogram->number_of_times = 0;
+  histogram->max_time = 0;
+}
+
+/**
+ * @brief Records the given time (in ns) to the histogram.
+ */
+static void logger_rw_histogram_add(logger_rw_histogram_t *histogram, const double time) {
+
+  int exponent;
+  double mantissa;
+  size_t bucket = 0;
+
+  if (time >= 1) {
+    /* time = mantissa * 2**exponent, where 0.5 <= mantissa < 1 and exponent >= 1 */
+    mantissa = frexp(time, &exponent);
+    if (exponent > LOGGER_RW_HISTOGRAM_EXPONENTS)
+      bucket = LOGGER_RW_HISTOGRAM_EXPONENTS * LOGGER_RW_HISTOGRAM_SUB_BUCKETS - 1;
+    else
+      bucket = (size_t) (exponent - 1) * LOGGER_RW_HISTOGRAM_SUB_BUCKETS
+          + (size_t) ((2 * mantissa - 1) * LOGGER_RW_HISTOGRAM_SUB_BUCKETS);
+  }
+  histogram->counts[bucket]++;
+  histogram->number_of_times++;
+  if (time > histogram->max_time)
+    histogram->max_time = time;
+}
+
+/**
+ * @brief Returns the given percentile (0 < percentile <= 1) of the recorded times (in ns).
+ *
+ * The upper bound of the bucket containing the percentile is returned (but never more than the largest
+ * recorded time).
+ */
+static double logger_rw_histogram_get_percentile(const logger_rw_histogram_t *histogram,
+                                                 const double percentile) {
+
+  size_t i, count = 0, rank;
+  double upper_bound;
+
+  if (histogram->number_of_times == 0)
+    return 0;
+
+  rank = (size_t) ceil(percentile * (double) histogram->number_of_times);
+  for (i = 0; i < LOGGER_RW_HISTOGRAM_EXPONENTS * LOGGER_RW_HISTOGRAM_SUB_BUCKETS; i++) {
+    count += histogram->counts[i];
+    if (count >= rank)
+      break;
+  }
+  upper_bound = ldexp(1 + (double) (i % LOGGER_RW_HISTOGRAM_SUB_BUCKETS + 1) / LOGGER_RW_HISTOGRAM_SUB_BUCKETS,
+      (int) (i / LOGGER_RW_HISTOGRAM_SUB_BUCKETS));
+  return (upper_bound < histogram->max_time) ? upper_bound : histogram->max_time;
+}
+
+/**
+ * @brief Outputs the percentiles of the recorded times (in seconds) to the given file.
+ */
+static void logger_rw_histogram_output(FILE *out_file, const logger_rw_histogram_t *histogram,
+                                       const char *name) {
+
+  fprintf(out_file, "%% %s evaluation time (s): p50 = %.3e, p90 = %.3e, p99 = %.3e, max = %.3e "
+      "(%lu evaluations)\n", name,
+      logger_rw_histogram_get_percentile(histogram, 0.5) / 1e9,
+      logger_rw_histogram_get_percentile(histogram, 0.9) / 1e9,
+      logger_rw_histogram_get_percentile(histogram, 0.99) / 1e9,
+      histogram->max_time / 1e9, (unsigned long) histogram->number_of_times);
+}
+
+/**
+ * @brief Frees the memory of the given histogram.
+ */
+static void logger_rw_histogram_free(logger_rw_histogram_t *histogram) {
+
+  if (histogram->counts != NULL) {
+    coco_free_memory(histogram->counts);
+    histogram->counts = NULL;
+  }
+}
+
 /**
  * @brief Evaluates the function and constraints and outputs the information according to the
  * observer options.
+ *
+ * If log_time is set, the evaluation times are measured using a monotonic clock and recorded to the
+ * histograms that are output when the logger is freed.
  */
 static void logger_rw_evaluate(coco_problem_t *problem, const double *x, double *y) {
 
@@ -60,14 +188,15 @@ static void logger_rw_evaluate(coco_problem_t *problem, const double *x, double
   double *constraints = NULL;
   size_t i;
   int log_this_time = 1;
-  time_t start, end;
+  double start = 0, middle = 0, end = 0;
+  double trace_start;
 
   logger = (logger_rw_data_t *) coco_problem_transformed_get_data(problem);
   inner_problem = coco_problem_transformed_get_inner_problem(problem);
 
   /* Time the evaluations */
   if (logger->log_time)
-    time(&start);
+    start = coco_get_time_ns();
 
   /* Evaluate the objective(s) */
   coco_evaluate_function(inner_problem, x, y);
@@ -76,6 +205,11 @@ static void logger_rw_evaluate(coco_problem_t *problem, const double *x, double
   if (problem->number_of_objectives == 1)
     logger->current_value = y[0];
 
+  if (logger->log_time) {
+    middle = coco_get_time_ns();
+    logger_rw_histogram_add(&logger->func_times, middle - start);
+  }
+
   /* Evaluate the constraints */
   if (problem->number_of_constraints > 0) {
     constraints = coco_allocate_vector(problem->number_of_constraints);
@@ -83,11 +217,22 @@ static void logger_rw_evaluate(coco_problem_t *problem, const double *x, double
   }
   logger->num_cons_evaluations = problem->evaluations_constraints;
 
+  /* The cache counters of the suite are read here, because the inner problem is freed before the logger */
+  if (logger->log_cache && socket_communication_get_cache_counters(inner_problem, &logger->cache_hits,
+      &logger->cache_misses)) {
+    logger->cache_hits -= logger->cache_hits_before;
+    logger->cache_misses -= logger->cache_misses_before;
+  }
+
   /* Time the evaluations */
-  if (logger->log_time)
-    time(&end);
+  if (logger->log_time) {
+    end = coco_get_time_ns();
+    if (problem->number_of_constraints > 0)
+      logger_rw_histogram_add(&logger->cons_times, end - middle);
+  }
 
   /* Log to the output file */
+  trace_start = coco_trace_begin();
   if ((problem->number_of_objectives == 1) && (logger->current_value < logger->best_value))
     logger->best_value = logger->current_value;
   else if (problem->number_of_objectives == 1)
@@ -111,10 +256,11 @@ static void logger_rw_evaluate(coco_problem_t *problem, const double *x, double
     }
     /* Log time in seconds */
     if (logger->log_time)
-      fprintf(logger->out_file, "%.0f\t", difftime(end, start));
+      fprintf(logger->out_file, "%.9f\t", (end - start) / 1e9);
     fprintf(logger->out_file, "\n");
   }
   fflush(logger->out_file);
+  coco_trace_end(COCO_TRACE_LOGGER_OUTPUT, trace_start, (double) logger->num_func_evaluations);
 
   if (problem->number_of_constraints > 0)
     coco_free_memory(constraints);
@@ -132,9 +278,19 @@ static void logger_rw_free(void *stuff) {
   logger = (logger_rw_data_t *) stuff;
 
   if (logger->out_file != NULL) {
+    if (logger->log_time) {
+      logger_rw_histogram_output(logger->out_file, &logger->func_times, "function");
+      if (logger->cons_times.number_of_times > 0)
+        logger_rw_histogram_output(logger->out_file, &logger->cons_times, "constraint");
+    }
+    if (logger->log_cache)
+      fprintf(logger->out_file, "%% evaluation cache: hits = %lu, misses = %lu\n",
+          (unsigned long) logger->cache_hits, (unsigned long) logger->cache_misses);
     fclose(logger->out_file);
     logger->out_file = NULL;
   }
+  logger_rw_histogram_free(&logger->func_times);
+  logger_rw_histogram_free(&logger->cons_times);
 }
 
 /**
@@ -182,6 +338,17 @@ static coco_problem_t *logger_rw(coco_observer_t *observer, coco_problem_t *inne
   logger_data->log_only_better = (observer_data->log_only_better) &&
       (inner_problem->number_of_objectives == 1);
   logger_data->log_time = observer_data->log_time;
+  logger_data->func_times.counts = NULL;
+  logger_data->cons_times.counts = NULL;
+  if (logger_data->log_time) {
+    logger_rw_histogram_initialize(&logger_data->func_times);
+    logger_rw_histogram_initialize(&logger_data->cons_times);
+  }
+
+  logger_data->cache_hits = 0;
+  logger_data->cache_misses = 0;
+  logger_data->log_cache = socket_communication_get_cache_counters(inner_problem,
+      &logger_data->cache_hits_before, &logger_data->cache_misses_before);
 
   logger_data->best_value = DBL_MAX;
   logger_data->current_value = DBL_MAX;
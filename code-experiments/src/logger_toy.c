@@ -38,7 +38,7 @@ static void logger_toy_free(void *stuff) {
   logger = (logger_toy_data_t *) stuff;
 
   if (logger->targets != NULL){
-    coco_free_memory(logger->targets);
+    coco_observer_log_targets_free(logger->targets);
     logger->targets = NULL;
   }
 
@@ -154,11 +154,13 @@ static int avl_check_balance(avl_node_t *avlnode) {
 }
 
 #ifdef AVL_COUNT
+#if (!AVL_TREE_COMMENT_UNUSED)
 static unsigned long avl_count(const avl_tree_t *avltree) {
   if (!avltree)
     return 0;
   return AVL_NODE_COUNT(avltree->top);
 }
+#endif
 
 #if (!AVL_TREE_COMMENT_UNUSED)
 static avl_node_t *avl_at(const avl_tree_t *avltree, unsigned long index) {
@@ -511,6 +513,13 @@ static void avl_tree_destruct(avl_tree_t *avltree) {
   free(avltree);
 }
 
+/* Frees the tree structure but leaves its nodes and items alone.
+ * To be used when both are owned by an allocator that frees them at once.
+ * O(1) */
+static void avl_tree_release(avl_tree_t *avltree) {
+  free(avltree);
+}
+
 static void avl_node_clear(avl_node_t *newnode) {
   newnode->left = newnode->right = NULL;
 #   ifdef AVL_COUNT
@@ -0,0 +1,332 @@
+/**
+ * @file mo_hypervolume.c
+ * @brief Incremental computation of the hypervolume of the points in an ND-tree with any number of
+ * objectives.
+ *
+ * The hypervolume is computed in the normalized ROI [0, 1]^num_obj w.r.t. the reference point (1, ..., 1),
+ * that is, only the part of the objective space dominated by the points that lies inside the ROI is
+ * measured. When a point that is not weakly dominated by the points in the tree is added, the hypervolume
+ * increases by the volume of the part of its box [point, 1] that is not dominated by the points in the tree
+ * (removing the points dominated by the new point afterwards does not change the hypervolume).
+ *
+ * For two and three objectives this contribution is computed exactly: it equals the volume of the box minus
+ * the hypervolume of the points in the tree projected onto the box. The latter is computed in O(n log n)
+ * time by sweeping the projected points in the order of the last objective while keeping the area
+ * dominated in the first two objectives up to date in an AVL tree (a staircase of points). Since every
+ * point in the ROI dominates a part of the box, all n points of the tree are projected for each added
+ * point and computing the hypervolume of a whole run of N nondominated points takes O(N^2 log N) time.
+ *
+ * For more objectives the hypervolume is estimated from a fixed set of uniformly distributed samples in
+ * the ROI: the contribution of a point is the share of the samples that it dominates and that were not
+ * dominated before. The samples that are not yet dominated are kept sorted by the first objective, so that
+ * only samples that can be dominated by the new point are checked. The estimate has a standard error of at
+ * most 0.5 / sqrt(MO_HYPERVOLUME_NUMBER_OF_SAMPLES) (see mo_hypervolume_get_precision()).
+ */
+
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "coco.h"
+#include "coco_utilities.c"
+#include "mo_avl_tree.c"
+#include "mo_slab.c"
+#include "mo_nd_tree.c"
+
+/** @brief The number of samples used to estimate the hypervolume for more than three objectives. */
+#define MO_HYPERVOLUME_NUMBER_OF_SAMPLES 100000
+
+/** @brief The seed of the samples (the same samples are used for all problems). */
+#define MO_HYPERVOLUME_SEED 1
+
+/**
+ * @brief The structure used to compute the hypervolume.
+ */
+typedef struct {
+  size_t number_of_objectives;     /**< @brief The number of objectives. */
+  double value;                    /**< @brief The (exact or estimated) hypervolume of the added points. */
+
+  double *lower;                   /**< @brief The lower corner of the box of the currently added point. */
+  double *upper;                   /**< @brief The reference point. */
+  double *projections;             /**< @brief The points in the tree projected onto the box. */
+  size_t number_of_projections;    /**< @brief The number of projected points. */
+  size_t capacity;                 /**< @brief The number of points that fit into projections. */
+  avl_tree_t *staircase;           /**< @brief The nondominated projected points in the first two objectives
+                                        ordered by the first objective. */
+  mo_slab_t *node_slab;            /**< @brief The slab holding the nodes of the staircase. */
+
+  double *samples;                 /**< @brief The samples not yet dominated by the added points (sorted by
+                                        the first objective). */
+  size_t number_of_samples;        /**< @brief The number of all samples. */
+  size_t number_of_undominated;    /**< @brief The number of samples not yet dominated. */
+} mo_hypervolume_t;
+
+/**
+ * @brief Defines the ordering of the staircase points based on the value of the first objective.
+ */
+static int mo_hypervolume_compare_by_first_objective(const double *point1,
+                                                     const double *point2,
+                                                     void *userdata) {
+  (void) userdata; /* To silence the compiler */
+  return AVL_CMP(point1[0], point2[0]);
+}
+
+/**
+ * @brief Defines the ordering of samples based on the value of the first objective (used by qsort).
+ */
+static int mo_hypervolume_compare_samples(const void *sample1, const void *sample2) {
+  return AVL_CMP(((const double *) sample1)[0], ((const double *) sample2)[0]);
+}
+
+/**
+ * @brief Defines the ordering of three-objective points based on the value of the last objective (used by
+ * qsort).
+ */
+static int mo_hypervolume_compare_by_third_objective(const void *point1, const void *point2) {
+  return AVL_CMP(((const double *) point1)[2], ((const double *) point2)[2]);
+}
+
+/**
+ * @brief Allocates the structure for computing the hypervolume of points with the given number of
+ * objectives.
+ */
+static mo_hypervolume_t *mo_hypervolume_allocate(const size_t number_of_objectives) {
+
+  mo_hypervolume_t *hypervolume = (mo_hypervolume_t *) coco_allocate_memory(sizeof(*hypervolume));
+  coco_random_state_t *random_generator;
+  size_t i;
+
+  assert(number_of_objectives >= 2);
+  hypervolume->number_of_objectives = number_of_objectives;
+  hypervolume->value = 0;
+  hypervolume->lower = coco_allocate_vector(number_of_objectives);
+  hypervolume->upper = coco_allocate_vector_with_value(number_of_objectives, 1);
+  hypervolume->projections = NULL;
+  hypervolume->number_of_projections = 0;
+  hypervolume->capacity = 0;
+  hypervolume->staircase = NULL;
+  hypervolume->node_slab = NULL;
+  hypervolume->samples = NULL;
+  hypervolume->number_of_samples = 0;
+  hypervolume->number_of_undominated = 0;
+
+  if (number_of_objectives <= 3) {
+    hypervolume->staircase = avl_tree_construct((avl_compare_t) mo_hypervolume_compare_by_first_objective, NULL);
+    hypervolume->node_slab = mo_slab_allocate(sizeof(avl_node_t), 256);
+    mo_slab_attach_to_tree(hypervolume->node_slab, hypervolume->staircase);
+  } else {
+    hypervolume->number_of_samples = MO_HYPERVOLUME_NUMBER_OF_SAMPLES;
+    hypervolume->number_of_undominated = MO_HYPERVOLUME_NUMBER_OF_SAMPLES;
+    hypervolume->samples = coco_allocate_vector(MO_HYPERVOLUME_NUMBER_OF_SAMPLES * number_of_objectives);
+    random_generator = coco_random_new(MO_HYPERVOLUME_SEED);
+    for (i = 0; i < MO_HYPERVOLUME_NUMBER_OF_SAMPLES * number_of_objectives; i++)
+      hypervolume->samples[i] = coco_random_uniform(random_generator);
+    coco_random_free(random_generator);
+    qsort(hypervolume->samples, MO_HYPERVOLUME_NUMBER_OF_SAMPLES, number_of_objectives * sizeof(double),
+        mo_hypervolume_compare_samples);
+  }
+  return hypervolume;
+}
+
+/**
+ * @brief Frees the structure for computing the hypervolume.
+ */
+static void mo_hypervolume_free(mo_hypervolume_t *hypervolume) {
+
+  coco_free_memory(hypervolume->lower);
+  coco_free_memory(hypervolume->upper);
+  if (hypervolume->projections != NULL)
+    coco_free_memory(hypervolume->projections);
+  if (hypervolume->staircase != NULL) {
+    avl_tree_release(hypervolume->staircase);
+    mo_slab_free(hypervolume->node_slab);
+  }
+  if (hypervolume->samples != NULL)
+    coco_free_memory(hypervolume->samples);
+  coco_free_memory(hypervolume);
+}
+
+/**
+ * @brief Adds the projection of the given point onto the current box to the projections (used as the visit
+ * function of the ND-tree).
+ */
+static void mo_hypervolume_project(const double *point, void *item, void *userdata) {
+
+  mo_hypervolume_t *hypervolume = (mo_hypervolume_t *) userdata;
+  const size_t num_obj = hypervolume->number_of_objectives;
+  double *projection = hypervolume->projections + hypervolume->number_of_projections * num_obj;
+  size_t i;
+
+  assert(hypervolume->number_of_projections < hypervolume->capacity);
+  for (i = 0; i < num_obj; i++)
+    projection[i] = coco_double_max(point[i], hypervolume->lower[i]);
+  hypervolume->number_of_projections++;
+
+  (void) item; /* To silence the compiler */
+}
+
+/**
+ * @brief Adds the point to the staircase and returns the increase of the area dominated by the staircase
+ * in the first two objectives (w.r.t. the reference point (1, 1)).
+ *
+ * The points of the staircase that become dominated are removed.
+ */
+static double mo_hypervolume_staircase_add(avl_tree_t *staircase, double *point) {
+
+  avl_node_t *node, *next_node;
+  double *other;
+  double height = 1, position = point[0], area = 0;
+
+  /* Find the last point that is not larger than the given one in the first objective */
+  node = avl_item_search_right(staircase, point, NULL);
+  if (node != NULL) {
+    other = (double *) node->item;
+    if (other[1] <= point[1])
+      return 0; /* The point is dominated */
+    height = other[1];
+    next_node = node->next;
+    if (other[0] == point[0])
+      avl_node_delete(staircase, node);
+    node = next_node;
+  } else {
+    node = staircase->head;
+  }
+
+  /* Remove the dominated points while adding the area between them and the given point */
+  while ((node != NULL) && (((double *) node->item)[1] >= point[1])) {
+    other = (double *) node->item;
+    area += (other[0] - position) * (height - point[1]);
+    position = other[0];
+    height = other[1];
+    next_node = node->next;
+    avl_node_delete(staircase, node);
+    node = next_node;
+  }
+  area += (((node != NULL) ? ((double *) node->item)[0] : 1) - position) * (height - point[1]);
+
+  avl_item_insert(staircase, point);
+  return area;
+}
+
+/**
+ * @brief Returns the exact volume of the part of the box [point, 1] that is not dominated by the points in
+ * the tree (for two or three objectives).
+ *
+ * The projection cannot be restricted to fewer points of the tree: any point q inside the ROI dominates the
+ * part [max(q, point), 1] of the box, so only the points outside the ROI are skipped. The contribution thus
+ * takes O(n log n) time for n points in the tree (and the whole run takes quadratic time).
+ */
+static double mo_hypervolume_exact_contribution(mo_hypervolume_t *hypervolume,
+                                                const double *point,
+                                                const mo_nd_tree_t *tree) {
+
+  const size_t num_obj = hypervolume->number_of_objectives;
+  double box = 1, dominated = 0, area = 0, next_value;
+  double *projection;
+  size_t i;
+
+  for (i = 0; i < num_obj; i++) {
+    hypervolume->lower[i] = coco_double_max(point[i], 0);
+    if (hypervolume->lower[i] >= 1)
+      return 0;
+    box *= 1 - hypervolume->lower[i];
+  }
+
+  /* Project the points of the tree that lie (partly) inside the ROI onto the box */
+  if (hypervolume->capacity < tree->number_of_points) {
+    if (hypervolume->projections != NULL)
+      coco_free_memory(hypervolume->projections);
+    hypervolume->capacity = 2 * tree->number_of_points;
+    hypervolume->projections = coco_allocate_vector(hypervolume->capacity * num_obj);
+  }
+  hypervolume->number_of_projections = 0;
+  mo_nd_tree_visit(tree, hypervolume->upper, mo_hypervolume_project, hypervolume);
+
+  /* Compute the hypervolume of the projected points */
+  if (num_obj == 2) {
+    for (i = 0; i < hypervolume->number_of_projections; i++)
+      dominated += mo_hypervolume_staircase_add(hypervolume->staircase, hypervolume->projections + 2 * i);
+  } else if (hypervolume->number_of_projections > 0) {
+    assert(num_obj == 3);
+    qsort(hypervolume->projections, hypervolume->number_of_projections, 3 * sizeof(double),
+        mo_hypervolume_compare_by_third_objective);
+    for (i = 0; i < hypervolume->number_of_projections; i++) {
+      projection = hypervolume->projections + 3 * i;
+      area += mo_hypervolume_staircase_add(hypervolume->staircase, projection);
+      next_value = (i + 1 < hypervolume->number_of_projections) ? projection[5] : 1;
+      dominated += area * (next_value - projection[2]);
+    }
+  }
+  avl_tree_purge(hypervolume->staircase);
+
+  /* Guard against negative values caused by rounding */
+  return coco_double_max(box - dominated, 0);
+}
+
+/**
+ * @brief Returns the estimated volume of the part of the box [point, 1] that is not dominated by the
+ * previously added points and removes the samples inside this part from the undominated samples.
+ */
+static double mo_hypervolume_sampled_contribution(mo_hypervolume_t *hypervolume, const double *point) {
+
+  const size_t num_obj = hypervolume->number_of_objectives;
+  size_t first = 0, last = hypervolume->number_of_undominated, middle, i, j, c;
+  double *sample;
+
+  /* Find the first sample that is not smaller than the point in the first objective */
+  while (first < last) {
+    middle = first + (last - first) / 2;
+    if (hypervolume->samples[middle * num_obj] < point[0])
+      first = middle + 1;
+    else
+      last = middle;
+  }
+
+  /* Remove the dominated samples (keeping the order of the remaining ones) */
+  for (i = first, j = first; i < hypervolume->number_of_undominated; i++) {
+    sample = hypervolume->samples + i * num_obj;
+    for (c = 1; c < num_obj; c++) {
+      if (point[c] > sample[c])
+        break;
+    }
+    if (c < num_obj) {
+      if (j < i)
+        memmove(hypervolume->samples + j * num_obj, sample, num_obj * sizeof(double));
+      j++;
+    }
+  }
+  i = hypervolume->number_of_undominated - j;
+  hypervolume->number_of_undominated = j;
+  return (double) i / (double) hypervolume->number_of_samples;
+}
+
+/**
+ * @brief Returns the precision of the hypervolume value: 0 if it is computed exactly and the largest
+ * possible standard error of the estimate, 0.5 / sqrt(number_of_samples), otherwise.
+ */
+static double mo_hypervolume_get_precision(const mo_hypervolume_t *hypervolume) {
+
+  if (hypervolume->samples == NULL)
+    return 0;
+  return 0.5 / sqrt((double) hypervolume->number_of_samples);
+}
+
+/**
+ * @brief Adds the point to the hypervolume and returns its contribution.
+ *
+ * @note Must be called before the point is inserted into the tree. The point must not be weakly dominated
+ * by a point in the tree.
+ */
+static double mo_hypervolume_add(mo_hypervolume_t *hypervolume, const double *point, const mo_nd_tree_t *tree) {
+
+  double contribution;
+
+  assert(tree->number_of_objectives == hypervolume->number_of_objectives);
+  if (hypervolume->samples == NULL)
+    contribution = mo_hypervolume_exact_contribution(hypervolume, point, tree);
+  else
+    contribution = mo_hypervolume_sampled_contribution(hypervolume, point);
+  hypervolume->value += contribution;
+  return contribution;
+}
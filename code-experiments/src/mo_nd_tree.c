@@ -0,0 +1,514 @@
+/**
+ * @file mo_nd_tree.c
+ * @brief Implementation of the ND-tree, an archive of mutually nondominated points with any number of
+ * objectives.
+ *
+ * The ND-tree (see Jaszkiewicz and Lust, "ND-Tree-Based Update: A Fast Algorithm for the Dynamic
+ * Nondominance Problem", IEEE Transactions on Evolutionary Computation 22(5), 2018) recursively splits the
+ * archive into subsets of points that lie close to each other in the objective space. Each node stores the
+ * ideal and the nadir point of its subset (or a slightly looser bound after points were removed). This
+ * allows to decide for a whole subset at once whether it contains a point that dominates the given point,
+ * whether the given point dominates all its points or whether neither can be the case, so that dominance
+ * queries and updates visit only a small part of the archive instead of all its points.
+ *
+ * The tree does not copy the points, but stores pointers to them together with pointers to the items they
+ * belong to (the points must therefore remain valid while they are in the tree). Points are compared in the
+ * same way as in mo_get_dominance() (values closer than mo_precision are treated as equal).
+ */
+
+#include <assert.h>
+
+#include "coco.h"
+#include "coco_utilities.c"
+#include "mo_slab.c"
+#include "mo_utilities.c"
+
+/** @brief The maximal number of points in a leaf of the ND-tree. */
+#define MO_ND_TREE_MAX_LEAF_SIZE 20
+
+/**
+ * @brief The function called for each item removed from the ND-tree because its point became dominated.
+ */
+typedef void (*mo_nd_tree_remove_t)(void *item, void *userdata);
+
+/**
+ * @brief The function called for each visited point of the ND-tree (see mo_nd_tree_visit()).
+ */
+typedef void (*mo_nd_tree_visit_t)(const double *point, void *item, void *userdata);
+
+/**
+ * @brief The node of the ND-tree.
+ *
+ * A leaf holds up to MO_ND_TREE_MAX_LEAF_SIZE points, an internal node up to number_of_objectives + 1
+ * children. All nodes except for the root are nonempty.
+ */
+typedef struct mo_nd_tree_node_s {
+  int is_leaf;                          /**< @brief Whether the node is a leaf. */
+  double *ideal;                        /**< @brief A lower bound of the points in the subtree. */
+  double *nadir;                        /**< @brief An upper bound of the points in the subtree. */
+  struct mo_nd_tree_node_s **children;  /**< @brief The children of an internal node. */
+  size_t number_of_children;            /**< @brief The number of children of an internal node. */
+  const double **points;                /**< @brief The points of a leaf. */
+  void **items;                         /**< @brief The items belonging to the points of a leaf. */
+  size_t number_of_points;              /**< @brief The number of points of a leaf. */
+} mo_nd_tree_node_t;
+
+/**
+ * @brief The ND-tree.
+ */
+typedef struct {
+  size_t number_of_objectives;  /**< @brief The number of objectives. */
+  size_t number_of_points;      /**< @brief The number of points in the tree. */
+  mo_nd_tree_node_t *root;      /**< @brief The root of the tree. */
+  mo_slab_t *node_slab;         /**< @brief The slab holding the nodes (together with their arrays). */
+  mo_nd_tree_remove_t remove;   /**< @brief Called for removed items (can be NULL). */
+  void *userdata;               /**< @brief Passed to the remove function. */
+} mo_nd_tree_t;
+
+/**
+ * @brief Returns whether point1 weakly dominates point2 (values closer than mo_precision are treated as
+ * equal).
+ */
+static int mo_nd_tree_weakly_dominates(const double *point1, const double *point2, const size_t num_obj) {
+
+  size_t i;
+
+  for (i = 0; i < num_obj; i++) {
+    if ((point1[i] > point2[i]) && !coco_double_almost_equal(point1[i], point2[i], mo_precision))
+      return 0;
+  }
+  return 1;
+}
+
+/**
+ * @brief Returns the squared Euclidean distance between the point and the middle of the node's bounds.
+ */
+static double mo_nd_tree_node_distance(const mo_nd_tree_node_t *node, const double *point, const size_t num_obj) {
+
+  size_t i;
+  double diff, distance = 0;
+
+  for (i = 0; i < num_obj; i++) {
+    diff = point[i] - (node->ideal[i] + node->nadir[i]) / 2;
+    distance += diff * diff;
+  }
+  return distance;
+}
+
+/**
+ * @brief Allocates an empty leaf (the node and its arrays are stored in a single block of the node slab).
+ */
+static mo_nd_tree_node_t *mo_nd_tree_node_allocate(mo_nd_tree_t *tree) {
+
+  const size_t num_obj = tree->number_of_objectives;
+  mo_nd_tree_node_t *node = (mo_nd_tree_node_t *) mo_slab_get_block(tree->node_slab);
+
+  node->ideal = (double *) ((char *) node + mo_slab_align(sizeof(*node)));
+  node->nadir = node->ideal + num_obj;
+  node->children = (mo_nd_tree_node_t **) (node->nadir + num_obj);
+  node->points = (const double **) (node->children + num_obj + 1);
+  node->items = (void **) (node->points + MO_ND_TREE_MAX_LEAF_SIZE + 1);
+  node->is_leaf = 1;
+  node->number_of_children = 0;
+  node->number_of_points = 0;
+  return node;
+}
+
+/**
+ * @brief Gives the nodes of the subtree back to the slab (and calls the remove function for their items if
+ * call_remove is set).
+ */
+static void mo_nd_tree_node_release(mo_nd_tree_t *tree, mo_nd_tree_node_t *node, const int call_remove) {
+
+  size_t i;
+
+  if (node->is_leaf) {
+    if (call_remove && (tree->remove != NULL)) {
+      for (i = 0; i < node->number_of_points; i++)
+        tree->remove(node->items[i], tree->userdata);
+    }
+    tree->number_of_points -= node->number_of_points;
+  } else {
+    for (i = 0; i < node->number_of_children; i++)
+      mo_nd_tree_node_release(tree, node->children[i], call_remove);
+  }
+  mo_slab_put_block(tree->node_slab, node);
+}
+
+/**
+ * @brief Returns whether the node contains no points.
+ */
+static int mo_nd_tree_node_is_empty(const mo_nd_tree_node_t *node) {
+  return node->is_leaf ? (node->number_of_points == 0) : (node->number_of_children == 0);
+}
+
+/**
+ * @brief Extends the bounds of the node with the given point (sets them to the point if the node is empty).
+ */
+static void mo_nd_tree_node_extend(mo_nd_tree_node_t *node, const double *point, const size_t num_obj) {
+
+  size_t i;
+  const int is_empty = mo_nd_tree_node_is_empty(node);
+
+  for (i = 0; i < num_obj; i++) {
+    if (is_empty || (point[i] < node->ideal[i]))
+      node->ideal[i] = point[i];
+    if (is_empty || (point[i] > node->nadir[i]))
+      node->nadir[i] = point[i];
+  }
+}
+
+/**
+ * @brief Recomputes the bounds of a nonempty node from its points or the bounds of its children.
+ */
+static void mo_nd_tree_node_update_bounds(mo_nd_tree_node_t *node, const size_t num_obj) {
+
+  size_t i, j;
+  const double *lower, *upper;
+  const size_t count = node->is_leaf ? node->number_of_points : node->number_of_children;
+
+  assert(count > 0);
+  for (j = 0; j < count; j++) {
+    lower = node->is_leaf ? node->points[j] : node->children[j]->ideal;
+    upper = node->is_leaf ? node->points[j] : node->children[j]->nadir;
+    for (i = 0; i < num_obj; i++) {
+      if ((j == 0) || (lower[i] < node->ideal[i]))
+        node->ideal[i] = lower[i];
+      if ((j == 0) || (upper[i] > node->nadir[i]))
+        node->nadir[i] = upper[i];
+    }
+  }
+}
+
+/**
+ * @brief Returns whether a point in the subtree weakly dominates the given point.
+ */
+static int mo_nd_tree_node_is_dominated(const mo_nd_tree_t *tree,
+                                        const mo_nd_tree_node_t *node,
+                                        const double *point) {
+
+  size_t i;
+  const size_t num_obj = tree->number_of_objectives;
+
+  /* No point of the subtree can dominate the given point if the ideal point does not */
+  if (!mo_nd_tree_weakly_dominates(node->ideal, point, num_obj))
+    return 0;
+  /* All points of the subtree dominate the given point if the nadir point does */
+  if (mo_nd_tree_weakly_dominates(node->nadir, point, num_obj))
+    return 1;
+
+  if (node->is_leaf) {
+    for (i = 0; i < node->number_of_points; i++) {
+      if (mo_nd_tree_weakly_dominates(node->points[i], point, num_obj))
+        return 1;
+    }
+  } else {
+    for (i = 0; i < node->number_of_children; i++) {
+      if (mo_nd_tree_node_is_dominated(tree, node->children[i], point))
+        return 1;
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief Removes the points of the subtree that are dominated by the given point (the given point must not
+ * be weakly dominated by any of them). Returns the number of removed points.
+ *
+ * Children that become empty are released and an internal node left with a single child takes over its
+ * content.
+ */
+static size_t mo_nd_tree_node_remove_dominated(mo_nd_tree_t *tree,
+                                               mo_nd_tree_node_t *node,
+                                               const double *point) {
+
+  size_t i, j, number_of_points, removed = 0;
+  const size_t num_obj = tree->number_of_objectives;
+  mo_nd_tree_node_t *child;
+
+  /* The point cannot dominate any point of the subtree if it does not dominate the nadir point */
+  if (!mo_nd_tree_weakly_dominates(point, node->nadir, num_obj))
+    return 0;
+
+  if (node->is_leaf) {
+    for (i = 0; i < node->number_of_points; ) {
+      if (mo_nd_tree_weakly_dominates(point, node->points[i], num_obj)) {
+        if (tree->remove != NULL)
+          tree->remove(node->items[i], tree->userdata);
+        node->number_of_points--;
+        node->points[i] = node->points[node->number_of_points];
+        node->items[i] = node->items[node->number_of_points];
+        removed++;
+      } else {
+        i++;
+      }
+    }
+    tree->number_of_points -= removed;
+  } else {
+    for (i = 0, j = 0; i < node->number_of_children; i++) {
+      child = node->children[i];
+      if (mo_nd_tree_weakly_dominates(point, child->ideal, num_obj)) {
+        /* The point dominates all points of the child */
+        number_of_points = tree->number_of_points;
+        mo_nd_tree_node_release(tree, child, 1);
+        removed += number_of_points - tree->number_of_points;
+        continue;
+      }
+      removed += mo_nd_tree_node_remove_dominated(tree, child, point);
+      if (mo_nd_tree_node_is_empty(child))
+        mo_nd_tree_node_release(tree, child, 1);
+      else
+        node->children[j++] = child;
+    }
+    node->number_of_children = j;
+
+    if (node->number_of_children == 1) {
+      /* Take over the content of the only child */
+      child = node->children[0];
+      node->is_leaf = child->is_leaf;
+      node->number_of_children = child->number_of_children;
+      node->number_of_points = child->number_of_points;
+      for (i = 0; i < child->number_of_children; i++)
+        node->children[i] = child->children[i];
+      for (i = 0; i < child->number_of_points; i++) {
+        node->points[i] = child->points[i];
+        node->items[i] = child->items[i];
+      }
+      mo_slab_put_block(tree->node_slab, child);
+    }
+  }
+
+  if ((removed > 0) && !mo_nd_tree_node_is_empty(node))
+    mo_nd_tree_node_update_bounds(node, num_obj);
+  return removed;
+}
+
+/**
+ * @brief Splits the overfull leaf into a node with up to number_of_objectives + 1 leaves.
+ *
+ * The first child receives the point that is the farthest from the others, each next child the point that
+ * is the farthest from the already chosen ones. The remaining points are added to the closest children.
+ */
+static void mo_nd_tree_node_split(mo_nd_tree_t *tree, mo_nd_tree_node_t *node) {
+
+  const size_t num_obj = tree->number_of_objectives;
+  const size_t number_of_points = node->number_of_points;
+  const size_t number_of_children = (num_obj + 1 < number_of_points) ? num_obj + 1 : number_of_points;
+  const double *points[MO_ND_TREE_MAX_LEAF_SIZE + 1];
+  void *items[MO_ND_TREE_MAX_LEAF_SIZE + 1];
+  double distances[MO_ND_TREE_MAX_LEAF_SIZE + 1];
+  int is_assigned[MO_ND_TREE_MAX_LEAF_SIZE + 1];
+  size_t i, j, c, best;
+  double diff, distance, best_distance;
+  mo_nd_tree_node_t *child;
+
+  assert(number_of_points == MO_ND_TREE_MAX_LEAF_SIZE + 1);
+  for (i = 0; i < number_of_points; i++) {
+    points[i] = node->points[i];
+    items[i] = node->items[i];
+    is_assigned[i] = 0;
+    distances[i] = 0;
+  }
+  /* The first seed is chosen w.r.t. all points */
+  for (i = 0; i < number_of_points; i++) {
+    for (j = i + 1; j < number_of_points; j++) {
+      for (c = 0, distance = 0; c < num_obj; c++) {
+        diff = points[i][c] - points[j][c];
+        distance += diff * diff;
+      }
+      distances[i] += distance;
+      distances[j] += distance;
+    }
+  }
+
+  node->is_leaf = 0;
+  node->number_of_points = 0;
+  node->number_of_children = 0;
+
+  /* Choose the seeds */
+  while (node->number_of_children < number_of_children) {
+    best = number_of_points;
+    best_distance = -1;
+    for (i = 0; i < number_of_points; i++) {
+      if (!is_assigned[i] && (distances[i] > best_distance)) {
+        best = i;
+        best_distance = distances[i];
+      }
+    }
+    assert(best < number_of_points);
+    is_assigned[best] = 1;
+    child = mo_nd_tree_node_allocate(tree);
+    mo_nd_tree_node_extend(child, points[best], num_obj);
+    child->points[0] = points[best];
+    child->items[0] = items[best];
+    child->number_of_points = 1;
+    if (node->number_of_children == 0) {
+      for (i = 0; i < number_of_points; i++)
+        distances[i] = 0;
+    }
+    node->children[node->number_of_children++] = child;
+    for (i = 0; i < number_of_points; i++) {
+      for (c = 0; c < num_obj; c++) {
+        diff = points[i][c] - points[best][c];
+        distances[i] += diff * diff;
+      }
+    }
+  }
+
+  /* Add the remaining points to the closest children */
+  for (i = 0; i < number_of_points; i++) {
+    if (is_assigned[i])
+      continue;
+    best = 0;
+    best_distance = mo_nd_tree_node_distance(node->children[0], points[i], num_obj);
+    for (j = 1; j < node->number_of_children; j++) {
+      distance = mo_nd_tree_node_distance(node->children[j], points[i], num_obj);
+      if (distance < best_distance) {
+        best = j;
+        best_distance = distance;
+      }
+    }
+    child = node->children[best];
+    assert(child->number_of_points < MO_ND_TREE_MAX_LEAF_SIZE);
+    mo_nd_tree_node_extend(child, points[i], num_obj);
+    child->points[child->number_of_points] = points[i];
+    child->items[child->number_of_points] = items[i];
+    child->number_of_points++;
+  }
+}
+
+/**
+ * @brief Allocates an empty ND-tree for points with the given number of objectives.
+ *
+ * @param number_of_objectives The number of objectives (at least 2).
+ * @param remove The function called for the items whose points are removed from the tree because they
+ * became dominated (can be NULL).
+ * @param userdata The data passed to the remove function.
+ */
+static mo_nd_tree_t *mo_nd_tree_allocate(const size_t number_of_objectives,
+                                         mo_nd_tree_remove_t remove,
+                                         void *userdata) {
+
+  mo_nd_tree_t *tree = (mo_nd_tree_t *) coco_allocate_memory(sizeof(*tree));
+
+  assert(number_of_objectives >= 2);
+  tree->number_of_objectives = number_of_objectives;
+  tree->number_of_points = 0;
+  tree->remove = remove;
+  tree->userdata = userdata;
+  tree->node_slab = mo_slab_allocate(mo_slab_align(sizeof(mo_nd_tree_node_t))
+      + 2 * number_of_objectives * sizeof(double) + (number_of_objectives + 1) * sizeof(mo_nd_tree_node_t *)
+      + (MO_ND_TREE_MAX_LEAF_SIZE + 1) * (sizeof(const double *) + sizeof(void *)), 64);
+  tree->root = mo_nd_tree_node_allocate(tree);
+  return tree;
+}
+
+/**
+ * @brief Frees the ND-tree (the points and items are not freed and the remove function is not called).
+ */
+static void mo_nd_tree_free(mo_nd_tree_t *tree) {
+  mo_slab_free(tree->node_slab);
+  coco_free_memory(tree);
+}
+
+/**
+ * @brief Returns whether the given point is weakly dominated by (or equal to) a point in the tree.
+ */
+static int mo_nd_tree_is_dominated(const mo_nd_tree_t *tree, const double *point) {
+  if (mo_nd_tree_node_is_empty(tree->root))
+    return 0;
+  return mo_nd_tree_node_is_dominated(tree, tree->root, point);
+}
+
+/**
+ * @brief Removes the points dominated by the given point from the tree (calling the remove function for
+ * their items) and inserts the point together with its item.
+ *
+ * @note The point must not be weakly dominated by a point in the tree (see mo_nd_tree_is_dominated()).
+ */
+static void mo_nd_tree_insert(mo_nd_tree_t *tree, const double *point, void *item) {
+
+  const size_t num_obj = tree->number_of_objectives;
+  mo_nd_tree_node_t *node = tree->root;
+  mo_nd_tree_node_t *child;
+  double distance, best_distance;
+  size_t i;
+
+  if (!mo_nd_tree_node_is_empty(node))
+    mo_nd_tree_node_remove_dominated(tree, node, point);
+  if (mo_nd_tree_node_is_empty(node)) {
+    /* All points were removed, the root becomes an empty leaf */
+    node->is_leaf = 1;
+    node->number_of_children = 0;
+    node->number_of_points = 0;
+  }
+
+  /* Descend to the closest leaf and extend the bounds on the way */
+  while (!node->is_leaf) {
+    mo_nd_tree_node_extend(node, point, num_obj);
+    child = node->children[0];
+    best_distance = mo_nd_tree_node_distance(child, point, num_obj);
+    for (i = 1; i < node->number_of_children; i++) {
+      distance = mo_nd_tree_node_distance(node->children[i], point, num_obj);
+      if (distance < best_distance) {
+        child = node->children[i];
+        best_distance = distance;
+      }
+    }
+    node = child;
+  }
+
+  mo_nd_tree_node_extend(node, point, num_obj);
+  node->points[node->number_of_points] = point;
+  node->items[node->number_of_points] = item;
+  node->number_of_points++;
+  tree->number_of_points++;
+  if (node->number_of_points > MO_ND_TREE_MAX_LEAF_SIZE)
+    mo_nd_tree_node_split(tree, node);
+}
+
+/**
+ * @brief Calls the visit function for the points of the subtree that are smaller than upper in all
+ * objectives (for all points if upper is NULL).
+ */
+static void mo_nd_tree_node_visit(const mo_nd_tree_t *tree,
+                                  const mo_nd_tree_node_t *node,
+                                  const double *upper,
+                                  mo_nd_tree_visit_t visit,
+                                  void *userdata) {
+  size_t i, j;
+  const size_t num_obj = tree->number_of_objectives;
+
+  if (upper != NULL) {
+    for (i = 0; i < num_obj; i++) {
+      if (node->ideal[i] >= upper[i])
+        return;
+    }
+  }
+
+  if (node->is_leaf) {
+    for (j = 0; j < node->number_of_points; j++) {
+      for (i = 0; (upper != NULL) && (i < num_obj); i++) {
+        if (node->points[j][i] >= upper[i])
+          break;
+      }
+      if ((upper == NULL) || (i == num_obj))
+        visit(node->points[j], node->items[j], userdata);
+    }
+  } else {
+    for (j = 0; j < node->number_of_children; j++)
+      mo_nd_tree_node_visit(tree, node->children[j], upper, visit, userdata);
+  }
+}
+
+/**
+ * @brief Calls the visit function for the points in the tree that are smaller than upper in all
+ * objectives (for all points if upper is NULL). Subtrees outside this region are skipped.
+ */
+static void mo_nd_tree_visit(const mo_nd_tree_t *tree,
+                             const double *upper,
+                             mo_nd_tree_visit_t visit,
+                             void *userdata) {
+  if (!mo_nd_tree_node_is_empty(tree->root))
+    mo_nd_tree_node_visit(tree, tree->root, upper, visit, userdata);
+}
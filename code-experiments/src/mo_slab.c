@@ -0,0 +1,219 @@
+/**
+ * @file mo_slab.c
+ * @brief Definitions of the slab allocator used to store the archives of nondominated solutions.
+ *
+ * A slab hands out memory blocks of a fixed size from large chunks. The chunks double in size, so that a
+ * slab holding n blocks consists of O(log n) chunks, the blocks (and therefore the solutions of an
+ * archive) lie next to each other in memory and the whole slab is freed in O(log n) time without visiting
+ * its blocks. Blocks that are given back to the slab are kept in a free list and reused.
+ *
+ * Besides fixed-size blocks, a slab can also hand out strings. Their sizes are rounded up to a power of
+ * two (times the alignment) and the strings that are given back to the slab are kept in a free list for
+ * each such size class, so that the memory taken by the strings is bounded by (about twice) the largest
+ * total size of the strings held at the same time.
+ *
+ * Since the first member of the slab is an AVL allocator, a slab with blocks of size sizeof(avl_node_t)
+ * can be used to allocate the nodes of an AVL tree (see mo_slab_attach_to_tree()).
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "coco.h"
+#include "coco_utilities.c"
+#include "mo_avl_tree.c"
+
+/**
+ * @brief The type used to align the memory blocks.
+ */
+typedef union {
+  void *pointer;
+  double number;
+  size_t size;
+} mo_slab_align_t;
+
+/**
+ * @brief The number of size classes of strings (the largest class holds strings of 2^39 aligned units).
+ */
+#define MO_SLAB_STRING_CLASSES 40
+
+/**
+ * @brief The header of a chunk of memory (the blocks follow the header).
+ */
+typedef struct mo_slab_chunk_s {
+  struct mo_slab_chunk_s *previous; /**< @brief The previously allocated chunk. */
+  mo_slab_align_t align;            /**< @brief Makes sure the blocks following the header are aligned. */
+} mo_slab_chunk_t;
+
+/**
+ * @brief The slab structure.
+ */
+typedef struct {
+  avl_allocator_t avl_allocator; /**< @brief The AVL allocator (must be the first member). */
+  size_t block_size;             /**< @brief The (aligned) size of a block. */
+  size_t chunk_capacity;         /**< @brief The number of blocks that fit into the next chunk. */
+  mo_slab_chunk_t *chunk;        /**< @brief The current (last allocated) chunk. */
+  char *next_free_byte;          /**< @brief The first unused byte of the current chunk. */
+  size_t remaining_bytes;        /**< @brief The number of unused bytes in the current chunk. */
+  void *free_blocks;             /**< @brief The list of blocks given back to the slab. */
+  void *free_strings[MO_SLAB_STRING_CLASSES]; /**< @brief The lists of strings given back to the slab (one
+                                                   for each size class). */
+} mo_slab_t;
+
+/**
+ * @brief Rounds the given size up to the multiple of the alignment.
+ */
+static size_t mo_slab_align(const size_t size) {
+  const size_t alignment = sizeof(mo_slab_align_t);
+  return ((size + alignment - 1) / alignment) * alignment;
+}
+
+/**
+ * @brief Returns a chunk of memory of the given size (the memory is aligned).
+ */
+static void *mo_slab_get_memory(mo_slab_t *slab, const size_t size) {
+
+  mo_slab_chunk_t *chunk;
+  size_t aligned_size = mo_slab_align(size);
+  size_t chunk_size;
+  void *memory;
+
+  if (aligned_size > slab->remaining_bytes) {
+    chunk_size = slab->chunk_capacity * slab->block_size;
+    if (chunk_size < aligned_size)
+      chunk_size = aligned_size;
+    chunk = (mo_slab_chunk_t *) coco_allocate_memory(sizeof(mo_slab_chunk_t) + chunk_size);
+    chunk->previous = slab->chunk;
+    slab->chunk = chunk;
+    slab->next_free_byte = (char *) (chunk + 1);
+    slab->remaining_bytes = chunk_size;
+    slab->chunk_capacity *= 2;
+  }
+
+  memory = slab->next_free_byte;
+  slab->next_free_byte += aligned_size;
+  slab->remaining_bytes -= aligned_size;
+  return memory;
+}
+
+/**
+ * @brief Returns a block of the slab (a previously freed block, if available).
+ */
+static void *mo_slab_get_block(mo_slab_t *slab) {
+
+  void *block;
+
+  if (slab->free_blocks != NULL) {
+    block = slab->free_blocks;
+    slab->free_blocks = *((void **) block);
+    return block;
+  }
+  return mo_slab_get_memory(slab, slab->block_size);
+}
+
+/**
+ * @brief Gives the block back to the slab, so that it can be reused.
+ */
+static void mo_slab_put_block(mo_slab_t *slab, void *block) {
+  *((void **) block) = slab->free_blocks;
+  slab->free_blocks = block;
+}
+
+/**
+ * @brief Returns the size class of a string of the given length (including the terminating null character).
+ */
+static size_t mo_slab_string_class(const size_t length) {
+  size_t string_class = 0;
+  while ((sizeof(mo_slab_align_t) << string_class) < length)
+    string_class++;
+  assert(string_class < MO_SLAB_STRING_CLASSES);
+  return string_class;
+}
+
+/**
+ * @brief Returns a copy of the given string stored in the slab (in a previously freed string of the same
+ * size class, if available).
+ */
+static char *mo_slab_strdup(mo_slab_t *slab, const char *string) {
+  size_t length = strlen(string) + 1;
+  size_t string_class = mo_slab_string_class(length);
+  char *copy;
+
+  if (slab->free_strings[string_class] != NULL) {
+    copy = (char *) slab->free_strings[string_class];
+    slab->free_strings[string_class] = *((void **) copy);
+  } else {
+    copy = (char *) mo_slab_get_memory(slab, sizeof(mo_slab_align_t) << string_class);
+  }
+  memcpy(copy, string, length);
+  return copy;
+}
+
+/**
+ * @brief Gives the string (returned by mo_slab_strdup()) back to the slab, so that its memory can be reused.
+ */
+static void mo_slab_put_string(mo_slab_t *slab, char *string) {
+  size_t string_class = mo_slab_string_class(strlen(string) + 1);
+  *((void **) string) = slab->free_strings[string_class];
+  slab->free_strings[string_class] = string;
+}
+
+/**
+ * @brief Allocates an AVL tree node from the slab (the AVL allocator of the slab).
+ */
+static avl_node_t *mo_slab_avl_allocate(avl_allocator_t *allocator) {
+  return (avl_node_t *) mo_slab_get_block((mo_slab_t *) allocator);
+}
+
+/**
+ * @brief Gives the AVL tree node back to the slab (the AVL deallocator of the slab).
+ */
+static void mo_slab_avl_deallocate(avl_allocator_t *allocator, avl_node_t *node) {
+  mo_slab_put_block((mo_slab_t *) allocator, node);
+}
+
+/**
+ * @brief Allocates a slab with blocks of the given size.
+ *
+ * @param block_size The size of a block in bytes.
+ * @param initial_capacity The number of blocks in the first chunk.
+ */
+static mo_slab_t *mo_slab_allocate(const size_t block_size, const size_t initial_capacity) {
+
+  mo_slab_t *slab = (mo_slab_t *) coco_allocate_memory(sizeof(*slab));
+  size_t i;
+
+  slab->avl_allocator.allocate = mo_slab_avl_allocate;
+  slab->avl_allocator.deallocate = mo_slab_avl_deallocate;
+  slab->block_size = mo_slab_align(block_size < sizeof(void *) ? sizeof(void *) : block_size);
+  slab->chunk_capacity = (initial_capacity > 0) ? initial_capacity : 1;
+  slab->chunk = NULL;
+  slab->next_free_byte = NULL;
+  slab->remaining_bytes = 0;
+  slab->free_blocks = NULL;
+  for (i = 0; i < MO_SLAB_STRING_CLASSES; i++)
+    slab->free_strings[i] = NULL;
+  return slab;
+}
+
+/**
+ * @brief Makes the tree allocate its nodes from the slab (the slab must contain blocks of the node size).
+ */
+static void mo_slab_attach_to_tree(mo_slab_t *slab, avl_tree_t *tree) {
+  assert(slab->block_size >= sizeof(avl_node_t));
+  tree->allocator = &slab->avl_allocator;
+}
+
+/**
+ * @brief Frees the slab together with all its blocks.
+ */
+static void mo_slab_free(mo_slab_t *slab) {
+
+  mo_slab_chunk_t *chunk, *previous;
+
+  for (chunk = slab->chunk; chunk != NULL; chunk = previous) {
+    previous = chunk->previous;
+    coco_free_memory(chunk);
+  }
+  coco_free_memory(slab);
+}
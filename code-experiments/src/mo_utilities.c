@@ -40,40 +40,59 @@ static double mo_get_norm(const double *first, const double *second, const size_
 }
 
 /**
- * @brief Creates normalized version of the given solution w.r.t. the given ROI.
+ * @brief Computes the scales used to normalize solutions w.r.t. the given ROI (see mo_normalize_into()).
+ *
+ * The scale of an objective equals 1 / ((nadir - ideal) * mo_discretization), so that a value is normalized
+ * and expressed in multiples of mo_discretization with a single multiplication. The scales should be
+ * computed once for each ROI and reused for all its solutions.
+ */
+static void mo_get_normalization_scales(const double *ideal,
+                                        const double *nadir,
+                                        const size_t num_obj,
+                                        double *scales) {
+  size_t i;
+
+  for (i = 0; i < num_obj; i++) {
+    assert((nadir[i] - ideal[i]) > mo_discretization);
+    scales[i] = 1.0 / ((nadir[i] - ideal[i]) * mo_discretization);
+  }
+}
+
+/**
+ * @brief Computes the normalized version of the given solution w.r.t. the given ROI and stores it into
+ * normalized_y (which must be allocated to hold num_obj values).
+ *
+ * The normalized values are rounded to multiples of mo_discretization using the scales precomputed by
+ * mo_get_normalization_scales() for the same ROI.
  *
  * If the optimum is known and the solution seems to be better than the extremes, it is
- * corrected (2 objectives are assumed).
- * The caller is responsible for freeing the allocated memory using coco_free_memory().
+ * corrected (for 2 objectives, a solution that reaches the ideal value in one objective is additionally
+ * corrected to be an extreme point).
  */
-static double *mo_normalize(const double *y,
-                            const double *ideal,
-                            const double *nadir,
-                            const size_t num_obj,
-                            const int is_opt_known) {
+static void mo_normalize_into(const double *y,
+                              const double *ideal,
+                              const double *nadir,
+                              const double *scales,
+                              const size_t num_obj,
+                              const int is_opt_known,
+                              double *normalized_y) {
 
   size_t i;
-  double *normalized_y = coco_allocate_vector(num_obj);
 
   for (i = 0; i < num_obj; i++) {
-    assert((nadir[i] - ideal[i]) > mo_discretization);
-    normalized_y[i] = (y[i] - ideal[i]) / (nadir[i] - ideal[i]);
-    normalized_y[i] = coco_double_round(normalized_y[i] / mo_discretization) * mo_discretization;
+    normalized_y[i] = coco_double_round((y[i] - ideal[i]) * scales[i]) * mo_discretization;
     if ((is_opt_known) && (normalized_y[i] < 0)) {
-      coco_warning("mo_normalize(): Adjusting %.15e to %.15e", y[i], ideal[i]);
+      coco_warning("mo_normalize_into(): Adjusting %.15e to %.15e", y[i], ideal[i]);
       normalized_y[i] = 0;
     }
   }
 
-  for (i = 0; i < num_obj; i++) {
-    assert(num_obj == 2);
+  for (i = 0; (num_obj == 2) && (i < num_obj); i++) {
     if ((is_opt_known) && coco_double_almost_equal(normalized_y[i], 0, mo_precision) && (normalized_y[1-i] < 1)) {
-      coco_warning("mo_normalize(): Adjusting %.15e to %.15e", y[1-i], nadir[1-i]);
+      coco_warning("mo_normalize_into(): Adjusting %.15e to %.15e", y[1-i], nadir[1-i]);
       normalized_y[1-i] = 1;
     }
   }
-
-  return normalized_y;
 }
 
 /**
@@ -138,26 +157,31 @@ static int mo_is_within_ROI(const double *normalized_y, const size_t num_obj) {
  * @brief Computes and returns the minimal normalized distance of the point normalized_y from the ROI
  * (equals 0 if within the ROI).
  *
- *  @note Assumes num_obj = 2 and normalized_y >= 0
+ * Performs the check of mo_is_within_ROI() and the computation of the distance in a single pass.
+ *
+ *  @note Assumes normalized_y >= 0
  */
 static double mo_get_distance_to_ROI(const double *normalized_y, const size_t num_obj) {
 
-  double diff_0, diff_1;
-
-  if (mo_is_within_ROI(normalized_y, num_obj))
-    return 0;
-
-  assert(num_obj == 2);
-  assert(normalized_y[0] >= 0);
-  assert(normalized_y[1] >= 0);
+  size_t i, number_of_outside = 0;
+  int within = 1;
+  double diff, last_diff = 0, distance = 0;
 
-  diff_0 = normalized_y[0] - 1;
-  diff_1 = normalized_y[1] - 1;
-  if ((diff_0 > 0) && (diff_1 > 0)) {
-    return sqrt(pow(diff_0, 2) + pow(diff_1, 2));
+  for (i = 0; i < num_obj; i++) {
+    assert((normalized_y[i] >= 0) || coco_double_almost_equal(normalized_y[i], 0, mo_precision));
+    diff = normalized_y[i] - 1;
+    if (diff > 0) {
+      if (!coco_double_almost_equal(normalized_y[i], 1, mo_precision))
+        within = 0;
+      distance += pow(diff, 2);
+      last_diff = diff;
+      number_of_outside++;
+    }
   }
-  else if (diff_0 > 0)
-    return diff_0;
-  else
-    return diff_1;
+  if (within)
+    return 0;
+  /* If the point lies outside the ROI in a single objective, the distance is the difference in it */
+  if (number_of_outside == 1)
+    return last_diff;
+  return sqrt(distance);
 }
@@ -0,0 +1,436 @@
+/**
+ * @file observer_memory.c
+ * @brief Implementation of the memory observer.
+ *
+ * The memory observer keeps the run-length data (the numbers of evaluations needed to hit the targets)
+ * of all observed problems in memory instead of writing them to files. The data can be accessed with the
+ * coco_observer_memory_* functions and can be optionally exported to the bbob format with
+ * coco_observer_memory_export.
+ */
+
+#include "coco.h"
+#include "coco_utilities.c"
+
+static coco_problem_t *logger_memory(coco_observer_t *observer, coco_problem_t *problem);
+static void logger_memory_free(void *logger);
+static void logger_memory_data_nullify_observer(void *logger_data);
+
+/**
+ * @brief The run-length data of a single problem.
+ *
+ * For each target hit, the target, the number of evaluations when it was first hit and the best value
+ * (distance to the optimal value) at that time are stored.
+ */
+typedef struct {
+  char *problem_id;              /**< @brief The problem id. */
+  size_t function;               /**< @brief Suite-dependent function number. */
+  size_t dimension;              /**< @brief The number of variables. */
+  size_t instance;               /**< @brief Suite-dependent instance number. */
+  double optimal_value;          /**< @brief The optimal value (or a reference value) of the problem. */
+  int is_opt_known;              /**< @brief Whether the optimal value is known. */
+
+  size_t number_of_hits;         /**< @brief The number of targets hits. */
+  size_t capacity;               /**< @brief The size of the allocated arrays. */
+  double *targets;               /**< @brief The hit targets. */
+  double *values;                /**< @brief The best values (distances to the optimal value) at the hits. */
+  size_t *evaluations;           /**< @brief The numbers of evaluations at the hits. */
+
+  size_t number_of_evaluations;  /**< @brief The number of evaluations performed on the problem. */
+  double best_value;             /**< @brief The best value (distance to the optimal value) found so far. */
+  int is_exported;               /**< @brief Whether the run has already been exported. */
+} observer_memory_run_t;
+
+/**
+ * @brief The memory observer data type.
+ *
+ * The observed problem is needed to break the link between the logger and the observer when the observer
+ * is freed before the problem (see also observer_bbob_data_t).
+ */
+typedef struct {
+  coco_problem_t *observed_problem;  /**< @brief Pointer to the observed problem (NULL if none is observed) */
+  char *suite_name;                  /**< @brief The name of the suite of the observed problems. */
+  size_t number_of_runs;             /**< @brief The number of stored runs. */
+  size_t capacity;                   /**< @brief The size of the allocated array of runs. */
+  observer_memory_run_t **runs;      /**< @brief The stored runs. */
+  int is_folder_created;             /**< @brief Whether the result folder has already been created. */
+} observer_memory_data_t;
+
+/**
+ * @brief Allocates a new run for the given problem.
+ */
+static observer_memory_run_t *observer_memory_run_allocate(const coco_problem_t *problem) {
+
+  observer_memory_run_t *run = (observer_memory_run_t *) coco_allocate_memory(sizeof(*run));
+
+  run->problem_id = coco_strdup(problem->problem_id);
+  run->function = problem->suite_dep_function;
+  run->dimension = problem->number_of_variables;
+  run->instance = problem->suite_dep_instance;
+  run->optimal_value = (problem->best_value != NULL) ? problem->best_value[0] : 0;
+  run->is_opt_known = problem->is_opt_known;
+
+  run->number_of_hits = 0;
+  run->capacity = 16;
+  run->targets = coco_allocate_vector(run->capacity);
+  run->values = coco_allocate_vector(run->capacity);
+  run->evaluations = coco_allocate_vector_size_t(run->capacity);
+
+  run->number_of_evaluations = 0;
+  run->best_value = DBL_MAX;
+  run->is_exported = 0;
+  return run;
+}
+
+/**
+ * @brief Appends a target hit to the run.
+ */
+static void observer_memory_run_add_hit(observer_memory_run_t *run,
+                                        const double target,
+                                        const double value,
+                                        const size_t evaluation) {
+  double *targets, *values;
+  size_t *evaluations;
+
+  if (run->number_of_hits == run->capacity) {
+    run->capacity *= 2;
+    targets = coco_allocate_vector(run->capacity);
+    values = coco_allocate_vector(run->capacity);
+    evaluations = coco_allocate_vector_size_t(run->capacity);
+    memcpy(targets, run->targets, run->number_of_hits * sizeof(double));
+    memcpy(values, run->values, run->number_of_hits * sizeof(double));
+    memcpy(evaluations, run->evaluations, run->number_of_hits * sizeof(size_t));
+    coco_free_memory(run->targets);
+    coco_free_memory(run->values);
+    coco_free_memory(run->evaluations);
+    run->targets = targets;
+    run->values = values;
+    run->evaluations = evaluations;
+  }
+  run->targets[run->number_of_hits] = target;
+  run->values[run->number_of_hits] = value;
+  run->evaluations[run->number_of_hits] = evaluation;
+  run->number_of_hits++;
+}
+
+/**
+ * @brief Frees the given run.
+ */
+static void observer_memory_run_free(observer_memory_run_t *run) {
+  coco_free_memory(run->problem_id);
+  coco_free_memory(run->targets);
+  coco_free_memory(run->values);
+  coco_free_memory(run->evaluations);
+  coco_free_memory(run);
+}
+
+/**
+ * @brief Adds a new run for the given problem to the observer data and returns it.
+ */
+static observer_memory_run_t *observer_memory_add_run(observer_memory_data_t *data, const coco_problem_t *problem) {
+
+  observer_memory_run_t **runs;
+  size_t i;
+
+  if (data->number_of_runs == data->capacity) {
+    data->capacity = (data->capacity == 0) ? 16 : 2 * data->capacity;
+    runs = (observer_memory_run_t **) coco_allocate_memory(data->capacity * sizeof(observer_memory_run_t *));
+    for (i = 0; i < data->number_of_runs; i++)
+      runs[i] = data->runs[i];
+    if (data->runs != NULL)
+      coco_free_memory(data->runs);
+    data->runs = runs;
+  }
+  data->runs[data->number_of_runs] = observer_memory_run_allocate(problem);
+  return data->runs[data->number_of_runs++];
+}
+
+/**
+ * @brief Frees all runs stored in the observer data.
+ */
+static void observer_memory_clear_runs(observer_memory_data_t *data) {
+
+  size_t i;
+
+  for (i = 0; i < data->number_of_runs; i++)
+    observer_memory_run_free(data->runs[i]);
+  data->number_of_runs = 0;
+}
+
+/**
+ * @brief Frees the memory of the given observer_memory_data_t object.
+ */
+static void observer_memory_data_free(void *stuff) {
+
+  observer_memory_data_t *data = (observer_memory_data_t *) stuff;
+  coco_problem_t *problem;
+
+  /* Make sure that the observed problem's pointer to the observer points to NULL */
+  if (data->observed_problem != NULL) {
+    problem = (coco_problem_t *) data->observed_problem;
+    if (problem->data != NULL) {
+      logger_memory_data_nullify_observer(coco_problem_transformed_get_data(problem));
+    }
+    data->observed_problem = NULL;
+  }
+
+  observer_memory_clear_runs(data);
+  if (data->runs != NULL) {
+    coco_free_memory(data->runs);
+    data->runs = NULL;
+  }
+  if (data->suite_name != NULL) {
+    coco_free_memory(data->suite_name);
+    data->suite_name = NULL;
+  }
+}
+
+/**
+ * @brief Initializes the memory observer.
+ *
+ * The memory observer has no specific options. It uses the general observer options number_target_triggers,
+ * log_target_precision and lin_target_precision to construct the targets (in the same way as the bbob
+ * observer) and does not create the result folder unless the data is exported.
+ */
+static void observer_memory(coco_observer_t *observer, const char *options, coco_option_keys_t **option_keys) {
+
+  observer_memory_data_t *observer_data;
+
+  *option_keys = NULL;
+
+  observer_data = (observer_memory_data_t *) coco_allocate_memory(sizeof(*observer_data));
+  observer_data->observed_problem = NULL;
+  observer_data->suite_name = NULL;
+  observer_data->number_of_runs = 0;
+  observer_data->capacity = 0;
+  observer_data->runs = NULL;
+  observer_data->is_folder_created = 0;
+
+  observer->logger_allocate_function = logger_memory;
+  observer->logger_free_function = logger_memory_free;
+  observer->restart_function = NULL;
+  observer->data_free_function = observer_memory_data_free;
+  observer->data = observer_data;
+
+  (void) options; /* To silence the compiler */
+}
+
+/**
+ * @brief Returns the memory observer data or raises an error if the observer is not a memory observer.
+ */
+static observer_memory_data_t *observer_memory_get_data(const coco_observer_t *observer, const char *caller) {
+  if ((observer == NULL) || (observer->data_free_function != observer_memory_data_free)) {
+    coco_error("%s(): The given observer is not a memory observer", caller);
+    return NULL; /* Never reached */
+  }
+  return (observer_memory_data_t *) observer->data;
+}
+
+/**
+ * @brief Returns the run with the given index or raises an error if the index is out of range.
+ */
+static observer_memory_run_t *observer_memory_get_run(const coco_observer_t *observer,
+                                                      const size_t run_index,
+                                                      const char *caller) {
+  observer_memory_data_t *data = observer_memory_get_data(observer, caller);
+  if (run_index >= data->number_of_runs) {
+    coco_error("%s(): Run index %lu out of range (number of runs = %lu)", caller, (unsigned long) run_index,
+        (unsigned long) data->number_of_runs);
+    return NULL; /* Never reached */
+  }
+  return data->runs[run_index];
+}
+
+/**
+ * The runs are stored in the order in which the problems were observed. The run of the currently observed
+ * problem is already included and its data is updated with each evaluation.
+ */
+size_t coco_observer_memory_get_number_of_runs(const coco_observer_t *observer) {
+  return observer_memory_get_data(observer, "coco_observer_memory_get_number_of_runs")->number_of_runs;
+}
+
+/**
+ * @return The id of the problem of the given run.
+ */
+const char *coco_observer_memory_get_problem_id(const coco_observer_t *observer, const size_t run_index) {
+  return observer_memory_get_run(observer, run_index, "coco_observer_memory_get_problem_id")->problem_id;
+}
+
+/**
+ * @return The number of evaluations performed in the given run.
+ */
+size_t coco_observer_memory_get_evaluations(const coco_observer_t *observer, const size_t run_index) {
+  return observer_memory_get_run(observer, run_index,
+      "coco_observer_memory_get_evaluations")->number_of_evaluations;
+}
+
+/**
+ * @return The number of targets hit in the given run (the size of the arrays needed by
+ * coco_observer_memory_get_hits).
+ */
+size_t coco_observer_memory_get_number_of_hits(const coco_observer_t *observer, const size_t run_index) {
+  return observer_memory_get_run(observer, run_index, "coco_observer_memory_get_number_of_hits")->number_of_hits;
+}
+
+/**
+ * Copies the targets hit in the given run and the numbers of evaluations when they were first hit into the
+ * given arrays, which must be allocated to hold coco_observer_memory_get_number_of_hits values.
+ *
+ * @note Since a single evaluation can hit more than one target, each recorded target is the hardest
+ * target hit at that evaluation.
+ */
+void coco_observer_memory_get_hits(const coco_observer_t *observer,
+                                   const size_t run_index,
+                                   double *targets,
+                                   size_t *evaluations) {
+  observer_memory_run_t *run = observer_memory_get_run(observer, run_index, "coco_observer_memory_get_hits");
+  size_t i;
+
+  for (i = 0; i < run->number_of_hits; i++) {
+    if (targets != NULL)
+      targets[i] = run->targets[i];
+    if (evaluations != NULL)
+      evaluations[i] = run->evaluations[i];
+  }
+}
+
+/**
+ * Frees the data of all finished runs (the run of the currently observed problem is kept). Useful when
+ * very many problems are observed and their data has already been processed.
+ */
+void coco_observer_memory_clear(coco_observer_t *observer) {
+
+  observer_memory_data_t *data = observer_memory_get_data(observer, "coco_observer_memory_clear");
+  observer_memory_run_t *current_run = NULL;
+
+  if ((data->observed_problem != NULL) && (data->number_of_runs > 0)) {
+    current_run = data->runs[data->number_of_runs - 1];
+    data->number_of_runs--;
+  }
+  observer_memory_clear_runs(data);
+  if (current_run != NULL)
+    data->runs[data->number_of_runs++] = current_run;
+}
+
+/**
+ * @brief Outputs a line in the bbob data format (without decision variables).
+ */
+static void observer_memory_export_line(FILE *file,
+                                        const observer_memory_run_t *run,
+                                        const size_t evaluation,
+                                        const double value) {
+  fprintf(file, "%lu %lu %+10.9e %+10.9e %+10.9e\n", (unsigned long) evaluation, 0UL, value,
+      value + run->optimal_value, value + run->optimal_value);
+}
+
+/**
+ * Writes the data of all runs that have not been exported yet to the result folder in the bbob format (one
+ * .info file per function and one .dat and .tdat file per function and dimension). The .dat files contain a
+ * line for each target hit, while the .tdat files contain only the line with the final number of
+ * evaluations. The decision variables are not stored and therefore not output. Each run is exported only
+ * once, so the run of the currently observed problem should be exported only after its optimization is
+ * finished (its later evaluations are not exported).
+ *
+ * The result folder is created when this function is called for the first time (if a folder with the
+ * same name already exists, a unique name is chosen in the same way as by the other observers), while the
+ * later calls append the new runs to the files in this folder.
+ */
+void coco_observer_memory_export(coco_observer_t *observer) {
+
+  observer_memory_data_t *data = observer_memory_get_data(observer, "coco_observer_memory_export");
+  observer_memory_run_t *run, *other;
+  char *path, *file_name, *relative_path;
+  FILE *info_file, *dat_file, *tdat_file;
+  size_t i, j, k;
+
+  for (i = 0; i < data->number_of_runs; i++) {
+    if (!data->runs[i]->is_exported)
+      break;
+  }
+  if (i == data->number_of_runs)
+    return;
+
+  /* Create a unique result folder when exporting for the first time */
+  if (!data->is_folder_created) {
+    path = coco_allocate_string(COCO_PATH_MAX + 1);
+    memcpy(path, observer->result_folder, strlen(observer->result_folder) + 1);
+    coco_create_unique_directory(&path);
+    coco_free_memory(observer->result_folder);
+    observer->result_folder = path;
+    data->is_folder_created = 1;
+    coco_info("Results will be output to folder %s", path);
+  }
+
+  /* Each pair of function and dimension is exported together */
+  for (i = 0; i < data->number_of_runs; i++) {
+    if (data->runs[i]->is_exported)
+      continue;
+    run = data->runs[i];
+
+    relative_path = coco_strdupf("data_f%lu", (unsigned long) run->function);
+    path = coco_allocate_string(COCO_PATH_MAX + 1);
+    memcpy(path, observer->result_folder, strlen(observer->result_folder) + 1);
+    coco_join_path(path, COCO_PATH_MAX, relative_path, NULL);
+    coco_create_directory(path);
+    coco_free_memory(path);
+    coco_free_memory(relative_path);
+    relative_path = coco_strdupf("data_f%lu/bbobexp_f%lu_DIM%lu", (unsigned long) run->function,
+        (unsigned long) run->function, (unsigned long) run->dimension);
+
+    path = coco_allocate_string(COCO_PATH_MAX + 1);
+    memcpy(path, observer->result_folder, strlen(observer->result_folder) + 1);
+    file_name = coco_strdupf("bbobexp_f%lu.info", (unsigned long) run->function);
+    coco_join_path(path, COCO_PATH_MAX, file_name, NULL);
+    info_file = fopen(path, "a");
+    coco_free_memory(file_name);
+    coco_free_memory(path);
+
+    path = coco_allocate_string(COCO_PATH_MAX + 1);
+    memcpy(path, observer->result_folder, strlen(observer->result_folder) + 1);
+    file_name = coco_strdupf("%s.dat", relative_path);
+    coco_join_path(path, COCO_PATH_MAX, file_name, NULL);
+    dat_file = fopen(path, "a");
+    coco_free_memory(file_name);
+    coco_free_memory(path);
+
+    path = coco_allocate_string(COCO_PATH_MAX + 1);
+    memcpy(path, observer->result_folder, strlen(observer->result_folder) + 1);
+    file_name = coco_strdupf("%s.tdat", relative_path);
+    coco_join_path(path, COCO_PATH_MAX, file_name, NULL);
+    tdat_file = fopen(path, "a");
+    coco_free_memory(file_name);
+    coco_free_memory(path);
+
+    if ((info_file == NULL) || (dat_file == NULL) || (tdat_file == NULL)) {
+      coco_error("coco_observer_memory_export(): Failed to open files in %s", observer->result_folder);
+      return; /* Never reached */
+    }
+
+    fprintf(info_file, "suite = '%s', funcId = %lu, DIM = %lu, Precision = %.3e, algId = '%s', "
+        "coco_version = '%s', logger = '%s', data_format = '%s'\n%%\n%s.dat",
+        data->suite_name, (unsigned long) run->function, (unsigned long) run->dimension, pow(10, -8),
+        observer->algorithm_name, coco_version, observer->observer_name, logger_bbob_data_format,
+        relative_path);
+
+    for (j = i; j < data->number_of_runs; j++) {
+      other = data->runs[j];
+      if (other->is_exported || (other->function != run->function) || (other->dimension != run->dimension))
+        continue;
+      other->is_exported = 1;
+
+      fprintf(info_file, ", %lu:%lu|%.1e", (unsigned long) other->instance,
+          (unsigned long) other->number_of_evaluations, other->best_value);
+      fprintf(dat_file, logger_bbob_header, other->is_opt_known ? "Fopt" : "Fref", other->optimal_value);
+      fprintf(tdat_file, logger_bbob_header, other->is_opt_known ? "Fopt" : "Fref", other->optimal_value);
+      for (k = 0; k < other->number_of_hits; k++)
+        observer_memory_export_line(dat_file, other, other->evaluations[k], other->values[k]);
+      if (other->number_of_evaluations > 0)
+        observer_memory_export_line(tdat_file, other, other->number_of_evaluations, other->best_value);
+    }
+    fprintf(info_file, "\n");
+
+    fclose(info_file);
+    fclose(dat_file);
+    fclose(tdat_file);
+    coco_free_memory(relative_path);
+  }
+}
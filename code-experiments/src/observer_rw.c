@@ -53,8 +53,10 @@ static void logger_rw_free(void *logger);
  * are better than previous ones (1). This is applicable only for the single-objective problems, where the
  * default value is 0. For multi-objective problems, all solutions are always logged.
  *
- * - "log_time: 0/1" determines whether the time needed to evaluate each solution is logged (0) or not (1).
- * The default value is 0.
+ * - "log_time: 0/1" determines whether the time needed to evaluate each solution is logged (1) or not (0).
+ * Times are measured with a monotonic clock and logged in seconds. When the logger is finalized, the
+ * percentiles (p50, p90, p99 and max) of the times of function and constraint evaluations are appended
+ * to the output file. The default value is 0.
  */
 static void observer_rw(coco_observer_t *observer, const char *options, coco_option_keys_t **option_keys) {
 
@@ -0,0 +1,441 @@
+/**
+ * @file socket_cache.c
+ * @brief Definitions of functions regarding the cache of evaluations by external evaluators.
+ *
+ * Evaluations by external evaluators (see socket_communication.c) can be expensive, while algorithms
+ * (especially on problems with integer variables) often evaluate the same solutions again. The cache
+ * keeps the results of the most recent evaluations in memory and, optionally, in a file that is shared
+ * across runs and processes.
+ *
+ * The evaluations are identified by a key, which consists of the evaluation type, the function, instance,
+ * dimension and number of values, the suite name and the exact bits of the x-values (integer variables
+ * are rounded first, as they are when sent to the evaluator). The keys are looked up in a hash table,
+ * while a list of all entries ordered from the most to the least recently used one determines which
+ * entry is removed when the cache is full.
+ *
+ * The cache file consists of a header, followed by a sequence of records:
+ * - header: the 8 characters "COCOCAC1", followed by the 32-bit unsigned integer 0x01020304 (used to
+ * determine the byte order);
+ * - record: the length of the key and the number of values as 32-bit unsigned integers, followed by the
+ * key and the values (doubles).
+ * The records are only ever appended (on POSIX platforms, each with a single write() on the descriptor
+ * opened for appending), so that several processes can use the same file at once. The file is read when the cache is created and the records appended by other
+ * processes are read whenever an evaluation is not found in memory.
+ *
+ * Logs of recorded evaluations (see socket_cache_allocate_log()) have the same format, so that they can
+ * be replayed by the replay server (see replay_evaluator.c in code-experiments/rw-problems/replay) and
+ * used as cache files.
+ */
+
+#include "coco_platform.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "coco.h"
+#include "coco_internal.h"
+#include "coco_utilities.c"
+
+/** @brief The number of entries kept in memory when only the cache file is given. */
+#define SOCKET_CACHE_DEFAULT_SIZE 100000
+
+/** @brief The maximal length of a key in the cache file (longer ones denote a corrupted file). */
+#define SOCKET_CACHE_MAX_KEY_LENGTH (1UL << 24)
+
+/**
+ * @brief An evaluation stored in the cache.
+ */
+typedef struct socket_cache_entry_s {
+  unsigned long hash;            /**< @brief The hash of the key. */
+  char *key;                     /**< @brief The key (see socket_cache_set_key()). */
+  size_t key_length;             /**< @brief The length of the key in bytes. */
+  double *values;                /**< @brief The values of the evaluation. */
+  size_t number_of_values;       /**< @brief The number of values. */
+  struct socket_cache_entry_s *next_in_bucket;
+                                 /**< @brief The next entry in the same bucket of the hash table. */
+  struct socket_cache_entry_s *newer;
+                                 /**< @brief The entry used after this one (NULL for the newest one). */
+  struct socket_cache_entry_s *older;
+                                 /**< @brief The entry used before this one (NULL for the oldest one). */
+} socket_cache_entry_t;
+
+/**
+ * @brief The cache of evaluations.
+ */
+typedef struct {
+  size_t capacity;               /**< @brief The maximal number of entries kept in memory. */
+  size_t number_of_entries;      /**< @brief The number of entries in memory. */
+  size_t number_of_buckets;      /**< @brief The number of buckets of the hash table (a power of two). */
+  socket_cache_entry_t **buckets;/**< @brief The hash table. */
+  socket_cache_entry_t *newest;  /**< @brief The most recently used entry. */
+  socket_cache_entry_t *oldest;  /**< @brief The least recently used entry. */
+  char *key;                     /**< @brief The current key (set by socket_cache_set_key()). */
+  size_t key_length;             /**< @brief The length of the current key. */
+  size_t key_size;               /**< @brief The allocated size of the current key. */
+  unsigned long hash;            /**< @brief The hash of the current key. */
+  FILE *file;                    /**< @brief The cache file (NULL if there is none). */
+  long file_offset;              /**< @brief The position in the file up to which the records were read. */
+  int append_only;               /**< @brief Whether the records are only appended to the file (and not
+                                      stored in memory or read). */
+  size_t hits;                   /**< @brief The number of evaluations found in the cache. */
+  size_t misses;                 /**< @brief The number of evaluations not found in the cache. */
+} socket_cache_t;
+
+/**
+ * @brief Returns the 32-bit FNV-1a hash of the given bytes.
+ */
+static unsigned long socket_cache_hash(const char *bytes, const size_t length) {
+  unsigned long hash = 2166136261UL;
+  size_t i;
+
+  for (i = 0; i < length; i++) {
+    hash ^= (unsigned long) (unsigned char) bytes[i];
+    hash = (hash * 16777619UL) & 0xFFFFFFFFUL;
+  }
+  return hash;
+}
+
+/**
+ * @brief Removes the entry from the list of entries ordered by their use.
+ */
+static void socket_cache_unlink(socket_cache_t *cache, socket_cache_entry_t *entry) {
+  if (entry->newer != NULL)
+    entry->newer->older = entry->older;
+  else
+    cache->newest = entry->older;
+  if (entry->older != NULL)
+    entry->older->newer = entry->newer;
+  else
+    cache->oldest = entry->newer;
+}
+
+/**
+ * @brief Puts the entry at the front of the list of entries ordered by their use.
+ */
+static void socket_cache_make_newest(socket_cache_t *cache, socket_cache_entry_t *entry) {
+  entry->newer = NULL;
+  entry->older = cache->newest;
+  if (cache->newest != NULL)
+    cache->newest->newer = entry;
+  else
+    cache->oldest = entry;
+  cache->newest = entry;
+}
+
+/**
+ * @brief Returns the entry with the given key (or NULL if there is none).
+ */
+static socket_cache_entry_t *socket_cache_find(const socket_cache_t *cache,
+                                               const char *key,
+                                               const size_t key_length,
+                                               const unsigned long hash) {
+  socket_cache_entry_t *entry;
+
+  for (entry = cache->buckets[hash & (cache->number_of_buckets - 1)]; entry != NULL;
+      entry = entry->next_in_bucket) {
+    if ((entry->hash == hash) && (entry->key_length == key_length) && (memcmp(entry->key, key, key_length) == 0))
+      return entry;
+  }
+  return NULL;
+}
+
+/**
+ * @brief Removes the least recently used entry from the cache.
+ */
+static void socket_cache_remove_oldest(socket_cache_t *cache) {
+  socket_cache_entry_t *entry = cache->oldest, **pointer;
+
+  for (pointer = &cache->buckets[entry->hash & (cache->number_of_buckets - 1)]; *pointer != entry;
+      pointer = &(*pointer)->next_in_bucket)
+    ;
+  *pointer = entry->next_in_bucket;
+  socket_cache_unlink(cache, entry);
+  coco_free_memory(entry->key);
+  coco_free_memory(entry->values);
+  coco_free_memory(entry);
+  cache->number_of_entries--;
+}
+
+/**
+ * @brief Stores the values with the given key in memory (replacing the values stored with the same key)
+ * and makes the entry the most recently used one.
+ */
+static void socket_cache_store(socket_cache_t *cache,
+                               const char *key,
+                               const size_t key_length,
+                               const unsigned long hash,
+                               const size_t number_of_values,
+                               const double *values) {
+  socket_cache_entry_t *entry = socket_cache_find(cache, key, key_length, hash);
+  socket_cache_entry_t **bucket;
+
+  if (entry != NULL) {
+    socket_cache_unlink(cache, entry);
+    if (entry->number_of_values != number_of_values) {
+      coco_free_memory(entry->values);
+      entry->values = coco_allocate_vector(number_of_values);
+      entry->number_of_values = number_of_values;
+    }
+  } else {
+    if (cache->number_of_entries == cache->capacity)
+      socket_cache_remove_oldest(cache);
+    entry = (socket_cache_entry_t *) coco_allocate_memory(sizeof(*entry));
+    entry->hash = hash;
+    entry->key = (char *) coco_allocate_memory(key_length);
+    memcpy(entry->key, key, key_length);
+    entry->key_length = key_length;
+    entry->values = coco_allocate_vector(number_of_values);
+    entry->number_of_values = number_of_values;
+    bucket = &cache->buckets[hash & (cache->number_of_buckets - 1)];
+    entry->next_in_bucket = *bucket;
+    *bucket = entry;
+    cache->number_of_entries++;
+  }
+  memcpy(entry->values, values, number_of_values * sizeof(double));
+  socket_cache_make_newest(cache, entry);
+}
+
+/**
+ * @brief Reads the records appended to the cache file since it was last read and stores them in memory.
+ *
+ * A record that is not complete yet (because another process is still writing it) is read next time.
+ */
+static void socket_cache_read_file(socket_cache_t *cache) {
+  unsigned int lengths[2];
+  char *key;
+  double *values;
+  size_t key_length, number_of_values;
+  int complete;
+
+  if ((cache->file == NULL) || cache->append_only || (fseek(cache->file, cache->file_offset, SEEK_SET) != 0))
+    return;
+  while (fread(lengths, sizeof(unsigned int), 2, cache->file) == 2) {
+    key_length = lengths[0];
+    number_of_values = lengths[1];
+    if ((key_length == 0) || (key_length > SOCKET_CACHE_MAX_KEY_LENGTH)
+        || (number_of_values > SOCKET_CACHE_MAX_KEY_LENGTH)) {
+      coco_warning("socket_cache_read_file(): The cache file is corrupted, it is not used anymore");
+      fclose(cache->file);
+      cache->file = NULL;
+      return;
+    }
+    key = (char *) coco_allocate_memory(key_length);
+    values = coco_allocate_vector(number_of_values + 1);
+    complete = (fread(key, 1, key_length, cache->file) == key_length)
+        && (fread(values, sizeof(double), number_of_values, cache->file) == number_of_values);
+    if (complete) {
+      socket_cache_store(cache, key, key_length, socket_cache_hash(key, key_length), number_of_values, values);
+      cache->file_offset = ftell(cache->file);
+    }
+    coco_free_memory(key);
+    coco_free_memory(values);
+    if (!complete)
+      break;
+  }
+  clearerr(cache->file);
+}
+
+/**
+ * @brief Opens the cache file (creating it if it does not exist yet) and reads its records.
+ */
+static void socket_cache_open_file(socket_cache_t *cache, const char *file_name) {
+  const char magic[] = "COCOCAC1";
+  char header[sizeof(magic) - 1];
+  unsigned int byte_order = 0x01020304, file_byte_order;
+
+  if ((cache->file = fopen(file_name, "a+b")) == NULL) {
+    coco_warning("socket_cache_open_file(): Failed to open the cache file %s, it is not used", file_name);
+    return;
+  }
+  fseek(cache->file, 0, SEEK_END);
+  if (ftell(cache->file) == 0) {
+    fwrite(magic, sizeof(char), strlen(magic), cache->file);
+    fwrite(&byte_order, sizeof(unsigned int), 1, cache->file);
+    fflush(cache->file);
+  }
+  rewind(cache->file);
+  if ((fread(header, sizeof(char), sizeof(header), cache->file) != sizeof(header))
+      || (memcmp(header, magic, sizeof(header)) != 0)
+      || (fread(&file_byte_order, sizeof(unsigned int), 1, cache->file) != 1)
+      || (file_byte_order != byte_order)) {
+    coco_warning("socket_cache_open_file(): %s is not a cache file of this platform, it is not used",
+        file_name);
+    fclose(cache->file);
+    cache->file = NULL;
+    return;
+  }
+  cache->file_offset = ftell(cache->file);
+  socket_cache_read_file(cache);
+}
+
+/**
+ * @brief Allocates a cache that keeps at most capacity evaluations in memory and uses the given cache
+ * file (if file_name is not NULL). If capacity is 0, SOCKET_CACHE_DEFAULT_SIZE is used.
+ */
+static socket_cache_t *socket_cache_allocate(const size_t capacity, const char *file_name) {
+  socket_cache_t *cache = (socket_cache_t *) coco_allocate_memory(sizeof(*cache));
+  size_t i;
+
+  cache->capacity = (capacity > 0) ? capacity : SOCKET_CACHE_DEFAULT_SIZE;
+  cache->number_of_entries = 0;
+  for (cache->number_of_buckets = 1; cache->number_of_buckets < cache->capacity; cache->number_of_buckets *= 2)
+    ;
+  cache->buckets = (socket_cache_entry_t **) coco_allocate_memory(cache->number_of_buckets
+      * sizeof(socket_cache_entry_t *));
+  for (i = 0; i < cache->number_of_buckets; i++)
+    cache->buckets[i] = NULL;
+  cache->newest = NULL;
+  cache->oldest = NULL;
+  cache->key = NULL;
+  cache->key_length = 0;
+  cache->key_size = 0;
+  cache->hash = 0;
+  cache->file = NULL;
+  cache->file_offset = 0;
+  cache->append_only = 0;
+  cache->hits = 0;
+  cache->misses = 0;
+  if (file_name != NULL)
+    socket_cache_open_file(cache, file_name);
+  return cache;
+}
+
+/**
+ * @brief Allocates a cache that only appends the inserted evaluations to the given file (a log of
+ * recorded evaluations, which is not read).
+ */
+static socket_cache_t *socket_cache_allocate_log(const char *file_name) {
+  socket_cache_t *cache = socket_cache_allocate(1, NULL);
+
+  cache->append_only = 1;
+  socket_cache_open_file(cache, file_name);
+  return cache;
+}
+
+/**
+ * @brief Frees the memory of the cache and closes its file.
+ */
+static void socket_cache_free(socket_cache_t *cache) {
+  while (cache->oldest != NULL)
+    socket_cache_remove_oldest(cache);
+  coco_free_memory(cache->buckets);
+  if (cache->key != NULL)
+    coco_free_memory(cache->key);
+  if (cache->file != NULL)
+    fclose(cache->file);
+  coco_free_memory(cache);
+}
+
+/**
+ * @brief Sets the key of the evaluation that is looked up or inserted next.
+ */
+static void socket_cache_set_key(socket_cache_t *cache,
+                                 const char *suite_name,
+                                 const unsigned long evaluation_type,
+                                 const size_t function,
+                                 const size_t instance,
+                                 const size_t dimension,
+                                 const size_t number_of_integer_variables,
+                                 const size_t number_of_values,
+                                 const double *x) {
+  unsigned int numbers[6];
+  size_t i, suite_name_length = strlen(suite_name);
+  double value;
+  char *pointer;
+
+  cache->key_length = sizeof(numbers) + suite_name_length + dimension * sizeof(double);
+  if (cache->key_size < cache->key_length) {
+    if (cache->key != NULL)
+      coco_free_memory(cache->key);
+    cache->key_size = cache->key_length;
+    cache->key = (char *) coco_allocate_memory(cache->key_size);
+  }
+  numbers[0] = (unsigned int) evaluation_type;
+  numbers[1] = (unsigned int) function;
+  numbers[2] = (unsigned int) instance;
+  numbers[3] = (unsigned int) dimension;
+  numbers[4] = (unsigned int) number_of_values;
+  numbers[5] = (unsigned int) suite_name_length;
+  memcpy(cache->key, numbers, sizeof(numbers));
+  pointer = cache->key + sizeof(numbers);
+  memcpy(pointer, suite_name, suite_name_length);
+  pointer += suite_name_length;
+  for (i = 0; i < dimension; i++) {
+    value = (i < number_of_integer_variables) ? (double) coco_double_to_int(x[i]) : x[i];
+    memcpy(pointer + i * sizeof(double), &value, sizeof(double));
+  }
+  cache->hash = socket_cache_hash(cache->key, cache->key_length);
+}
+
+/**
+ * @brief Looks up the evaluation with the current key (see socket_cache_set_key()) and saves its
+ * number_of_values values into values.
+ *
+ * If the evaluation is not in memory, the records appended to the cache file by other processes are read
+ * first. Returns 1 (a hit) if the evaluation was found and 0 (a miss) otherwise.
+ */
+static int socket_cache_lookup(socket_cache_t *cache, const size_t number_of_values, double *values) {
+  socket_cache_entry_t *entry = socket_cache_find(cache, cache->key, cache->key_length, cache->hash);
+
+  if ((entry == NULL) && (cache->file != NULL)) {
+    socket_cache_read_file(cache);
+    entry = socket_cache_find(cache, cache->key, cache->key_length, cache->hash);
+  }
+  if ((entry == NULL) || (entry->number_of_values != number_of_values)) {
+    cache->misses++;
+    return 0;
+  }
+  memcpy(values, entry->values, number_of_values * sizeof(double));
+  socket_cache_unlink(cache, entry);
+  socket_cache_make_newest(cache, entry);
+  cache->hits++;
+  return 1;
+}
+
+/**
+ * @brief Returns 1 if the evaluation with the current key is in memory and 0 otherwise (the counters of
+ * hits and misses are not changed).
+ */
+static int socket_cache_contains(const socket_cache_t *cache) {
+  return socket_cache_find(cache, cache->key, cache->key_length, cache->hash) != NULL;
+}
+
+/**
+ * @brief Inserts the evaluation with the current key and the given values into the cache (and appends it
+ * to the cache file).
+ */
+static void socket_cache_insert(socket_cache_t *cache, const size_t number_of_values, const double *values) {
+  unsigned int lengths[2];
+  char *record;
+  size_t record_length;
+  long end;
+  int written;
+
+  if (!cache->append_only)
+    socket_cache_store(cache, cache->key, cache->key_length, cache->hash, number_of_values, values);
+  if (cache->file == NULL)
+    return;
+
+  /* The record is written at once, so that the records of different processes do not interleave (the
+   * descriptor is used directly, since the stream could split the record into several writes) */
+  lengths[0] = (unsigned int) cache->key_length;
+  lengths[1] = (unsigned int) number_of_values;
+  record_length = sizeof(lengths) + cache->key_length + number_of_values * sizeof(double);
+  record = (char *) coco_allocate_memory(record_length);
+  memcpy(record, lengths, sizeof(lengths));
+  memcpy(record + sizeof(lengths), cache->key, cache->key_length);
+  memcpy(record + sizeof(lengths) + cache->key_length, values, number_of_values * sizeof(double));
+#if WINSOCK
+  fseek(cache->file, 0, SEEK_END);
+  written = (fwrite(record, 1, record_length, cache->file) == record_length) && (fflush(cache->file) == 0);
+  end = ftell(cache->file);
+#else
+  written = (write(fileno(cache->file), record, record_length) == (ssize_t) record_length);
+  end = (long) lseek(fileno(cache->file), 0, SEEK_CUR);
+#endif
+  if (!written)
+    coco_warning("socket_cache_insert(): Failed to write to the cache file");
+  else if (end - (long) record_length == cache->file_offset)
+    cache->file_offset = end; /* No need to read the own record again */
+  coco_free_memory(record);
+}
@@ -1,22 +1,151 @@
 #include <stdio.h>
 #include <string.h>
 #include "coco_platform.h"
+#include "coco_trace.c"
+#include "socket_cache.c"
 
 #define HOST "127.0.0.1"    /* Local host */
-#define MESSAGE_SIZE 8192   /* Large enough for the entire message */
-#define RESPONSE_SIZE 1024  /* Large enough for the entire response (objective values or constraint violations) */
+#define RECEIVE_SIZE 1024   /* The number of bytes received at once (the responses can be longer) */
+#define MAX_ENDPOINTS 1024  /* The maximal number of socket servers used at once */
+
+/* Sending to a dropped connection must not raise SIGPIPE (the endpoint is dropped instead) */
+#if !WINSOCK && defined(MSG_NOSIGNAL)
+#define SEND_FLAGS MSG_NOSIGNAL
+#else
+#define SEND_FLAGS 0
+#endif
+
+/* Definitions for the local transports (see socket_communication_connect_unix() and
+ * socket_communication_attach_shm(), they must match those in socket_server.c) */
+#define SOCKET_UNIX_PATH "/tmp/coco_socket_%u" /* The path of the Unix-domain socket of the server on a port */
+#define SOCKET_SHM_HEADER_SIZE 128     /* The space reserved for the header of each ring */
+#define SOCKET_SHM_SPIN 10000          /* The number of checks of an empty ring before sleeping (with
+                                          several processors) */
+#if !WINSOCK && defined(__GNUC__)
+#define SOCKET_SHM 1                   /* Shared memory needs the memory barriers of GCC (and compatible) */
+#define SOCKET_SHM_BARRIER() __sync_synchronize()
+#else
+#define SOCKET_SHM 0
+#endif
+#if defined(__linux__)
+#define SOCKET_SHM_DIRECTORY "/dev/shm"
+#else
+#define SOCKET_SHM_DIRECTORY "/tmp"
+#endif
+
+/* Definitions for the binary protocol (see socket_communication_create_binary_message()) */
+#define SOCKET_BINARY_MAGIC "COCB"      /* The first four bytes of each binary frame */
+#define SOCKET_BINARY_VERSION 2         /* The version of the binary protocol */
+#define SOCKET_BINARY_HEADER_SIZE 40    /* The magic followed by nine 32-bit unsigned integers */
+#define SOCKET_BINARY_HELLO 0           /* The frame type used to negotiate the protocol */
+#define SOCKET_BINARY_FEATURE_BOTH 1    /* The feature bit announced by servers that support evaluations of
+                                           type SOCKET_EVALUATE_BOTH */
 
 /**
- * @brief Data type needed for socket communication (used by the suites that need it).
+ * @brief The protocol used to communicate with the external evaluator.
+ */
+typedef enum {
+  SOCKET_PROTOCOL_TEXT,   /**< @brief Text messages (the default). */
+  SOCKET_PROTOCOL_BINARY  /**< @brief Binary frames with raw IEEE-754 doubles. */
+} socket_protocol_e;
+
+/**
+ * @brief The transport used to exchange the messages with the external evaluator.
+ */
+typedef enum {
+  SOCKET_TRANSPORT_TCP,   /**< @brief TCP sockets (the default). */
+  SOCKET_TRANSPORT_UNIX,  /**< @brief Unix-domain sockets (the server must run on the same machine). */
+  SOCKET_TRANSPORT_SHM    /**< @brief Rings in shared memory (the server must run on the same machine). */
+} socket_transport_e;
+
+/**
+ * @brief The header of a ring in shared memory (see socket_communication_attach_shm()).
+ *
+ * The producer writes the bytes at position head and then advances head, while the consumer reads the
+ * bytes at position tail and then advances tail (the positions are taken modulo the size of the ring,
+ * which is a power of two). A consumer that finds the ring empty sets sleeping and waits for a byte on
+ * the socket, which the producer sends only in this case.
  */
 typedef struct {
-  unsigned short port;           /**< @brief The port for communication with the external evaluator. */
-  char *host_name;               /**< @brief The host name for communication with the external evaluator. */
-  int precision_x;               /**< @brief Precision used to write the x-values to the external evaluator. */
-  char* prev_message_obj;        /**< @brief Message of the previous evaluation of objectives */
-  char* prev_response_obj;       /**< @brief Response of the previous evaluation of objectives */
-  char* prev_message_con;        /**< @brief Message of the previous evaluation of constraints */
-  char* prev_response_con;       /**< @brief Response of the previous evaluation of constraints */
+  volatile unsigned int head;    /**< @brief The number of bytes written by the producer. */
+  char padding[64];              /**< @brief Keeps head and tail in different cache lines. */
+  volatile unsigned int tail;    /**< @brief The number of bytes read by the consumer. */
+  volatile unsigned int sleeping;/**< @brief Whether the consumer waits for a byte on the socket. */
+} socket_communication_ring_t;
+
+/**
+ * @brief The type of evaluation (the values are also used as frame types in the binary protocol).
+ */
+typedef enum {
+  SOCKET_EVALUATE_OBJECTIVES = 1, /**< @brief Evaluation of objectives. */
+  SOCKET_EVALUATE_CONSTRAINTS = 2,/**< @brief Evaluation of constraints. */
+  SOCKET_EVALUATE_BOTH = 3        /**< @brief Evaluation of objectives followed by constraints. */
+} socket_evaluation_e;
+
+/**
+ * @brief A previously performed evaluation (used to avoid sending the same message twice in a row).
+ */
+typedef struct {
+  char *message;                 /**< @brief The message (a string or a binary frame). */
+  size_t message_length;         /**< @brief The length of the message in bytes. */
+  double *values;                /**< @brief The values from the response. */
+  size_t number_of_values;       /**< @brief The number of values from the response. */
+} socket_communication_previous_t;
+
+/**
+ * @brief A batch of prefetched evaluations (see socket_prefetch_function()).
+ */
+typedef struct {
+  size_t function;               /**< @brief The function number of the problem. */
+  size_t instance;               /**< @brief The instance number of the problem. */
+  size_t dimension;              /**< @brief The dimension of the problem. */
+  size_t number_of_values;       /**< @brief The number of values for each solution. */
+  size_t number_of_solutions;    /**< @brief The number of solutions in the batch. */
+  size_t next;                   /**< @brief The index of the solution that is expected to be looked up next. */
+  double *x;                     /**< @brief The solutions stored one after another. */
+  double *values;                /**< @brief The values of the solutions stored one after another. */
+} socket_communication_batch_t;
+
+/**
+ * @brief A request sent to the external evaluator with the binary protocol (see
+ * socket_communication_send_request()).
+ */
+typedef struct socket_communication_request_s {
+  unsigned long sequence;        /**< @brief The sequence id of the request. */
+  socket_evaluation_e evaluation_type;
+                                 /**< @brief The type of evaluation. */
+  size_t function;               /**< @brief The function number of the problem. */
+  size_t instance;               /**< @brief The instance number of the problem. */
+  size_t dimension;              /**< @brief The dimension of the problem. */
+  size_t number_of_values;       /**< @brief The number of values for each solution. */
+  size_t number_of_solutions;    /**< @brief The number of solutions. */
+  double *x;                     /**< @brief The solutions stored one after another. */
+  double *values;                /**< @brief The values of the solutions (valid once received). */
+  int received;                  /**< @brief Whether the response has been received. */
+  int discarded;                 /**< @brief Whether the response is not needed anymore (the request is
+                                      removed as soon as it is received). */
+  char *frame;                   /**< @brief The sent frame (kept in case it needs to be resent). */
+  size_t length;                 /**< @brief The length of the sent frame. */
+  size_t endpoint;               /**< @brief The index of the endpoint the request was sent to. */
+  double trace_start;            /**< @brief The time when the request was sent (for tracing). */
+  struct socket_communication_request_s *next;
+                                 /**< @brief The next (younger) request. */
+} socket_communication_request_t;
+
+/**
+ * @brief A socket server (external evaluator) used for the evaluations.
+ */
+typedef struct {
+  char *host_name;               /**< @brief The host name of the socket server. */
+  unsigned short port;           /**< @brief The port of the socket server. */
+  int connected;                 /**< @brief Whether the connection is open (0 if it could not be opened or
+                                      was dropped). */
+  size_t number_of_requests_in_flight;
+                                 /**< @brief The number of requests waiting for a response. */
+  char *shm;                     /**< @brief The shared memory with the rings (NULL if the messages are
+                                      exchanged through the socket). */
+  unsigned int ring_size;        /**< @brief The size of each ring in the shared memory in bytes. */
+  size_t spin;                   /**< @brief The number of checks of an empty ring before sleeping. */
 #if WINSOCK
   SOCKET sock;                   /**< @brief Socket on Windows. */
   SOCKADDR_IN serv_addr;         /**< @brief Server address on Windows. */
@@ -24,45 +153,929 @@ typedef struct {
   int sock;                      /**< @brief Socket on non-Windows platforms. */
   struct sockaddr_in serv_addr;  /**< @brief Server address on non-Windows platforms. */
 #endif
+} socket_communication_endpoint_t;
+
+/**
+ * @brief Data type needed for socket communication (used by the suites that need it).
+ *
+ * The evaluations can be spread over several socket servers (endpoints). Each request is sent to the
+ * endpoint with the fewest requests waiting for a response. If an endpoint drops, its requests are
+ * resent to the remaining ones.
+ */
+typedef struct {
+  socket_communication_endpoint_t *endpoints;
+                                 /**< @brief The socket servers used for the evaluations. */
+  size_t number_of_endpoints;    /**< @brief The number of endpoints. */
+  size_t last_endpoint;          /**< @brief The index of the endpoint used last. */
+  int precision_x;               /**< @brief Precision used to write the x-values to the external evaluator. */
+  socket_protocol_e protocol;    /**< @brief The protocol used to communicate with the external evaluator. */
+  socket_transport_e transport;  /**< @brief The transport used to exchange the messages. */
+  unsigned int ring_size;        /**< @brief The size of the rings for the shared-memory transport. */
+  char *buffer;                  /**< @brief Buffer for the messages (grows as needed). */
+  size_t buffer_size;            /**< @brief The size of the buffer in bytes. */
+  char *response;                /**< @brief Buffer for the text responses (grows as needed). */
+  size_t response_size;          /**< @brief The size of the response buffer in bytes. */
+  socket_communication_previous_t previous_obj;
+                                 /**< @brief The previous evaluation of objectives. */
+  socket_communication_previous_t previous_con;
+                                 /**< @brief The previous evaluation of constraints. */
+  socket_communication_batch_t batch_obj;
+                                 /**< @brief The prefetched evaluations of objectives. */
+  socket_communication_batch_t batch_con;
+                                 /**< @brief The prefetched evaluations of constraints. */
+  size_t window;                 /**< @brief The maximal number of requests waiting for a response from
+                                      each endpoint. */
+  unsigned long next_sequence;   /**< @brief The sequence id of the next request. */
+  socket_communication_request_t *first_request;
+                                 /**< @brief The oldest request that has not been used yet. */
+  socket_communication_request_t *last_request;
+                                 /**< @brief The youngest request that has not been used yet. */
+  socket_cache_t *cache;         /**< @brief The cache of evaluations (NULL if it is not used). */
+  int combined;                  /**< @brief Whether the objectives and constraints of a problem with
+                                      constraints are evaluated with a single request. */
+  socket_cache_t *record;        /**< @brief The log of recorded evaluations (NULL if they are not
+                                      recorded). */
+  double *record_x;              /**< @brief The x-values of the recorded evaluation. */
+  size_t record_x_size;          /**< @brief The number of allocated x-values. */
 } socket_communication_data_t;
 
+/**
+ * @brief Frees the memory of a socket_communication_previous_t object (not the object itself).
+ */
+static void socket_communication_previous_free(socket_communication_previous_t *previous) {
+  if (previous->message != NULL) {
+    coco_free_memory(previous->message);
+    previous->message = NULL;
+  }
+  if (previous->values != NULL) {
+    coco_free_memory(previous->values);
+    previous->values = NULL;
+  }
+  previous->message_length = 0;
+  previous->number_of_values = 0;
+}
+
+/**
+ * @brief Frees the memory of a socket_communication_batch_t object (not the object itself).
+ */
+static void socket_communication_batch_free(socket_communication_batch_t *batch) {
+  if (batch->x != NULL) {
+    coco_free_memory(batch->x);
+    batch->x = NULL;
+  }
+  if (batch->values != NULL) {
+    coco_free_memory(batch->values);
+    batch->values = NULL;
+  }
+  batch->number_of_solutions = 0;
+  batch->next = 0;
+}
+
+/**
+ * @brief Makes sure the buffer can hold at least size bytes.
+ */
+static void socket_communication_reserve(socket_communication_data_t *data, const size_t size) {
+  if (data->buffer_size >= size)
+    return;
+  if (data->buffer != NULL)
+    coco_free_memory(data->buffer);
+  data->buffer_size = (size > 2 * data->buffer_size) ? size : 2 * data->buffer_size;
+  data->buffer = (char *) coco_allocate_memory(data->buffer_size);
+}
+
+#if SOCKET_SHM
+/**
+ * @brief Returns the size of the shared memory with two rings of the given size.
+ */
+static size_t socket_communication_shm_size(const unsigned int ring_size) {
+  return 2 * (SOCKET_SHM_HEADER_SIZE + (size_t) ring_size);
+}
+
+/**
+ * @brief Returns the header of the ring with the given index (0 for the requests and 1 for the responses).
+ */
+static socket_communication_ring_t *socket_communication_ring(const socket_communication_endpoint_t *endpoint,
+                                                              const size_t index) {
+  return (socket_communication_ring_t *) (void *) (endpoint->shm + index * SOCKET_SHM_HEADER_SIZE);
+}
+
+/**
+ * @brief Returns the bytes of the ring with the given index (0 for the requests and 1 for the responses).
+ */
+static char *socket_communication_ring_bytes(const socket_communication_endpoint_t *endpoint,
+                                             const size_t index) {
+  return endpoint->shm + 2 * SOCKET_SHM_HEADER_SIZE + index * endpoint->ring_size;
+}
+
+/**
+ * @brief Writes all length bytes of the buffer into the ring for the requests (waiting for free space if
+ * needed) and wakes up the server if it waits for them.
+ *
+ * Returns 0 on success and -1 if the server closed the connection.
+ */
+static int socket_communication_ring_write(const socket_communication_endpoint_t *endpoint,
+                                           const char *buffer,
+                                           size_t length) {
+  socket_communication_ring_t *ring = socket_communication_ring(endpoint, 0);
+  char *bytes = socket_communication_ring_bytes(endpoint, 0);
+  size_t count, position;
+  char byte;
+
+  while (length > 0) {
+    while ((count = endpoint->ring_size - (ring->head - ring->tail)) == 0) {
+      /* The ring is full, wait until the server reads from it (or closes the connection) */
+      if (recv(endpoint->sock, &byte, 1, MSG_PEEK | MSG_DONTWAIT) == 0)
+        return -1;
+      sched_yield();
+    }
+    position = ring->head & (endpoint->ring_size - 1);
+    if (count > endpoint->ring_size - position)
+      count = endpoint->ring_size - position;
+    if (count > length)
+      count = length;
+    memcpy(bytes + position, buffer, count);
+    SOCKET_SHM_BARRIER(); /* The bytes must be visible before the new head */
+    ring->head += (unsigned int) count;
+    buffer += count;
+    length -= count;
+    SOCKET_SHM_BARRIER(); /* The new head must be visible before sleeping is checked */
+    if (ring->sleeping) {
+      ring->sleeping = 0;
+      send(endpoint->sock, "", 1, SEND_FLAGS);
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief Reads at most length bytes from the ring for the responses into the buffer and returns their
+ * number (or -1 if the server closed the connection).
+ *
+ * If the ring is empty, it is checked endpoint->spin times before the client sleeps until the server
+ * sends a byte through the socket, so that no system calls are needed while the responses keep coming.
+ */
+static long socket_communication_ring_read(const socket_communication_endpoint_t *endpoint,
+                                           char *buffer,
+                                           size_t length) {
+  socket_communication_ring_t *ring = socket_communication_ring(endpoint, 1);
+  const char *bytes = socket_communication_ring_bytes(endpoint, 1);
+  size_t count, position, spin = 0;
+  char wake_up[64];
+
+  while ((count = (size_t) (ring->head - ring->tail)) == 0) {
+    if (spin++ < endpoint->spin)
+      continue;
+    ring->sleeping = 1;
+    SOCKET_SHM_BARRIER(); /* The server must see sleeping before head is checked again */
+    if ((ring->head == ring->tail) && (recv(endpoint->sock, wake_up, sizeof(wake_up), 0) <= 0))
+      return -1;
+    ring->sleeping = 0;
+  }
+  SOCKET_SHM_BARRIER(); /* The bytes must be read after the head */
+  position = ring->tail & (endpoint->ring_size - 1);
+  if (count > endpoint->ring_size - position)
+    count = endpoint->ring_size - position;
+  if (count > length)
+    count = length;
+  memcpy(buffer, bytes + position, count);
+  SOCKET_SHM_BARRIER(); /* The bytes must be read before the new tail is visible */
+  ring->tail += (unsigned int) count;
+  return (long) count;
+}
+#endif
+
+/**
+ * @brief Sends all length bytes of the buffer to the endpoint (send() can send only a part of them).
+ *
+ * Returns 0 on success and -1 if the sending failed.
+ */
+static int socket_communication_send_all(const socket_communication_endpoint_t *endpoint,
+                                         const char *buffer,
+                                         size_t length) {
+  long sent_len;
+
+#if SOCKET_SHM
+  if (endpoint->shm != NULL)
+    return socket_communication_ring_write(endpoint, buffer, length);
+#endif
+  while (length > 0) {
+#if WINSOCK
+    sent_len = (long) send(endpoint->sock, buffer, (int) length, SEND_FLAGS);
+#else
+    sent_len = (long) send(endpoint->sock, buffer, length, SEND_FLAGS);
+#endif
+    if (sent_len <= 0)
+      return -1;
+    buffer += sent_len;
+    length -= (size_t) sent_len;
+  }
+  return 0;
+}
+
+/**
+ * @brief Receives at most length bytes from the endpoint into the buffer and returns their number (like
+ * recv(), returns 0 or a negative number if the receiving failed).
+ */
+static long socket_communication_receive_some(const socket_communication_endpoint_t *endpoint,
+                                              char *buffer,
+                                              size_t length) {
+#if SOCKET_SHM
+  if (endpoint->shm != NULL)
+    return socket_communication_ring_read(endpoint, buffer, length);
+#endif
+#if WINSOCK
+  return (long) recv(endpoint->sock, buffer, (int) length, 0);
+#else
+  return (long) recv(endpoint->sock, buffer, length, 0);
+#endif
+}
+
+/**
+ * @brief Receives exactly length bytes from the endpoint into the buffer (recv() can return only a part
+ * of them).
+ *
+ * Returns 0 on success and -1 if the receiving failed (for example, because the connection was closed
+ * by the server).
+ */
+static int socket_communication_receive_all(const socket_communication_endpoint_t *endpoint,
+                                            char *buffer,
+                                            size_t length) {
+  long received_len;
+
+  while (length > 0) {
+    received_len = socket_communication_receive_some(endpoint, buffer, length);
+    if (received_len <= 0)
+      return -1;
+    buffer += received_len;
+    length -= (size_t) received_len;
+  }
+  return 0;
+}
+
+/**
+ * @brief Writes the unsigned integer as four bytes in little-endian order.
+ */
+static void socket_communication_write_uint32(char *buffer, const unsigned long value) {
+  unsigned char *bytes = (unsigned char *) buffer;
+  bytes[0] = (unsigned char) (value & 0xFF);
+  bytes[1] = (unsigned char) ((value >> 8) & 0xFF);
+  bytes[2] = (unsigned char) ((value >> 16) & 0xFF);
+  bytes[3] = (unsigned char) ((value >> 24) & 0xFF);
+}
+
+/**
+ * @brief Reads an unsigned integer written by socket_communication_write_uint32().
+ */
+static unsigned long socket_communication_read_uint32(const char *buffer) {
+  const unsigned char *bytes = (const unsigned char *) buffer;
+  return (unsigned long) bytes[0] | ((unsigned long) bytes[1] << 8) | ((unsigned long) bytes[2] << 16)
+      | ((unsigned long) bytes[3] << 24);
+}
+
+/**
+ * @brief Returns 1 if the platform stores doubles in little-endian order and 0 otherwise.
+ */
+static int socket_communication_is_little_endian(void) {
+  const double one = 1.0;
+  /* The last byte of the IEEE-754 representation of 1.0 (in little-endian order) is 0x3F */
+  return ((const unsigned char *) &one)[sizeof(double) - 1] == 0x3F;
+}
+
+/**
+ * @brief Writes the double as eight bytes of its IEEE-754 representation in little-endian order.
+ */
+static void socket_communication_write_double(char *buffer, const double value) {
+  size_t i;
+  const unsigned char *bytes = (const unsigned char *) &value;
+
+  if (socket_communication_is_little_endian())
+    memcpy(buffer, &value, sizeof(double));
+  else {
+    for (i = 0; i < sizeof(double); i++)
+      buffer[i] = (char) bytes[sizeof(double) - 1 - i];
+  }
+}
+
+/**
+ * @brief Reads a double written by socket_communication_write_double().
+ */
+static double socket_communication_read_double(const char *buffer) {
+  size_t i;
+  double value;
+  unsigned char *bytes = (unsigned char *) &value;
+
+  if (socket_communication_is_little_endian())
+    memcpy(&value, buffer, sizeof(double));
+  else {
+    for (i = 0; i < sizeof(double); i++)
+      bytes[i] = (unsigned char) buffer[sizeof(double) - 1 - i];
+  }
+  return value;
+}
+
+/**
+ * @brief Writes the header of a binary frame into buffer.
+ */
+static void socket_communication_write_binary_header(char *buffer,
+                                                     const unsigned long type,
+                                                     const size_t suite_name_length,
+                                                     const size_t number_of_values,
+                                                     const size_t function,
+                                                     const size_t instance,
+                                                     const size_t dimension,
+                                                     const size_t count,
+                                                     const unsigned long sequence) {
+  memcpy(buffer, SOCKET_BINARY_MAGIC, 4);
+  socket_communication_write_uint32(buffer + 4, SOCKET_BINARY_VERSION);
+  socket_communication_write_uint32(buffer + 8, type);
+  socket_communication_write_uint32(buffer + 12, (unsigned long) suite_name_length);
+  socket_communication_write_uint32(buffer + 16, (unsigned long) number_of_values);
+  socket_communication_write_uint32(buffer + 20, (unsigned long) function);
+  socket_communication_write_uint32(buffer + 24, (unsigned long) instance);
+  socket_communication_write_uint32(buffer + 28, (unsigned long) dimension);
+  socket_communication_write_uint32(buffer + 32, (unsigned long) count);
+  socket_communication_write_uint32(buffer + 36, sequence);
+}
+
+/**
+ * @brief Negotiates the binary protocol with the external evaluator at the endpoint.
+ *
+ * Sends a HELLO frame with the version of the protocol and expects a HELLO frame with the version
+ * supported by the server and the features it supports (as bits of the field <n>, servers that do not
+ * announce any features leave it at 0). If the versions differ, the text protocol is used instead. Note
+ * that servers without support for the binary protocol cannot answer (they typically exit).
+ */
+static void socket_communication_negotiate(socket_communication_data_t *data,
+                                           const socket_communication_endpoint_t *endpoint) {
+
+  char header[SOCKET_BINARY_HEADER_SIZE];
+  unsigned long version;
+
+  socket_communication_write_binary_header(header, SOCKET_BINARY_HELLO, 0, 0, 0, 0, 0, 0, 0);
+  if ((socket_communication_send_all(endpoint, header, SOCKET_BINARY_HEADER_SIZE) != 0)
+      || (socket_communication_receive_all(endpoint, header, SOCKET_BINARY_HEADER_SIZE) != 0)
+      || (memcmp(header, SOCKET_BINARY_MAGIC, 4) != 0)
+      || (socket_communication_read_uint32(header + 8) != SOCKET_BINARY_HELLO)) {
+    coco_error("socket_communication_negotiate(): Unexpected response of the server (host = %s, port = %d)",
+        endpoint->host_name, endpoint->port);
+    return; /* Never reached */
+  }
+  version = socket_communication_read_uint32(header + 4);
+  if (version != SOCKET_BINARY_VERSION) {
+    coco_warning("socket_communication_negotiate(): The server supports version %lu of the binary protocol "
+        "instead of %lu, using the text protocol", version, (unsigned long) SOCKET_BINARY_VERSION);
+    data->protocol = SOCKET_PROTOCOL_TEXT;
+    data->combined = 0;
+  }
+  if ((socket_communication_read_uint32(header + 32) & SOCKET_BINARY_FEATURE_BOTH) == 0)
+    data->combined = 0;
+}
+
+/**
+ * @brief Frees the memory of a socket_communication_request_t object.
+ */
+static void socket_communication_request_free(socket_communication_request_t *request) {
+  coco_free_memory(request->x);
+  coco_free_memory(request->values);
+  coco_free_memory(request->frame);
+  coco_free_memory(request);
+}
+
+/**
+ * @brief Removes the request from the list of requests and frees it.
+ */
+static void socket_communication_unlink_request(socket_communication_data_t *data,
+                                                socket_communication_request_t *request) {
+  socket_communication_request_t *previous = NULL;
+
+  if (data->first_request != request) {
+    for (previous = data->first_request; previous->next != request; previous = previous->next)
+      ;
+    previous->next = request->next;
+  } else {
+    data->first_request = request->next;
+  }
+  if (data->last_request == request)
+    data->last_request = previous;
+  socket_communication_request_free(request);
+}
+
+/**
+ * @brief Closes the connection with the endpoint.
+ */
+static void socket_communication_close(socket_communication_endpoint_t *endpoint) {
+#if WINSOCK
+  closesocket(endpoint->sock);
+#else
+  close(endpoint->sock);
+#endif
+#if SOCKET_SHM
+  if (endpoint->shm != NULL) {
+    munmap(endpoint->shm, socket_communication_shm_size(endpoint->ring_size));
+    endpoint->shm = NULL;
+  }
+#endif
+  endpoint->connected = 0;
+  endpoint->number_of_requests_in_flight = 0;
+}
+
+/**
+ * @brief Returns the index of the connected endpoint with the fewest requests waiting for a response.
+ *
+ * Ties are broken in a round-robin fashion, so that consecutive evaluations are spread over all
+ * endpoints.
+ */
+static size_t socket_communication_choose_endpoint(socket_communication_data_t *data) {
+  size_t i, index, best = data->number_of_endpoints;
+
+  for (i = 1; i <= data->number_of_endpoints; i++) {
+    index = (data->last_endpoint + i) % data->number_of_endpoints;
+    if (data->endpoints[index].connected && ((best == data->number_of_endpoints)
+        || (data->endpoints[index].number_of_requests_in_flight
+            < data->endpoints[best].number_of_requests_in_flight)))
+      best = index;
+  }
+  if (best == data->number_of_endpoints) {
+    coco_error("socket_communication_choose_endpoint(): No socket server is available anymore");
+    return 0; /* Never reached */
+  }
+  data->last_endpoint = best;
+  return best;
+}
+
+static void socket_communication_drop_endpoint(socket_communication_data_t *data, const size_t index);
+
+/**
+ * @brief Sends the frame of the request to the endpoint with the given index (if the sending fails, the
+ * endpoint is dropped and the request is sent to another one).
+ */
+static void socket_communication_send_frame(socket_communication_data_t *data,
+                                            socket_communication_request_t *request,
+                                            const size_t index) {
+  socket_communication_endpoint_t *endpoint = &data->endpoints[index];
+
+  request->endpoint = index;
+  endpoint->number_of_requests_in_flight++;
+  if (socket_communication_send_all(endpoint, request->frame, request->length) != 0)
+    socket_communication_drop_endpoint(data, request->endpoint);
+}
+
+/**
+ * @brief Drops the endpoint whose connection failed and resends the requests that were waiting for its
+ * responses to the remaining endpoints.
+ */
+static void socket_communication_drop_endpoint(socket_communication_data_t *data, const size_t index) {
+  socket_communication_request_t *request;
+  socket_communication_endpoint_t *endpoint = &data->endpoints[index];
+
+  coco_warning("socket_communication_drop_endpoint(): Lost the connection with the socket server (host = %s, "
+      "port = %d)", endpoint->host_name, endpoint->port);
+  socket_communication_close(endpoint);
+  for (request = data->first_request; request != NULL; request = request->next) {
+    if (!request->received && (request->endpoint == index))
+      socket_communication_send_frame(data, request, socket_communication_choose_endpoint(data));
+  }
+}
+
+/**
+ * @brief Receives a response from the endpoint with the given index.
+ *
+ * Each server answers the requests in the order in which it received them. The response is matched to
+ * its request using the sequence id. The response has the same header as the request (with l = 0),
+ * followed by n * r doubles (see socket_communication_create_binary_message()). If the connection fails,
+ * the endpoint is dropped (and its requests are resent to other endpoints).
+ */
+static void socket_communication_receive_response(socket_communication_data_t *data, const size_t index) {
+  size_t i, number_of_all_values;
+  char header[SOCKET_BINARY_HEADER_SIZE];
+  unsigned long sequence;
+  socket_communication_request_t *request;
+  socket_communication_endpoint_t *endpoint = &data->endpoints[index];
+
+  if (socket_communication_receive_all(endpoint, header, SOCKET_BINARY_HEADER_SIZE) != 0) {
+    socket_communication_drop_endpoint(data, index);
+    return;
+  }
+  sequence = socket_communication_read_uint32(header + 36);
+  for (request = data->first_request; request != NULL; request = request->next) {
+    if (!request->received && (request->endpoint == index) && (request->sequence == sequence))
+      break;
+  }
+  if ((request == NULL) || (memcmp(header, SOCKET_BINARY_MAGIC, 4) != 0)
+      || (socket_communication_read_uint32(header + 8) != (unsigned long) request->evaluation_type)
+      || (socket_communication_read_uint32(header + 16) != (unsigned long) request->number_of_values)
+      || (socket_communication_read_uint32(header + 32) != (unsigned long) request->number_of_solutions)) {
+    coco_error("socket_communication_receive_response(): Unexpected response of the server");
+    return; /* Never reached */
+  }
+
+  /* The values are received directly into request->values and converted in place */
+  number_of_all_values = request->number_of_solutions * request->number_of_values;
+  if (socket_communication_receive_all(endpoint, (char *) request->values,
+      number_of_all_values * sizeof(double)) != 0) {
+    socket_communication_drop_endpoint(data, index);
+    return;
+  }
+  for (i = 0; i < number_of_all_values; i++)
+    request->values[i] = socket_communication_read_double((char *) &request->values[i]);
+  request->received = 1;
+  endpoint->number_of_requests_in_flight--;
+  coco_trace_end(COCO_TRACE_SOCKET_ROUND_TRIP, request->trace_start, (double) request->length);
+  if (request->discarded)
+    socket_communication_unlink_request(data, request);
+}
+
+/**
+ * @brief Sends the binary frame of the given length from data->buffer (see
+ * socket_communication_create_binary_message()) as a new request and returns it.
+ *
+ * The request gets the next sequence id, is appended to the list of requests and is sent to the least
+ * loaded endpoint. The response is not awaited, but if data->window requests are already waiting for a
+ * response from each endpoint, a response is received first (so that at most data->window requests are
+ * in flight for each endpoint).
+ */
+static socket_communication_request_t *socket_communication_send_request(socket_communication_data_t *data,
+                                                                         const coco_problem_t *problem,
+                                                                         const socket_evaluation_e evaluation_type,
+                                                                         const size_t number_of_values,
+                                                                         const double *x,
+                                                                         const size_t number_of_solutions,
+                                                                         const size_t length) {
+  socket_communication_request_t *request;
+  size_t index;
+
+  while (data->endpoints[index = socket_communication_choose_endpoint(data)].number_of_requests_in_flight
+      >= data->window)
+    socket_communication_receive_response(data, index);
+
+  request = (socket_communication_request_t *) coco_allocate_memory(sizeof(*request));
+  request->sequence = data->next_sequence;
+  data->next_sequence = (data->next_sequence + 1) & 0xFFFFFFFFUL;
+  request->evaluation_type = evaluation_type;
+  request->function = problem->suite_dep_function;
+  request->instance = problem->suite_dep_instance;
+  request->dimension = problem->number_of_variables;
+  request->number_of_values = number_of_values;
+  request->number_of_solutions = number_of_solutions;
+  request->x = coco_duplicate_vector(x, number_of_solutions * problem->number_of_variables);
+  request->values = coco_allocate_vector(number_of_solutions * number_of_values);
+  request->received = 0;
+  request->discarded = 0;
+  socket_communication_write_uint32(data->buffer + 36, request->sequence);
+  request->frame = (char *) coco_allocate_memory(length);
+  memcpy(request->frame, data->buffer, length);
+  request->length = length;
+  request->next = NULL;
+
+  if (data->last_request != NULL)
+    data->last_request->next = request;
+  else
+    data->first_request = request;
+  data->last_request = request;
+
+  request->trace_start = coco_trace_begin();
+  socket_communication_send_frame(data, request, index);
+  return request;
+}
+
+/**
+ * @brief Returns the oldest request for the evaluation of the single solution x of the given type that
+ * has not been discarded or NULL if there is no such request.
+ */
+static socket_communication_request_t *socket_communication_find_request(const socket_communication_data_t *data,
+                                                                         const coco_problem_t *problem,
+                                                                         const socket_evaluation_e evaluation_type,
+                                                                         const size_t number_of_values,
+                                                                         const double *x) {
+  socket_communication_request_t *request;
+
+  for (request = data->first_request; request != NULL; request = request->next) {
+    if (!request->discarded && (request->number_of_solutions == 1)
+        && (request->evaluation_type == evaluation_type)
+        && (request->function == problem->suite_dep_function)
+        && (request->instance == problem->suite_dep_instance)
+        && (request->dimension == problem->number_of_variables)
+        && (request->number_of_values == number_of_values)
+        && (memcmp(request->x, x, problem->number_of_variables * sizeof(double)) == 0))
+      return request;
+  }
+  return NULL;
+}
+
+/**
+ * @brief Waits for the response to the request, saves its values into values and removes the request
+ * from the list of requests (values can be NULL if they are not needed).
+ *
+ * The other requests are kept, since their responses can still be collected later (also when they have
+ * already been received).
+ */
+static void socket_communication_use_request(socket_communication_data_t *data,
+                                             socket_communication_request_t *request,
+                                             double *values) {
+  /* The request must not be freed while its response is being awaited */
+  request->discarded = 0;
+  /* The endpoint of the request can change if the original one is dropped */
+  while (!request->received)
+    socket_communication_receive_response(data, request->endpoint);
+  if (values != NULL)
+    memcpy(values, request->values, request->number_of_solutions * request->number_of_values * sizeof(double));
+  socket_communication_unlink_request(data, request);
+}
+
+/**
+ * @brief Discards the request submitted for the evaluation of x of the given type (if there is one)
+ * because x was evaluated without it.
+ *
+ * A request that has already received its response is removed right away, the others are removed as
+ * soon as their responses are received (the servers still send them).
+ */
+static void socket_communication_discard_request(socket_communication_data_t *data,
+                                                 const coco_problem_t *problem,
+                                                 const socket_evaluation_e evaluation_type,
+                                                 const size_t number_of_values,
+                                                 const double *x) {
+  socket_communication_request_t *request;
+
+  /* With combined evaluations, x was submitted as a request of the type both */
+  if (data->combined && (problem->number_of_constraints > 0))
+    request = socket_communication_find_request(data, problem, SOCKET_EVALUATE_BOTH,
+        problem->number_of_objectives + problem->number_of_constraints, x);
+  else
+    request = socket_communication_find_request(data, problem, evaluation_type, number_of_values, x);
+  if (request == NULL)
+    return;
+  if (request->received)
+    socket_communication_unlink_request(data, request);
+  else
+    request->discarded = 1;
+}
+
 /**
  * @brief Frees the memory of a socket_communication_data_t object.
  */
 static void socket_communication_data_finalize(void *stuff) {
 
   socket_communication_data_t *data;
+  socket_communication_endpoint_t *endpoint;
+  size_t i;
 
   assert(stuff != NULL);
   data = (socket_communication_data_t *) stuff;
-  if (data->host_name != NULL) {
-    coco_free_memory(data->host_name);
+  if (data->buffer != NULL) {
+    coco_free_memory(data->buffer);
+  }
+  if (data->response != NULL) {
+    coco_free_memory(data->response);
   }
 
-  /* Free the strings */
-  if (data->prev_message_obj != NULL) {
-    coco_free_memory(data->prev_message_obj);
+  if (data->cache != NULL) {
+    coco_info("socket_communication_data_finalize(): Evaluation cache: %lu hits, %lu misses",
+        (unsigned long) data->cache->hits, (unsigned long) data->cache->misses);
+    socket_cache_free(data->cache);
   }
-  if (data->prev_response_obj != NULL) {
-    coco_free_memory(data->prev_response_obj);
+  if (data->record != NULL) {
+    socket_cache_free(data->record);
+    if (data->record_x != NULL)
+      coco_free_memory(data->record_x);
   }
-  if (data->prev_message_con != NULL) {
-    coco_free_memory(data->prev_message_con);
+
+  /* Free the previous evaluations */
+  socket_communication_previous_free(&data->previous_obj);
+  socket_communication_previous_free(&data->previous_con);
+  socket_communication_batch_free(&data->batch_obj);
+  socket_communication_batch_free(&data->batch_con);
+
+  /* Receive the responses to the remaining requests (the servers expect them to be read) and free them */
+  while (data->first_request != NULL)
+    socket_communication_use_request(data, data->first_request, NULL);
+
+  for (i = 0; i < data->number_of_endpoints; i++) {
+    endpoint = &data->endpoints[i];
+    if (endpoint->connected) {
+      /* Tell the socket server to reset */
+      socket_communication_send_all(endpoint, "RESET", strlen("RESET") + 1);
+      socket_communication_close(endpoint);
+    }
+    coco_free_memory(endpoint->host_name);
   }
-  if (data->prev_response_con != NULL) {
-    coco_free_memory(data->prev_response_con);
+  coco_free_memory(data->endpoints);
+#if WINSOCK
+  WSACleanup();
+#endif
+}
+
+#if !WINSOCK
+/**
+ * @brief Connects to the Unix-domain socket of the socket server on the port of the endpoint (see
+ * SOCKET_UNIX_PATH). Returns 0 on success and -1 otherwise.
+ */
+static int socket_communication_connect_unix(socket_communication_endpoint_t *endpoint) {
+  struct sockaddr_un address;
+
+  if ((endpoint->sock = socket(AF_UNIX, SOCK_STREAM, 0)) < 0) {
+    coco_error("socket_communication_connect_unix(): Socket creation error");
+  }
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  sprintf(address.sun_path, SOCKET_UNIX_PATH, (unsigned int) endpoint->port);
+  if (connect(endpoint->sock, (struct sockaddr*) &address, sizeof(address)) < 0) {
+    close(endpoint->sock);
+    return -1;
   }
+  return 0;
+}
+#endif
+
+/**
+ * @brief Connects to the socket server of the endpoint using the given transport (the shared-memory
+ * transport is set up later through a Unix-domain socket, see socket_communication_attach_shm()). Returns
+ * 0 on success and -1 otherwise.
+ */
+static int socket_communication_connect(socket_communication_endpoint_t *endpoint,
+                                        const socket_transport_e transport) {
+
+  int enable = 1;
 
 #if WINSOCK
-  /* Tell the socket server to reset */
-  send(data->sock, "RESET", (int)strlen("RESET") + 1, 0);
-  closesocket(data->sock);
-  WSACleanup();
+  /* Create a socket */
+  if ((endpoint->sock = socket(AF_INET, SOCK_STREAM, 0)) == INVALID_SOCKET) {
+    coco_error("socket_communication_connect(): Could not create socket: %d", WSAGetLastError());
+  }
+
+  (endpoint->serv_addr).sin_addr.s_addr = inet_addr(endpoint->host_name);
+  (endpoint->serv_addr).sin_family = AF_INET;
+  (endpoint->serv_addr).sin_port = htons(endpoint->port);
+
+  /* Connect to the evaluator */
+  if (connect(endpoint->sock, (SOCKADDR *) &(endpoint->serv_addr), sizeof(endpoint->serv_addr)) < 0) {
+    closesocket(endpoint->sock);
+    return -1;
+  }
+  (void) transport; /* Only TCP is available */
 #else
-  /* Tell the socket server to reset */
-  send(data->sock, "RESET", strlen("RESET") + 1, 0);
-  close(data->sock);
+  if (transport != SOCKET_TRANSPORT_TCP) {
+    if (socket_communication_connect_unix(endpoint) != 0)
+      return -1;
+  } else {
+    /* Create a socket */
+    if ((endpoint->sock = socket(AF_INET, SOCK_STREAM, 0)) < 0) {
+      coco_error("socket_communication_connect(): Socket creation error");
+    }
+
+    (endpoint->serv_addr).sin_family = AF_INET;
+    (endpoint->serv_addr).sin_port = htons(endpoint->port);
+
+    /* Convert IPv4 and IPv6 addresses from text to binary form */
+    if (inet_pton(AF_INET, endpoint->host_name, &(endpoint->serv_addr).sin_addr) <= 0) {
+      coco_error("socket_communication_connect(): Invalid address / Address not supported (host = %s)",
+          endpoint->host_name);
+    }
+
+    /* Connect to the evaluator */
+    if (connect(endpoint->sock, (struct sockaddr*) &(endpoint->serv_addr), sizeof(endpoint->serv_addr)) < 0) {
+      close(endpoint->sock);
+      return -1;
+    }
+  }
+#endif
+  /* Disable Nagle's algorithm, which would delay the requests sent without waiting for responses */
+  if (transport == SOCKET_TRANSPORT_TCP)
+    setsockopt(endpoint->sock, IPPROTO_TCP, TCP_NODELAY, (const char *) &enable, sizeof(enable));
+#ifdef SO_NOSIGPIPE
+  setsockopt(endpoint->sock, SOL_SOCKET, SO_NOSIGPIPE, (const char *) &enable, sizeof(enable));
 #endif
+  endpoint->connected = 1;
+  return 0;
+}
+
+#if SOCKET_SHM
+/**
+ * @brief Sets up the shared-memory transport with the socket server of the endpoint (connected through a
+ * Unix-domain socket).
+ *
+ * Creates a file in shared memory with two rings (one for the requests and one for the responses, each
+ * of data->ring_size bytes), maps it and sends its path to the server with the text message
+ * "SHM <path> <size>". If the server answers "OK", all further messages are exchanged through the rings
+ * and the socket is only used to wake up a peer that waits for data (see socket_communication_ring_t).
+ * Otherwise (the Python server, for example, answers "NO"), the messages are exchanged through the socket.
+ */
+static void socket_communication_attach_shm(const socket_communication_data_t *data,
+                                            socket_communication_endpoint_t *endpoint,
+                                            const size_t index) {
+  static unsigned long number_of_files = 0;
+  char path[COCO_PATH_MAX + 1], message[COCO_PATH_MAX + 32], response[64];
+  size_t response_len = 0, size = socket_communication_shm_size(data->ring_size);
+  char *shm = NULL;
+  int fd;
+
+  sprintf(path, "%s/coco_shm_%ld_%lu_%lu", SOCKET_SHM_DIRECTORY, (long) getpid(), number_of_files++,
+      (unsigned long) index);
+  if ((fd = open(path, O_RDWR | O_CREAT | O_EXCL, 0600)) < 0) {
+    coco_warning("socket_communication_attach_shm(): Could not create %s, using the socket (port = %d)", path,
+        endpoint->port);
+    return;
+  }
+  if ((ftruncate(fd, (off_t) size) != 0)
+      || ((shm = (char *) mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)) == MAP_FAILED)) {
+    coco_warning("socket_communication_attach_shm(): Could not map %s, using the socket (port = %d)", path,
+        endpoint->port);
+    close(fd);
+    unlink(path);
+    return;
+  }
+  close(fd);
+
+  /* The file is filled with zeros, so that both rings are empty */
+  memset(response, 0, sizeof(response));
+  if (socket_communication_send_all(endpoint, message,
+      (size_t) sprintf(message, "SHM %s %u", path, data->ring_size) + 1) == 0) {
+    while ((response_len < sizeof(response) - 1)
+        && (socket_communication_receive_some(endpoint, response + response_len, 1) == 1)
+        && (response[response_len] != '\0'))
+      response_len++;
+  }
+  /* Both processes have mapped the file, so that its name is not needed anymore */
+  unlink(path);
+  if (strcmp(response, "OK") == 0) {
+    endpoint->shm = shm;
+    endpoint->ring_size = data->ring_size;
+    /* Waiting actively makes sense only if the server can run at the same time */
+    endpoint->spin = (sysconf(_SC_NPROCESSORS_ONLN) > 1) ? SOCKET_SHM_SPIN : 0;
+  } else {
+    coco_warning("socket_communication_attach_shm(): The server does not support shared memory, using the "
+        "socket (port = %d)", endpoint->port);
+    munmap(shm, size);
+  }
+}
+#endif
+
+/**
+ * @brief Reads the endpoints from the suite options.
+ *
+ * The endpoints can be given as "endpoints: host1:port1,host2:port2,..." (the value can be put between
+ * quotation marks to avoid warnings about unknown option keys) or as "ports: 7000-7007", in which case
+ * the host name is taken from the option "host_name". Without these options, a single endpoint with the
+ * given host name and port is used.
+ */
+static void socket_communication_read_endpoints(socket_communication_data_t *data,
+                                                const char *suite_options,
+                                                const unsigned short default_port) {
+  char host_name[COCO_PATH_MAX + 1];
+  char *option_string, *colon;
+  char **parts;
+  size_t *ports = NULL;
+  size_t i, count = 0;
+  unsigned short port = default_port;
+
+  strcpy(host_name, HOST);
+  coco_options_read_string(suite_options, "host_name", host_name);
+  data->endpoints = (socket_communication_endpoint_t *) coco_allocate_memory(
+      MAX_ENDPOINTS * sizeof(socket_communication_endpoint_t));
+
+  option_string = coco_allocate_string(COCO_PATH_MAX + 1);
+  if (coco_options_read_string(suite_options, "endpoints", option_string) > 0) {
+    parts = coco_string_split(option_string, ',');
+    for (i = 0; parts[i] != NULL; i++) {
+      if ((strlen(parts[i]) > 0) && (count < MAX_ENDPOINTS)) {
+        colon = strrchr(parts[i], ':');
+        if ((colon == NULL) || (sscanf(colon + 1, "%hu", &port) != 1)) {
+          coco_warning("socket_communication_read_endpoints(): Ignoring endpoint '%s' (expected host:port)",
+              parts[i]);
+        } else {
+          *colon = '\0';
+          data->endpoints[count].host_name = coco_strdup(parts[i]);
+          data->endpoints[count++].port = port;
+        }
+      }
+      coco_free_memory(parts[i]);
+    }
+    coco_free_memory(parts[i]);
+    coco_free_memory(parts);
+  } else if (coco_options_read_values(suite_options, "ports", option_string) > 0) {
+    ports = coco_string_parse_ranges(option_string, 1, 65535, "ports", MAX_ENDPOINTS);
+    for (i = 0; (ports != NULL) && (ports[i] != 0); i++) {
+      data->endpoints[count].host_name = coco_strdup(host_name);
+      data->endpoints[count++].port = (unsigned short) ports[i];
+    }
+    if (ports != NULL)
+      coco_free_memory(ports);
+  }
+  coco_free_memory(option_string);
+
+  if (count == 0) {
+    coco_options_read(suite_options, "port", "%hu", &port);
+    data->endpoints[count].host_name = coco_strdup(host_name);
+    data->endpoints[count++].port = port;
+  }
+  for (i = 0; i < count; i++) {
+    data->endpoints[i].connected = 0;
+    data->endpoints[i].number_of_requests_in_flight = 0;
+    data->endpoints[i].shm = NULL;
+    data->endpoints[i].ring_size = 0;
+    data->endpoints[i].spin = 0;
+  }
+  data->number_of_endpoints = count;
+  data->last_endpoint = count - 1;
 }
 
 static socket_communication_data_t *socket_communication_data_initialize(
@@ -72,16 +1085,13 @@ static socket_communication_data_t *socket_communication_data_initialize(
   WSADATA wsa;
 #endif
   socket_communication_data_t *data;
+  char protocol[COCO_PATH_MAX + 1], transport[COCO_PATH_MAX + 1], cache_file[COCO_PATH_MAX + 1];
+  char record_file[COCO_PATH_MAX + 1];
+  size_t i, number_of_connected = 0, shm_size = 1 << 20, cache_size = 0;
+  int combined = -1;
   data = (socket_communication_data_t *) coco_allocate_memory(sizeof(*data));
 
-  data->host_name = coco_strdup(HOST);
-  if (coco_options_read_string(suite_options, "host_name", data->host_name) == 0) {
-    strcpy(data->host_name, HOST);
-  }
-
-  data->port = default_port;
-  if (coco_options_read(suite_options, "port", "%hu", &(data->port)) == 0) {
-  }
+  socket_communication_read_endpoints(data, suite_options, default_port);
 
   data->precision_x = 8;
   if (coco_options_read_int(suite_options, "precision_x", &(data->precision_x)) != 0) {
@@ -92,50 +1102,133 @@ static socket_communication_data_t *socket_communication_data_initialize(
     }
   }
 
+  data->window = 16;
+  if (coco_options_read_size_t(suite_options, "window", &(data->window)) != 0) {
+    if (data->window < 1) {
+      data->window = 1;
+      coco_warning("socket_communication_data_initialize(): Adjusted window value to %lu",
+          (unsigned long) data->window);
+    }
+  }
+
+  /* The binary protocol sends the x-values exactly (precision_x is used only by the text protocol) */
+  data->protocol = SOCKET_PROTOCOL_TEXT;
+  if (coco_options_read_string(suite_options, "protocol", protocol) != 0) {
+    if (strcmp(protocol, "binary") == 0)
+      data->protocol = SOCKET_PROTOCOL_BINARY;
+    else if (strcmp(protocol, "text") != 0)
+      coco_warning("socket_communication_data_initialize(): Unknown protocol '%s', using the text protocol",
+          protocol);
+  }
+
+  /* The local transports need a server on the same machine (the host names are ignored) */
+  data->transport = SOCKET_TRANSPORT_TCP;
+  if (coco_options_read_string(suite_options, "transport", transport) != 0) {
+    if (strcmp(transport, "unix") == 0)
+      data->transport = SOCKET_TRANSPORT_UNIX;
+    else if (strcmp(transport, "shm") == 0)
+      data->transport = SOCKET_TRANSPORT_SHM;
+    else if (strcmp(transport, "tcp") != 0)
+      coco_warning("socket_communication_data_initialize(): Unknown transport '%s', using TCP", transport);
+  }
+#if WINSOCK
+  if (data->transport != SOCKET_TRANSPORT_TCP) {
+    coco_warning("socket_communication_data_initialize(): Transport '%s' not available, using TCP", transport);
+    data->transport = SOCKET_TRANSPORT_TCP;
+  }
+#elif !SOCKET_SHM
+  if (data->transport == SOCKET_TRANSPORT_SHM) {
+    coco_warning("socket_communication_data_initialize(): Transport 'shm' not available, using 'unix'");
+    data->transport = SOCKET_TRANSPORT_UNIX;
+  }
+#endif
+
+  /* The size of the rings is a power of two between 4 KB and 1 GB */
+  coco_options_read_size_t(suite_options, "shm_size", &shm_size);
+  for (data->ring_size = 4096; (data->ring_size < shm_size) && (data->ring_size < (1UL << 30));
+      data->ring_size *= 2)
+    ;
+
 #if WINSOCK
   /* Initialize Winsock */
   if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) {
     coco_error("socket_communication_data_initialize(): Winsock initialization failed: %d", WSAGetLastError());
   }
+#endif
 
-  /* Create a socket */
-  if ((data->sock = socket(AF_INET, SOCK_STREAM, 0)) == INVALID_SOCKET) {
-    coco_error("socket_communication_data_initialize(): Could not create socket: %d", WSAGetLastError());
+  /* Connect to the evaluators (the ones that cannot be reached are not used) */
+  for (i = 0; i < data->number_of_endpoints; i++) {
+    if (socket_communication_connect(&data->endpoints[i], data->transport) == 0)
+      number_of_connected++;
+    else if (data->number_of_endpoints > 1)
+      coco_warning("socket_communication_data_initialize(): Connection failed (host = %s, port = %d)",
+          data->endpoints[i].host_name, data->endpoints[i].port);
   }
-
-  (data->serv_addr).sin_addr.s_addr = inet_addr(data->host_name);
-  (data->serv_addr).sin_family = AF_INET;
-  (data->serv_addr).sin_port = htons(data->port);
-
-  /* Connect to the evaluator */
-  if (connect(data->sock, (SOCKADDR *) &(data->serv_addr), sizeof(data->serv_addr)) < 0) {
+  if ((number_of_connected == 0) && (data->number_of_endpoints == 1)) {
     coco_error("socket_communication_data_initialize(): Connection failed (host = %s, port = %d)\nIs the server running?",
-        data->host_name, data->port);
-  }
-#else
-  /* Create a socket */
-  if ((data->sock = socket(AF_INET, SOCK_STREAM, 0)) < 0) {
-    coco_error("socket_communication_data_initialize(): Socket creation error");
+        data->endpoints[0].host_name, data->endpoints[0].port);
+  } else if (number_of_connected == 0) {
+    coco_error("socket_communication_data_initialize(): Connection failed for all %lu endpoints\nAre the servers running?",
+        (unsigned long) data->number_of_endpoints);
   }
 
-  (data->serv_addr).sin_family = AF_INET;
-  (data->serv_addr).sin_port = htons(data->port);
+  data->buffer = NULL;
+  data->buffer_size = 0;
+  data->response = NULL;
+  data->response_size = 0;
+  data->previous_obj.message = NULL;
+  data->previous_obj.values = NULL;
+  socket_communication_previous_free(&data->previous_obj);
+  data->previous_con.message = NULL;
+  data->previous_con.values = NULL;
+  socket_communication_previous_free(&data->previous_con);
+  data->batch_obj.x = NULL;
+  data->batch_obj.values = NULL;
+  socket_communication_batch_free(&data->batch_obj);
+  data->batch_con.x = NULL;
+  data->batch_con.values = NULL;
+  socket_communication_batch_free(&data->batch_con);
+  data->next_sequence = 1;
+  data->first_request = NULL;
+  data->last_request = NULL;
 
-  /* Convert IPv4 and IPv6 addresses from text to binary form */
-  if (inet_pton(AF_INET, data->host_name, &(data->serv_addr).sin_addr) <= 0) {
-    coco_error("socket_communication_data_initialize(): Invalid address / Address not supported");
-  }
+  /* The cache is used if its size or file is given (evaluators with noise should not use it) */
+  data->cache = NULL;
+  coco_options_read_size_t(suite_options, "cache_size", &cache_size);
+  if (coco_options_read_string(suite_options, "cache_file", cache_file) > 0)
+    data->cache = socket_cache_allocate(cache_size, cache_file);
+  else if (cache_size > 0)
+    data->cache = socket_cache_allocate(cache_size, NULL);
 
-  /* Connect to the evaluator */
-  if (connect(data->sock, (struct sockaddr*) &(data->serv_addr), sizeof(data->serv_addr)) < 0) {
-    coco_error("socket_communication_data_initialize(): Connection failed (host = %s, port = %d)\nIs the server running?",
-        data->host_name, data->port);
+  /* The evaluations obtained from the evaluators are appended to the log (to be replayed later) */
+  data->record = NULL;
+  data->record_x = NULL;
+  data->record_x_size = 0;
+  if (coco_options_read_string(suite_options, "record", record_file) > 0)
+    data->record = socket_cache_allocate_log(record_file);
+
+#if SOCKET_SHM
+  if (data->transport == SOCKET_TRANSPORT_SHM) {
+    for (i = 0; i < data->number_of_endpoints; i++) {
+      if (data->endpoints[i].connected)
+        socket_communication_attach_shm(data, &data->endpoints[i], i);
+    }
   }
 #endif
-  data->prev_message_obj = coco_strdup("");
-  data->prev_response_obj = coco_strdup("");
-  data->prev_message_con = coco_strdup("");
-  data->prev_response_con = coco_strdup("");
+
+  /* Combined evaluations are used with the binary protocol if all servers support them (this is
+   * negotiated) and with the text protocol only if requested (the servers cannot be asked) */
+  coco_options_read_int(suite_options, "combined", &combined);
+  data->combined = (data->protocol == SOCKET_PROTOCOL_BINARY) ? (combined != 0) : (combined > 0);
+  if (data->protocol == SOCKET_PROTOCOL_BINARY) {
+    for (i = 0; i < data->number_of_endpoints; i++) {
+      if (data->endpoints[i].connected)
+        socket_communication_negotiate(data, &data->endpoints[i]);
+    }
+    if ((combined > 0) && !data->combined)
+      coco_warning("socket_communication_data_initialize(): Combined evaluations not supported by the server, "
+          "evaluating objectives and constraints separately");
+  }
   return data;
 }
 
@@ -144,30 +1237,42 @@ static socket_communication_data_t *socket_communication_data_initialize(
  * s <s> t <t> r <r> f <f> i <i> d <d> x <x1> <x2> ... <xd>
  * Where
  * <s> is the suite name (for example, "toy-socket")
- * <t> is the type of evaluation (one of "objectives", "constraints", "add_info")
+ * <t> is the type of evaluation (one of "objectives", "constraints", "both")
  * <r> is the number of values to be returned
  * <f> is the function number
  * <i> is the instance number
  * <d> is the problem dimension
  * <xi> is the i-th value of x (there should be exactly d x-values)
+ *
+ * For the type "both", <r> is followed by c <c>, where <c> is the number of constraints, and the response
+ * contains the r - c objective values followed by the c constraint values.
+ *
+ * The message is terminated by a null character. It is created in data->buffer, which is enlarged if
+ * needed, so that the message can be arbitrarily long. Returns the length of the message (including the
+ * terminating null character).
  */
-static void socket_communication_create_message(char *message,
-                                                const char *evaluation_type,
-                                                const size_t number_of_values,
-                                                const double *x,
-                                                const coco_problem_t *problem) {
+static size_t socket_communication_create_message(socket_communication_data_t *data,
+                                                  const socket_evaluation_e evaluation_type,
+                                                  const size_t number_of_values,
+                                                  const double *x,
+                                                  const coco_problem_t *problem) {
   size_t i;
   int write_count, offset;
-  socket_communication_data_t *data;
+  char *message;
   coco_suite_t *suite = problem->suite;
+  const char *type_name = (evaluation_type == SOCKET_EVALUATE_OBJECTIVES) ? "objectives"
+      : ((evaluation_type == SOCKET_EVALUATE_CONSTRAINTS) ? "constraints" : "both");
 
-  assert(suite);
-  data = (socket_communication_data_t *) suite->data;
-  assert(data);
+  /* Each number (including the x-values written with the chosen precision) fits into 32 + precision_x
+   * characters */
+  socket_communication_reserve(data, strlen(suite->suite_name) + strlen(type_name)
+      + (problem->number_of_variables + 7) * (size_t) (32 + data->precision_x));
+  message = data->buffer;
 
-  offset = sprintf(message, "s %s t %s r %lu f %lu i %lu d %lu x ",
-      suite->suite_name, evaluation_type,
-      (unsigned long) number_of_values,
+  offset = sprintf(message, "s %s t %s r %lu ", suite->suite_name, type_name, (unsigned long) number_of_values);
+  if (evaluation_type == SOCKET_EVALUATE_BOTH)
+    offset += sprintf(message + offset, "c %lu ", (unsigned long) problem->number_of_constraints);
+  offset += sprintf(message + offset, "f %lu i %lu d %lu x ",
       (unsigned long) problem->suite_dep_function,
       (unsigned long) problem->suite_dep_instance,
       (unsigned long) problem->number_of_variables);
@@ -178,6 +1283,75 @@ static void socket_communication_create_message(char *message,
       write_count = sprintf(message + offset, "%.*e ", data->precision_x, x[i]);
     offset += write_count;
   }
+  return (size_t) offset + 1;
+}
+
+/**
+ * Creates the binary frame for the evaluator in data->buffer and returns its length. The frame has the
+ * following format:
+ * <magic> <version> <t> <l> <r> <f> <i> <d> <n> <q> <s> <x1> <x2> ... <xd>
+ * Where
+ * <magic> are the four bytes "COCB"
+ * <version> is the version of the binary protocol
+ * <t> is the type of evaluation (1 for objectives, 2 for constraints, 3 for both)
+ * <l> is the length of the suite name
+ * <r> is the number of values to be returned
+ * <f> is the function number
+ * <i> is the instance number
+ * <d> is the problem dimension
+ * <n> is the number of solutions
+ * <q> is the sequence id of the request (written by socket_communication_send_request())
+ * <s> is the suite name (without the terminating null character)
+ * <xi> is the i-th value of x (there should be exactly d x-values for each of the n solutions)
+ *
+ * Frames of type 3 contain the number of constraints <c> between <s> and <x1>, the r values of each
+ * solution in the response are then the r - c objective values followed by the c constraint values.
+ *
+ * All numbers except the x-values are 32-bit unsigned integers, the x-values are IEEE-754 doubles. All
+ * numbers are written in little-endian order. The response of the evaluator has the same header (with
+ * l = 0), followed by n * r doubles (the r values of the first solution, then those of the second one
+ * and so on). Several requests can be sent before receiving the responses, which must come in the same
+ * order (with the same sequence ids) as the requests.
+ */
+static size_t socket_communication_create_binary_message(socket_communication_data_t *data,
+                                                         const socket_evaluation_e evaluation_type,
+                                                         const size_t number_of_values,
+                                                         const double *x,
+                                                         const size_t number_of_solutions,
+                                                         const coco_problem_t *problem) {
+  size_t i, j, length, suite_name_length;
+  char *pointer;
+  const double *solution;
+  coco_suite_t *suite = problem->suite;
+
+  suite_name_length = strlen(suite->suite_name);
+  length = SOCKET_BINARY_HEADER_SIZE + suite_name_length
+      + number_of_solutions * problem->number_of_variables * sizeof(double);
+  if (evaluation_type == SOCKET_EVALUATE_BOTH)
+    length += 4;
+  socket_communication_reserve(data, length);
+
+  socket_communication_write_binary_header(data->buffer, (unsigned long) evaluation_type, suite_name_length,
+      number_of_values, problem->suite_dep_function, problem->suite_dep_instance,
+      problem->number_of_variables, number_of_solutions, 0);
+  pointer = data->buffer + SOCKET_BINARY_HEADER_SIZE;
+  memcpy(pointer, suite->suite_name, suite_name_length);
+  pointer += suite_name_length;
+  if (evaluation_type == SOCKET_EVALUATE_BOTH) {
+    socket_communication_write_uint32(pointer, (unsigned long) problem->number_of_constraints);
+    pointer += 4;
+  }
+  for (j = 0; j < number_of_solutions; j++) {
+    solution = x + j * problem->number_of_variables;
+    for (i = 0; i < problem->number_of_variables; i++) {
+      if (i < problem->number_of_integer_variables)
+        socket_communication_write_double(pointer, (double) coco_double_to_int(solution[i]));
+      else
+        socket_communication_write_double(pointer, solution[i]);
+      pointer += sizeof(double);
+    }
+  }
+  return length;
 }
 
 /**
@@ -205,100 +1379,523 @@ static void socket_communication_save_response(const char *response,
 }
 
 /**
- * Sends the message to the external evaluator through sockets. The external evaluator must be running
- * a server using the same port. Returns the response.
+ * Sends the message of the given length from data->buffer to the external evaluator through sockets.
+ * The external evaluator must be running a server using the same port. Receives the response until its
+ * terminating null character into data->response (enlarged as needed) and returns it. The message is
+ * sent to the endpoints one after another (if the connection with an endpoint fails, the endpoint is
+ * dropped and the message is sent to the next one).
  *
  * Should be working for different platforms.
  */
-static char* socket_communication_get_response(const socket_communication_data_t *data,
-                                               const char *message) {
+static const char* socket_communication_get_response(socket_communication_data_t *data,
+                                                     const size_t message_length) {
 
-#if WINSOCK
-  size_t response_len;
-#else
-  long int response_len;
-#endif
-  char response[RESPONSE_SIZE];
-  assert(data->sock);
+  long received_len = 0;
+  size_t index, response_len;
+  char *response;
+  socket_communication_endpoint_t *endpoint;
+  const double trace_start = coco_trace_begin();
 
-#if WINSOCK
-  /* Send message */
-  if (send(data->sock, message, (int)strlen(message) + 1, 0) < 0) {
-    coco_error("socket_communication_evaluate(): Send failed: %d", WSAGetLastError());
+  while (1) {
+    index = socket_communication_choose_endpoint(data);
+    endpoint = &data->endpoints[index];
+    response_len = 0;
+
+    /* Send message */
+    if (socket_communication_send_all(endpoint, data->buffer, message_length) == 0) {
+      coco_debug("Sent message: %s", data->buffer);
+
+      /* Receive the response (it can arrive in several parts) */
+      do {
+        if (data->response_size < response_len + RECEIVE_SIZE + 1) {
+          data->response_size = 2 * data->response_size + RECEIVE_SIZE + 1;
+          response = (char *) coco_allocate_memory(data->response_size);
+          if (data->response != NULL) {
+            memcpy(response, data->response, response_len);
+            coco_free_memory(data->response);
+          }
+          data->response = response;
+        }
+        received_len = socket_communication_receive_some(endpoint, data->response + response_len, RECEIVE_SIZE);
+        if (received_len <= 0)
+          break;
+        response_len += (size_t) received_len;
+      } while (memchr(data->response + response_len - (size_t) received_len, '\0', (size_t) received_len) == NULL);
+      if (received_len > 0)
+        break;
+    }
+    socket_communication_drop_endpoint(data, index);
   }
-  coco_debug("Sent message: %s", message);
+  data->response[response_len] = '\0';
+  coco_debug("Received response: %s (length %lu)", data->response, (unsigned long) response_len);
+
+  coco_trace_end(COCO_TRACE_SOCKET_ROUND_TRIP, trace_start, (double) message_length);
+  return data->response;
+}
 
-  /* Receive the response */
-  if ((response_len = (size_t) recv(data->sock, response, RESPONSE_SIZE, 0)) == SOCKET_ERROR) {
-    coco_error("socket_communication_evaluate(): Receive failed: %d", WSAGetLastError());
+/**
+ * @brief Looks up x in the batch of prefetched evaluations and saves its values into values.
+ *
+ * Returns 1 if x was found and 0 otherwise. The solutions are usually looked up in the order in which
+ * they were prefetched, so the expected one is checked first.
+ */
+static int socket_communication_batch_lookup(socket_communication_batch_t *batch,
+                                             const coco_problem_t *problem,
+                                             const size_t number_of_values,
+                                             const double *x,
+                                             double *values) {
+  size_t i, index;
+  const size_t dimension = problem->number_of_variables;
+
+  if ((batch->number_of_solutions == 0) || (batch->function != problem->suite_dep_function)
+      || (batch->instance != problem->suite_dep_instance) || (batch->dimension != dimension)
+      || (batch->number_of_values != number_of_values))
+    return 0;
+
+  for (i = 0; i < batch->number_of_solutions; i++) {
+    index = (batch->next + i) % batch->number_of_solutions;
+    if (memcmp(batch->x + index * dimension, x, dimension * sizeof(double)) == 0) {
+      memcpy(values, batch->values + index * number_of_values, number_of_values * sizeof(double));
+      batch->next = (index + 1) % batch->number_of_solutions;
+      return 1;
+    }
   }
-  response[response_len] = '\0';
-  coco_debug("Received response: %s (length %d)", response, response_len);
-#else
-  /* Send message */
-  if (send(data->sock, message, strlen(message) + 1, 0) < 0) {
-    coco_error("socket_communication_evaluate(): Send failed");
+  return 0;
+}
+
+/**
+ * @brief Appends the evaluations of the number_of_solutions solutions x (stored one after another) of
+ * the given type to the log of recorded evaluations (if they are recorded).
+ *
+ * The evaluations are recorded with the x-values received by the evaluator (with the text protocol,
+ * they are rounded to precision_x digits), so that the replay server can find them. The evaluations of
+ * objectives and constraints are recorded separately even if they were obtained together.
+ */
+static void socket_communication_record(socket_communication_data_t *data,
+                                        const coco_problem_t *problem,
+                                        const socket_evaluation_e evaluation_type,
+                                        const size_t number_of_values,
+                                        const double *x,
+                                        const size_t number_of_solutions,
+                                        const double *values) {
+  size_t i, j;
+  const size_t dimension = problem->number_of_variables;
+  char number[64];
+
+  if (data->record == NULL)
+    return;
+  if (data->record_x_size < dimension) {
+    if (data->record_x != NULL)
+      coco_free_memory(data->record_x);
+    data->record_x = coco_allocate_vector(dimension);
+    data->record_x_size = dimension;
   }
-  coco_debug("Sent message: %s", message);
+  for (j = 0; j < number_of_solutions; j++) {
+    for (i = 0; i < dimension; i++) {
+      data->record_x[i] = x[j * dimension + i];
+      if ((data->protocol == SOCKET_PROTOCOL_TEXT) && (i >= problem->number_of_integer_variables)) {
+        sprintf(number, "%.*e", data->precision_x, data->record_x[i]);
+        data->record_x[i] = strtod(number, NULL);
+      }
+    }
+    socket_cache_set_key(data->record, problem->suite->suite_name, (unsigned long) evaluation_type,
+        problem->suite_dep_function, problem->suite_dep_instance, dimension, problem->number_of_integer_variables,
+        number_of_values, data->record_x);
+    socket_cache_insert(data->record, number_of_values, values + j * number_of_values);
+  }
+}
 
-  /* Receive the response */
-  response_len = read(data->sock, response, RESPONSE_SIZE);
-  response[response_len] = '\0';
-  coco_debug("Received response: %s (length %ld)", response, response_len);
-#endif
-  return coco_strdup(response);
+/**
+ * @brief Replaces the previous evaluation of the given type with the evaluation of x.
+ */
+static void socket_communication_remember(socket_communication_data_t *data,
+                                          const coco_problem_t *problem,
+                                          const socket_evaluation_e evaluation_type,
+                                          const size_t number_of_values,
+                                          const double *x,
+                                          const double *values) {
+  size_t message_length;
+  socket_communication_previous_t *previous;
+
+  previous = (evaluation_type == SOCKET_EVALUATE_OBJECTIVES) ? &data->previous_obj : &data->previous_con;
+  if (data->protocol == SOCKET_PROTOCOL_BINARY)
+    message_length = socket_communication_create_binary_message(data, evaluation_type, number_of_values, x, 1,
+        problem);
+  else
+    message_length = socket_communication_create_message(data, evaluation_type, number_of_values, x, problem);
+  socket_communication_previous_free(previous);
+  previous->message = (char *) coco_allocate_memory(message_length);
+  memcpy(previous->message, data->buffer, message_length);
+  previous->message_length = message_length;
+  previous->values = coco_duplicate_vector(values, number_of_values);
+  previous->number_of_values = number_of_values;
 }
 
 /**
- * @brief Calls the external evaluator to evaluate the objective values for x.
+ * @brief Evaluates the objectives and constraints of x with a single request and saves the values of the
+ * given evaluation type into values.
+ *
+ * Both parts are remembered as the previous evaluations of their type, so that the evaluation of the
+ * other type for the same x (by the logger or coco_is_feasible(), for example) needs no communication.
  */
-static void socket_evaluate_function(coco_problem_t *problem, const double *x, double *y) {
+static void socket_communication_evaluate_both(socket_communication_data_t *data,
+                                               const coco_problem_t *problem,
+                                               const socket_evaluation_e evaluation_type,
+                                               const double *x,
+                                               double *values) {
+  const size_t number_of_objectives = problem->number_of_objectives;
+  const size_t number_of_values = number_of_objectives + problem->number_of_constraints;
+  double *both_values = coco_allocate_vector(number_of_values);
+  size_t message_length;
+  const char *response;
+  socket_communication_request_t *request;
 
-  char message[MESSAGE_SIZE];
-  const char evaluation_type[] = "objectives";
+  if (data->protocol == SOCKET_PROTOCOL_BINARY) {
+    /* Use the request for x if it was submitted before */
+    request = socket_communication_find_request(data, problem, SOCKET_EVALUATE_BOTH, number_of_values, x);
+    if (request == NULL) {
+      message_length = socket_communication_create_binary_message(data, SOCKET_EVALUATE_BOTH, number_of_values,
+          x, 1, problem);
+      request = socket_communication_send_request(data, problem, SOCKET_EVALUATE_BOTH, number_of_values, x, 1,
+          message_length);
+    }
+    socket_communication_use_request(data, request, both_values);
+  } else {
+    message_length = socket_communication_create_message(data, SOCKET_EVALUATE_BOTH, number_of_values, x,
+        problem);
+    response = socket_communication_get_response(data, message_length);
+    socket_communication_save_response(response, number_of_values, both_values);
+  }
+
+  socket_communication_record(data, problem, SOCKET_EVALUATE_OBJECTIVES, number_of_objectives, x, 1,
+      both_values);
+  socket_communication_record(data, problem, SOCKET_EVALUATE_CONSTRAINTS, problem->number_of_constraints, x, 1,
+      both_values + number_of_objectives);
+  socket_communication_remember(data, problem, SOCKET_EVALUATE_OBJECTIVES, number_of_objectives, x,
+      both_values);
+  socket_communication_remember(data, problem, SOCKET_EVALUATE_CONSTRAINTS, problem->number_of_constraints, x,
+      both_values + number_of_objectives);
+  if (evaluation_type == SOCKET_EVALUATE_OBJECTIVES)
+    memcpy(values, both_values, number_of_objectives * sizeof(double));
+  else
+    memcpy(values, both_values + number_of_objectives, problem->number_of_constraints * sizeof(double));
+  coco_free_memory(both_values);
+}
+
+/**
+ * @brief Evaluates x with the external evaluator and saves the number_of_values results into values.
+ *
+ * If x was prefetched or submitted or if the message equals the one of the previous evaluation of the
+ * same type, the stored values (or the response to the submitted request) are used instead of sending a
+ * new request (a request submitted for x that is not used is discarded). If data->combined is set, the
+ * objectives and constraints of problems with constraints are evaluated together (see
+ * socket_communication_evaluate_both()).
+ */
+static void socket_communication_evaluate_uncached(const coco_problem_t *problem,
+                                                   const socket_evaluation_e evaluation_type,
+                                                   const size_t number_of_values,
+                                                   const double *x,
+                                                   double *values) {
+
+  const char *response;
+  size_t message_length;
   socket_communication_data_t *data;
+  socket_communication_previous_t *previous;
+  socket_communication_request_t *request;
   coco_suite_t *suite = problem->suite;
 
   assert(suite);
   data = (socket_communication_data_t *) suite->data;
   assert(data);
+  previous = (evaluation_type == SOCKET_EVALUATE_OBJECTIVES) ? &data->previous_obj : &data->previous_con;
+
+  if (socket_communication_batch_lookup(
+      (evaluation_type == SOCKET_EVALUATE_OBJECTIVES) ? &data->batch_obj : &data->batch_con, problem,
+      number_of_values, x, values)) {
+    if (data->protocol == SOCKET_PROTOCOL_BINARY)
+      socket_communication_discard_request(data, problem, evaluation_type, number_of_values, x);
+    return;
+  }
+
+  if (data->protocol == SOCKET_PROTOCOL_BINARY)
+    message_length = socket_communication_create_binary_message(data, evaluation_type, number_of_values, x, 1,
+        problem);
+  else
+    message_length = socket_communication_create_message(data, evaluation_type, number_of_values, x, problem);
 
-  socket_communication_create_message(message, evaluation_type, problem->number_of_objectives, x, problem);
-  if (strcmp(message, data->prev_message_obj) != 0) {
-    /* Get the response from the socket server */
-    coco_free_memory(data->prev_message_obj);
-    data->prev_message_obj = coco_strdup(message);
-    coco_free_memory(data->prev_response_obj);
-    data->prev_response_obj = socket_communication_get_response(data, message);
+  if ((previous->message != NULL) && (previous->message_length == message_length)
+      && (previous->number_of_values == number_of_values)
+      && (memcmp(previous->message, data->buffer, message_length) == 0)) {
+    memcpy(values, previous->values, number_of_values * sizeof(double));
+    if (data->protocol == SOCKET_PROTOCOL_BINARY)
+      socket_communication_discard_request(data, problem, evaluation_type, number_of_values, x);
+    return;
   }
-  socket_communication_save_response(data->prev_response_obj, problem->number_of_objectives, y);
-  coco_debug("objective message %s", message);
+
+  if (data->combined && (problem->number_of_constraints > 0)) {
+    socket_communication_evaluate_both(data, problem, evaluation_type, x, values);
+    return;
+  }
+
+  /* Remember the message (the buffer is reused for the next binary messages) */
+  socket_communication_previous_free(previous);
+  previous->message = (char *) coco_allocate_memory(message_length);
+  memcpy(previous->message, data->buffer, message_length);
+  previous->message_length = message_length;
+
+  /* Get the response from the socket server */
+  if (data->protocol == SOCKET_PROTOCOL_BINARY) {
+    /* Use the request for x if it was submitted before */
+    request = socket_communication_find_request(data, problem, evaluation_type, number_of_values, x);
+    if (request == NULL)
+      request = socket_communication_send_request(data, problem, evaluation_type, number_of_values, x, 1,
+          message_length);
+    socket_communication_use_request(data, request, values);
+  } else {
+    response = socket_communication_get_response(data, message_length);
+    socket_communication_save_response(response, number_of_values, values);
+  }
+  socket_communication_record(data, problem, evaluation_type, number_of_values, x, 1, values);
+  previous->values = coco_duplicate_vector(values, number_of_values);
+  previous->number_of_values = number_of_values;
 }
 
+static void socket_evaluate_function(coco_problem_t *problem, const double *x, double *y);
+
 /**
- * @brief Calls the external evaluator to evaluate the constraint violations for x.
+ * @brief Sets the key of the evaluation of x in the cache of the suite (see socket_cache_set_key()).
  */
-static void socket_evaluate_constraint(coco_problem_t *problem, const double *x, double *y, int update_counter) {
+static void socket_communication_set_cache_key(socket_communication_data_t *data,
+                                               const coco_problem_t *problem,
+                                               const socket_evaluation_e evaluation_type,
+                                               const size_t number_of_values,
+                                               const double *x) {
+  socket_cache_set_key(data->cache, problem->suite->suite_name, (unsigned long) evaluation_type,
+      problem->suite_dep_function, problem->suite_dep_instance, problem->number_of_variables,
+      problem->number_of_integer_variables, number_of_values, x);
+}
+
+/**
+ * @brief Evaluates x and saves the number_of_values results into values, using the cache of evaluations
+ * if it is enabled.
+ *
+ * The evaluations found in the cache are not sent to the external evaluator, but they are still counted
+ * as evaluations of the problem (by coco_evaluate_function() and coco_evaluate_constraint()). A request
+ * submitted for x (for example, if x was submitted twice) is discarded when x is found in the cache.
+ */
+static void socket_communication_evaluate(const coco_problem_t *problem,
+                                          const socket_evaluation_e evaluation_type,
+                                          const size_t number_of_values,
+                                          const double *x,
+                                          double *values) {
+  socket_communication_data_t *data = (socket_communication_data_t *) problem->suite->data;
+
+  if (data->cache != NULL) {
+    socket_communication_set_cache_key(data, problem, evaluation_type, number_of_values, x);
+    if (socket_cache_lookup(data->cache, number_of_values, values)) {
+      if (data->protocol == SOCKET_PROTOCOL_BINARY)
+        socket_communication_discard_request(data, problem, evaluation_type, number_of_values, x);
+      return;
+    }
+  }
+  socket_communication_evaluate_uncached(problem, evaluation_type, number_of_values, x, values);
+  if (data->cache != NULL)
+    socket_cache_insert(data->cache, number_of_values, values);
+}
 
-  char message[MESSAGE_SIZE];
-  const char evaluation_type[] = "constraints";
+/**
+ * @brief Saves the numbers of hits and misses of the evaluation cache used by the problem into hits and
+ * misses.
+ *
+ * Returns 1 if the problem is evaluated by an external evaluator that uses the cache and 0 otherwise.
+ */
+static int socket_communication_get_cache_counters(const coco_problem_t *problem, size_t *hits, size_t *misses) {
   socket_communication_data_t *data;
-  coco_suite_t *suite = problem->suite;
 
-  assert(suite);
-  data = (socket_communication_data_t *) suite->data;
+  if ((problem->evaluate_function != socket_evaluate_function) || (problem->suite == NULL)
+      || (problem->suite->data == NULL))
+    return 0;
+  data = (socket_communication_data_t *) problem->suite->data;
+  if (data->cache == NULL)
+    return 0;
+  *hits = data->cache->hits;
+  *misses = data->cache->misses;
+  return 1;
+}
+
+/**
+ * @brief Evaluates the batch of solutions x with a single request to each of the connected endpoints (the
+ * solutions are split evenly among them) and stores the results in the given batch (replacing its previous
+ * contents).
+ */
+static void socket_communication_prefetch(const coco_problem_t *problem,
+                                          const socket_evaluation_e evaluation_type,
+                                          const size_t number_of_values,
+                                          const double *x,
+                                          const size_t number_of_solutions,
+                                          socket_communication_batch_t *batch) {
+  size_t message_length, i, first, count, number_of_parts = 0;
+  socket_communication_request_t **requests;
+  socket_communication_data_t *data = (socket_communication_data_t *) problem->suite->data;
+  const size_t dimension = problem->number_of_variables;
+
+  socket_communication_batch_free(batch);
+  batch->x = coco_duplicate_vector(x, number_of_solutions * dimension);
+  batch->values = coco_allocate_vector(number_of_solutions * number_of_values);
+
+  for (i = 0; i < data->number_of_endpoints; i++)
+    number_of_parts += (size_t) data->endpoints[i].connected;
+  if (number_of_parts > number_of_solutions)
+    number_of_parts = number_of_solutions;
+  requests = (socket_communication_request_t **) coco_allocate_memory(number_of_parts * sizeof(*requests));
+  for (i = 0; i < number_of_parts; i++) {
+    first = i * number_of_solutions / number_of_parts;
+    count = (i + 1) * number_of_solutions / number_of_parts - first;
+    message_length = socket_communication_create_binary_message(data, evaluation_type, number_of_values,
+        x + first * dimension, count, problem);
+    requests[i] = socket_communication_send_request(data, problem, evaluation_type, number_of_values,
+        x + first * dimension, count, message_length);
+  }
+  for (i = 0; i < number_of_parts; i++)
+    socket_communication_use_request(data, requests[i],
+        batch->values + (i * number_of_solutions / number_of_parts) * number_of_values);
+  coco_free_memory(requests);
+  batch->function = problem->suite_dep_function;
+  batch->instance = problem->suite_dep_instance;
+  batch->dimension = dimension;
+  batch->number_of_values = number_of_values;
+  batch->number_of_solutions = number_of_solutions;
+  batch->next = 0;
+}
+
+
+/**
+ * @brief Stores the number_of_values values starting at offset of each solution from the batch both into
+ * the batch part (replacing its previous contents).
+ */
+static void socket_communication_batch_split(const socket_communication_batch_t *both,
+                                             const size_t offset,
+                                             const size_t number_of_values,
+                                             socket_communication_batch_t *part) {
+  size_t i;
+
+  socket_communication_batch_free(part);
+  part->x = coco_duplicate_vector(both->x, both->number_of_solutions * both->dimension);
+  part->values = coco_allocate_vector(both->number_of_solutions * number_of_values);
+  for (i = 0; i < both->number_of_solutions; i++)
+    memcpy(part->values + i * number_of_values, both->values + i * both->number_of_values + offset,
+        number_of_values * sizeof(double));
+  part->function = both->function;
+  part->instance = both->instance;
+  part->dimension = both->dimension;
+  part->number_of_values = number_of_values;
+  part->number_of_solutions = both->number_of_solutions;
+  part->next = 0;
+}
+
+/**
+ * @brief Prefetches the objective values (and constraint violations, if the problem has constraints) of
+ * the batch of solutions x, so that their subsequent evaluations need no communication (with combined
+ * evaluations, both are obtained with the same requests).
+ *
+ * Requires the binary protocol (with the text protocol, the solutions are evaluated one by one).
+ */
+static void socket_prefetch_function(coco_problem_t *problem, const double *x, const size_t number_of_solutions) {
+  socket_communication_data_t *data;
+  socket_communication_batch_t both;
+
+  assert(problem->suite);
+  data = (socket_communication_data_t *) problem->suite->data;
   assert(data);
+  if (data->protocol != SOCKET_PROTOCOL_BINARY)
+    return;
 
-  socket_communication_create_message(message, evaluation_type, problem->number_of_constraints, x, problem);
-  if (strcmp(message, data->prev_message_con) != 0) {
-    /* Get the response from the socket server */
-    coco_free_memory(data->prev_message_con);
-    data->prev_message_con = coco_strdup(message);
-    coco_free_memory(data->prev_response_con);
-    data->prev_response_con = socket_communication_get_response(data, message);
+  if (data->combined && (problem->number_of_constraints > 0)) {
+    both.x = NULL;
+    both.values = NULL;
+    socket_communication_prefetch(problem, SOCKET_EVALUATE_BOTH,
+        problem->number_of_objectives + problem->number_of_constraints, x, number_of_solutions, &both);
+    socket_communication_batch_split(&both, 0, problem->number_of_objectives, &data->batch_obj);
+    socket_communication_batch_split(&both, problem->number_of_objectives, problem->number_of_constraints,
+        &data->batch_con);
+    socket_communication_batch_free(&both);
+  } else {
+    socket_communication_prefetch(problem, SOCKET_EVALUATE_OBJECTIVES, problem->number_of_objectives, x,
+        number_of_solutions, &data->batch_obj);
+    if (problem->number_of_constraints > 0)
+      socket_communication_prefetch(problem, SOCKET_EVALUATE_CONSTRAINTS, problem->number_of_constraints, x,
+          number_of_solutions, &data->batch_con);
   }
-  socket_communication_save_response(data->prev_response_con, problem->number_of_constraints, y);
-  coco_debug("constraint message %s", message);
-  (void) update_counter; /* To silence the compiler */
+  socket_communication_record(data, problem, SOCKET_EVALUATE_OBJECTIVES, problem->number_of_objectives, x,
+      number_of_solutions, data->batch_obj.values);
+  if (problem->number_of_constraints > 0)
+    socket_communication_record(data, problem, SOCKET_EVALUATE_CONSTRAINTS, problem->number_of_constraints, x,
+        number_of_solutions, data->batch_con.values);
 }
 
+/**
+ * @brief Sends the request for the evaluation of x of the given type without waiting for the response
+ * (unless the evaluation is in the cache).
+ */
+static void socket_communication_submit(socket_communication_data_t *data,
+                                        const coco_problem_t *problem,
+                                        const socket_evaluation_e evaluation_type,
+                                        const size_t number_of_values,
+                                        const double *x) {
+  size_t message_length;
+
+  /* A combined evaluation is skipped if the objectives are cached */
+  if (data->cache != NULL) {
+    if (evaluation_type == SOCKET_EVALUATE_BOTH)
+      socket_communication_set_cache_key(data, problem, SOCKET_EVALUATE_OBJECTIVES, problem->number_of_objectives,
+          x);
+    else
+      socket_communication_set_cache_key(data, problem, evaluation_type, number_of_values, x);
+    if (socket_cache_contains(data->cache))
+      return;
+  }
+  message_length = socket_communication_create_binary_message(data, evaluation_type, number_of_values, x, 1,
+      problem);
+  socket_communication_send_request(data, problem, evaluation_type, number_of_values, x, 1, message_length);
+}
+
+/**
+ * @brief Sends the requests for the evaluation of the objective values (and constraint violations, if the
+ * problem has constraints, with a single request if combined evaluations are used) of x without waiting for
+ * the responses, which are used when x is evaluated.
+ *
+ * Requires the binary protocol (with the text protocol, x is evaluated only when it is collected).
+ */
+static void socket_submit_function(coco_problem_t *problem, const double *x) {
+  socket_communication_data_t *data;
+
+  assert(problem->suite);
+  data = (socket_communication_data_t *) problem->suite->data;
+  assert(data);
+  if (data->protocol != SOCKET_PROTOCOL_BINARY)
+    return;
+
+  if (data->combined && (problem->number_of_constraints > 0)) {
+    socket_communication_submit(data, problem, SOCKET_EVALUATE_BOTH,
+        problem->number_of_objectives + problem->number_of_constraints, x);
+    return;
+  }
+  socket_communication_submit(data, problem, SOCKET_EVALUATE_OBJECTIVES, problem->number_of_objectives, x);
+  if (problem->number_of_constraints > 0)
+    socket_communication_submit(data, problem, SOCKET_EVALUATE_CONSTRAINTS, problem->number_of_constraints, x);
+}
+
+/**
+ * @brief Calls the external evaluator to evaluate the objective values for x.
+ */
+static void socket_evaluate_function(coco_problem_t *problem, const double *x, double *y) {
+  socket_communication_evaluate(problem, SOCKET_EVALUATE_OBJECTIVES, problem->number_of_objectives, x, y);
+}
+
+/**
+ * @brief Calls the external evaluator to evaluate the constraint violations for x.
+ */
+static void socket_evaluate_constraint(coco_problem_t *problem, const double *x, double *y, int update_counter) {
+  socket_communication_evaluate(problem, SOCKET_EVALUATE_CONSTRAINTS, problem->number_of_constraints, x, y);
+  (void) update_counter; /* To silence the compiler */
+}
@@ -33,8 +33,10 @@ static coco_suite_t *coco_suite_allocate(const char *suite_name,
 
 /**
  * @brief Sets the dimensions and default instances for the bbob-biobj suites.
+ *
+ * The only suite option used here is "instance_cache" (see suite_biobj_set_instance_cache()).
  */
-static coco_suite_t *suite_biobj_initialize(const char *suite_name) {
+static coco_suite_t *suite_biobj_initialize(const char *suite_name, const char *suite_options) {
 
   coco_suite_t *suite;
   const size_t dimensions[] = { 2, 3, 5, 10, 20, 40 };
@@ -50,6 +52,7 @@ static coco_suite_t *suite_biobj_initialize(const char *suite_name) {
   }
 
   suite->data_free_function = suite_biobj_new_inst_free;
+  suite_biobj_set_instance_cache(suite, suite_options);
 
   return suite;
 }
@@ -91,6 +94,8 @@ static coco_problem_t *suite_biobj_get_problem(coco_suite_t *suite,
 
   problem = coco_get_biobj_problem(function, dimension, instance, coco_get_bbob_problem, &new_inst_data,
       suite->number_of_instances, suite->dimensions, suite->number_of_dimensions);
+  /* Keep the new instances (if any) for the next problems */
+  suite->data = new_inst_data;
 
   problem->suite_dep_function = function;
   problem->suite_dep_instance = instance;
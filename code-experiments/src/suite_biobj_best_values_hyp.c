@@ -11,6 +11,10 @@
  * pre-processing purposes, its formatting should not be altered. This means that there must be exactly one
  * string per line, the first string appearing on the next line after "static const char..." (no comments 
  * allowed in between). Nothing should be placed on the last line (line with };).
+ *
+ * @note The strings must be sorted by their keys (in the order of strcmp), since the values are looked up
+ * with binary search (see suite_biobj_find_best_hyp_value()). The pre-processing scripts write the values
+ * in this order.
  */
 static const char *suite_biobj_best_values_hyp[] = { /* Best values on 29.01.2017 16:30:00, copied from: best values current data, 10.07.2016 */
   "bbob-biobj_f01_i01_d02 0.833332923849452",
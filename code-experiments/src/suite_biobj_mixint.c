@@ -20,11 +20,14 @@ static coco_suite_t *coco_suite_allocate(const char *suite_name,
                                          const char *default_instances,
                                          const int known_optima);
 static void suite_biobj_new_inst_free(void *stuff);
+static void suite_biobj_set_instance_cache(coco_suite_t *suite, const char *suite_options);
 
 /**
  * @brief Sets the dimensions and default instances for the bbob-biobj-mixint suite.
+ *
+ * The only suite option used here is "instance_cache" (see suite_biobj_set_instance_cache()).
  */
-static coco_suite_t *suite_biobj_mixint_initialize(void) {
+static coco_suite_t *suite_biobj_mixint_initialize(const char *suite_options) {
 
   coco_suite_t *suite;
   const size_t dimensions[] = { 5, 10, 20, 40, 80, 160 };
@@ -32,6 +35,7 @@ static coco_suite_t *suite_biobj_mixint_initialize(void) {
 
   suite = coco_suite_allocate("bbob-biobj-mixint", 92, num_dimensions, dimensions, "instances: 1-15", 0);
   suite->data_free_function = suite_biobj_new_inst_free;
+  suite_biobj_set_instance_cache(suite, suite_options);
 
   return suite;
 }
@@ -195,6 +199,8 @@ static coco_problem_t *suite_biobj_mixint_get_problem(coco_suite_t *suite,
   else
     problem = coco_get_biobj_mixint_problem(function, dimension, instance, coco_get_largescale_problem,
         &new_inst_data, suite->number_of_instances, suite->dimensions, suite->number_of_dimensions);
+  /* Keep the new instances (if any) for the next problems */
+  suite->data = new_inst_data;
 
   problem->suite_dep_function = function;
   problem->suite_dep_instance = instance;
@@ -7,10 +7,15 @@
  * suite_biobj_instances. If a new instance of the problem is called, a check ensures that the two underlying
  * single-objective instances create a true bi-objective problem. However, these new instances need to be
  * manually added to suite_biobj_instances, otherwise they will be computed each time the suite constructor
- * is invoked with these instances.
+ * is invoked with these instances (unless they are stored in the instance cache given with the suite option
+ * "instance_cache", see suite_biobj_set_instance_cache()).
  */
 
+#include <stdlib.h>
+#include <string.h>
+
 #include "coco.h"
+#include "socket_cache.c"
 #include "suite_biobj_best_values_hyp.c"
 
 /**
@@ -48,6 +53,9 @@ typedef struct {
 
   size_t max_new_instances;  /**< @brief The maximal number of new instances. */
 
+  socket_cache_t *instance_cache; /**< @brief The cache of new instances shared across runs (NULL if none
+                                       is used). */
+
 } suite_biobj_new_inst_t;
 
 /**
@@ -71,67 +79,215 @@ static void suite_biobj_new_inst_free(void *stuff) {
   }
   coco_free_memory(data->new_instances);
   data->new_instances = NULL;
+
+  if (data->instance_cache != NULL) {
+    socket_cache_free(data->instance_cache);
+    data->instance_cache = NULL;
+  }
+}
+
+/**
+ * @brief Allocates the structure holding the information about new instances (without the new instances).
+ */
+static suite_biobj_new_inst_t *suite_biobj_new_inst_allocate(void) {
+
+  suite_biobj_new_inst_t *data = (suite_biobj_new_inst_t *) coco_allocate_memory(sizeof(*data));
+
+  data->new_instances = NULL;
+  data->max_new_instances = 0;
+  data->instance_cache = NULL;
+  return data;
+}
+
+/**
+ * @brief Opens the cache of new instances if it is given with the suite option "instance_cache".
+ *
+ * The cache file (in the format of the cache files of socket suites, see socket_cache.c) stores the
+ * instance2 accepted by suite_biobj_get_new_instance() for the given instance1 and dimensions, so that the
+ * search needs to be performed only once across runs (and processes) that use the same file.
+ */
+static void suite_biobj_set_instance_cache(coco_suite_t *suite, const char *suite_options) {
+
+  suite_biobj_new_inst_t *data;
+  char *file_name;
+
+  if ((suite_options == NULL) || (strlen(suite_options) == 0))
+    return;
+
+  file_name = coco_allocate_string(COCO_PATH_MAX + 1);
+  if (coco_options_read_string(suite_options, "instance_cache", file_name) > 0) {
+    data = suite_biobj_new_inst_allocate();
+    /* The suites have at most 1000 instances (see COCO_MAX_INSTANCES) */
+    data->instance_cache = socket_cache_allocate(1000, file_name);
+    suite->data = data;
+  }
+  coco_free_memory(file_name);
+}
+
+/**
+ * @brief Sets the key of the instance cache to the given instance1 and dimensions.
+ *
+ * The instance2 depends also on the construction of the bbob problems, therefore the version of COCO is
+ * part of the key.
+ */
+static void suite_biobj_set_instance_cache_key(socket_cache_t *cache,
+                                               const size_t instance1,
+                                               const size_t *dimensions,
+                                               const size_t num_dimensions) {
+  char *name = coco_strdupf("bbob-biobj instances %s", coco_version);
+  double *x = coco_allocate_vector(num_dimensions);
+  size_t d;
+
+  for (d = 0; d < num_dimensions; d++)
+    x[d] = (double) dimensions[d];
+  socket_cache_set_key(cache, name, 1, 0, instance1, num_dimensions, num_dimensions, 1, x);
+  coco_free_memory(x);
+  coco_free_memory(name);
+}
+
+/**
+ * @brief Single-objective bbob problems of one instance used when checking candidates for new instances.
+ *
+ * The problems are constructed when first needed and reused for all function pairs they take part in,
+ * which avoids constructing the same problem (with its transformations) for each pair.
+ */
+typedef struct {
+  coco_problem_t **problems;  /**< @brief The problems (NULL if not constructed yet), indexed by function
+                                   and dimension. */
+  const size_t *functions;    /**< @brief The bbob functions. */
+  size_t num_functions;       /**< @brief The number of bbob functions. */
+  const size_t *dimensions;   /**< @brief The dimensions. */
+  size_t num_dimensions;      /**< @brief The number of dimensions. */
+  size_t instance;            /**< @brief The instance of all problems. */
+} suite_biobj_problem_cache_t;
+
+/**
+ * @brief Allocates an empty cache of problems of the given instance.
+ */
+static suite_biobj_problem_cache_t *suite_biobj_problem_cache_allocate(const size_t *functions,
+                                                                       const size_t num_functions,
+                                                                       const size_t *dimensions,
+                                                                       const size_t num_dimensions,
+                                                                       const size_t instance) {
+  suite_biobj_problem_cache_t *cache;
+  size_t i;
+
+  cache = (suite_biobj_problem_cache_t *) coco_allocate_memory(sizeof(*cache));
+  cache->problems = (coco_problem_t **) coco_allocate_memory(num_functions * num_dimensions
+      * sizeof(coco_problem_t *));
+  for (i = 0; i < num_functions * num_dimensions; i++)
+    cache->problems[i] = NULL;
+  cache->functions = functions;
+  cache->num_functions = num_functions;
+  cache->dimensions = dimensions;
+  cache->num_dimensions = num_dimensions;
+  cache->instance = instance;
+  return cache;
+}
+
+/**
+ * @brief Frees the cache together with its problems.
+ */
+static void suite_biobj_problem_cache_free(suite_biobj_problem_cache_t *cache) {
+  size_t i;
+
+  for (i = 0; i < cache->num_functions * cache->num_dimensions; i++) {
+    if (cache->problems[i] != NULL)
+      coco_problem_free(cache->problems[i]);
+  }
+  coco_free_memory(cache->problems);
+  coco_free_memory(cache);
+}
+
+/**
+ * @brief Returns the problem with the given function and the dimension with the given index (the problem
+ * is constructed if it is not yet in the cache).
+ */
+static coco_problem_t *suite_biobj_problem_cache_get(suite_biobj_problem_cache_t *cache,
+                                                     const size_t function,
+                                                     const size_t dimension_idx) {
+  size_t f, i;
+
+  for (f = 0; f < cache->num_functions; f++) {
+    if (cache->functions[f] == function)
+      break;
+  }
+  if (f == cache->num_functions) {
+    coco_error("suite_biobj_problem_cache_get(): function %lu not found", (unsigned long) function);
+    return NULL; /* Never reached */
+  }
+
+  i = f * cache->num_dimensions + dimension_idx;
+  if (cache->problems[i] == NULL)
+    cache->problems[i] = coco_get_bbob_problem(function, cache->dimensions[dimension_idx], cache->instance);
+  return cache->problems[i];
 }
 
 /**
  * @brief  Performs a few checks and returns whether the two given problem instances should break the search
  * for new instances in suite_biobj_get_new_instance().
+ *
+ * The ideal and nadir points are computed as in coco_problem_stacked_allocate(), but without constructing
+ * the stacked problem, that is, the ideal point consists of the optimal values of the two problems and the
+ * nadir point of their values in the optimum of the other problem.
  */
-static int suite_biobj_check_inst_consistency(const size_t dimension,
-                                              size_t function1,
-                                              size_t instance1,
-                                              size_t function2,
-                                              size_t instance2) {
-  coco_problem_t *problem = NULL;
-  coco_problem_t *problem1, *problem2;
+static int suite_biobj_check_inst_consistency(coco_problem_t *problem1, coco_problem_t *problem2) {
+
   int break_search = 0;
   double norm;
-  double *smallest_values_of_interest, *largest_values_of_interest;
+  double ideal[2], nadir[2];
   const double apart_enough = 1e-4;
 
-  problem1 = coco_get_bbob_problem(function1, dimension, instance1);
-  problem2 = coco_get_bbob_problem(function2, dimension, instance2);
-
-  /* Set smallest and largest values of interest to some value (not important which, it just needs to be a
-   * vector of doubles of the right dimension) */
-  smallest_values_of_interest = coco_allocate_vector_with_value(dimension, -100);
-  largest_values_of_interest = coco_allocate_vector_with_value(dimension, 100);
-  problem = coco_problem_stacked_allocate(problem1, problem2, smallest_values_of_interest,
-          largest_values_of_interest);
-  coco_free_memory(smallest_values_of_interest);
-  coco_free_memory(largest_values_of_interest);
+  assert(problem1->best_parameter != NULL);
+  assert(problem2->best_parameter != NULL);
+  ideal[0] = problem1->best_value[0];
+  ideal[1] = problem2->best_value[0];
+  coco_evaluate_function(problem1, problem2->best_parameter, &nadir[0]);
+  coco_evaluate_function(problem2, problem1->best_parameter, &nadir[1]);
 
   /* Check whether the ideal and nadir points are too close in the objective space */
-  norm = mo_get_norm(problem->best_value, problem->nadir_value, 2);
+  norm = mo_get_norm(ideal, nadir, 2);
   if (norm < 1e-1) { /* TODO How to set this value in a sensible manner? */
     coco_debug(
-        "suite_biobj_check_inst_consistency(): The ideal and nadir points of %s are too close in the objective space",
-        problem->problem_id);
-    coco_debug("norm = %e, ideal = %e\t%e, nadir = %e\t%e", norm, problem->best_value[0],
-        problem->best_value[1], problem->nadir_value[0], problem->nadir_value[1]);
+        "suite_biobj_check_inst_consistency(): The ideal and nadir points of %s__%s are too close in the objective space",
+        problem1->problem_id, problem2->problem_id);
+    coco_debug("norm = %e, ideal = %e\t%e, nadir = %e\t%e", norm, ideal[0], ideal[1], nadir[0], nadir[1]);
     break_search = 1;
   }
 
   /* Check whether the extreme optimal points are too close in the decision space */
-  norm = mo_get_norm(problem1->best_parameter, problem2->best_parameter, problem->number_of_variables);
+  norm = mo_get_norm(problem1->best_parameter, problem2->best_parameter, problem1->number_of_variables);
   if (norm < apart_enough) {
     coco_debug(
-        "suite_biobj_check_inst_consistency(): The extreme points of %s are too close in the decision space",
-        problem->problem_id);
+        "suite_biobj_check_inst_consistency(): The extreme points of %s__%s are too close in the decision space",
+        problem1->problem_id, problem2->problem_id);
     coco_debug("norm = %e", norm);
     break_search = 1;
   }
 
-  /* Clean up */
-  if (problem) {
-    coco_problem_stacked_free(problem);
-    problem = NULL;
-  }
-
   return break_search;
 
 }
 
+/**
+ * @brief Saves the instance to new_instances.
+ */
+static void suite_biobj_save_new_instance(suite_biobj_new_inst_t *new_inst_data,
+                                          const size_t instance,
+                                          const size_t instance1,
+                                          const size_t instance2) {
+  size_t i;
+
+  for (i = 0; i < new_inst_data->max_new_instances; i++) {
+    if (new_inst_data->new_instances[i][0] == 0) {
+      new_inst_data->new_instances[i][0] = instance;
+      new_inst_data->new_instances[i][1] = instance1;
+      new_inst_data->new_instances[i][2] = instance2;
+      break;
+    }
+  }
+}
+
 /**
  * @brief Computes the instance number of the second problem/objective so that the resulting bi-objective
  * problem has more than a single optimal solution.
@@ -141,7 +297,10 @@ static int suite_biobj_check_inst_consistency(const size_t dimension,
  * An appropriate instance is the one for which the resulting bi-objective problem (in any considered
  * dimension) has the ideal and nadir points apart enough in the objective space and the extreme optimal
  * points apart enough in the decision space. When the instance has been found, it is output through
- * coco_warning, so that the user can see it and eventually manually add it to suite_biobj_instances.
+ * coco_info, so that the user can see it and eventually manually add it to suite_biobj_instances.
+ *
+ * If the instance cache is used, the instance2 is taken from the cache when it contains an instance2
+ * accepted for the same instance1 and dimensions, and appended to the cache otherwise.
  */
 static size_t suite_biobj_get_new_instance(suite_biobj_new_inst_t *new_inst_data,
                                            const size_t instance,
@@ -157,55 +316,74 @@ static size_t suite_biobj_get_new_instance(suite_biobj_new_inst_t *new_inst_data
   size_t num_tries = 0;
   const size_t max_tries = 1000;
   int appropriate_instance_found = 0, break_search, warning_produced = 0;
-  size_t d, f1, f2, i;
-  size_t function1, function2, dimension;
+  size_t d, f1, f2;
+  suite_biobj_problem_cache_t *cache1, *cache2;
+  double cached_instance2;
+
+  /* Look for the instance in the instance cache first */
+  if (new_inst_data->instance_cache != NULL) {
+    suite_biobj_set_instance_cache_key(new_inst_data->instance_cache, instance1, dimensions, num_dimensions);
+    if (socket_cache_lookup(new_inst_data->instance_cache, 1, &cached_instance2)) {
+      instance2 = coco_double_to_size_t(cached_instance2);
+      coco_info("suite_biobj_get_new_instance(): Instance %lu created from instances %lu and %lu (found in "
+          "the instance cache)", (unsigned long) instance, (unsigned long) instance1, (unsigned long) instance2);
+      suite_biobj_save_new_instance(new_inst_data, instance, instance1, instance2);
+      return instance2;
+    }
+  }
+
+  /* The problems of instance1 are the same for all candidates of instance2 */
+  cache1 = suite_biobj_problem_cache_allocate(bbob_functions, num_bbob_functions, dimensions, num_dimensions,
+      instance1);
 
   while ((!appropriate_instance_found) && (num_tries < max_tries)) {
     num_tries++;
     instance2 = instance1 + num_tries;
     break_search = 0;
+    cache2 = suite_biobj_problem_cache_allocate(bbob_functions, num_bbob_functions, dimensions, num_dimensions,
+        instance2);
 
     /* An instance is "appropriate" if the ideal and nadir points in the objective space and the two
      * extreme optimal points in the decisions space are apart enough for all problems (all dimensions
      * and function combinations); therefore iterate over all dimensions and function combinations */
 
     for (f1 = 0; (f1 < num_bbob_functions-1) && !break_search; f1++) {
-      function1 = bbob_functions[f1];
       for (f2 = f1+1; (f2 < num_bbob_functions) && !break_search; f2++) {
-        function2 = bbob_functions[f2];
         for (d = 0; (d < num_dimensions) && !break_search; d++) {
-          dimension = dimensions[d];
 
-          if (dimension == 0) {
+          if (dimensions[d] == 0) {
             if (!warning_produced)
               coco_warning("suite_biobj_get_new_instance(): remove filtering of dimensions to get generally acceptable instances!");
             warning_produced = 1;
             continue;
           }
 
-          break_search = suite_biobj_check_inst_consistency(dimension, function1, instance1, function2, instance2);
+          break_search = suite_biobj_check_inst_consistency(
+              suite_biobj_problem_cache_get(cache1, bbob_functions[f1], d),
+              suite_biobj_problem_cache_get(cache2, bbob_functions[f2], d));
         }
       }
     }
 
     /* Finally, check all functions (f,f) with f in {f1, f2, f6, f8, f13, f14, f15, f17, f20, f21}: */
     for (f1 = 0; (f1 < num_sel_bbob_functions) && !break_search; f1++) {
-      function1 = sel_bbob_functions[f1];
-      function2 = sel_bbob_functions[f1];
       for (d = 0; (d < num_dimensions) && !break_search; d++) {
-        dimension = dimensions[d];
 
-        if (dimension == 0) {
+        if (dimensions[d] == 0) {
             if (!warning_produced)
               coco_warning("suite_biobj_get_new_instance(): remove filtering of dimensions to get generally acceptable instances!");
             warning_produced = 1;
             continue;
           }
 
-        break_search = suite_biobj_check_inst_consistency(dimension, function1, instance1, function2, instance2);
+        break_search = suite_biobj_check_inst_consistency(
+            suite_biobj_problem_cache_get(cache1, sel_bbob_functions[f1], d),
+            suite_biobj_problem_cache_get(cache2, sel_bbob_functions[f1], d));
       }
     }
 
+    suite_biobj_problem_cache_free(cache2);
+
     if (break_search) {
       /* The search was broken, continue with next instance2 */
       continue;
@@ -215,18 +393,17 @@ static size_t suite_biobj_get_new_instance(suite_biobj_new_inst_t *new_inst_data
       coco_info("suite_biobj_get_new_instance(): Instance %lu created from instances %lu and %lu",
           (unsigned long) instance, (unsigned long) instance1, (unsigned long) instance2);
 
-      /* Save the instance to new_instances */
-      for (i = 0; i < new_inst_data->max_new_instances; i++) {
-        if (new_inst_data->new_instances[i][0] == 0) {
-          new_inst_data->new_instances[i][0] = instance;
-          new_inst_data->new_instances[i][1] = instance1;
-          new_inst_data->new_instances[i][2] = instance2;
-          break;
-        };
+      suite_biobj_save_new_instance(new_inst_data, instance, instance1, instance2);
+      if (new_inst_data->instance_cache != NULL) {
+        cached_instance2 = (double) instance2;
+        suite_biobj_set_instance_cache_key(new_inst_data->instance_cache, instance1, dimensions, num_dimensions);
+        socket_cache_insert(new_inst_data->instance_cache, 1, &cached_instance2);
       }
     }
   }
 
+  suite_biobj_problem_cache_free(cache1);
+
   if (!appropriate_instance_found) {
     coco_error("suite_biobj_get_new_instance(): Could not find suitable instance %lu in %lu tries",
         (unsigned long) instance, (unsigned long) num_tries);
@@ -443,13 +620,13 @@ static coco_problem_t *coco_get_biobj_problem(const size_t function,
   if (!instance_found) {
     /* Finally, if the instance is not found, create a new one */
 
-    if ((*new_inst_data) == NULL) {
-      /* Allocate space needed for saving new instances */
-      (*new_inst_data) = (suite_biobj_new_inst_t *) coco_allocate_memory(sizeof(**new_inst_data));
-
-      /* Most often the actual number of new instances will be lower than max_new_instances, because
-       * some of them are already in suite_biobj_instances. However, in order to avoid iterating over
-       * suite_biobj_new_inst_t, the allocation uses max_new_instances. */
+    if ((*new_inst_data) == NULL)
+      (*new_inst_data) = suite_biobj_new_inst_allocate();
+    if ((*new_inst_data)->new_instances == NULL) {
+      /* Allocate space needed for saving new instances. Most often the actual number of new instances
+       * will be lower than max_new_instances, because some of them are already in suite_biobj_instances.
+       * However, in order to avoid iterating over suite_biobj_new_inst_t, the allocation uses
+       * max_new_instances. */
       (*new_inst_data)->max_new_instances = num_new_instances;
 
       (*new_inst_data)->new_instances = (size_t **) coco_allocate_memory((*new_inst_data)->max_new_instances * sizeof(size_t *));
@@ -499,6 +676,38 @@ static coco_problem_t *coco_get_biobj_problem(const size_t function,
   return problem;
 }
 
+/**
+ * @brief Returns the index of the entry in suite_biobj_best_values_hyp with the given key (or the number
+ * of entries if the key is not found).
+ *
+ * Uses binary search, which relies on the entries being sorted by their keys (see the notes in
+ * suite_biobj_best_values_hyp.c). Only the keys are compared, the values are not parsed.
+ */
+static size_t suite_biobj_find_best_hyp_value(const char *key) {
+
+  const size_t count = sizeof(suite_biobj_best_values_hyp) / sizeof(char *);
+  const size_t key_length = strlen(key);
+  size_t low = 0, high = count, middle;
+  const char *entry;
+  int comparison;
+
+  while (low < high) {
+    middle = low + (high - low) / 2;
+    entry = suite_biobj_best_values_hyp[middle];
+    comparison = strncmp(entry, key, key_length);
+    /* The entry key is longer than (and therefore follows) the given key */
+    if ((comparison == 0) && (entry[key_length] != ' '))
+      comparison = 1;
+    if (comparison < 0)
+      low = middle + 1;
+    else if (comparison > 0)
+      high = middle;
+    else
+      return middle;
+  }
+  return count;
+}
+
 /**
  * @brief Saves the best known value for the hypervolume indicator matching the given key.
  *
@@ -510,24 +719,19 @@ static void suite_biobj_get_best_hyp_value(const int known_optima,
                                            double *value) {
 
   const double default_value = 1.0;
-  size_t i, count;
-  char *curr_key;
+  const size_t count = sizeof(suite_biobj_best_values_hyp) / sizeof(char *);
+  size_t index;
 
   if (known_optima) {
-    curr_key = coco_allocate_string(COCO_PATH_MAX + 1);
-    count = sizeof(suite_biobj_best_values_hyp) / sizeof(char *);
-    for (i = 0; i < count; i++) {
-      sscanf(suite_biobj_best_values_hyp[i], "%s %lf", curr_key, value);
-      if (strcmp(curr_key, key) == 0) {
-        coco_free_memory(curr_key);
-        return;
-      }
+    index = suite_biobj_find_best_hyp_value(key);
+    if (index < count) {
+      *value = strtod(suite_biobj_best_values_hyp[index] + strlen(key), NULL);
+      return;
     }
     /* If it comes to this point, the key was not found */
     *value = default_value;
     coco_warning("suite_biobj_get_best_hyp_value(): best value of %s could not be found; set to %f",
         key, default_value);
-    coco_free_memory(curr_key);
     return;
   }
   else {
@@ -28,6 +28,8 @@ static coco_suite_t *suite_rw_mario_gan_biobj_initialize(const char *suite_optio
 
   suite->data = socket_communication_data_initialize(suite_options, 7200);
   suite->data_free_function = socket_communication_data_finalize;
+  suite->prefetch_function = socket_prefetch_function;
+  suite->submit_function = socket_submit_function;
   return suite;
 }
 
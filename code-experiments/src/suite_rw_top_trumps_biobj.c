@@ -20,6 +20,8 @@ static coco_suite_t *suite_rw_top_trumps_biobj_initialize(const char *suite_opti
   suite = coco_suite_allocate("rw-top-trumps-biobj", 3, 4, dimensions, "instances: 1-15", 0);
   suite->data = socket_communication_data_initialize(suite_options, 7000);
   suite->data_free_function = socket_communication_data_finalize;
+  suite->prefetch_function = socket_prefetch_function;
+  suite->submit_function = socket_submit_function;
 
   return suite;
 }
@@ -34,6 +34,8 @@ static coco_suite_t *suite_toy_socket_initialize(const char *suite_options) {
 
   suite->data = socket_communication_data_initialize(suite_options, 7000);
   suite->data_free_function = socket_communication_data_finalize;
+  suite->prefetch_function = socket_prefetch_function;
+  suite->submit_function = socket_submit_function;
   return suite;
 }
 
@@ -0,0 +1,346 @@
+/**
+ * Tests the evaluation of the toy-socket suites by a running socket server (see the folder rw-problems).
+ *
+ * Usage:
+ * test_toy-socket protocols PORT
+ *   Checks that the evaluations obtained with the binary protocol match those obtained with the text
+ *   protocol: exactly if the x-values are sent with enough digits to be read back exactly and up to the
+ *   rounding of the x-values to precision_x digits otherwise.
+ * test_toy-socket pipelining PORT [CONNECTIONS]
+ *   Checks that the evaluations of submitted solutions (pipelined with sequence ids) are collected in order
+ *   and match those of the solutions evaluated one by one. If CONNECTIONS (1 by default) is larger than 1,
+ *   the requests are also spread over this many connections to the server (which needs to serve several
+ *   clients at once, as does the C server).
+ * test_toy-socket combined PORT
+ *   Checks that the combined evaluations of objectives and constraints (of the type both) match the
+ *   separate evaluations with both protocols.
+ * test_toy-socket record PORT LOG PROTOCOL
+ *   Evaluates the solutions with the given protocol and records the evaluations in the log.
+ * test_toy-socket replay REPLAY_PORT PORT PROTOCOL
+ *   Checks that the replay server on REPLAY_PORT (which replays a log recorded with the given protocol)
+ *   answers the requests sent with both protocols with the evaluations of the server on PORT.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "coco.h"
+
+#define NUMBER_OF_SOLUTIONS 25 /* The number of solutions evaluated on each problem */
+#define MAX_VALUES 1000        /* The largest number of values obtained on all problems of a suite */
+
+/**
+ * Generates the random solutions evaluated on the problem (the same solutions for each problem index).
+ */
+static void generate_solutions(const coco_problem_t *problem, double *x) {
+
+  const size_t dimension = coco_problem_get_dimension(problem);
+  coco_random_state_t *rng = coco_random_new((uint32_t) coco_problem_get_suite_dep_index(problem) + 1);
+  double scale;
+  size_t i, j;
+
+  for (i = 0; i < NUMBER_OF_SOLUTIONS; i++) {
+    /* Scale the solutions so that all constraints are both satisfied and violated by some of them */
+    scale = 1.5 * coco_random_uniform(rng);
+    for (j = 0; j < dimension; j++)
+      x[i * dimension + j] = scale * (2 * coco_random_uniform(rng) - 1);
+  }
+  coco_random_free(rng);
+}
+
+/**
+ * Evaluates the same random solutions on all problems of the suite with the given options and stores
+ * their objective values and constraint violations into values. Returns the number of values.
+ *
+ * If pipelined is set, all solutions of a problem are submitted twice before they are collected (the
+ * second evaluations must equal the first ones).
+ */
+static size_t evaluate_suite(const char *suite_name, const char *suite_options, const int pipelined,
+                             double *values) {
+
+  coco_suite_t *suite;
+  coco_problem_t *problem;
+  double *x, *collected_x, *y;
+  size_t dimension, number_of_objectives, number_of_constraints, number_of_values = 0, first, i, k;
+
+  suite = coco_suite(suite_name, "", suite_options);
+  while ((problem = coco_suite_get_next_problem(suite, NULL)) != NULL) {
+
+    dimension = coco_problem_get_dimension(problem);
+    number_of_objectives = coco_problem_get_number_of_objectives(problem);
+    number_of_constraints = coco_problem_get_number_of_constraints(problem);
+    x = coco_allocate_vector(NUMBER_OF_SOLUTIONS * dimension);
+    collected_x = coco_allocate_vector(dimension);
+    y = coco_allocate_vector(number_of_objectives);
+    generate_solutions(problem, x);
+    if (pipelined) {
+      for (k = 0; k < 2; k++) {
+        for (i = 0; i < NUMBER_OF_SOLUTIONS; i++)
+          coco_evaluate_function_submit(problem, x + i * dimension);
+      }
+    }
+
+    first = number_of_values;
+    for (i = 0; i < NUMBER_OF_SOLUTIONS; i++) {
+      if (number_of_values + number_of_objectives + number_of_constraints > MAX_VALUES)
+        coco_error("evaluate_suite(): more than %d values", MAX_VALUES);
+      if (pipelined) {
+        if (!coco_evaluate_function_collect(problem, collected_x, values + number_of_values)
+            || (memcmp(collected_x, x + i * dimension, dimension * sizeof(double)) != 0))
+          coco_error("evaluate_suite(): Solution %lu of %s was not collected in order", (unsigned long) i,
+              coco_problem_get_id(problem));
+      } else {
+        coco_evaluate_function(problem, x + i * dimension, values + number_of_values);
+      }
+      number_of_values += number_of_objectives;
+      if (number_of_constraints > 0) {
+        coco_evaluate_constraint(problem, x + i * dimension, values + number_of_values);
+        number_of_values += number_of_constraints;
+      }
+    }
+
+    if (pipelined) {
+      for (i = 0; i < NUMBER_OF_SOLUTIONS; i++) {
+        if (!coco_evaluate_function_collect(problem, collected_x, y)
+            || (memcmp(collected_x, x + i * dimension, dimension * sizeof(double)) != 0)
+            || (memcmp(y, values + first + i * (number_of_objectives + number_of_constraints),
+                number_of_objectives * sizeof(double)) != 0))
+          coco_error("evaluate_suite(): The second evaluation of solution %lu of %s differs from the first one",
+              (unsigned long) i, coco_problem_get_id(problem));
+      }
+      if (coco_evaluate_function_collect(problem, collected_x, y))
+        coco_error("evaluate_suite(): More solutions of %s were collected than submitted",
+            coco_problem_get_id(problem));
+    }
+
+    coco_free_memory(x);
+    coco_free_memory(collected_x);
+    coco_free_memory(y);
+  }
+  coco_suite_free(suite);
+  return number_of_values;
+}
+
+/**
+ * Compares the evaluations of the suite obtained with the binary and text protocols from the server on
+ * the given port.
+ */
+static void check_protocols(const char *suite_name, const int port) {
+
+  const int precision_x = 8;
+  double *binary_values = coco_allocate_vector(MAX_VALUES);
+  double *text_values = coco_allocate_vector(MAX_VALUES);
+  double tolerance;
+  char suite_options[100];
+  size_t number_of_values, i;
+
+  sprintf(suite_options, "port: %d protocol: binary", port);
+  number_of_values = evaluate_suite(suite_name, suite_options, 0, binary_values);
+  if (number_of_values == 0)
+    coco_error("check_protocols(): No evaluations of %s were performed!", suite_name);
+
+  /* With 17 digits the x-values are read back exactly (as are the values in the responses) */
+  sprintf(suite_options, "port: %d protocol: text precision_x: 17", port);
+  if (evaluate_suite(suite_name, suite_options, 0, text_values) != number_of_values)
+    coco_error("check_protocols(): The numbers of values of %s do not match", suite_name);
+  for (i = 0; i < number_of_values; i++) {
+    if (binary_values[i] != text_values[i])
+      coco_error("check_protocols(): Value %lu of %s differs between the protocols (%.17e != %.17e)",
+          (unsigned long) i, suite_name, binary_values[i], text_values[i]);
+  }
+
+  /* With fewer digits the values differ by the rounding of the x-values */
+  sprintf(suite_options, "port: %d protocol: text precision_x: %d", port, precision_x);
+  if (evaluate_suite(suite_name, suite_options, 0, text_values) != number_of_values)
+    coco_error("check_protocols(): The numbers of values of %s do not match", suite_name);
+  for (i = 0; i < number_of_values; i++) {
+    tolerance = pow(10, 1 - precision_x) * (1 + fabs(binary_values[i]));
+    if (fabs(binary_values[i] - text_values[i]) > tolerance)
+      coco_error("check_protocols(): Value %lu of %s differs between the protocols by more than %.1e "
+          "(%.17e != %.17e)", (unsigned long) i, suite_name, tolerance, binary_values[i], text_values[i]);
+  }
+
+  printf("Compared %lu values of %s\n", (unsigned long) number_of_values, suite_name);
+  printf("DONE!\n");
+  coco_free_memory(binary_values);
+  coco_free_memory(text_values);
+  fflush(stdout);
+}
+
+/**
+ * Compares the evaluations of the suite obtained one by one with those obtained by submitting the solutions
+ * and collecting them later (with several requests in flight, with the cache of evaluations and, if more
+ * than one connection is given, spread over several connections to the server on the given port).
+ */
+static void check_pipelining(const char *suite_name, const int port, const int connections) {
+
+  const char *options[2] = { "port: %d protocol: binary window: 3",
+                             "port: %d protocol: binary cache_size: 1000" };
+  double *values = coco_allocate_vector(MAX_VALUES);
+  double *pipelined_values = coco_allocate_vector(MAX_VALUES);
+  char suite_options[300];
+  size_t number_of_values, i;
+  int k;
+
+  sprintf(suite_options, "port: %d protocol: binary", port);
+  number_of_values = evaluate_suite(suite_name, suite_options, 0, values);
+  if (number_of_values == 0)
+    coco_error("check_pipelining(): No evaluations of %s were performed!", suite_name);
+
+  for (k = 0; k < 3; k++) {
+    if (k < 2) {
+      sprintf(suite_options, options[k], port);
+    } else if (connections > 1) {
+      /* The responses arrive on the connections in any order and are matched by their sequence ids */
+      strcpy(suite_options, "endpoints: \"");
+      for (i = 0; i < (size_t) connections; i++)
+        sprintf(suite_options + strlen(suite_options), "%s127.0.0.1:%d", (i > 0) ? "," : "", port);
+      strcat(suite_options, "\" protocol: binary window: 2 combined: 0");
+    } else {
+      break;
+    }
+    if (evaluate_suite(suite_name, suite_options, 1, pipelined_values) != number_of_values)
+      coco_error("check_pipelining(): The numbers of values of %s do not match", suite_name);
+    for (i = 0; i < number_of_values; i++) {
+      if (values[i] != pipelined_values[i])
+        coco_error("check_pipelining(): Value %lu of %s differs with options '%s' (%.17e != %.17e)",
+            (unsigned long) i, suite_name, suite_options, values[i], pipelined_values[i]);
+    }
+  }
+
+  printf("Compared %lu pipelined values of %s\n", (unsigned long) number_of_values, suite_name);
+  printf("DONE!\n");
+  coco_free_memory(values);
+  coco_free_memory(pipelined_values);
+  fflush(stdout);
+}
+
+/**
+ * Compares the evaluations of the suite obtained with combined evaluations of objectives and constraints
+ * (in a single round trip of the type both) with those obtained with separate evaluations, using both
+ * protocols with the server on the given port.
+ */
+static void check_combined(const char *suite_name, const int port) {
+
+  const char *protocols[2] = { "text", "binary" };
+  double *values = coco_allocate_vector(MAX_VALUES);
+  double *combined_values = coco_allocate_vector(MAX_VALUES);
+  char suite_options[100];
+  size_t number_of_values, i, k;
+
+  for (k = 0; k < 2; k++) {
+    sprintf(suite_options, "port: %d protocol: %s combined: 0", port, protocols[k]);
+    number_of_values = evaluate_suite(suite_name, suite_options, 0, values);
+    if (number_of_values == 0)
+      coco_error("check_combined(): No evaluations of %s were performed!", suite_name);
+
+    sprintf(suite_options, "port: %d protocol: %s combined: 1", port, protocols[k]);
+    if (evaluate_suite(suite_name, suite_options, 0, combined_values) != number_of_values)
+      coco_error("check_combined(): The numbers of values of %s do not match", suite_name);
+    for (i = 0; i < number_of_values; i++) {
+      if (values[i] != combined_values[i])
+        coco_error("check_combined(): Value %lu of %s differs with combined evaluations and the %s protocol "
+            "(%.17e != %.17e)", (unsigned long) i, suite_name, protocols[k], values[i], combined_values[i]);
+    }
+  }
+
+  printf("Compared %lu combined values of %s\n", (unsigned long) number_of_values, suite_name);
+  printf("DONE!\n");
+  coco_free_memory(values);
+  coco_free_memory(combined_values);
+  fflush(stdout);
+}
+
+/**
+ * Evaluates the suite with the server on the given port using the given protocol and records the
+ * evaluations in the log.
+ */
+static void record_suite(const char *suite_name, const int port, const char *log, const char *protocol) {
+
+  double *values = coco_allocate_vector(MAX_VALUES);
+  char suite_options[300];
+
+  if (strlen(log) > 200)
+    coco_error("record_suite(): The name of the log %s is too long", log);
+  sprintf(suite_options, "port: %d protocol: %s record: %s", port, protocol, log);
+  if (evaluate_suite(suite_name, suite_options, 0, values) == 0)
+    coco_error("record_suite(): No evaluations of %s were performed!", suite_name);
+  printf("Recorded the evaluations of %s\n", suite_name);
+  coco_free_memory(values);
+  fflush(stdout);
+}
+
+/**
+ * Compares the evaluations of the suite obtained from the replay server on replay_port using both
+ * protocols with those obtained from the server on the given port using the protocol with which the
+ * replayed log was recorded.
+ *
+ * The evaluations must match exactly: the requests sent with the other protocol than the recorded one
+ * are found by their x-values rounded to precision_x digits.
+ */
+static void check_replay(const char *suite_name, const int replay_port, const int port, const char *protocol) {
+
+  const char *protocols[2] = { "text", "binary" };
+  double *values = coco_allocate_vector(MAX_VALUES);
+  double *replayed_values = coco_allocate_vector(MAX_VALUES);
+  char suite_options[100];
+  size_t number_of_values, i, k;
+
+  sprintf(suite_options, "port: %d protocol: %s", port, protocol);
+  number_of_values = evaluate_suite(suite_name, suite_options, 0, values);
+  if (number_of_values == 0)
+    coco_error("check_replay(): No evaluations of %s were performed!", suite_name);
+
+  for (k = 0; k < 2; k++) {
+    sprintf(suite_options, "port: %d protocol: %s", replay_port, protocols[k]);
+    if (evaluate_suite(suite_name, suite_options, 0, replayed_values) != number_of_values)
+      coco_error("check_replay(): The numbers of values of %s do not match", suite_name);
+    for (i = 0; i < number_of_values; i++) {
+      if (values[i] != replayed_values[i])
+        coco_error("check_replay(): Value %lu of %s recorded with the %s protocol differs when replayed with "
+            "the %s protocol (%.17e != %.17e)", (unsigned long) i, suite_name, protocol, protocols[k],
+            values[i], replayed_values[i]);
+    }
+  }
+
+  printf("Compared %lu replayed values of %s\n", (unsigned long) number_of_values, suite_name);
+  printf("DONE!\n");
+  coco_free_memory(values);
+  coco_free_memory(replayed_values);
+  fflush(stdout);
+}
+
+int main(int argc, char *argv[])  {
+
+  int connections;
+
+  /* Mute output that is not error */
+  coco_set_log_level("error");
+
+  if ((argc == 3) && (strcmp(argv[1], "protocols") == 0)) {
+    check_protocols("toy-socket", atoi(argv[2]));
+    check_protocols("toy-socket-biobj", atoi(argv[2]));
+  } else if (((argc == 3) || (argc == 4)) && (strcmp(argv[1], "pipelining") == 0)) {
+    connections = (argc == 4) ? atoi(argv[3]) : 1;
+    if ((connections < 1) || (connections > 8))
+      coco_error("The number of connections must be between 1 and 8");
+    check_pipelining("toy-socket", atoi(argv[2]), connections);
+    check_pipelining("toy-socket-biobj", atoi(argv[2]), connections);
+  } else if ((argc == 3) && (strcmp(argv[1], "combined") == 0)) {
+    check_combined("toy-socket", atoi(argv[2]));
+    check_combined("toy-socket-biobj", atoi(argv[2]));
+  } else if ((argc == 5) && (strcmp(argv[1], "record") == 0)) {
+    record_suite("toy-socket", atoi(argv[2]), argv[3], argv[4]);
+    record_suite("toy-socket-biobj", atoi(argv[2]), argv[3], argv[4]);
+  } else if ((argc == 5) && (strcmp(argv[1], "replay") == 0)) {
+    check_replay("toy-socket", atoi(argv[2]), atoi(argv[3]), argv[4]);
+    check_replay("toy-socket-biobj", atoi(argv[2]), atoi(argv[3]), argv[4]);
+  } else {
+    coco_error("Usage: test_toy-socket protocols PORT\n       test_toy-socket pipelining PORT [CONNECTIONS]\n"
+        "       test_toy-socket combined PORT\n       test_toy-socket record PORT LOG PROTOCOL\n"
+        "       test_toy-socket replay REPLAY_PORT PORT PROTOCOL");
+  }
+  return 0;
+}
@@ -27,10 +27,81 @@ MU_TEST(test_biobj_utilities_instances) {
   coco_suite_free(suite);
 }
 
+/**
+ * Tests that new instances are stored in and taken from the instance cache.
+ */
+MU_TEST(test_biobj_utilities_instance_cache) {
+
+  char file_name[] = "test_instance_cache.bin";
+  const char *options = "dimensions: 2 function_indices: 1 instance_cache: test_instance_cache.bin";
+  coco_suite_t *suite;
+  coco_problem_t *problem;
+  suite_biobj_new_inst_t *new_inst_data;
+  double best_value[2];
+
+  remove(file_name);
+
+  /* The new instances are found by the search and stored in the cache */
+  suite = coco_suite("bbob-biobj", "instances: 16-17", options);
+  problem = coco_suite_get_next_problem(suite, NULL);
+  best_value[0] = problem->best_value[0];
+  problem = coco_suite_get_next_problem(suite, NULL);
+  best_value[1] = problem->best_value[0];
+  new_inst_data = (suite_biobj_new_inst_t *) suite->data;
+  mu_check(new_inst_data->instance_cache->hits == 0);
+  mu_check(new_inst_data->instance_cache->misses == 2);
+  coco_suite_free(suite);
+
+  /* The same instances are then taken from the cache */
+  suite = coco_suite("bbob-biobj", "instances: 16-17", options);
+  problem = coco_suite_get_next_problem(suite, NULL);
+  mu_check(problem->best_value[0] == best_value[0]);
+  problem = coco_suite_get_next_problem(suite, NULL);
+  mu_check(problem->best_value[0] == best_value[1]);
+  new_inst_data = (suite_biobj_new_inst_t *) suite->data;
+  mu_check(new_inst_data->instance_cache->hits == 2);
+  mu_check(new_inst_data->instance_cache->misses == 0);
+  coco_suite_free(suite);
+
+  remove(file_name);
+}
+
+/**
+ * Tests the lookup of the best known hypervolume values.
+ */
+MU_TEST(test_biobj_utilities_best_hyp_value) {
+
+  const size_t count = sizeof(suite_biobj_best_values_hyp) / sizeof(char *);
+  char key[COCO_PATH_MAX + 1];
+  double expected_value, value;
+  size_t i;
+
+  /* The binary search needs the entries to be sorted by their keys */
+  for (i = 1; i < count; i++)
+    mu_check(strcmp(suite_biobj_best_values_hyp[i - 1], suite_biobj_best_values_hyp[i]) < 0);
+
+  for (i = 0; i < count; i++) {
+    sscanf(suite_biobj_best_values_hyp[i], "%s %lf", key, &expected_value);
+    mu_check(suite_biobj_find_best_hyp_value(key) == i);
+    suite_biobj_get_best_hyp_value(1, key, &value);
+    mu_check(value == expected_value);
+  }
+
+  mu_check(suite_biobj_find_best_hyp_value("bbob-biobj_f01_i01_d0") == count);
+  mu_check(suite_biobj_find_best_hyp_value("bbob-biobj_f01_i01_d020") == count);
+  mu_check(suite_biobj_find_best_hyp_value("bbob-biobj_f93_i01_d02") == count);
+  mu_check(suite_biobj_find_best_hyp_value("") == count);
+
+  suite_biobj_get_best_hyp_value(0, "bbob-biobj_f01_i01_d02", &value);
+  mu_check(value == 1.0);
+}
+
 /**
  * Run all tests in this file.
  */
 MU_TEST_SUITE(test_all_biobj_utilities) {
   MU_RUN_TEST(test_biobj_utilities_instances);
+  MU_RUN_TEST(test_biobj_utilities_instance_cache);
+  MU_RUN_TEST(test_biobj_utilities_best_hyp_value);
 }
 
@@ -261,6 +261,152 @@ MU_TEST(test_coco_archive_precision_issues) {
   coco_archive_free(archive);
 }
 
+/**
+ * Computes the hypervolume and the number of solutions of the archive from scratch (by walking the whole
+ * tree).
+ */
+static double test_coco_archive_compute_hypervolume(coco_archive_t *archive, size_t *number_of_solutions) {
+
+  avl_node_t *node;
+  coco_archive_avl_item_t *item, *previous_item;
+  double hypervolume = 0;
+
+  *number_of_solutions = 1;
+  for (node = archive->tree->head->next; node != NULL; node = node->next) {
+    (*number_of_solutions)++;
+    item = (coco_archive_avl_item_t *) node->item;
+    previous_item = (coco_archive_avl_item_t *) node->prev->item;
+    if (mo_is_within_ROI(item->normalized_y, 2)) {
+      if (mo_is_within_ROI(previous_item->normalized_y, 2))
+        hypervolume += (previous_item->normalized_y[0] - item->normalized_y[0]) * (1 - item->normalized_y[1]);
+      else
+        hypervolume += (1 - item->normalized_y[0]) * (1 - item->normalized_y[1]);
+    }
+  }
+  return hypervolume;
+}
+
+/**
+ * Tests that the incrementally maintained hypervolume and number of solutions match the ones computed
+ * from scratch.
+ */
+MU_TEST(test_coco_archive_incremental_hypervolume) {
+
+  coco_archive_t *archive;
+  double y1, y2, hypervolume;
+  unsigned long seed = 12345;
+  size_t i, number_of_solutions;
+  int correct = 1;
+
+  archive = coco_archive("bbob-biobj", 1, 2, 1);
+
+  for (i = 0; i < 5000; i++) {
+    /* Points spread over (and slightly beyond) the ROI, getting better with time */
+    seed = (seed * 1103515245 + 12345) % 2147483648UL;
+    y1 = archive->ideal[0] + (archive->nadir[0] - archive->ideal[0]) * (1.2 - (double) i / 5000.0)
+        * (double) seed / 2147483648.0;
+    seed = (seed * 1103515245 + 12345) % 2147483648UL;
+    y2 = archive->ideal[1] + (archive->nadir[1] - archive->ideal[1]) * (1.2 - (double) i / 5000.0)
+        * (double) seed / 2147483648.0;
+    coco_archive_add_solution(archive, y1, y2, "text\n");
+
+    hypervolume = test_coco_archive_compute_hypervolume(archive, &number_of_solutions);
+    if ((coco_archive_get_number_of_solutions(archive) != number_of_solutions) ||
+        !about_equal_value(coco_archive_get_hypervolume(archive), hypervolume))
+      correct = 0;
+  }
+  mu_check(correct);
+  mu_check(coco_archive_get_number_of_solutions(archive) > 2);
+  mu_check(coco_archive_get_hypervolume(archive) > 0);
+
+  coco_archive_free(archive);
+}
+
+/**
+ * Tests that adding a batch of solutions gives the same archive as adding them one by one.
+ */
+MU_TEST(test_coco_archive_add_solutions) {
+
+  coco_archive_t *archive1, *archive2;
+  const size_t number_of_solutions = 3000;
+  double *y = coco_allocate_vector(2 * number_of_solutions);
+  char **texts = (char **) coco_allocate_memory(number_of_solutions * sizeof(char *));
+  const char *text1, *text2;
+  unsigned long seed = 54321;
+  size_t i, number_of_updates;
+  int equal_texts = 1;
+
+  archive1 = coco_archive("bbob-biobj", 1, 2, 1);
+  archive2 = coco_archive("bbob-biobj", 1, 2, 1);
+
+  for (i = 0; i < number_of_solutions; i++) {
+    /* Coarse values (to get some equal solutions) spread over (and slightly beyond) the ROI */
+    seed = (seed * 1103515245 + 12345) % 2147483648UL;
+    y[2 * i] = archive1->ideal[0] + (archive1->nadir[0] - archive1->ideal[0]) * 1.1
+        * (double) (seed % 200) / 200.0;
+    seed = (seed * 1103515245 + 12345) % 2147483648UL;
+    y[2 * i + 1] = archive1->ideal[1] + (archive1->nadir[1] - archive1->ideal[1]) * 1.1
+        * (double) (seed % 200) / 200.0;
+    texts[i] = coco_strdupf("%lu\n", (unsigned long) i);
+  }
+
+  /* The first half is added one by one to both archives, the second half as a batch to the second one */
+  for (i = 0; i < number_of_solutions; i++)
+    coco_archive_add_solution(archive1, y[2 * i], y[2 * i + 1], texts[i]);
+  for (i = 0; i < number_of_solutions / 2; i++)
+    coco_archive_add_solution(archive2, y[2 * i], y[2 * i + 1], texts[i]);
+  number_of_updates = coco_archive_add_solutions(archive2, number_of_solutions - number_of_solutions / 2,
+      &y[number_of_solutions / 2 * 2], (const char **) &texts[number_of_solutions / 2]);
+
+  mu_check(number_of_updates > 0);
+  mu_check(coco_archive_get_number_of_solutions(archive1) == coco_archive_get_number_of_solutions(archive2));
+  mu_check(about_equal_value(coco_archive_get_hypervolume(archive1), coco_archive_get_hypervolume(archive2)));
+  do {
+    text1 = coco_archive_get_next_solution_text(archive1);
+    text2 = coco_archive_get_next_solution_text(archive2);
+    if (strcmp(text1, text2) != 0)
+      equal_texts = 0;
+  } while ((strcmp(text1, "") != 0) && (strcmp(text2, "") != 0));
+  mu_check(equal_texts);
+
+  for (i = 0; i < number_of_solutions; i++)
+    coco_free_memory(texts[i]);
+  coco_free_memory(texts);
+  coco_free_memory(y);
+  coco_archive_free(archive1);
+  coco_archive_free(archive2);
+}
+
+/**
+ * Tests that the memory of the archive stays bounded when many solutions are inserted and later dominated.
+ */
+MU_TEST(test_coco_archive_memory) {
+
+  coco_archive_t *archive;
+  mo_slab_chunk_t *chunk;
+  char text[100];
+  double y1, y2;
+  size_t i, number_of_chunks = 0;
+
+  archive = coco_archive("bbob-biobj", 1, 2, 1);
+
+  for (i = 0; i < 100000; i++) {
+    /* Each solution dominates the previous one (the texts have different lengths) */
+    y1 = archive->ideal[0] + (archive->nadir[0] - archive->ideal[0]) * (1 - (double) i / 100000.0) / 2;
+    y2 = archive->ideal[1] + (archive->nadir[1] - archive->ideal[1]) * (1 - (double) i / 100000.0) / 2;
+    sprintf(text, "%lu\t%.*f\t%f\n", (unsigned long) i, (int) (i % 50), y1, y2);
+    coco_archive_add_solution(archive, y1, y2, text);
+  }
+  mu_check(coco_archive_get_number_of_solutions(archive) == 3);
+
+  /* The texts of the dominated solutions are reused, so that the first chunks are enough */
+  for (chunk = archive->text_slab->chunk; chunk != NULL; chunk = chunk->previous)
+    number_of_chunks++;
+  mu_check(number_of_chunks == 1);
+
+  coco_archive_free(archive);
+}
+
 /**
  * Run all tests in this file.
  */
@@ -268,4 +414,7 @@ MU_TEST_SUITE(test_all_coco_archive) {
   MU_RUN_TEST(test_coco_archive);
   MU_RUN_TEST(test_coco_archive_extreme_solutions);
   MU_RUN_TEST(test_coco_archive_precision_issues);
+  MU_RUN_TEST(test_coco_archive_incremental_hypervolume);
+  MU_RUN_TEST(test_coco_archive_add_solutions);
+  MU_RUN_TEST(test_coco_archive_memory);
 }
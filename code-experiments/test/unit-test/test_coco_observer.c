@@ -49,7 +49,7 @@ MU_TEST(test_coco_observer_targets_trigger) {
   update = coco_observer_targets_trigger(targets, -0.100099999);
   mu_check(!update);
 
-  coco_free_memory(targets);
+  coco_observer_targets_free(targets);
 }
 
 /**
@@ -107,7 +107,7 @@ MU_TEST(test_coco_observer_log_targets_trigger) {
   mu_check(update);
   mu_check(about_equal_value(targets->value,  -1000));
 
-  coco_free_memory(targets);
+  coco_observer_log_targets_free(targets);
 
   targets = coco_observer_log_targets(10, 1e-8);
   update = coco_observer_log_targets_trigger(targets, 1e-9);
@@ -118,12 +118,103 @@ MU_TEST(test_coco_observer_log_targets_trigger) {
   mu_check(update);
   update = coco_observer_log_targets_trigger(targets, -1.2e-7);
   mu_check(update);
-  coco_free_memory(targets);
+  coco_observer_log_targets_free(targets);
 
   targets = coco_observer_log_targets(10, 1e-8);
   update = coco_observer_log_targets_trigger(targets, -1.2e-7);
   mu_check(update);
-  coco_free_memory(targets);
+  coco_observer_log_targets_free(targets);
+}
+
+
+/**
+ * The original computation of coco_observer_log_targets_trigger (which computes the exponent of each
+ * value) used to check that the thresholds do not change the triggered targets.
+ */
+static int test_coco_observer_log_targets_reference(int *exponent,
+                                                    double *value,
+                                                    const size_t number_of_targets,
+                                                    const double precision,
+                                                    const double given_value) {
+  const double number_of_targets_double = (double) (long) number_of_targets;
+  double verified_value;
+  int current_exponent, adjusted_exponent;
+
+  if (given_value >= 0) {
+    if (given_value == 0)
+      verified_value = precision / 10.0;
+    else if (given_value < precision)
+      verified_value = precision;
+    else
+      verified_value = given_value;
+    current_exponent = (int) (ceil(log10(verified_value) * number_of_targets_double));
+    if (current_exponent < *exponent) {
+      *exponent = current_exponent;
+      *value = (given_value == 0) ? 0 : pow(10, (double) current_exponent / number_of_targets_double);
+      return 1;
+    }
+  } else {
+    verified_value = (given_value > -precision) ? precision : -given_value;
+    current_exponent = (int) (floor(log10(verified_value) * number_of_targets_double));
+    adjusted_exponent = 2 * (int) (ceil(log10(precision / 10.0) * number_of_targets_double))
+        - current_exponent - 1;
+    if (adjusted_exponent < *exponent) {
+      *exponent = adjusted_exponent;
+      *value = - pow(10, (double) current_exponent / number_of_targets_double);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/**
+ * Tests that coco_observer_log_targets_trigger triggers the same targets as the original computation for
+ * a dense sweep of values (including the target values and their close neighbors) and for random values.
+ */
+MU_TEST(test_coco_observer_log_targets_trigger_sweep) {
+
+  const size_t numbers_of_targets[3] = { 1, 10, 100 };
+  const double precisions[3] = { 1e-8, 1e-5, 3e-9 };
+  coco_observer_log_targets_t *targets;
+  coco_random_state_t *random_generator = coco_random_new(12345);
+  int reference_exponent, update, reference_update;
+  double reference_value, value, target;
+  size_t i, j, k, mismatches = 0, updates = 0;
+
+  for (i = 0; i < 3; i++) {
+    for (j = 0; j < 2; j++) {
+      targets = coco_observer_log_targets(numbers_of_targets[i], precisions[i]);
+      reference_exponent = INT_MAX;
+      reference_value = DBL_MAX;
+      for (k = 0; k < 400000; k++) {
+        if (j == 0) {
+          /* Decreasing values from 1e10 to about -1e36 in steps of 1/2000 of a decade (which include the
+           * targets) and their neighbors */
+          target = pow(10, 10 - (double) (k / 3) / 2000.0);
+          if (target < precisions[i] / 100)
+            target = -pow(10, (double) (k / 3) / 2000.0 - 30);
+          value = target * ((k % 3 == 0) ? 1 + 1e-15 : ((k % 3 == 1) ? 1 : 1 - 1e-15));
+          if (k == 200000)
+            value = 0;
+        } else {
+          /* Random values with random magnitudes */
+          value = pow(10, 20 * coco_random_uniform(random_generator) - 12)
+              * ((coco_random_uniform(random_generator) < 0.8) ? 1 : -1);
+        }
+        update = coco_observer_log_targets_trigger(targets, value);
+        reference_update = test_coco_observer_log_targets_reference(&reference_exponent, &reference_value,
+            numbers_of_targets[i], precisions[i], value);
+        updates += (size_t) update;
+        if ((update != reference_update) || (targets->exponent != reference_exponent)
+            || (targets->value != reference_value))
+          mismatches++;
+      }
+      coco_observer_log_targets_free(targets);
+    }
+  }
+  coco_random_free(random_generator);
+  mu_check(updates > 1000);
+  mu_check(mismatches == 0);
 }
 
 
@@ -222,12 +313,229 @@ MU_TEST(test_coco_observer_evaluations_trigger) {
   coco_observer_evaluations_free(evaluations);
 }
 
+/**
+ * Tests that coco_observer_evaluations_next_trigger finds the same evaluation numbers as calling
+ * coco_observer_evaluations_trigger for each evaluation number.
+ */
+MU_TEST(test_coco_observer_evaluations_next_trigger) {
+
+  const size_t jumps[6] = { 1, 3, 17, 1000, 123457, 1000000 };
+  coco_observer_evaluations_t *evaluations1, *evaluations2;
+  size_t i, j, evaluation = 0, next, number_of_triggers = 0;
+
+  evaluations1 = coco_observer_evaluations("1,2,5", 3);
+  evaluations2 = coco_observer_evaluations("1,2,5", 3);
+
+  for (i = 0; i < 60; i++) {
+    /* Check the triggers in (evaluation, evaluation + jump) and then at evaluation + jump */
+    next = coco_observer_evaluations_next_trigger(evaluations2, evaluation + 1, evaluation + jumps[i % 6] - 1);
+    for (j = evaluation + 1; j < evaluation + jumps[i % 6]; j++) {
+      if (coco_observer_evaluations_trigger(evaluations1, j)) {
+        mu_check(next == j);
+        next = coco_observer_evaluations_next_trigger(evaluations2, j + 1, evaluation + jumps[i % 6] - 1);
+        number_of_triggers++;
+      }
+    }
+    mu_check(next == 0);
+    evaluation += jumps[i % 6];
+    mu_check(coco_observer_evaluations_trigger(evaluations1, evaluation) ==
+        coco_observer_evaluations_trigger(evaluations2, evaluation));
+  }
+  mu_check(number_of_triggers > 100);
+  mu_check(coco_observer_evaluations_next_trigger(evaluations2, 10, 9) == 0);
+
+  coco_observer_evaluations_free(evaluations1);
+  coco_observer_evaluations_free(evaluations2);
+}
+
+/**
+ * Tests the tracing of events (only the outermost evaluation must be traced).
+ */
+MU_TEST(test_coco_observer_trace) {
+
+  const char *file_name = "test_coco_trace.bin";
+  double start, outer, inner;
+  char magic[8];
+  unsigned int header[2];
+  coco_trace_record_t records[3];
+  FILE *file;
+
+  coco_trace_start(file_name);
+  start = coco_trace_begin();
+  outer = coco_trace_begin_evaluation();
+  inner = coco_trace_begin_evaluation();
+  mu_check(start >= 0);
+  mu_check(outer >= start);
+  mu_check(inner < 0);
+  coco_trace_end_evaluation(COCO_TRACE_FUNCTION_EVALUATION, inner, 1);
+  coco_trace_end_evaluation(COCO_TRACE_FUNCTION_EVALUATION, outer, 2);
+  coco_trace_end(COCO_TRACE_LOGGER_OUTPUT, coco_trace_begin(), 3);
+  coco_trace_end(COCO_TRACE_PROBLEM_CONSTRUCTION, start, 4);
+  coco_trace_stop();
+
+  /* Tracing is disabled after the trace is stopped */
+  mu_check(coco_trace_begin() < 0);
+
+  file = fopen(file_name, "rb");
+  mu_check(file != NULL);
+  mu_check(fread(magic, sizeof(char), 8, file) == 8);
+  mu_check(strncmp(magic, "COCOTRC1", 8) == 0);
+  mu_check(fread(header, sizeof(unsigned int), 2, file) == 2);
+  mu_check(header[0] == 0x01020304);
+  mu_check(header[1] == sizeof(coco_trace_record_t));
+  mu_check(fread(records, sizeof(coco_trace_record_t), 3, file) == 3);
+  mu_check(fread(magic, sizeof(char), 1, file) == 0);
+  fclose(file);
+  remove(file_name);
+
+  mu_check(records[0].event == COCO_TRACE_FUNCTION_EVALUATION);
+  mu_check(about_equal_value(records[0].value, 2));
+  mu_check(records[1].event == COCO_TRACE_LOGGER_OUTPUT);
+  mu_check(records[2].event == COCO_TRACE_PROBLEM_CONSTRUCTION);
+  mu_check(records[2].start <= records[0].start);
+  mu_check(records[2].duration >= records[0].duration);
+}
+
+/**
+ * Tests the memory observer.
+ */
+MU_TEST(test_coco_observer_memory) {
+
+  coco_suite_t *suite;
+  coco_observer_t *observer;
+  coco_problem_t *problem;
+  double x[2], y[1];
+  double targets[100];
+  size_t evaluations[100];
+  size_t i, number_of_hits;
+
+  suite = coco_suite("bbob", NULL, "dimensions: 2 function_indices: 1 instance_indices: 1-2");
+  observer = coco_observer("memory", "result_folder: test_memory_observer");
+  problem = coco_suite_get_next_problem(suite, observer);
+
+  /* Approach the optimum of the sphere function */
+  for (i = 0; i < 20; i++) {
+    x[0] = problem->best_parameter[0] + pow(0.5, (double) i);
+    x[1] = problem->best_parameter[1];
+    coco_evaluate_function(problem, x, y);
+  }
+  mu_check(coco_observer_memory_get_number_of_runs(observer) == 1);
+  mu_check(coco_observer_memory_get_evaluations(observer, 0) == 20);
+  mu_check(strcmp(coco_observer_memory_get_problem_id(observer, 0), "bbob_f001_i01_d02") == 0);
+
+  number_of_hits = coco_observer_memory_get_number_of_hits(observer, 0);
+  mu_check(number_of_hits > 1);
+  mu_check(number_of_hits <= 20);
+  coco_observer_memory_get_hits(observer, 0, targets, evaluations);
+  mu_check(evaluations[0] == 1);
+  for (i = 1; i < number_of_hits; i++) {
+    mu_check(evaluations[i] > evaluations[i - 1]);
+    mu_check(targets[i] < targets[i - 1]);
+  }
+
+  /* The run of the current problem is kept, while the finished runs are freed */
+  coco_observer_memory_clear(observer);
+  mu_check(coco_observer_memory_get_number_of_runs(observer) == 1);
+  problem = coco_suite_get_next_problem(suite, observer);
+  mu_check(coco_observer_memory_get_number_of_runs(observer) == 2);
+  coco_observer_memory_clear(observer);
+  mu_check(coco_observer_memory_get_number_of_runs(observer) == 1);
+  mu_check(strcmp(coco_observer_memory_get_problem_id(observer, 0), "bbob_f001_i02_d02") == 0);
+  mu_check(coco_observer_memory_get_evaluations(observer, 0) == 0);
+
+  /* No files are written */
+  mu_check(!coco_directory_exists(coco_observer_get_result_folder(observer)));
+
+  coco_observer_free(observer);
+  coco_suite_free(suite);
+}
+
+/**
+ * Returns the number of occurrences of the given string in the given file.
+ */
+static size_t test_coco_observer_count_in_file(const char *file_name, const char *string) {
+
+  FILE *file;
+  char line[1000];
+  char *position;
+  size_t count = 0;
+
+  file = fopen(file_name, "r");
+  if (file == NULL)
+    return 0;
+  while (fgets(line, sizeof(line), file) != NULL) {
+    for (position = strstr(line, string); position != NULL; position = strstr(position + 1, string))
+      count++;
+  }
+  fclose(file);
+  return count;
+}
+
+/**
+ * Tests exporting the data of the memory observer several times.
+ */
+MU_TEST(test_coco_observer_memory_export) {
+
+  coco_suite_t *suite;
+  coco_observer_t *observer;
+  coco_problem_t *problem;
+  char *path, *existing_path;
+  char *info_file, *dat_file;
+  double x[2], y[1];
+  size_t i;
+
+  /* A folder with the same name as the result folder already exists */
+  existing_path = coco_allocate_string(COCO_PATH_MAX + 1);
+  strcpy(existing_path, "exdata");
+  coco_join_path(existing_path, COCO_PATH_MAX, "test_memory_export", NULL);
+  coco_create_directory(existing_path);
+
+  suite = coco_suite("bbob", NULL, "dimensions: 2 function_indices: 1 instance_indices: 1-3");
+  observer = coco_observer("memory", "result_folder: test_memory_export");
+  while ((problem = coco_suite_get_next_problem(suite, observer)) != NULL) {
+    for (i = 0; i < 10; i++) {
+      x[0] = problem->best_parameter[0] + pow(0.5, (double) i);
+      x[1] = problem->best_parameter[1];
+      coco_evaluate_function(problem, x, y);
+    }
+    coco_observer_memory_export(observer);
+  }
+  /* Nothing new is exported */
+  coco_observer_memory_export(observer);
+
+  /* The data is exported to a new folder */
+  path = coco_strdup(coco_observer_get_result_folder(observer));
+  mu_check(strcmp(path, existing_path) != 0);
+  info_file = coco_strdupf("%s/bbobexp_f1.info", path);
+  dat_file = coco_strdupf("%s/data_f1/bbobexp_f1_DIM2.dat", path);
+
+  /* Each run is exported exactly once */
+  mu_check(test_coco_observer_count_in_file(info_file, ", 1:10|") == 1);
+  mu_check(test_coco_observer_count_in_file(info_file, ", 2:10|") == 1);
+  mu_check(test_coco_observer_count_in_file(info_file, ", 3:10|") == 1);
+  mu_check(test_coco_observer_count_in_file(dat_file, "Fopt") == 3);
+
+  coco_observer_free(observer);
+  coco_suite_free(suite);
+  coco_remove_directory(path);
+  coco_remove_directory(existing_path);
+  coco_free_memory(existing_path);
+  coco_free_memory(info_file);
+  coco_free_memory(dat_file);
+  coco_free_memory(path);
+}
+
 /**
  * Run all tests in this file.
  */
 MU_TEST_SUITE(test_all_coco_observer) {
   MU_RUN_TEST(test_coco_observer_targets_trigger);
   MU_RUN_TEST(test_coco_observer_log_targets_trigger);
+  MU_RUN_TEST(test_coco_observer_log_targets_trigger_sweep);
   MU_RUN_TEST(test_coco_observer_lin_targets_trigger);
   MU_RUN_TEST(test_coco_observer_evaluations_trigger);
+  MU_RUN_TEST(test_coco_observer_evaluations_next_trigger);
+  MU_RUN_TEST(test_coco_observer_trace);
+  MU_RUN_TEST(test_coco_observer_memory);
+  MU_RUN_TEST(test_coco_observer_memory_export);
 }
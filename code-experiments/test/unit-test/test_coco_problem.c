@@ -52,6 +52,46 @@ MU_TEST(test_coco_evaluate_function) {
   coco_free_memory(y);
 }
 
+/**
+ * Tests whether the points submitted with coco_evaluate_function_submit are collected in the same order
+ * and evaluated as with coco_evaluate_function.
+ */
+MU_TEST(test_coco_evaluate_function_submit) {
+
+  coco_suite_t *suite;
+  coco_problem_t *problem;
+  double x[2], collected_x[2], y, collected_y;
+  size_t i, next_collected = 0;
+
+  suite = coco_suite("bbob", NULL, "dimensions: 2 function_indices: 1-3 instance_indices: 1");
+  while ((problem = coco_suite_get_next_problem(suite, NULL)) != NULL) {
+    mu_check(coco_evaluate_function_collect(problem, collected_x, &collected_y) == 0);
+    /* Submit more points than the initial capacity of the queue and collect some of them in between */
+    for (i = 0; i < 40; i++) {
+      x[0] = (double) i / 10;
+      x[1] = -(double) i / 20;
+      coco_evaluate_function_submit(problem, x);
+      if (i % 3 == 0) {
+        mu_check(coco_evaluate_function_collect(problem, collected_x, &collected_y) == 1);
+        mu_check(about_equal_value(collected_x[0], (double) next_collected / 10));
+        next_collected++;
+      }
+    }
+    while (coco_evaluate_function_collect(problem, collected_x, &collected_y) == 1) {
+      x[0] = (double) next_collected / 10;
+      x[1] = -(double) next_collected / 20;
+      mu_check(about_equal_2d(collected_x, x[0], x[1]));
+      coco_evaluate_function(problem, x, &y);
+      mu_check(about_equal_value(collected_y, y));
+      next_collected++;
+    }
+    mu_check(next_collected == 40);
+    mu_check(coco_problem_get_evaluations(problem) == 66);
+    next_collected = 0;
+  }
+  coco_suite_free(suite);
+}
+
 /**
  * Tests whether coco_evaluate_constraint returns a vector of NANs 
  * when given a vector with one or more NAN values.
@@ -129,13 +169,69 @@ MU_TEST(test_coco_problem_get_largest_fvalues_of_interest_bbob_biobj_ext) {
   coco_suite_free(suite);
 }
 
+#if defined(COCO_PROFILING)
+/**
+ * Tests that the profiling of a transformed problem counts the evaluations of each layer and that the
+ * time spent in each layer includes the time spent in its inner layers.
+ */
+MU_TEST(test_coco_problem_profile_report) {
+
+  coco_suite_t *suite = coco_suite("bbob", "", "dimensions: 5 function_indices: 8 instance_indices: 1");
+  coco_problem_t *problem = coco_suite_get_next_problem(suite, NULL);
+  const coco_problem_t *layer;
+  const size_t number_of_evaluations = 1000;
+  double x[5] = { 0.1, -0.2, 0.3, -0.4, 0.5 }, y[1];
+  size_t i, number_of_layers = 0, number_of_lines = 0;
+  FILE *file;
+  int c;
+
+  mu_check(coco_set_profiling(1) == 0);
+  for (i = 0; i < number_of_evaluations; i++) {
+    x[0] = (double) i / (double) number_of_evaluations;
+    coco_evaluate_function(problem, x, y);
+  }
+  mu_check(coco_set_profiling(0) == 1);
+
+  /* Evaluations that are not profiled are not counted */
+  coco_evaluate_function(problem, x, y);
+
+  for (layer = problem; layer != NULL; layer = layer->profile_inner) {
+    number_of_layers++;
+    mu_check(layer->profile_calls == number_of_evaluations);
+    mu_check(layer->profile_time >= layer->profile_inner_time);
+    if (layer->profile_inner != NULL) {
+      mu_check(layer->profile_inner_time >= layer->profile_inner->profile_time);
+    } else {
+      mu_check(layer->profile_inner_time == 0);
+    }
+  }
+  /* The raw function and at least one transformation */
+  mu_check(number_of_layers > 1);
+
+  /* The report contains the title, the header and a line for each layer */
+  file = tmpfile();
+  coco_problem_profile_report(problem, file);
+  rewind(file);
+  while ((c = fgetc(file)) != EOF)
+    number_of_lines += (c == '\n');
+  fclose(file);
+  mu_check(number_of_lines == number_of_layers + 2);
+
+  coco_suite_free(suite);
+}
+#endif
+
 /**
  * Run all tests in this file.
  */
 MU_TEST_SUITE(test_all_coco_problem) {
   MU_RUN_TEST(test_coco_evaluate_function);
+  MU_RUN_TEST(test_coco_evaluate_function_submit);
   MU_RUN_TEST(test_coco_evaluate_constraint);
   MU_RUN_TEST(test_coco_is_feasible);
   MU_RUN_TEST(test_coco_problem_get_largest_fvalues_of_interest_bbob_biobj_ext);
+#if defined(COCO_PROFILING)
+  MU_RUN_TEST(test_coco_problem_profile_report);
+#endif
 }
 
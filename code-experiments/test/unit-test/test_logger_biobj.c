@@ -3,6 +3,7 @@
 
 static int about_equal_vector(const double *a, const double *b, const size_t dimension);
 static int about_equal_2d(const double *a, const double b1, const double b2);
+static double test_mo_hypervolume_by_grid(double **points, const size_t number_of_points, const size_t num_obj);
 
 /**
  * Tests several things in the computation of the modified hypervolume indicator for a specific
@@ -188,6 +189,86 @@ MU_TEST(test_coco_logger_biobj_feed_solution) {
   coco_suite_free(suite);
 }
 
+/**
+ * Tests logging of a problem with three objectives constructed by stacking three single-objective problems.
+ */
+MU_TEST(test_logger_biobj_three_objectives) {
+
+  const size_t number_of_evaluations = 60;
+  coco_suite_t *suite;
+  coco_observer_t *observer;
+  coco_problem_t *problem1, *problem2, *problem3, *stacked, *problem;
+  coco_random_state_t *random_generator = coco_random_new(3);
+  double *smallest_values_of_interest = coco_allocate_vector_with_value(2, -5);
+  double *largest_values_of_interest = coco_allocate_vector_with_value(2, 5);
+  double *x = coco_allocate_vector(2);
+  double *y = coco_allocate_vector(3);
+  double *normalized_y = coco_allocate_vector(3 * number_of_evaluations);
+  double **points = (double **) coco_allocate_memory(number_of_evaluations * sizeof(double *));
+  double expected_nadir[3], scales[3];
+  size_t i, j;
+
+  logger_biobj_data_t *logger;
+  logger_biobj_indicator_t *indicator;
+
+  suite = coco_suite("bbob-biobj", "", "dimensions: 2 function_indices: 1 instance_indices: 1");
+  observer = coco_observer("bbob-biobj", "log_nondominated: final");
+
+  problem1 = coco_get_bbob_problem(1, 2, 1);
+  problem2 = coco_get_bbob_problem(2, 2, 2);
+  problem3 = coco_get_bbob_problem(1, 2, 3);
+
+  /* The expected nadir values are the worst values of the objectives in the optima of the other problems */
+  coco_evaluate_function(problem1, problem2->best_parameter, &expected_nadir[0]);
+  coco_evaluate_function(problem1, problem3->best_parameter, &y[0]);
+  expected_nadir[0] = coco_double_max(expected_nadir[0], y[0]);
+  coco_evaluate_function(problem2, problem1->best_parameter, &expected_nadir[1]);
+  coco_evaluate_function(problem2, problem3->best_parameter, &y[0]);
+  expected_nadir[1] = coco_double_max(expected_nadir[1], y[0]);
+  coco_evaluate_function(problem3, problem1->best_parameter, &expected_nadir[2]);
+  coco_evaluate_function(problem3, problem2->best_parameter, &y[0]);
+  expected_nadir[2] = coco_double_max(expected_nadir[2], y[0]);
+
+  stacked = coco_problem_stacked_allocate(problem1, problem2, smallest_values_of_interest,
+      largest_values_of_interest);
+  stacked = coco_problem_stacked_allocate(stacked, problem3, smallest_values_of_interest,
+      largest_values_of_interest);
+  mu_check(coco_problem_get_number_of_objectives(stacked) == 3);
+  mu_check(about_equal_value(stacked->best_value[0], problem1->best_value[0]));
+  mu_check(about_equal_value(stacked->best_value[1], problem2->best_value[0]));
+  mu_check(about_equal_value(stacked->best_value[2], problem3->best_value[0]));
+  mu_check(about_equal_vector(stacked->nadir_value, expected_nadir, 3));
+  mo_get_normalization_scales(stacked->best_value, stacked->nadir_value, 3, scales);
+
+  stacked->suite = suite;
+  coco_problem_set_type(stacked, "stacked-3");
+  problem = coco_problem_add_observer(stacked, observer);
+  logger = (logger_biobj_data_t *) coco_problem_transformed_get_data(problem);
+  indicator = (logger_biobj_indicator_t *) (logger->indicators[0]);
+
+  for (i = 0; i < number_of_evaluations; i++) {
+    for (j = 0; j < 2; j++)
+      x[j] = 10 * coco_random_uniform(random_generator) - 5;
+    coco_evaluate_function(problem, x, y);
+    mo_normalize_into(y, stacked->best_value, stacked->nadir_value, scales, 3, stacked->is_opt_known,
+        normalized_y + 3 * i);
+    points[i] = normalized_y + 3 * i;
+    mu_check(about_equal_value(indicator->current_value, test_mo_hypervolume_by_grid(points, i + 1, 3)));
+  }
+  mu_check(indicator->current_value > 0);
+
+  coco_problem_free(problem);
+  coco_observer_free(observer);
+  coco_suite_free(suite);
+  coco_random_free(random_generator);
+  coco_free_memory(smallest_values_of_interest);
+  coco_free_memory(largest_values_of_interest);
+  coco_free_memory(x);
+  coco_free_memory(y);
+  coco_free_memory(normalized_y);
+  coco_free_memory(points);
+}
+
 /**
  * Run all tests in this file.
  */
@@ -195,4 +276,5 @@ MU_TEST_SUITE(test_all_logger_biobj) {
   MU_RUN_TEST(test_logger_biobj_evaluate);
   MU_RUN_TEST(test_logger_biobj_evaluate2);
   MU_RUN_TEST(test_coco_logger_biobj_feed_solution);
+  MU_RUN_TEST(test_logger_biobj_three_objectives);
 }
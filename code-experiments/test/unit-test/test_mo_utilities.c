@@ -41,42 +41,42 @@ MU_TEST(test_mo_get_norm) {
 }
 
 /**
- * Tests the function mo_normalize.
+ * Tests the function mo_normalize_into.
  */
 MU_TEST(test_mo_normalize) {
 
   double *y = coco_allocate_vector(2);
   double *ideal = coco_allocate_vector(2);
   double *nadir = coco_allocate_vector(2);
-  double *result;
+  double *result = coco_allocate_vector(2);
+  double *scales = coco_allocate_vector(2);
 
   ideal[0] = 100;
   ideal[1] = 0.2;
   nadir[0] = 200;
   nadir[1] = 0.22;
+  mo_get_normalization_scales(ideal, nadir, 2, scales);
 
-  result = mo_normalize(ideal, ideal, nadir, 2);
+  mo_normalize_into(ideal, ideal, nadir, scales, 2, 1, result);
   /* Note that the ideal point gets adjusted to be equal to an extreme point! */
   mu_check(about_equal_2d(result, 0, 1));
-  coco_free_memory(result);
 
-  result = mo_normalize(nadir, ideal, nadir, 2);
+  mo_normalize_into(nadir, ideal, nadir, scales, 2, 1, result);
   mu_check(about_equal_2d(result, 1, 1));
-  coco_free_memory(result);
 
   y[0] = 50;
   y[1] = 0.1;
-  result = mo_normalize(y, ideal, nadir, 2);
+  mo_normalize_into(y, ideal, nadir, scales, 2, 1, result);
   /* Note that a point better than the ideal point gets adjusted to be equal to an extreme point! */
   mu_check(about_equal_2d(result, 0, 1));
-  coco_free_memory(result);
 
   y[0] = 180;
   y[1] = 0.21;
-  result = mo_normalize(y, ideal, nadir, 2);
+  mo_normalize_into(y, ideal, nadir, scales, 2, 1, result);
   mu_check(about_equal_2d(result, 0.8, 0.5));
-  coco_free_memory(result);
 
+  coco_free_memory(result);
+  coco_free_memory(scales);
   coco_free_memory(y);
   coco_free_memory(ideal);
   coco_free_memory(nadir);
@@ -160,6 +160,236 @@ MU_TEST(test_mo_get_distance_to_ROI) {
   mu_check(about_equal_value(mo_get_distance_to_ROI(y, 2), 0.53851648071345037));
 
   coco_free_memory(y);
+
+  y = coco_allocate_vector(3);
+
+  y[0] = 0.5; y[1] = 1; y[2] = 0;
+  mu_check(about_equal_value(mo_get_distance_to_ROI(y, 3), 0));
+
+  y[0] = 0.5; y[1] = 1.25; y[2] = 0;
+  mu_check(about_equal_value(mo_get_distance_to_ROI(y, 3), 0.25));
+
+  y[0] = 1.2; y[1] = 0.5; y[2] = 1.5;
+  mu_check(about_equal_value(mo_get_distance_to_ROI(y, 3), 0.53851648071345037));
+
+  coco_free_memory(y);
+}
+
+/**
+ * Returns a random point that is likely to be nondominated by the previous ones (its values sum up to a
+ * random number between 1 and 1.2).
+ */
+static void test_mo_random_point(coco_random_state_t *random_generator, const size_t num_obj, double *point) {
+
+  size_t i;
+  double sum = 0, scale;
+
+  for (i = 0; i < num_obj; i++) {
+    point[i] = coco_random_uniform(random_generator);
+    sum += point[i];
+  }
+  scale = (1 + 0.2 * coco_random_uniform(random_generator)) / sum;
+  for (i = 0; i < num_obj; i++)
+    point[i] *= scale;
+}
+
+/**
+ * Computes the hypervolume of the points in [0, 1]^num_obj w.r.t. the reference point (1, ..., 1) by
+ * checking all cells of the grid defined by the values of the points.
+ */
+static double test_mo_hypervolume_by_grid(double **points, const size_t number_of_points, const size_t num_obj) {
+
+  double *grid = coco_allocate_vector(num_obj * (number_of_points + 1));
+  size_t *index = coco_allocate_vector_size_t(num_obj);
+  double volume = 0, cell;
+  size_t i, j, c;
+
+  for (c = 0; c < num_obj; c++) {
+    for (i = 0; i < number_of_points; i++)
+      grid[c * (number_of_points + 1) + i] = coco_double_min(coco_double_max(points[i][c], 0), 1);
+    grid[c * (number_of_points + 1) + number_of_points] = 1;
+    qsort(grid + c * (number_of_points + 1), number_of_points + 1, sizeof(double), mo_hypervolume_compare_samples);
+    index[c] = 0;
+  }
+
+  while (index[num_obj - 1] < number_of_points) {
+    cell = 1;
+    for (c = 0; c < num_obj; c++)
+      cell *= grid[c * (number_of_points + 1) + index[c] + 1] - grid[c * (number_of_points + 1) + index[c]];
+    if (cell > 0) {
+      for (i = 0; i < number_of_points; i++) {
+        for (c = 0; c < num_obj; c++) {
+          if (points[i][c] > grid[c * (number_of_points + 1) + index[c]])
+            break;
+        }
+        if (c == num_obj) {
+          volume += cell;
+          break;
+        }
+      }
+    }
+    for (j = 0; j < num_obj; j++) {
+      index[j]++;
+      if ((index[j] < number_of_points) || (j == num_obj - 1))
+        break;
+      index[j] = 0;
+    }
+  }
+
+  coco_free_memory(grid);
+  coco_free_memory(index);
+  return volume;
+}
+
+/**
+ * Marks the item as removed and counts the removed items (the remove function of the ND-tree).
+ */
+static void test_mo_nd_tree_remove(void *item, void *userdata) {
+  int *state = (int *) item;
+  *state = (*state == 1) ? 2 : -1;
+  (*(size_t *) userdata)++;
+}
+
+/**
+ * Marks the item as visited and counts the visited items.
+ */
+static void test_mo_nd_tree_visit(const double *point, void *item, void *userdata) {
+  int *state = (int *) item;
+  *state = (*state == 1) ? 3 : -1;
+  (*(size_t *) userdata)++;
+  (void) point;
+}
+
+/**
+ * Tests the ND-tree against a naive archive of nondominated points.
+ *
+ * The items in the tree are the states of the points (0 if not inserted, 1 if in the tree, 2 if removed,
+ * 3 if visited and -1 if removed or visited unexpectedly).
+ */
+MU_TEST(test_mo_nd_tree) {
+
+  const size_t number_of_points = 3000;
+  const size_t objectives[3] = { 2, 3, 5 };
+  coco_random_state_t *random_generator = coco_random_new(7);
+  mo_nd_tree_t *tree;
+  double *points;
+  int *in_archive, *state;
+  size_t i, j, k, num_obj, number_of_removed, number_of_visited, number_in_archive, number_dominated;
+  int is_dominated;
+
+  for (k = 0; k < 3; k++) {
+    num_obj = objectives[k];
+    points = coco_allocate_vector(number_of_points * num_obj);
+    in_archive = (int *) coco_allocate_memory(number_of_points * sizeof(int));
+    state = (int *) coco_allocate_memory(number_of_points * sizeof(int));
+    number_of_removed = 0;
+    number_in_archive = 0;
+    tree = mo_nd_tree_allocate(num_obj, test_mo_nd_tree_remove, &number_of_removed);
+
+    for (i = 0; i < number_of_points; i++) {
+      test_mo_random_point(random_generator, num_obj, points + i * num_obj);
+      /* Duplicate a previous point from time to time */
+      if ((i > 0) && (i % 97 == 0))
+        memcpy(points + i * num_obj, points + (i / 2) * num_obj, num_obj * sizeof(double));
+      in_archive[i] = 0;
+      state[i] = 0;
+
+      is_dominated = 0;
+      for (j = 0; j < i; j++) {
+        if (in_archive[j] && (mo_get_dominance(points + i * num_obj, points + j * num_obj, num_obj) < 0))
+          is_dominated = 1;
+      }
+      mu_check(mo_nd_tree_is_dominated(tree, points + i * num_obj) == is_dominated);
+      if (is_dominated)
+        continue;
+
+      number_dominated = 0;
+      for (j = 0; j < i; j++) {
+        if (in_archive[j] && (mo_get_dominance(points + i * num_obj, points + j * num_obj, num_obj) == 1)) {
+          in_archive[j] = 0;
+          number_dominated++;
+        }
+      }
+      in_archive[i] = 1;
+      state[i] = 1;
+      number_of_removed = 0;
+      mo_nd_tree_insert(tree, points + i * num_obj, &state[i]);
+      number_in_archive = number_in_archive + 1 - number_dominated;
+      mu_check(number_of_removed == number_dominated);
+      mu_check(tree->number_of_points == number_in_archive);
+    }
+    mu_check(number_in_archive > 100);
+
+    /* Check that the tree contains exactly the points of the naive archive */
+    number_of_visited = 0;
+    mo_nd_tree_visit(tree, NULL, test_mo_nd_tree_visit, &number_of_visited);
+    mu_check(number_of_visited == number_in_archive);
+    for (i = 0; i < number_of_points; i++)
+      mu_check((state[i] == 3) == (in_archive[i] == 1));
+
+    mo_nd_tree_free(tree);
+    coco_free_memory(points);
+    coco_free_memory(in_archive);
+    coco_free_memory(state);
+  }
+  coco_random_free(random_generator);
+}
+
+/**
+ * Tests the incremental hypervolume computation (exact for 2 and 3 objectives, estimated for more).
+ */
+MU_TEST(test_mo_hypervolume) {
+
+  const size_t objectives[3] = { 2, 3, 4 };
+  const size_t numbers_of_points[3] = { 400, 150, 30 };
+  coco_random_state_t *random_generator = coco_random_new(11);
+  mo_nd_tree_t *tree;
+  mo_hypervolume_t *hypervolume;
+  double *points, **added;
+  size_t i, k, num_obj, number_of_points, number_of_added;
+  double exact, contribution;
+
+  for (k = 0; k < 3; k++) {
+    num_obj = objectives[k];
+    number_of_points = numbers_of_points[k];
+    points = coco_allocate_vector(number_of_points * num_obj);
+    added = (double **) coco_allocate_memory(number_of_points * sizeof(double *));
+    number_of_added = 0;
+    tree = mo_nd_tree_allocate(num_obj, NULL, NULL);
+    hypervolume = mo_hypervolume_allocate(num_obj);
+
+    for (i = 0; i < number_of_points; i++) {
+      /* Shift the points so that some of them lie (partly) outside the ROI */
+      test_mo_random_point(random_generator, num_obj, points + i * num_obj);
+      points[i * num_obj] += 0.3 * coco_random_uniform(random_generator) - 0.1;
+      if (mo_nd_tree_is_dominated(tree, points + i * num_obj))
+        continue;
+      contribution = mo_hypervolume_add(hypervolume, points + i * num_obj, tree);
+      mu_check(contribution >= 0);
+      mo_nd_tree_insert(tree, points + i * num_obj, NULL);
+      added[number_of_added++] = points + i * num_obj;
+
+      if ((num_obj < 4) && ((number_of_added % 25 == 0) || (i == number_of_points - 1))) {
+        exact = test_mo_hypervolume_by_grid(added, number_of_added, num_obj);
+        mu_check(fabs(hypervolume->value - exact) < 1e-12);
+      }
+    }
+
+    if (num_obj < 4) {
+      mu_check(mo_hypervolume_get_precision(hypervolume) == 0);
+    } else {
+      /* The estimate should lie within six standard errors of the exact value */
+      mu_check(mo_hypervolume_get_precision(hypervolume) > 0);
+      exact = test_mo_hypervolume_by_grid(added, number_of_added, num_obj);
+      mu_check(fabs(hypervolume->value - exact) < 6 * mo_hypervolume_get_precision(hypervolume));
+    }
+
+    mo_hypervolume_free(hypervolume);
+    mo_nd_tree_free(tree);
+    coco_free_memory(points);
+    coco_free_memory(added);
+  }
+  coco_random_free(random_generator);
 }
 
 /**
@@ -171,4 +401,6 @@ MU_TEST_SUITE(test_all_mo_utilities) {
   MU_RUN_TEST(test_mo_get_dominance);
   MU_RUN_TEST(test_mo_is_within_ROI);
   MU_RUN_TEST(test_mo_get_distance_to_ROI);
+  MU_RUN_TEST(test_mo_nd_tree);
+  MU_RUN_TEST(test_mo_hypervolume);
 }
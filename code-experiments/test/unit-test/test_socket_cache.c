@@ -0,0 +1,104 @@
+#include "coco.h"
+#include "minunit_c89.h"
+
+/**
+ * Sets the key of an evaluation of the objective of f1 in dimension 2 with one integer variable.
+ */
+static void test_socket_cache_set_key(socket_cache_t *cache, const double x0, const double x1) {
+  double x[2];
+  x[0] = x0;
+  x[1] = x1;
+  socket_cache_set_key(cache, "toy-socket", 1, 1, 1, 2, 1, 1, x);
+}
+
+/**
+ * Tests looking up, inserting and evicting evaluations in a cache kept in memory.
+ */
+MU_TEST(test_socket_cache_memory) {
+
+  socket_cache_t *cache = socket_cache_allocate(2, NULL);
+  double value;
+
+  /* Evaluations that are not in the cache are misses */
+  test_socket_cache_set_key(cache, 1, 0.5);
+  mu_check(!socket_cache_contains(cache));
+  mu_check(!socket_cache_lookup(cache, 1, &value));
+  value = 1.5;
+  socket_cache_insert(cache, 1, &value);
+  value = 0;
+  mu_check(socket_cache_lookup(cache, 1, &value));
+  mu_check(value == 1.5);
+
+  /* The integer variables are rounded, the continuous ones are compared exactly */
+  test_socket_cache_set_key(cache, 1.2, 0.5);
+  mu_check(socket_cache_contains(cache));
+  test_socket_cache_set_key(cache, 1, 0.5 + 1e-16);
+  mu_check(!socket_cache_contains(cache));
+
+  /* The least recently used evaluation is removed when the cache is full */
+  test_socket_cache_set_key(cache, 2, 0.5);
+  value = 2.5;
+  socket_cache_insert(cache, 1, &value);
+  test_socket_cache_set_key(cache, 1, 0.5);
+  mu_check(socket_cache_lookup(cache, 1, &value));
+  test_socket_cache_set_key(cache, 3, 0.5);
+  value = 3.5;
+  socket_cache_insert(cache, 1, &value);
+  test_socket_cache_set_key(cache, 2, 0.5);
+  mu_check(!socket_cache_contains(cache));
+  test_socket_cache_set_key(cache, 1, 0.5);
+  mu_check(socket_cache_contains(cache));
+  test_socket_cache_set_key(cache, 3, 0.5);
+  mu_check(socket_cache_contains(cache));
+
+  /* A different number of values is a different evaluation */
+  mu_check(!socket_cache_lookup(cache, 2, &value));
+
+  mu_check(cache->hits == 2);
+  mu_check(cache->misses == 2);
+  socket_cache_free(cache);
+}
+
+/**
+ * Tests sharing evaluations through the cache file.
+ */
+MU_TEST(test_socket_cache_file) {
+
+  char file_name[] = "test_socket_cache.bin";
+  socket_cache_t *cache1, *cache2;
+  double values[2];
+
+  remove(file_name);
+  cache1 = socket_cache_allocate(0, file_name);
+  cache2 = socket_cache_allocate(0, file_name);
+
+  /* An evaluation inserted by one cache is found by the other one */
+  test_socket_cache_set_key(cache1, 1, 0.5);
+  values[0] = 1.5;
+  values[1] = -1.5;
+  socket_cache_insert(cache1, 2, values);
+  test_socket_cache_set_key(cache2, 1, 0.5);
+  values[0] = values[1] = 0;
+  mu_check(socket_cache_lookup(cache2, 2, values));
+  mu_check((values[0] == 1.5) && (values[1] == -1.5));
+  socket_cache_free(cache1);
+  socket_cache_free(cache2);
+
+  /* The evaluations are read when the file is opened again */
+  cache1 = socket_cache_allocate(1, file_name);
+  test_socket_cache_set_key(cache1, 1, 0.5);
+  mu_check(socket_cache_contains(cache1));
+  test_socket_cache_set_key(cache1, 2, 0.5);
+  mu_check(!socket_cache_contains(cache1));
+  socket_cache_free(cache1);
+
+  remove(file_name);
+}
+
+/**
+ * Run all tests in this file.
+ */
+MU_TEST_SUITE(test_all_socket_cache) {
+  MU_RUN_TEST(test_socket_cache_memory);
+  MU_RUN_TEST(test_socket_cache_file);
+}
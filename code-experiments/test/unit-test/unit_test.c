@@ -12,6 +12,7 @@
 #include "test_logger_bbob.c"
 #include "test_logger_biobj.c"
 #include "test_mo_utilities.c"
+#include "test_socket_cache.c"
 /*#include "unit_test_fail.c"*/
 
 int main(void) {
@@ -29,6 +30,7 @@ int main(void) {
   MU_RUN_SUITE(test_all_logger_biobj);
   MU_RUN_SUITE(test_all_mo_utilities);
   MU_RUN_SUITE(test_all_biobj_utilities);
+  MU_RUN_SUITE(test_all_socket_cache);
 
 	/* Run this if you want to see some tests fail
 	MU_RUN_SUITE(test_suite_fail); */
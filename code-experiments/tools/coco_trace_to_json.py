@@ -0,0 +1,86 @@
+## -*- mode: python -*-
+
+## Converts binary COCO trace files (produced when the observer option "trace: 1"
+## is used) to the Chrome trace JSON format, which can be viewed with Perfetto
+## (https://ui.perfetto.dev) or chrome://tracing.
+##
+## Usage: python coco_trace_to_json.py OUTPUT_JSON TRACE_FILE [TRACE_FILE ...]
+##
+## Each trace file corresponds to one process (for example one batch of a
+## parallel experiment) and is shown as a separate timeline. Since the
+## timestamps come from a monotonic clock, the timelines of processes run on
+## the same machine are aligned.
+
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+
+import json
+import struct
+import sys
+
+MAGIC = b'COCOTRC1'
+
+# Must be consistent with coco_trace_event_t in code-experiments/src/coco_trace.c
+EVENT_NAMES = ['problem construction', 'problem free', 'function evaluation',
+               'constraint evaluation', 'logger output', 'socket round trip']
+EVENT_ARGUMENTS = ['problem index', 'problem index', 'evaluations',
+                   'constraint evaluations', 'evaluations', 'message length']
+
+
+def read_trace(file_name):
+    """Returns the list of records (start, duration, value, event) read from
+    the binary trace file with the given name."""
+    with open(file_name, 'rb') as f:
+        data = f.read()
+    if data[:len(MAGIC)] != MAGIC:
+        raise ValueError('%s is not a COCO trace file' % file_name)
+    header = data[len(MAGIC):len(MAGIC) + 8]
+    for byte_order in ('<', '>'):
+        marker, record_size = struct.unpack(byte_order + 'II', header)
+        if marker == 0x01020304:
+            break
+    else:
+        raise ValueError('%s has an unknown byte order' % file_name)
+    record_format = byte_order + 'dddII'
+    if struct.calcsize(record_format) != record_size:
+        raise ValueError('%s has an unsupported record size %d' % (file_name, record_size))
+    records = []
+    offset = len(MAGIC) + 8
+    while offset + record_size <= len(data):
+        start, duration, value, event, _ = struct.unpack_from(record_format, data, offset)
+        records.append((start, duration, value, event))
+        offset += record_size
+    return records
+
+
+def convert(trace_file_names):
+    """Returns the Chrome trace (as a dictionary) of the given trace files."""
+    traces = [read_trace(name) for name in trace_file_names]
+    starts = [record[0] for records in traces for record in records]
+    origin = min(starts) if starts else 0
+    events = []
+    for pid, (name, records) in enumerate(zip(trace_file_names, traces)):
+        events.append({'name': 'process_name', 'ph': 'M', 'pid': pid, 'tid': 0,
+                       'args': {'name': name}})
+        for start, duration, value, event in records:
+            if event >= len(EVENT_NAMES):
+                continue
+            events.append({'name': EVENT_NAMES[event], 'cat': 'coco', 'ph': 'X',
+                           'pid': pid, 'tid': 0,
+                           'ts': (start - origin) / 1e3, 'dur': duration / 1e3,
+                           'args': {EVENT_ARGUMENTS[event]: int(value)}})
+    return {'traceEvents': events, 'displayTimeUnit': 'ns'}
+
+
+def main(args):
+    if len(args) < 2:
+        print('Usage: python coco_trace_to_json.py OUTPUT_JSON TRACE_FILE [TRACE_FILE ...]')
+        return 1
+    with open(args[0], 'w') as f:
+        json.dump(convert(args[1:]), f)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
@@ -3,6 +3,7 @@
 from __future__ import absolute_import, division, print_function, unicode_literals
 import numpy as np
 cimport numpy as np
+from libc.stdlib cimport malloc, free
 
 # Must initialize numpy or risk segfaults
 np.import_array()
@@ -15,6 +16,8 @@ cdef extern from "coco.h":
     coco_archive_t *coco_archive(char *suite_name, size_t function, 
                                  size_t dimension, size_t instance)
     int coco_archive_add_solution(coco_archive_t *archive, double f1, double f2, char *text)
+    size_t coco_archive_add_solutions(coco_archive_t *archive, size_t number_of_solutions, double *y,
+                                      const char **texts)
     size_t coco_archive_get_number_of_solutions(coco_archive_t *archive)
     double coco_archive_get_hypervolume(coco_archive_t *archive)
     char *coco_archive_get_next_solution_text(coco_archive_t *archive)
@@ -69,6 +72,35 @@ cdef class Archive:
         if updated:
             self.up_to_date = False            
         return updated
+
+    def add_solutions(self, y, texts):
+        """Adds a batch of solutions to the archive and returns the number of them contained in the updated
+           archive (the result is the same as when adding the solutions one by one, but faster).
+           :param y: objective values of the solutions (a NumPy array or any sequence of shape (n, 2))
+           :param texts: texts of the solutions (a sequence of n strings)
+        """
+        cdef np.ndarray[double, ndim=2, mode="c"] _y = np.ascontiguousarray(y, dtype=np.float64).reshape(-1, 2)
+        cdef list _texts = [_bstring(text) for text in texts]
+        cdef size_t n = _y.shape[0]
+        cdef size_t i
+        cdef const char **_c_texts
+        if <size_t> len(_texts) != n:
+            raise ValueError('The number of texts ({}) does not match the number of solutions ({})'.format(
+                len(_texts), n))
+        if n == 0:
+            return 0
+        _c_texts = <const char **> malloc(n * sizeof(char *))
+        if _c_texts == NULL:
+            raise MemoryError()
+        try:
+            for i in range(n):
+                _c_texts[i] = _texts[i]
+            updated = coco_archive_add_solutions(self.archive, n, &_y[0, 0], _c_texts)
+        finally:
+            free(_c_texts)
+        if updated:
+            self.up_to_date = False
+        return updated
         
     def get_next_solution_text(self):
         self._tmp_text = coco_archive_get_next_solution_text(self.archive)
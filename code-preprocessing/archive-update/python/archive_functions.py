@@ -46,12 +46,23 @@ class ProblemInstanceInfo:
             return False
         return True
 
-    def fill_archive(self, archive):
+    def fill_archive(self, archive, batch_size=100000):
         """Reads the solutions from the files and feeds them to the given archive. If a file contains a single
         instance, all comments are skipped. If a file contains multiple instances, only the solutions up to the next
         instance are read. If the file contains no solutions for the given problem instance, an exception is raised.
+        The solutions are fed to the archive in batches.
            :param archive: archive to be filled with solutions
+           :param batch_size: maximal number of solutions fed to the archive at once
         """
+        y = []
+        texts = []
+
+        def feed_batch():
+            if texts:
+                archive.add_solutions(y, texts)
+                del y[:]
+                del texts[:]
+
         for f_info in self.file_info:
             f_name = f_info.get('file_name')
             single_instance = f_info.get('single_instance')
@@ -82,14 +93,19 @@ class ProblemInstanceInfo:
                         if line[0] != '%':
                             # Solution found, feed it to the archive
                             try:
-                                archive.add_solution(float(line.split()[1]), float(line.split()[2]), line)
+                                values = line.split()
+                                y.append((float(values[1]), float(values[2])))
+                                texts.append(line)
                                 solution_found = True
+                                if len(texts) >= batch_size:
+                                    feed_batch()
                             except IndexError:
                                 print('Problem in file {}, line {}, skipping line'.format(f_name, line))
                                 sys.stdout.flush()
                                 continue
 
                 f.close()
+                feed_batch()
                 if not instance_found:
                     raise PreprocessingException('File \'{}\' does not contain \'instance = {}\''.format(f_name,
                                                                                                          self.instance))
@@ -156,6 +156,57 @@ def run_archive_update():
     assert almost_equal(new_hypervolumes.get('bbob-biobj_f52_i07_d02'), 0.920581303184137, precision)
 
 
+def run_add_solutions():
+    """
+    Tests whether filling the archives in batches with add_solutions() gives the same archives as adding the
+    solutions one by one with add_solution().
+    """
+    from cocoprep.archive_functions import ArchiveInfo
+    from cocoprep.archive_load_data import parse_range
+    from cocoprep.coco_archive import Archive
+
+    class OneByOneArchive:
+        """Feeds the batches of solutions to the wrapped archive one by one."""
+        def __init__(self, archive):
+            self.archive = archive
+
+        def add_solutions(self, y, texts):
+            for (f1, f2), text in zip(y, texts):
+                self.archive.add_solution(f1, f2, text)
+
+    def get_texts(archive):
+        texts = []
+        while True:
+            text = archive.get_next_solution_text()
+            if text is None:
+                return texts
+            texts.append(text)
+
+    base_path = dirname(__file__)
+    archive_info = ArchiveInfo(abspath(join(base_path, 'test-data', 'archives-input')), parse_range('1-55'),
+                               parse_range('1-10'), parse_range('2,3,5,10,20,40'), False)
+    while True:
+        problem_instance_info = archive_info.get_next_problem_instance_info()
+        if problem_instance_info is None:
+            break
+        archives = []
+        # Small batches are used so that the archives are filled with several of them
+        for batch_size in [1, 7, 100000]:
+            archive = Archive(problem_instance_info.suite_name, problem_instance_info.function,
+                              problem_instance_info.instance, problem_instance_info.dimension)
+            problem_instance_info.fill_archive(archive, batch_size)
+            archives.append(archive)
+        archive = Archive(problem_instance_info.suite_name, problem_instance_info.function,
+                          problem_instance_info.instance, problem_instance_info.dimension)
+        problem_instance_info.fill_archive(OneByOneArchive(archive))
+
+        expected_texts = get_texts(archive)
+        for batch_archive in archives:
+            assert batch_archive.number_of_solutions == archive.number_of_solutions
+            assert batch_archive.hypervolume == archive.hypervolume
+            assert get_texts(batch_archive) == expected_texts
+
+
 def run_archive_reformat():
     """
     Tests whether reformat_archives() from archive_reformat.py works correctly for the given input.
@@ -301,6 +352,9 @@ def test_all():
     run_archive_update()
     timing.log('run_archive_update done', timing.now())
 
+    run_add_solutions()
+    timing.log('run_add_solutions done', timing.now())
+
     run_archive_reformat()
     timing.log('run_archive_reformat done', timing.now())
 
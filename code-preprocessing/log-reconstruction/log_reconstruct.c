@@ -0,0 +1,989 @@
+/**
+ * @file log_reconstruct.c
+ * @brief Reconstructs the .info, .dat and .tdat files of the bbob-biobj logger from archive (.adat) files.
+ *
+ * A faster equivalent of log_reconstruct.py that produces the same output. The archive files are read
+ * line by line and the solutions are fed to the logger (in the "log_nondominated: read" mode) in batches
+ * using coco_logger_biobj_feed_solutions().
+ *
+ * Problems of different problem types write into different files. On POSIX systems, the archive files
+ * are therefore split among JOBS processes according to the problem types and processed in parallel. The
+ * files of each problem type are always processed in the same order as by the sequential reconstruction,
+ * so that the output does not depend on the number of processes.
+ *
+ * Usage:
+ *
+ *   log_reconstruct [-f FUNCTIONS] [-i INSTANCES] [-d DIMENSIONS] [-a ALGORITHM_INFO] [-j JOBS]
+ *                   OUTPUT INPUT ALGORITHM_NAME
+ *
+ * FUNCTIONS, INSTANCES and DIMENSIONS are comma-separated lists of integers and integer ranges (such as
+ * "1-10,15"), OUTPUT is the name of the result folder (within the "exdata" folder) and INPUT is the folder
+ * containing the archive files (the folder is searched recursively). By default, JOBS equals the number of
+ * available processors.
+ *
+ * To build the tool, run "python do.py build-log-reconstruction" from the root of the repository.
+ */
+
+#if !(defined(_WIN32) || defined(_WIN64) || defined(__MINGW64__) || defined(__CYGWIN__))
+#define LOG_RECONSTRUCT_POSIX 1
+#if !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+#else
+#define LOG_RECONSTRUCT_POSIX 0
+#endif
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if LOG_RECONSTRUCT_POSIX
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#else
+#include <windows.h>
+#endif
+
+#include "coco.h"
+
+/**
+ * @brief The number of solutions fed to the logger at once.
+ */
+#define LOG_RECONSTRUCT_BATCH_SIZE 4096
+
+/**
+ * @brief A sorted set of integers (functions, instances or dimensions).
+ */
+typedef struct {
+  size_t *values;    /**< @brief The values (in increasing order). */
+  size_t count;      /**< @brief The number of values. */
+  size_t capacity;   /**< @brief The number of values that fit into the allocated memory. */
+} log_reconstruct_set_t;
+
+/**
+ * @brief Information on an archive file.
+ */
+typedef struct {
+  char *file_name;   /**< @brief The path to the file. */
+  size_t size;       /**< @brief The size of the file in bytes (used to balance the work among processes). */
+  size_t function;   /**< @brief The function. */
+  size_t dimension;  /**< @brief The dimension. */
+  size_t instance;   /**< @brief The instance read from the file name or 0 if the file name has no instance. */
+  size_t group;      /**< @brief The group of files that need to be processed by the same process. */
+} log_reconstruct_file_t;
+
+/**
+ * @brief A growing list of archive files.
+ */
+typedef struct {
+  log_reconstruct_file_t *files; /**< @brief The files. */
+  size_t count;                  /**< @brief The number of files. */
+  size_t capacity;               /**< @brief The number of files that fit into the allocated memory. */
+} log_reconstruct_file_list_t;
+
+/**
+ * @brief Adds the value to the set (if it is not yet contained in it).
+ */
+static void log_reconstruct_set_add(log_reconstruct_set_t *set, const size_t value) {
+
+  size_t i, *values;
+
+  for (i = 0; (i < set->count) && (set->values[i] <= value); i++) {
+    if (set->values[i] == value)
+      return;
+  }
+
+  if (set->count == set->capacity) {
+    set->capacity = (set->capacity == 0) ? 16 : 2 * set->capacity;
+    values = (size_t *) coco_allocate_memory(set->capacity * sizeof(size_t));
+    if (set->count > 0) {
+      memcpy(values, set->values, set->count * sizeof(size_t));
+      coco_free_memory(set->values);
+    }
+    set->values = values;
+  }
+
+  memmove(set->values + i + 1, set->values + i, (set->count - i) * sizeof(size_t));
+  set->values[i] = value;
+  set->count++;
+}
+
+/**
+ * @brief Returns 1 if the set contains the value and 0 otherwise.
+ */
+static int log_reconstruct_set_contains(const log_reconstruct_set_t *set, const size_t value) {
+
+  size_t low = 0, high = set->count, middle;
+
+  while (low < high) {
+    middle = low + (high - low) / 2;
+    if (set->values[middle] == value)
+      return 1;
+    else if (set->values[middle] < value)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+  return 0;
+}
+
+/**
+ * @brief Frees the memory of the set.
+ */
+static void log_reconstruct_set_free(log_reconstruct_set_t *set) {
+  if (set->capacity > 0)
+    coco_free_memory(set->values);
+  set->values = NULL;
+  set->count = 0;
+  set->capacity = 0;
+}
+
+/**
+ * @brief Parses the nonnegative integer at the start of the string.
+ *
+ * @return The position after the integer or NULL if the string does not start with a digit.
+ */
+static const char *log_reconstruct_parse_integer(const char *string, size_t *value) {
+
+  char *end;
+  unsigned long result;
+
+  if (!isdigit((unsigned char) *string))
+    return NULL;
+  result = strtoul(string, &end, 10);
+  *value = (size_t) result;
+  return end;
+}
+
+/**
+ * @brief Skips the white space at the start of the string.
+ */
+static const char *log_reconstruct_skip_space(const char *string) {
+  while (isspace((unsigned char) *string))
+    string++;
+  return string;
+}
+
+/**
+ * @brief Parses a string of comma-separated integers and integer ranges (such as "1, 3-5, 10") into the
+ * set (as parse_range() from cocoprep.archive_load_data).
+ */
+static void log_reconstruct_set_parse(log_reconstruct_set_t *set, const char *string) {
+
+  const char *position = string;
+  size_t first, last, value;
+
+  while (*position != '\0') {
+    position = log_reconstruct_parse_integer(log_reconstruct_skip_space(position), &first);
+    if (position == NULL)
+      coco_error("log_reconstruct(): range '%s' not in correct format", string);
+    last = first;
+    position = log_reconstruct_skip_space(position);
+    if (*position == '-') {
+      position = log_reconstruct_parse_integer(log_reconstruct_skip_space(position + 1), &last);
+      if (position == NULL)
+        coco_error("log_reconstruct(): range '%s' not in correct format", string);
+      position = log_reconstruct_skip_space(position);
+      if (last < first) {
+        value = first;
+        first = last;
+        last = value;
+      }
+    }
+    if ((*position != ',') && (*position != '\0'))
+      coco_error("log_reconstruct(): range '%s' not in correct format", string);
+    if (*position == ',')
+      position++;
+    for (value = first; value <= last; value++)
+      log_reconstruct_set_add(set, value);
+  }
+}
+
+/**
+ * @brief Returns the string of comma-separated integers representing the set. If use_ranges is 1,
+ * consecutive integers are joined into ranges (such as "1-5,10"), as by get_range() from
+ * cocoprep.archive_load_data.
+ *
+ * The returned string needs to be freed by the caller.
+ */
+static char *log_reconstruct_set_to_string(const log_reconstruct_set_t *set, const int use_ranges) {
+
+  char *string = (char *) coco_allocate_memory(set->count * 2 * 24 + 1);
+  size_t i, j, length = 0;
+
+  string[0] = '\0';
+  for (i = 0; i < set->count; i = j + 1) {
+    for (j = i; use_ranges && (j + 1 < set->count) && (set->values[j + 1] == set->values[j] + 1); j++)
+      ;
+    if (i > 0)
+      string[length++] = ',';
+    if (j > i)
+      length += (size_t) sprintf(string + length, "%lu-%lu", (unsigned long) set->values[i],
+          (unsigned long) set->values[j]);
+    else
+      length += (size_t) sprintf(string + length, "%lu", (unsigned long) set->values[i]);
+  }
+  return string;
+}
+
+/**
+ * @brief Reads the value of the key from a string of comma-separated pairs "key = value" (as
+ * get_key_value() from cocoprep.archive_load_data, but only for integer values).
+ *
+ * @return 1 if the key was found and its value is an integer and 0 otherwise.
+ */
+static int log_reconstruct_get_key_value(const char *string, const char *key, size_t *value) {
+
+  const char *start, *end, *equals;
+  const size_t key_length = strlen(key);
+
+  for (start = string; *start != '\0'; start = (*end == ',') ? end + 1 : end) {
+    for (end = start; (*end != ',') && (*end != '\0'); end++)
+      ;
+    for (equals = start; (equals < end) && (*equals != '='); equals++)
+      ;
+    if (equals == end)
+      continue;
+    start = log_reconstruct_skip_space(start);
+    if ((start + key_length > equals) || (strncmp(start, key, key_length) != 0))
+      continue;
+    if (log_reconstruct_skip_space(start + key_length) != equals)
+      continue;
+    return log_reconstruct_parse_integer(log_reconstruct_skip_space(equals + 1), value) != NULL;
+  }
+  return 0;
+}
+
+/**
+ * @brief Reads the next line of the file into the buffer (which grows as needed).
+ *
+ * @return The line or NULL if the end of the file was reached.
+ */
+static char *log_reconstruct_read_line(FILE *file, char **buffer, size_t *buffer_size) {
+
+  size_t length;
+  char *larger_buffer;
+
+  if (fgets(*buffer, (int) *buffer_size, file) == NULL)
+    return NULL;
+  length = strlen(*buffer);
+  while ((length + 1 == *buffer_size) && ((*buffer)[length - 1] != '\n')) {
+    larger_buffer = (char *) coco_allocate_memory(2 * *buffer_size);
+    memcpy(larger_buffer, *buffer, length + 1);
+    coco_free_memory(*buffer);
+    *buffer = larger_buffer;
+    *buffer_size *= 2;
+    if (fgets(*buffer + length, (int) (*buffer_size - length), file) == NULL)
+      break;
+    length += strlen(*buffer + length);
+  }
+  return *buffer;
+}
+
+/**
+ * @brief Returns 1 if the line contains at least three white-space separated words and 0 otherwise.
+ */
+static int log_reconstruct_has_three_words(const char *line) {
+
+  size_t count = 0;
+
+  for (line = log_reconstruct_skip_space(line); *line != '\0'; line = log_reconstruct_skip_space(line)) {
+    if (++count == 3)
+      return 1;
+    while ((*line != '\0') && !isspace((unsigned char) *line))
+      line++;
+  }
+  return 0;
+}
+
+/**
+ * @brief Parses a line with the evaluation number followed by (at least) two objective values.
+ *
+ * @return 1 if the line was parsed successfully and 0 otherwise (the evaluation might have been parsed
+ * even if the objective values were not).
+ */
+static int log_reconstruct_parse_solution(const char *line, size_t *evaluation, double *y) {
+
+  const char *position;
+  char *end;
+  size_t i;
+
+  position = log_reconstruct_parse_integer(log_reconstruct_skip_space(line), evaluation);
+  if ((position == NULL) || !isspace((unsigned char) *position))
+    return 0;
+  for (i = 0; i < 2; i++) {
+    y[i] = strtod(position, &end);
+    if ((end == position) || ((*end != '\0') && !isspace((unsigned char) *end)))
+      return 0;
+    position = end;
+  }
+  return 1;
+}
+
+/**
+ * @brief Returns 1 if the string ends with the given ending and 0 otherwise.
+ */
+static int log_reconstruct_ends_with(const char *string, const char *ending) {
+  const size_t length = strlen(string), ending_length = strlen(ending);
+  return (length >= ending_length) && (strcmp(string + length - ending_length, ending) == 0);
+}
+
+/**
+ * @brief Adds the file with the given name to the list.
+ */
+static void log_reconstruct_file_list_add(log_reconstruct_file_list_t *list, char *file_name,
+                                          const size_t size) {
+
+  log_reconstruct_file_t *files;
+
+  if (list->count == list->capacity) {
+    list->capacity = (list->capacity == 0) ? 64 : 2 * list->capacity;
+    files = (log_reconstruct_file_t *) coco_allocate_memory(list->capacity * sizeof(log_reconstruct_file_t));
+    if (list->count > 0) {
+      memcpy(files, list->files, list->count * sizeof(log_reconstruct_file_t));
+      coco_free_memory(list->files);
+    }
+    list->files = files;
+  }
+  list->files[list->count].file_name = file_name;
+  list->files[list->count].size = size;
+  list->count++;
+}
+
+/**
+ * @brief Returns the path constructed from the folder and the file name (as os.path.join()).
+ */
+static char *log_reconstruct_join_path(const char *folder, const char *file_name) {
+  const size_t length = strlen(folder);
+  if ((length > 0) && ((folder[length - 1] == '/') || (folder[length - 1] == '\\')))
+    return coco_strdupf("%s%s", folder, file_name);
+#if LOG_RECONSTRUCT_POSIX
+  return coco_strdupf("%s/%s", folder, file_name);
+#else
+  return coco_strdupf("%s\\%s", folder, file_name);
+#endif
+}
+
+/**
+ * @brief Adds all .adat files contained in the folder (and its subfolders) to the list.
+ */
+static void log_reconstruct_find_files(log_reconstruct_file_list_t *list, const char *folder) {
+
+  char *path;
+#if LOG_RECONSTRUCT_POSIX
+  DIR *directory;
+  struct dirent *entry;
+  struct stat status;
+
+  directory = opendir(folder);
+  if (directory == NULL)
+    return;
+  while ((entry = readdir(directory)) != NULL) {
+    if ((strcmp(entry->d_name, ".") == 0) || (strcmp(entry->d_name, "..") == 0))
+      continue;
+    path = log_reconstruct_join_path(folder, entry->d_name);
+    if (stat(path, &status) != 0) {
+      coco_free_memory(path);
+    } else if (S_ISDIR(status.st_mode)) {
+      log_reconstruct_find_files(list, path);
+      coco_free_memory(path);
+    } else if (log_reconstruct_ends_with(entry->d_name, ".adat")) {
+      log_reconstruct_file_list_add(list, path, (size_t) status.st_size);
+    } else {
+      coco_free_memory(path);
+    }
+  }
+  closedir(directory);
+#else
+  WIN32_FIND_DATAA entry;
+  HANDLE handle;
+  char *pattern = log_reconstruct_join_path(folder, "*");
+
+  handle = FindFirstFileA(pattern, &entry);
+  coco_free_memory(pattern);
+  if (handle == INVALID_HANDLE_VALUE)
+    return;
+  do {
+    if ((strcmp(entry.cFileName, ".") == 0) || (strcmp(entry.cFileName, "..") == 0))
+      continue;
+    path = log_reconstruct_join_path(folder, entry.cFileName);
+    if (entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+      log_reconstruct_find_files(list, path);
+      coco_free_memory(path);
+    } else if (log_reconstruct_ends_with(entry.cFileName, ".adat")) {
+      log_reconstruct_file_list_add(list, path, (size_t) entry.nFileSizeLow);
+    } else {
+      coco_free_memory(path);
+    }
+  } while (FindNextFileA(handle, &entry));
+  FindClose(handle);
+#endif
+}
+
+/**
+ * @brief Compares the files by their names (used to sort the files).
+ */
+static int log_reconstruct_compare_files(const void *a, const void *b) {
+  return strcmp(((const log_reconstruct_file_t *) a)->file_name, ((const log_reconstruct_file_t *) b)->file_name);
+}
+
+/**
+ * @brief Reads the function, dimension and (optional) instance from the archive file name in the form
+ * [suite-name]_f[function]_d[dimension]_*.* or [suite-name]_f[function]_i[instance]_d[dimension]_*.*.
+ *
+ * @return 1 if the file name is in the expected form and 0 otherwise.
+ */
+static int log_reconstruct_parse_file_name(log_reconstruct_file_t *file) {
+
+  const char *name = file->file_name, *position;
+
+  for (position = name; *position != '\0'; position++) {
+    if ((*position == '/') || (*position == '\\'))
+      name = position + 1;
+  }
+
+  position = strchr(name, '_');
+  if ((position == NULL) || (position[1] != 'f'))
+    return 0;
+  position = log_reconstruct_parse_integer(position + 2, &file->function);
+  if ((position == NULL) || (*position != '_'))
+    return 0;
+
+  file->instance = 0;
+  if (position[1] == 'i') {
+    position = log_reconstruct_parse_integer(position + 2, &file->instance);
+    if ((position == NULL) || (*position != '_'))
+      return 0;
+  }
+  if (position[1] != 'd')
+    return 0;
+  position = log_reconstruct_parse_integer(position + 2, &file->dimension);
+  return (position != NULL) && ((*position == '_') || (*position == '\0'));
+}
+
+/**
+ * @brief Adds the instances from the "% instance = " lines of the archive file that are contained in the
+ * instance set to the found set (as get_instances() from cocoprep.archive_load_data).
+ *
+ * @return The number of "% instance = " lines in the file.
+ */
+static size_t log_reconstruct_read_instances(const char *file_name, const log_reconstruct_set_t *instances,
+                                             log_reconstruct_set_t *found, char **buffer, size_t *buffer_size) {
+
+  FILE *file;
+  char *line;
+  size_t instance, count = 0;
+
+  file = fopen(file_name, "r");
+  if (file == NULL)
+    return 0;
+  while ((line = log_reconstruct_read_line(file, buffer, buffer_size)) != NULL) {
+    if ((line[0] == '%') && (strstr(line, "instance") != NULL)
+        && log_reconstruct_get_key_value(line + 1, "instance", &instance)) {
+      count++;
+      if (log_reconstruct_set_contains(instances, instance))
+        log_reconstruct_set_add(found, instance);
+    }
+  }
+  fclose(file);
+  return count;
+}
+
+/**
+ * @brief The state of the reconstruction of a single archive file.
+ */
+typedef struct {
+  coco_problem_t *problem;    /**< @brief The problem of the current instance. */
+  size_t *batch_evaluations;  /**< @brief The evaluation numbers of the solutions in the batch. */
+  double *batch_y;            /**< @brief The objective vectors of the solutions in the batch. */
+  size_t batch_count;         /**< @brief The number of solutions in the batch. */
+  size_t count_not_updated;   /**< @brief The number of solutions that did not update the archive. */
+} log_reconstruct_state_t;
+
+/**
+ * @brief Feeds the solutions in the batch to the logger.
+ */
+static void log_reconstruct_flush(log_reconstruct_state_t *state) {
+  if (state->batch_count == 0)
+    return;
+  state->count_not_updated += state->batch_count - coco_logger_biobj_feed_solutions(state->problem,
+      state->batch_count, state->batch_evaluations, state->batch_y);
+  state->batch_count = 0;
+}
+
+/**
+ * @brief Reconstructs the logger output of the problem instances in the archive file that are contained in
+ * the instance set (mirrors log_reconstruct() from log_reconstruct.py).
+ */
+static void log_reconstruct_file(const log_reconstruct_file_t *file, const log_reconstruct_set_t *instances,
+                                 coco_suite_t *suite, coco_observer_t *observer, log_reconstruct_state_t *state,
+                                 char **buffer, size_t *buffer_size) {
+
+  FILE *input;
+  char *line;
+  double y[2], last_y[2] = { 0, 0 };
+  size_t instance = 0, value, evaluation = 0, old_evaluation;
+  int is_instance_included = 0, evaluation_found = 0, has_objective_vector = 0;
+
+  input = fopen(file->file_name, "r");
+  if (input == NULL)
+    coco_error("log_reconstruct(): failed to open file '%s'", file->file_name);
+  printf("%s\n", file->file_name);
+  fflush(stdout);
+
+  state->problem = NULL;
+  state->batch_count = 0;
+  state->count_not_updated = 0;
+
+  while ((line = log_reconstruct_read_line(input, buffer, buffer_size)) != NULL) {
+
+    if (!log_reconstruct_has_three_words(line))
+      continue;
+
+    else if ((line[0] == '%') && (strstr(line, "instance") != NULL)) {
+      if (!log_reconstruct_get_key_value(line + 1, "instance", &instance))
+        coco_error("log_reconstruct(): cannot read the instance in file '%s', line\n%s", file->file_name, line);
+      is_instance_included = log_reconstruct_set_contains(instances, instance);
+      if (is_instance_included) {
+        if (state->problem != NULL) {
+          if (!evaluation_found)
+            coco_error("log_reconstruct(): missing the line `%% evaluations = ` in the previous problem. This "
+                "problem is file = %s, instance = %lu", file->file_name, (unsigned long) instance);
+          log_reconstruct_flush(state);
+          if (state->count_not_updated > 0)
+            printf("%lu solutions did not update the archive\n", (unsigned long) state->count_not_updated);
+          coco_problem_free(state->problem);
+        }
+        state->problem = coco_suite_get_problem_by_function_dimension_instance(suite, file->function,
+            file->dimension, instance);
+        if (state->problem == NULL)
+          coco_error("log_reconstruct(): problem f%lu, d%lu, i%lu not found in the suite",
+              (unsigned long) file->function, (unsigned long) file->dimension, (unsigned long) instance);
+        state->problem = coco_problem_add_observer(state->problem, observer);
+        evaluation_found = 0;
+      }
+    }
+
+    else if ((line[0] != '%') && is_instance_included) {
+      if (!log_reconstruct_parse_solution(line, &evaluation, y)) {
+        printf("Problem in file %s, line %s, skipping line\n", file->file_name, line);
+        continue;
+      }
+      state->batch_evaluations[state->batch_count] = evaluation;
+      state->batch_y[2 * state->batch_count] = last_y[0] = y[0];
+      state->batch_y[2 * state->batch_count + 1] = last_y[1] = y[1];
+      has_objective_vector = 1;
+      if (++state->batch_count == LOG_RECONSTRUCT_BATCH_SIZE)
+        log_reconstruct_flush(state);
+    }
+
+    else if ((line[0] == '%') && (strstr(line, "evaluations") != NULL) && is_instance_included) {
+      if (!log_reconstruct_get_key_value(line + 1, "evaluations", &value))
+        coco_error("log_reconstruct(): cannot read the evaluations in file '%s', line\n%s", file->file_name,
+            line);
+      log_reconstruct_flush(state);
+      old_evaluation = evaluation;
+      evaluation = value;
+      evaluation_found = 1;
+      if ((evaluation > old_evaluation) && (state->problem != NULL) && has_objective_vector)
+        coco_logger_biobj_feed_solution(state->problem, evaluation, last_y);
+    }
+  }
+
+  if (state->problem != NULL) {
+    log_reconstruct_flush(state);
+    if (!evaluation_found)
+      printf("Missing the line `%% evaluations = ` in this or the previous problem. This is file = %s, "
+          "instance = %lu\n", file->file_name, (unsigned long) instance);
+    if (state->count_not_updated > 0)
+      printf("%lu solutions did not update the archive\n", (unsigned long) state->count_not_updated);
+    coco_problem_free(state->problem);
+    state->problem = NULL;
+  }
+  fflush(stdout);
+  fclose(input);
+}
+
+/**
+ * @brief Reconstructs the logger output of the given files that are assigned to the given worker.
+ */
+static void log_reconstruct_work(const log_reconstruct_file_list_t *list, const size_t *group_worker,
+                                 const size_t worker, const log_reconstruct_set_t *instances,
+                                 coco_suite_t *suite, coco_observer_t *observer) {
+
+  log_reconstruct_state_t state;
+  size_t buffer_size = 1024, i;
+  char *buffer = (char *) coco_allocate_memory(buffer_size);
+
+  state.problem = NULL;
+  state.batch_evaluations = (size_t *) coco_allocate_memory(LOG_RECONSTRUCT_BATCH_SIZE * sizeof(size_t));
+  state.batch_y = coco_allocate_vector(2 * LOG_RECONSTRUCT_BATCH_SIZE);
+
+  for (i = 0; i < list->count; i++) {
+    if (group_worker[list->files[i].group] == worker)
+      log_reconstruct_file(&list->files[i], instances, suite, observer, &state, &buffer, &buffer_size);
+  }
+
+  coco_free_memory(state.batch_evaluations);
+  coco_free_memory(state.batch_y);
+  coco_free_memory(buffer);
+}
+
+/**
+ * @brief Returns the representative of the group (the groups are kept in a union-find structure).
+ */
+static size_t log_reconstruct_find_group(size_t *group_parent, size_t group) {
+  while (group_parent[group] != group) {
+    group_parent[group] = group_parent[group_parent[group]];
+    group = group_parent[group];
+  }
+  return group;
+}
+
+/**
+ * @brief Groups the files so that files of different groups write into different output files and the
+ * output of each group does not depend on the other groups.
+ *
+ * Files with problems of the same problem type write into the same .info file and are put into the same
+ * group. The logger writes a "function = , dim = " line into the .info file whenever the function or
+ * dimension differ from those of the previously logged problem (of any type). If the previous file is of
+ * another type, but the previous file of the same type has the same function and dimension, the two types
+ * are therefore also put into the same group.
+ *
+ * @return The number of groups.
+ */
+static size_t log_reconstruct_group_files(log_reconstruct_file_list_t *list, coco_suite_t *suite,
+                                          const log_reconstruct_set_t *instances) {
+
+  char **problem_types;
+  size_t *group_parent, *group_last_file, *group_index;
+  size_t i, j, group, number_of_types = 0, number_of_groups = 0;
+  coco_problem_t *problem;
+  int changed = 1;
+
+  problem_types = (char **) coco_allocate_memory(list->count * sizeof(char *));
+  for (i = 0; i < list->count; i++) {
+    problem = coco_suite_get_problem_by_function_dimension_instance(suite, list->files[i].function,
+        list->files[i].dimension, instances->values[0]);
+    if (problem == NULL)
+      coco_error("log_reconstruct(): problem f%lu, d%lu not found in the suite",
+          (unsigned long) list->files[i].function, (unsigned long) list->files[i].dimension);
+    for (j = 0; (j < number_of_types) && (strcmp(problem_types[j], coco_problem_get_type(problem)) != 0); j++)
+      ;
+    if (j == number_of_types)
+      problem_types[number_of_types++] = coco_strdupf("%s", coco_problem_get_type(problem));
+    list->files[i].group = j;
+    coco_problem_free(problem);
+  }
+
+  group_parent = (size_t *) coco_allocate_memory((number_of_types + 1) * sizeof(size_t));
+  group_last_file = (size_t *) coco_allocate_memory((number_of_types + 1) * sizeof(size_t));
+  group_index = (size_t *) coco_allocate_memory((number_of_types + 1) * sizeof(size_t));
+  for (j = 0; j < number_of_types; j++)
+    group_parent[j] = j;
+
+  while (changed) {
+    changed = 0;
+    for (j = 0; j < number_of_types; j++)
+      group_last_file[j] = list->count;
+    for (i = 0; i < list->count; i++) {
+      group = log_reconstruct_find_group(group_parent, list->files[i].group);
+      j = group_last_file[group];
+      if ((i > 0) && (log_reconstruct_find_group(group_parent, list->files[i - 1].group) != group)
+          && (j < list->count) && (list->files[j].function == list->files[i].function)
+          && (list->files[j].dimension == list->files[i].dimension)) {
+        group_parent[log_reconstruct_find_group(group_parent, list->files[i - 1].group)] = group;
+        changed = 1;
+      }
+      group_last_file[group] = i;
+    }
+  }
+
+  /* Number the groups consecutively */
+  for (j = 0; j < number_of_types; j++)
+    group_index[j] = number_of_types;
+  for (j = 0; j < number_of_types; j++) {
+    group = log_reconstruct_find_group(group_parent, j);
+    if (group_index[group] == number_of_types)
+      group_index[group] = number_of_groups++;
+  }
+  for (i = 0; i < list->count; i++)
+    list->files[i].group = group_index[log_reconstruct_find_group(group_parent, list->files[i].group)];
+
+  for (j = 0; j < number_of_types; j++)
+    coco_free_memory(problem_types[j]);
+  coco_free_memory(problem_types);
+  coco_free_memory(group_parent);
+  coco_free_memory(group_last_file);
+  coco_free_memory(group_index);
+  return number_of_groups;
+}
+
+/**
+ * @brief Assigns the groups to the workers so that their total file sizes are balanced (the largest group
+ * is assigned to the least loaded worker first).
+ */
+static void log_reconstruct_assign_groups(const log_reconstruct_file_list_t *list, const size_t number_of_groups,
+                                          const size_t number_of_workers, size_t *group_worker) {
+
+  double *group_size, *worker_size;
+  size_t i, j, largest, worker;
+
+  group_size = coco_allocate_vector(number_of_groups);
+  worker_size = coco_allocate_vector(number_of_workers);
+  for (j = 0; j < number_of_groups; j++) {
+    group_size[j] = 0;
+    group_worker[j] = number_of_workers;
+  }
+  for (i = 0; i < list->count; i++)
+    group_size[list->files[i].group] += (double) list->files[i].size + 1;
+  for (worker = 0; worker < number_of_workers; worker++)
+    worker_size[worker] = 0;
+
+  for (i = 0; i < number_of_groups; i++) {
+    largest = number_of_groups;
+    for (j = 0; j < number_of_groups; j++) {
+      if ((group_worker[j] == number_of_workers) && ((largest == number_of_groups)
+          || (group_size[j] > group_size[largest])))
+        largest = j;
+    }
+    worker = 0;
+    for (j = 1; j < number_of_workers; j++) {
+      if (worker_size[j] < worker_size[worker])
+        worker = j;
+    }
+    group_worker[largest] = worker;
+    worker_size[worker] += group_size[largest];
+  }
+
+  coco_free_memory(group_size);
+  coco_free_memory(worker_size);
+}
+
+/**
+ * @brief Runs the workers (in parallel processes if possible) and returns 0 if all of them succeeded.
+ */
+static int log_reconstruct_run_workers(const log_reconstruct_file_list_t *list, const size_t *group_worker,
+                                       const size_t number_of_workers, const log_reconstruct_set_t *instances,
+                                       coco_suite_t *suite, coco_observer_t *observer) {
+#if LOG_RECONSTRUCT_POSIX
+  pid_t *pids;
+  size_t worker;
+  int status, result = 0;
+
+  if (number_of_workers > 1) {
+    pids = (pid_t *) coco_allocate_memory(number_of_workers * sizeof(pid_t));
+    fflush(stdout);
+    fflush(stderr);
+    for (worker = 0; worker < number_of_workers; worker++) {
+      pids[worker] = fork();
+      if (pids[worker] < 0) {
+        coco_error("log_reconstruct(): failed to start a new process");
+      } else if (pids[worker] == 0) {
+        log_reconstruct_work(list, group_worker, worker, instances, suite, observer);
+        exit(EXIT_SUCCESS);
+      }
+    }
+    for (worker = 0; worker < number_of_workers; worker++) {
+      if ((waitpid(pids[worker], &status, 0) < 0) || !WIFEXITED(status) || (WEXITSTATUS(status) != 0))
+        result = 1;
+    }
+    coco_free_memory(pids);
+    return result;
+  }
+#endif
+  log_reconstruct_work(list, group_worker, 0, instances, suite, observer);
+  (void) number_of_workers;
+  return 0;
+}
+
+/**
+ * @brief Returns the number of available processors.
+ */
+static size_t log_reconstruct_get_number_of_processors(void) {
+#if LOG_RECONSTRUCT_POSIX && defined(_SC_NPROCESSORS_ONLN)
+  long number = sysconf(_SC_NPROCESSORS_ONLN);
+  if (number > 0)
+    return (size_t) number;
+#endif
+  return 1;
+}
+
+/**
+ * @brief Prints the usage of the tool.
+ */
+static void log_reconstruct_print_usage(void) {
+  printf("Usage: log_reconstruct [-f FUNCTIONS] [-i INSTANCES] [-d DIMENSIONS] [-a ALGORITHM_INFO] [-j JOBS]\n");
+  printf("                       OUTPUT INPUT ALGORITHM_NAME\n\n");
+  printf("Reconstructs the .info, .dat and .tdat files produced by the bbob-biobj logger from the .adat files\n");
+  printf("in the INPUT folder and stores them into the OUTPUT folder (within the exdata folder).\n\n");
+  printf("  -f FUNCTIONS       functions to be included (default 1-92)\n");
+  printf("  -i INSTANCES       instances to be included (default 1-15)\n");
+  printf("  -d DIMENSIONS      dimensions to be included (default 2,3,5,10,20,40)\n");
+  printf("  -a ALGORITHM_INFO  algorithm information (default '')\n");
+  printf("  -j JOBS            number of parallel processes (default: number of processors)\n");
+}
+
+int main(int argc, char *argv[]) {
+
+  log_reconstruct_set_t functions = { NULL, 0, 0 }, instances = { NULL, 0, 0 }, dimensions = { NULL, 0, 0 };
+  log_reconstruct_set_t found_functions = { NULL, 0, 0 }, found_instances = { NULL, 0, 0 };
+  log_reconstruct_set_t found_dimensions = { NULL, 0, 0 }, file_instances = { NULL, 0, 0 };
+  log_reconstruct_file_list_t all_files = { NULL, 0, 0 }, list = { NULL, 0, 0 };
+  const char *positional[3] = { NULL, NULL, NULL };
+  const char *function_range = "1-92", *instance_range = "1-15", *dimension_range = "2,3,5,10,20,40";
+  const char *algorithm_info = "";
+  char *function_string, *instance_string, *dimension_string, *suite_instance, *suite_options;
+  char *observer_options, *buffer;
+  size_t buffer_size = 1024, number_of_jobs = 0, number_of_positional = 0, number_of_groups, i, j;
+  size_t *group_worker;
+  coco_suite_t *suite;
+  coco_observer_t *observer;
+  log_reconstruct_file_t *file;
+  int is_ext = 0, result;
+
+  for (i = 1; i < (size_t) argc; i++) {
+    if ((strcmp(argv[i], "-h") == 0) || (strcmp(argv[i], "--help") == 0)) {
+      log_reconstruct_print_usage();
+      return EXIT_SUCCESS;
+    } else if ((argv[i][0] == '-') && (argv[i][1] != '\0') && (argv[i][2] == '\0') && (i + 1 < (size_t) argc)
+        && (strchr("fidaj", argv[i][1]) != NULL)) {
+      if (argv[i][1] == 'f')
+        function_range = argv[++i];
+      else if (argv[i][1] == 'i')
+        instance_range = argv[++i];
+      else if (argv[i][1] == 'd')
+        dimension_range = argv[++i];
+      else if (argv[i][1] == 'a')
+        algorithm_info = argv[++i];
+      else if ((log_reconstruct_parse_integer(argv[++i], &number_of_jobs) == NULL) || (number_of_jobs == 0))
+        coco_error("log_reconstruct(): the number of jobs '%s' is not a positive integer", argv[i]);
+    } else if (number_of_positional < 3) {
+      positional[number_of_positional++] = argv[i];
+    } else {
+      log_reconstruct_print_usage();
+      return EXIT_FAILURE;
+    }
+  }
+  if (number_of_positional < 3) {
+    log_reconstruct_print_usage();
+    return EXIT_FAILURE;
+  }
+  log_reconstruct_set_parse(&functions, function_range);
+  log_reconstruct_set_parse(&instances, instance_range);
+  log_reconstruct_set_parse(&dimensions, dimension_range);
+  if (number_of_jobs == 0)
+    number_of_jobs = log_reconstruct_get_number_of_processors();
+
+  printf("Program called with arguments: \ninput folder = %s\noutput folder = %s\n", positional[1],
+      positional[0]);
+  printf("functions = %s \ninstances = %s\ndimensions = %s\n", function_range, instance_range, dimension_range);
+  printf("alg_name = %s \nalg_info = %s\n\n", positional[2], algorithm_info);
+
+  /* Collect the archive files and the problem instances they contain (as ArchiveInfo) */
+  printf("Reading archive information...\n");
+  fflush(stdout);
+  log_reconstruct_find_files(&all_files, positional[1]);
+  if (all_files.count == 0)
+    coco_error("log_reconstruct(): folder '%s' does not exist or is empty", positional[1]);
+  qsort(all_files.files, all_files.count, sizeof(log_reconstruct_file_t), log_reconstruct_compare_files);
+
+  buffer = (char *) coco_allocate_memory(buffer_size);
+  for (i = 0; i < all_files.count; i++) {
+    file = &all_files.files[i];
+    if (!log_reconstruct_parse_file_name(file)) {
+      printf("Skipping file %s\nFile name '%s' not in expected format '[suite-name]_f[function]_d[dimension]_*.*' "
+          "or '[suite-name]_f[function]_i[instance]_d[dimension]_*.*'\n", file->file_name, file->file_name);
+      coco_free_memory(file->file_name);
+      continue;
+    }
+    if (!log_reconstruct_set_contains(&functions, file->function)
+        || !log_reconstruct_set_contains(&dimensions, file->dimension)) {
+      coco_free_memory(file->file_name);
+      continue;
+    }
+    if (file->instance > 0) {
+      if (log_reconstruct_set_contains(&instances, file->instance))
+        log_reconstruct_set_add(&file_instances, file->instance);
+    } else if (log_reconstruct_read_instances(file->file_name, &instances, &file_instances, &buffer,
+        &buffer_size) == 0) {
+      printf("Skipping file %s\nFile '%s' does not contain an 'instance' string\n", file->file_name,
+          file->file_name);
+    }
+    if (file_instances.count == 0) {
+      coco_free_memory(file->file_name);
+      continue;
+    }
+    log_reconstruct_file_list_add(&list, file->file_name, file->size);
+    list.files[list.count - 1].function = file->function;
+    list.files[list.count - 1].dimension = file->dimension;
+    list.files[list.count - 1].instance = file->instance;
+    log_reconstruct_set_add(&found_functions, file->function);
+    log_reconstruct_set_add(&found_dimensions, file->dimension);
+    for (j = 0; j < file_instances.count; j++)
+      log_reconstruct_set_add(&found_instances, file_instances.values[j]);
+    file_instances.count = 0;
+    if ((file->function >= 55) && (file->function <= 92))
+      is_ext = 1;
+  }
+  coco_free_memory(buffer);
+  printf("Successfully processed archive information from %lu files.\n", (unsigned long) list.count);
+  if (list.count == 0) {
+    printf("No archive files to reconstruct.\n");
+    return EXIT_SUCCESS;
+  }
+
+  printf("Initializing the suite and observer...\n");
+  function_string = log_reconstruct_set_to_string(&found_functions, 1);
+  instance_string = log_reconstruct_set_to_string(&found_instances, 1);
+  dimension_string = log_reconstruct_set_to_string(&found_dimensions, 0);
+  suite_instance = coco_strdupf("instances: %s", instance_string);
+  suite_options = coco_strdupf("dimensions: %s function_indices: %s", dimension_string, function_string);
+  suite = coco_suite(is_ext ? "bbob-biobj-ext" : "bbob-biobj", suite_instance, suite_options);
+  if (suite == NULL)
+    coco_error("log_reconstruct(): cannot construct the suite with options '%s'", suite_options);
+  observer_options = coco_strdupf("result_folder: %s algorithm_name: %s algorithm_info: \"%s\" "
+      "log_nondominated: read", positional[0], positional[2], algorithm_info);
+  observer = coco_observer("bbob-biobj", observer_options);
+
+  number_of_groups = log_reconstruct_group_files(&list, suite, &found_instances);
+  if (number_of_jobs > number_of_groups)
+    number_of_jobs = number_of_groups;
+  group_worker = (size_t *) coco_allocate_memory(number_of_groups * sizeof(size_t));
+  log_reconstruct_assign_groups(&list, number_of_groups, number_of_jobs, group_worker);
+
+  printf("Reconstructing (%lu files, %lu processes)...\n", (unsigned long) list.count,
+      (unsigned long) number_of_jobs);
+  fflush(stdout);
+  result = log_reconstruct_run_workers(&list, group_worker, number_of_jobs, &instances, suite, observer);
+
+  coco_observer_free(observer);
+  coco_suite_free(suite);
+  for (i = 0; i < list.count; i++)
+    coco_free_memory(list.files[i].file_name);
+  coco_free_memory(list.files);
+  coco_free_memory(all_files.files);
+  coco_free_memory(group_worker);
+  coco_free_memory(function_string);
+  coco_free_memory(instance_string);
+  coco_free_memory(dimension_string);
+  coco_free_memory(suite_instance);
+  coco_free_memory(suite_options);
+  coco_free_memory(observer_options);
+  log_reconstruct_set_free(&functions);
+  log_reconstruct_set_free(&instances);
+  log_reconstruct_set_free(&dimensions);
+  log_reconstruct_set_free(&found_functions);
+  log_reconstruct_set_free(&found_instances);
+  log_reconstruct_set_free(&found_dimensions);
+  log_reconstruct_set_free(&file_instances);
+
+  if (result != 0)
+    coco_error("log_reconstruct(): the reconstruction failed");
+  printf("Done.\n");
+  return EXIT_SUCCESS;
+}
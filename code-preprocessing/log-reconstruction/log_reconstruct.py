@@ -25,7 +25,8 @@ def log_reconstruct(input_path, output_path, algorithm_name, algorithm_info, fun
     function_string = archive_info.get_function_string()
     instance_string = archive_info.get_instance_string()
     dimension_string = archive_info.get_dimension_string()
-    file_name_set = archive_info.get_file_name_set()
+    # The files are read in the order of their names (as by the C tool log_reconstruct)
+    file_name_set = sorted(archive_info.get_file_name_set())
 
     print('Initializing the suite and observer...')
     suite_instance = 'instances: {}'.format(instance_string)
@@ -85,7 +86,7 @@ def log_reconstruct(input_path, output_path, algorithm_name, algorithm_info, fun
                         print('Problem in file {}, line {}, skipping line\n{}'.format(input_file, line, error))
                         continue
 
-                elif line[0] == '%' and 'evaluations' in line:
+                elif line[0] == '%' and 'evaluations' in line and instance in instances:
                     old_evaluation = evaluation
                     evaluation = int(get_key_value(line[1:], 'evaluations'))
                     evaluation_found = True
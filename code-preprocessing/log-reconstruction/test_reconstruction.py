@@ -134,6 +134,32 @@ def run_log_reconstruct():
                           abspath(join(root, name)).replace('exdata', 'test-data'))
 
 
+def run_log_reconstruct_c():
+    """
+    Tests whether the C tool log_reconstruct (built with `python do.py build-log-reconstruction`) produces the
+    same output as log_reconstruct() from log_reconstruct.py. Skipped if the tool has not been built.
+    """
+    import subprocess
+
+    base_path = abspath(dirname(__file__))
+    executable = join(base_path, 'log_reconstruct')
+    if not exists(executable) and not exists(executable + '.exe'):
+        return
+
+    subprocess.check_call([executable, '-f', '1-55', '-i', '1-10', '-d', '2,3,5,10,20,40',
+                           '-a', 'A test for reconstruction of logger output',
+                           'reconstruction-c', join(base_path, 'test-data', 'archives-input'), 'RECONSTRUCTOR'],
+                          cwd=base_path)
+
+    endings = ('.info', '.dat', '.tdat')
+    for root, dirs, files in walk(abspath(join(base_path, 'exdata', 'reconstruction')), topdown=False):
+        files = [f for f in files if f.endswith(endings)]
+        for name in files:
+            assert compare_files(abspath(join(root, name)),
+                                 abspath(join(root, name)).replace(join('exdata', 'reconstruction'),
+                                                                   join('exdata', 'reconstruction-c')), 0.5e-15)
+
+
 def run_merge_lines():
     """
     Tests whether merge_lines_in() from merge_lines_in_info_files.py works correctly for the given input.
@@ -168,6 +194,8 @@ def test_all():
 
     run_log_reconstruct()
 
+    run_log_reconstruct_c()
+
     run_merge_lines()
 
     cleanup_reconstruction_data()
@@ -141,6 +141,7 @@ def run_c_unit_tests():
     """ Runs unit tests in C """
     try:
         run('code-experiments/test/unit-test', ['./unit_test'], verbose=_verbosity)
+        run('code-experiments/test/unit-test', ['./unit_test_profiling'], verbose=_verbosity)
     except subprocess.CalledProcessError:
         sys.exit(-1)
 
@@ -156,6 +157,10 @@ def build_c_integration_tests():
     copy_file('code-experiments/src/bbob2009_testcases2.txt', 'code-experiments/test/integration-test/bbob2009_testcases2.txt')
     make("code-experiments/test/integration-test", "clean", verbose=_build_verbosity)
     make("code-experiments/test/integration-test", "all", verbose=_build_verbosity)
+    # The toy-socket test needs the socket servers and the replay server
+    build_toy_socket_server_c()
+    build_toy_socket_server_python()
+    build_replay_server()
 
 
 def run_c_integration_tests():
@@ -175,10 +180,72 @@ def run_c_integration_tests():
             ['./test_bbob-largescale'], verbose=_verbosity)
         run('code-experiments/test/integration-test',
             ['./test_bbob-mixint'], verbose=_verbosity)
+        run_c_toy_socket_tests()
     except subprocess.CalledProcessError:
         sys.exit(-1)
 
 
+def _start_socket_server(command, port):
+    """Starts the socket server with the given command and waits until it accepts connections on
+    the given port"""
+    server = subprocess.Popen(command)
+    for _ in range(100):
+        if server.poll() is not None:
+            break  # The server has stopped (for example, because the port is still in use)
+        try:
+            socket.create_connection((socket_server_host, port)).close()
+            return server
+        except socket.error:
+            time.sleep(0.1)
+    server.kill()
+    raise RuntimeError('Socket server on port {} did not start'.format(port))
+
+
+def _run_c_replay_tests(port):
+    """Records the evaluations of the socket server on the given port with both protocols and checks
+    that the replay server answers the requests sent with either protocol in the same way"""
+    test_dir = os.path.join('code-experiments', 'test', 'integration-test')
+    replay_server = os.path.join('code-experiments', 'rw-problems', 'replay_server')
+    for replay_port, protocol in zip([socket_test_port_replay, socket_test_port_replay + 1], ['text', 'binary']):
+        log = 'toy-socket-{}.log'.format(protocol)
+        if os.path.exists(os.path.join(test_dir, log)):
+            os.remove(os.path.join(test_dir, log))
+        run(test_dir, ['./test_toy-socket', 'record', str(port), log, protocol], verbose=_verbosity)
+        server = _start_socket_server([replay_server, str(replay_port),
+                                       os.path.abspath(os.path.join(test_dir, log)), 'silent'], replay_port)
+        try:
+            run(test_dir, ['./test_toy-socket', 'replay', str(replay_port), str(port), protocol],
+                verbose=_verbosity)
+        finally:
+            _stop_socket_server(replay_port)
+            server.wait()
+        os.remove(os.path.join(test_dir, log))
+
+
+def run_c_toy_socket_tests():
+    """Runs the toy-socket integration tests in C against the C and Python socket servers and the
+    replay server (the servers are started on their test ports and stopped afterwards)"""
+    rw_problems = os.path.join('code-experiments', 'rw-problems')
+    # Only the C server serves several connections at once, its evaluations are also replayed
+    servers = [([os.path.join(rw_problems, 'socket_server')], socket_test_port_c, 2, True),
+               ([sys.executable, os.path.join(rw_problems, 'socket_server.py')], socket_test_port_python, 1,
+                False)]
+    for command, port, connections, replay in servers:
+        server = _start_socket_server(command + [str(port), 'silent'], port)
+        try:
+            run('code-experiments/test/integration-test',
+                ['./test_toy-socket', 'protocols', str(port)], verbose=_verbosity)
+            run('code-experiments/test/integration-test',
+                ['./test_toy-socket', 'pipelining', str(port), str(connections)], verbose=_verbosity)
+            run('code-experiments/test/integration-test',
+                ['./test_toy-socket', 'combined', str(port)], verbose=_verbosity)
+            if replay:
+                _run_c_replay_tests(port)
+        finally:
+            _stop_socket_server(port)
+            server.wait()
+
+
 def build_c_example_tests():
     """ Builds an example experiment test in C """
     if os.path.exists('code-experiments/test/example-test'):
@@ -754,6 +821,9 @@ socket_server_host = '127.0.0.1'  # Local host
 socket_server_port_c = 7000
 socket_server_port_python = 7200
 socket_server_ports = [socket_server_port_c, socket_server_port_python]
+socket_test_port_c = 7300  # Ports used by the integration tests
+socket_test_port_python = 7301
+socket_test_port_replay = 7302  # The first of two ports used by the replay servers in the integration tests
 rw_evaluator_top_trumps = 'EVALUATE_RW_TOP_TRUMPS'
 rw_evaluator_mario_gan = 'EVALUATE_RW_MARIO_GAN'
 rw_evaluators = [rw_evaluator_top_trumps, rw_evaluator_mario_gan]
@@ -935,6 +1005,33 @@ def build_socket_servers(force_download=False):
     build_rw_mario_gan_server(force_download=force_download, exclusive_evaluator=False)
 
 
+def build_replay_server():
+    """Build the replay server, which answers the requests from a log recorded with the suite option
+    'record' instead of calling the evaluators (only the toy socket evaluator is built in)"""
+    for rw_evaluator in rw_evaluators:
+        _set_external_evaluator(rw_evaluator, 0)
+    make(os.path.join('code-experiments', 'rw-problems'), 'replay_server', verbose=_build_verbosity)
+
+
+def run_replay_server(port, log, precision_x=None, do_build=False):
+    """Build (if do_build) and run the replay server that answers the requests from the given log (the
+    precision_x of the text protocol is used to match the requests sent with the other protocol)"""
+    if log is None:
+        print('The log needs to be given (log=<file>)')
+        sys.exit(-1)
+    if do_build:
+        build_replay_server()
+    if port is None:
+        port = socket_server_port_c
+    command = '{} {} {} {}silent'.format(
+        os.path.join('code-experiments', 'rw-problems', 'replay_server'),
+        port, os.path.abspath(log), '' if precision_x is None else 'precision_x={} '.format(precision_x))
+    if 'win32' not in sys.platform:
+        command = './' + command
+    p = Process(target=subprocess.Popen, args=(command,), kwargs=dict(shell=True))
+    p.start()
+
+
 def run_toy_socket_server_c(port, do_build=False):
     """Build and run the socket server with the toy socket evaluator in C"""
     if do_build:
@@ -1153,6 +1250,18 @@ def install_preprocessing(package_install_option=[]):
            verbose=_verbosity, custom_exception_handler=install_error)
 
 
+def build_log_reconstruction():
+    """ Builds the C tool for the reconstruction of the bbob-biobj logger output """
+    global RELEASE
+    amalgamate(CORE_FILES + ['code-experiments/src/coco_runtime_c.c'],
+               'code-preprocessing/log-reconstruction/coco.c', RELEASE,
+               {"COCO_VERSION": git_version(pep440=True)})
+    expand_file('code-experiments/src/coco.h', 'code-preprocessing/log-reconstruction/coco.h',
+                {'COCO_VERSION': git_version(pep440=True)})
+    make("code-preprocessing/log-reconstruction", "clean", verbose=_build_verbosity)
+    make("code-preprocessing/log-reconstruction", "all", verbose=_build_verbosity)
+
+
 def test_preprocessing(package_install_option=[]):
     install_preprocessing(package_install_option=package_install_option)
     python('code-preprocessing/archive-update', ['-m', 'pytest'], verbose=_verbosity)
@@ -1275,12 +1384,15 @@ Available commands for users:
   build-rw-mario-gan-server      - Build the rw_mario_gan server (will download data if not yet present) 
   build-socket-servers           - Build all the available servers (will download data if not yet present) 
   build-rw-experiment            - Build the experiment with sockets (will download data if not yet present) 
+  build-replay-server            - Build the server that replays evaluations recorded with the suite option 'record'
 
   run-toy-socket-server-c        - Build and run the toy socket server in C
   run-toy-socket-server-python   - Build and run the toy socket server in Python
   run-rw-top-trumps-server       - Build and run the rw_top_trumps server (will download data if not yet present) 
   run-rw-mario-gan-server        - Build and run the rw_mario_gan server (will download data if not yet present)  
   run-socket-servers             - Build and run all socket servers (will download data if not yet present) 
+  run-replay-server              - Build and run the replay server (the recorded log is given with log=<file>,
+                                   the precision of the text protocol with precision_x=<n>)
   stop-socket-servers            - Stop all running socket servers
   run-rw-experiment              - Run the experiment with sockets 
 
@@ -1318,6 +1430,8 @@ Available commands for developers:
                             below)
   test-preprocessing      - Runs preprocessing tests [needs access to the
                             internet] (see NOTE below)
+  build-log-reconstruction - Build the C tool for the reconstruction of the
+                            bbob-biobj logger output
   
 NOTE: These commands install Python packages to the global site packages by
       by default. This behavior can be modified by providing one of the
@@ -1341,6 +1455,8 @@ def main(args):
     port = None
     force_rw_download = False  # Whether to force download of the data of the real-world problems
     rw_do_build = True  # Whether to also build real-world problem servers when running them
+    replay_log = None  # The log of recorded evaluations used by the replay server
+    replay_precision_x = None  # The precision of the x-values used by the text protocol
     for arg in args[1:]:
         if arg == 'and-test':
             also_test_python = True
@@ -1354,6 +1470,10 @@ def main(args):
             force_rw_download = strtobool(arg[18:])
         elif arg[:6] == 'build=':
             rw_do_build = strtobool(arg[6:])
+        elif arg[:4] == 'log=':
+            replay_log = arg[4:]
+        elif arg[:12] == 'precision_x=':
+            replay_precision_x = int(arg[12:])
     if cmd == 'build': build(package_install_option=package_install_option)
     elif cmd == 'run': run_all(package_install_option=package_install_option)
     elif cmd == 'test': test()
@@ -1389,6 +1509,7 @@ def main(args):
     elif cmd == 'leak-check': leak_check()
     elif cmd == 'install-preprocessing': install_preprocessing(package_install_option=package_install_option)
     elif cmd == 'test-preprocessing': test_preprocessing(package_install_option=package_install_option)
+    elif cmd == 'build-log-reconstruction': build_log_reconstruction()
     elif cmd == 'build-toy-socket-server-c': build_toy_socket_server_c()
     elif cmd == 'build-toy-socket-server-python': build_toy_socket_server_python()
     elif cmd == 'build-rw-top-trumps-server': build_rw_top_trumps_server(force_download=force_rw_download)
@@ -1400,6 +1521,8 @@ def main(args):
     elif cmd == 'run-rw-mario-gan-server': run_rw_mario_gan_server(port=port, force_download=force_rw_download, do_build=rw_do_build)
     elif cmd == 'run-socket-servers': run_socket_servers(force_download=force_rw_download, do_build=rw_do_build)
     elif cmd == 'stop-socket-servers': stop_socket_servers(port=port)
+    elif cmd == 'build-replay-server': build_replay_server()
+    elif cmd == 'run-replay-server': run_replay_server(port=port, log=replay_log, precision_x=replay_precision_x, do_build=rw_do_build)
     elif cmd == 'build-rw-experiment': build_rw_experiment(
         package_install_option=package_install_option, force_download=force_rw_download,
         args=args[1:])